@@ -6,8 +6,10 @@ import {
   DefWindowProcW,
   DispatchMessageW,
   GetMessageW,
+  MSG,
   PostQuitMessage,
   RegisterClassExW,
+  SetWndProcNumericParams,
   ShowWindow,
   TranslateMessage,
   UpdateWindow,
@@ -24,17 +26,25 @@ import {
   WS_VISIBLE,
 } from '@libwin/user32';
 
-function WndProc(windowHandle: bigint, message: number, longParam: number, wordParam: number): bigint {
+// wParam and lParam arrive as Numbers unless they don't fit in one, and DefWindowProcW returns a Number likewise.
+function WndProc(
+  windowHandle: bigint,
+  message: number,
+  wordParam: number | bigint,
+  longParam: number | bigint,
+): number | bigint {
   switch (message) {
     case WM_DESTROY:
       PostQuitMessage(0);
-      return 0n;
+      return 0;
     default:
-      return DefWindowProcW(windowHandle, message, longParam, wordParam);
+      return DefWindowProcW(windowHandle, message, wordParam, longParam);
   }
 }
 
 function WinMain(instanceHandle: number, showCmd: number): number {
+  SetWndProcNumericParams(true);
+
   RegisterClassExW({
     cbSize: 80,
     style: CS_VREDRAW,
@@ -64,7 +74,7 @@ function WinMain(instanceHandle: number, showCmd: number): number {
 
   UpdateWindow(hWnd);
 
-  const msg = {};
+  const msg = new MSG();
 
   while (GetMessageW(msg, null, 0, 0)) {
     TranslateMessage(msg);
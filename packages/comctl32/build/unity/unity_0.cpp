@@ -0,0 +1 @@
+#include "../../src/comctl32.cpp"
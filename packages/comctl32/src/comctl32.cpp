@@ -1,5 +1,9 @@
 #include "comctl32.hpp"
 
-Napi::Object Initialize(const Napi::Env env, Napi::Object exports) { return exports; }
+Napi::Object Comctl32::Initialize(const Napi::Env env, Napi::Object exports) { return exports; }
+
+#ifndef LIBWIN_MONOLITHIC
+static Napi::Object Initialize(const Napi::Env env, Napi::Object exports) { return Comctl32::Initialize(env, exports); }
 
 NODE_API_MODULE(comctl32, Initialize)
+#endif
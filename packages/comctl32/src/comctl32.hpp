@@ -7,6 +7,10 @@
 #include "../../common/include/quickbind.hpp"
 
 namespace Comctl32 {
+  // Defines every comctl32 binding on `exports`. Called by this addon's module entry point, or by the combined libwin
+  // addon when building with LIBWIN_MONOLITHIC.
+  Napi::Object Initialize(const Napi::Env env, Napi::Object exports);
+
   Napi::Value AddMRUStringW(const Napi::CallbackInfo &info);
   Napi::Value CreateMRUListW(const Napi::CallbackInfo &info);
   Napi::Value CreateMappedBitmap(const Napi::CallbackInfo &info);
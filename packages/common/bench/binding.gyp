@@ -0,0 +1,22 @@
+{
+  "includes": [
+    "../../../common.gypi"
+  ],
+  "targets": [
+    {
+      "target_name": "quickbind_bench",
+      "sources": [
+        "src/quickbind_bench.cpp"
+      ],
+      "include_dirs": [
+        "<!(node -p \"require('node-addon-api').include\")"
+      ],
+      "dependencies": [
+        "<!(node -p \"require('node-addon-api').targets\"):node_addon_api"
+      ],
+      "ldflags": [
+        "-Wl,-Bsymbolic-functions"
+      ]
+    }
+  ]
+}
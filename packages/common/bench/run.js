@@ -0,0 +1,143 @@
+//@ts-check
+import { writeFileSync } from 'node:fs';
+import { constants } from 'node:os';
+import { fileURLToPath } from 'node:url';
+
+// Runs the native quickbind benchmarks in ./src and reports ns/op and heap allocations/op for every case as JSON.
+//
+// Usage: node packages/common/bench/run.js [--filter=regex] [--iterations=200000] [--output=file]
+//
+// Build the addon first with `npm run build:bench --workspace=packages/common`. Off Windows the win32-stub backend is
+// loaded as well, since the ANSI string readers call into it; build it with `npm run build:stub`. Every case is warmed
+// up for a tenth of its iterations before it is timed.
+const options = process.argv.slice(2);
+
+const filter = new RegExp(option('filter') ?? '');
+const iterations = Math.max(1, Number.parseInt(option('iterations') ?? '200000', 10) || 1);
+const output = option('output');
+
+if (process.platform !== 'win32') {
+  load('../win32-stub/build/Release/win32_stub.node', constants.dlopen.RTLD_NOW | constants.dlopen.RTLD_GLOBAL);
+}
+
+/** @type {{ cases(): string[], run(name: string, iterations: number, value: unknown): Result | undefined }} */
+const bench = load('./build/Release/quickbind_bench.node');
+
+const SHORT_STRING = 'The quick brown fox jumps over the lazy dog.';
+const LONG_STRING = SHORT_STRING.repeat(24);
+
+/**
+ * The value each reader reads, by reader name without Required/Optional and template arguments. Readers listed with
+ * more than one value are run once for each.
+ *
+ * @type {Record<string, Record<string, unknown>>}
+ */
+const VALUES = {
+  Boolean: { '': true },
+  Uint8: { '': 42 },
+  Int8: { '': -42 },
+  Uint16: { '': 42 },
+  Int16: { '': -42 },
+  Uint32: { '': 42 },
+  Int32: { '': -42 },
+  Uint64: { '': 0x1234n },
+  Int64: { '': -0x1234n },
+  UintPtr: { Number: 42, BigInt: 42n },
+  IntPtr: { Number: -42, BigInt: -42n },
+  String: { [SHORT_STRING.length]: SHORT_STRING, [LONG_STRING.length]: LONG_STRING },
+  AnsiString: { [SHORT_STRING.length]: SHORT_STRING, [LONG_STRING.length]: LONG_STRING },
+  WideString: { [SHORT_STRING.length]: SHORT_STRING, [LONG_STRING.length]: LONG_STRING },
+  Object: { '': {} },
+  Function: { '': () => {} },
+  Handle: { '': 0x20000n },
+  Span: {
+    Uint8Array: new Uint8Array(64),
+    ArrayBuffer: new ArrayBuffer(64),
+    DataView: new DataView(new ArrayBuffer(64)),
+  },
+};
+
+/** @type {{ name: string, nsPerOp: number, allocationsPerOp: number }[]} */
+const results = [];
+
+for (const name of bench.cases()) {
+  const property = name.endsWith(' (property)');
+  const reader = /^Read(?:Required|Optional)(\w+)/.exec(name)?.[1];
+  const values = reader ? VALUES[reader] : { '': undefined };
+
+  if (!values) {
+    throw new Error(`No value to benchmark ${name} with`);
+  }
+
+  for (const [variant, value] of Object.entries(values)) {
+    const label = variant ? `${name} [${variant}]` : name;
+
+    if (!filter.test(label)) {
+      continue;
+    }
+
+    const argument = property ? { value } : value;
+
+    bench.run(name, Math.ceil(iterations / 10), argument);
+
+    const result = bench.run(name, iterations, argument);
+
+    if (!result) {
+      throw new Error(`${label} did not complete`);
+    }
+
+    console.error(`${label}: ${result.nsPerOp.toFixed(1)} ns/op, ${result.allocationsPerOp} allocations/op`);
+
+    results.push({ name: label, nsPerOp: round(result.nsPerOp), allocationsPerOp: result.allocationsPerOp });
+  }
+}
+
+const json = JSON.stringify(
+  { platform: process.platform, arch: process.arch, node: process.version, iterations, results },
+  null,
+  2,
+);
+
+if (output) {
+  writeFileSync(output, `${json}\n`);
+} else {
+  console.log(json);
+}
+
+/**
+ * @typedef {Object} Result
+ * @property {number} nsPerOp
+ * @property {number} allocationsPerOp
+ */
+
+/**
+ * @param {string} name
+ *
+ * @returns {string | undefined}
+ */
+function option(name) {
+  return options.find((arg) => arg.startsWith(`--${name}=`))?.slice(name.length + 3);
+}
+
+/**
+ * @param {string} path Relative to this file.
+ * @param {number} [flags] Defaults to RTLD_LAZY, as for require().
+ *
+ * @returns {any}
+ */
+function load(path, flags = constants.dlopen.RTLD_LAZY) {
+  const module = { exports: {} };
+
+  process.dlopen(module, fileURLToPath(new URL(path, import.meta.url)), flags);
+
+  return module.exports;
+}
+
+/**
+ * @param {number} value
+ *
+ * @returns {number}
+ */
+function round(value) {
+  return Math.round(value * 10) / 10;
+}
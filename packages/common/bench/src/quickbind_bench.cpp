@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <string>
+
+#include <napi.h>
+#include <windows.h>
+
+#include "../../include/quickbind.hpp"
+
+/**
+ * Native benchmarks for quickbind. Every case is one read or conversion, run in a loop inside a single call so the
+ * numbers are the cost of quickbind itself and not of getting into the addon. Each iteration gets its own
+ * Napi::HandleScope and qb::CallArena::Scope, the way every binding call through a QB_EXPORT table does; the
+ * "(scopes)" case measures those alone.
+ *
+ *   run(name, iterations, value) -> { nsPerOp, allocationsPerOp }
+ *
+ * Argument readers read `value`, and property readers read `value.value`. Allocations are the operator new calls made
+ * from this addon, arena growth included; what V8 allocates on its own heap is not part of them. Driven by ../run.js.
+ */
+
+namespace {
+  size_t allocations = 0;
+
+  constexpr uint16_t VALUE = 2;
+
+  // Keeps the compiler from dropping a read whose result is never used.
+  template <typename T> void Consume(const T &value) {
+#if defined(_MSC_VER)
+    static const void *volatile sink;
+    sink = &value;
+#else
+    asm volatile("" : : "g"(&value) : "memory");
+#endif
+  }
+
+  struct Case {
+    const char *name;
+    void (*run)(const Napi::CallbackInfo &info);
+  };
+
+  const std::wstring SHORT_TEXT(32, L'x');
+  const std::wstring LONG_TEXT(8192, L'x');
+} // namespace
+
+// Counts every allocation made from this addon. binding.gyp links it with -Bsymbolic-functions, so its own calls bind
+// to these instead of to the operator new Node already resolved, and nothing outside of it is affected.
+void *operator new(const size_t size) {
+  allocations++;
+
+  if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+
+  std::abort();
+}
+
+void *operator new[](const size_t size) { return ::operator new(size); }
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete[](void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { std::free(pointer); }
+
+// Required and optional, from an argument and from a property, for one reader.
+#define QB_BENCH_READER(reader)                                                                                        \
+  Case{"ReadRequired" #reader,                                                                                         \
+       [](const Napi::CallbackInfo &info) { Consume(qb::ReadRequired##reader(info, VALUE)); }},                        \
+      Case{"ReadOptional" #reader,                                                                                     \
+           [](const Napi::CallbackInfo &info) { Consume(qb::ReadOptional##reader(info, VALUE)); }},                    \
+      Case{"ReadRequired" #reader " (property)",                                                                       \
+           [](const Napi::CallbackInfo &info) {                                                                        \
+             Consume(qb::ReadRequired##reader(info[VALUE].As<Napi::Object>(), "value"));                               \
+           }},                                                                                                         \
+      Case{"ReadOptional" #reader " (property)", [](const Napi::CallbackInfo &info) {                                  \
+             Consume(qb::ReadOptional##reader(info[VALUE].As<Napi::Object>(), "value"));                              \
+           }}
+
+const Case CASES[] = {
+    {"(scopes)", [](const Napi::CallbackInfo &) {}},
+
+    QB_BENCH_READER(Boolean),
+    QB_BENCH_READER(Uint8),
+    QB_BENCH_READER(Uint8<qb::Narrowing::Checked>),
+    QB_BENCH_READER(Uint8<qb::Narrowing::Saturate>),
+    QB_BENCH_READER(Int8),
+    QB_BENCH_READER(Uint16),
+    QB_BENCH_READER(Uint16<qb::Narrowing::Checked>),
+    QB_BENCH_READER(Uint16<qb::Narrowing::Saturate>),
+    QB_BENCH_READER(Int16),
+    QB_BENCH_READER(Uint32),
+    QB_BENCH_READER(Int32),
+    QB_BENCH_READER(Uint64),
+    QB_BENCH_READER(Int64),
+    QB_BENCH_READER(UintPtr),
+    QB_BENCH_READER(IntPtr),
+    QB_BENCH_READER(String),
+    QB_BENCH_READER(AnsiString),
+    QB_BENCH_READER(WideString),
+    QB_BENCH_READER(Object),
+    QB_BENCH_READER(Function),
+    QB_BENCH_READER(Handle<HWND>),
+    QB_BENCH_READER(Span<uint8_t>),
+    QB_BENCH_READER(Span<const uint32_t>),
+
+    {"HandleToBigInt",
+     [](const Napi::CallbackInfo &info) {
+       Consume(qb::HandleToBigInt(info, reinterpret_cast<HWND>(static_cast<uintptr_t>(0x20000))));
+     }},
+    {"ToNumberOrBigInt (Number)",
+     [](const Napi::CallbackInfo &info) { Consume(qb::ToNumberOrBigInt(info.Env(), static_cast<intptr_t>(-42))); }},
+    {"ToNumberOrBigInt (BigInt)",
+     [](const Napi::CallbackInfo &info) { Consume(qb::ToNumberOrBigInt(info.Env(), UINTPTR_MAX)); }},
+    {"WideToString (32)",
+     [](const Napi::CallbackInfo &info) {
+       Consume(qb::WideToString(info.Env(), SHORT_TEXT.c_str(), SHORT_TEXT.size()));
+     }},
+    {"WideToString (8192)",
+     [](const Napi::CallbackInfo &info) {
+       Consume(qb::WideToString(info.Env(), LONG_TEXT.c_str(), LONG_TEXT.size()));
+     }},
+    {"TextBuffer::ToString (32)",
+     [](const Napi::CallbackInfo &info) {
+       qb::TextBuffer &buffer = qb::TextBuffer::Current();
+       std::copy(SHORT_TEXT.begin(), SHORT_TEXT.end(), buffer.Reserve(256));
+       Consume(buffer.ToString(info.Env(), SHORT_TEXT.size()));
+     }},
+    {"TextBuffer::ToString (8192)",
+     [](const Napi::CallbackInfo &info) {
+       qb::TextBuffer &buffer = qb::TextBuffer::Current();
+       std::copy(LONG_TEXT.begin(), LONG_TEXT.end(), buffer.Reserve(LONG_TEXT.size()));
+       Consume(buffer.ToString(info.Env(), LONG_TEXT.size()));
+     }},
+};
+
+#undef QB_BENCH_READER
+
+static Napi::Value Cases(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  Napi::Array names = Napi::Array::New(env, std::size(CASES));
+
+  for (size_t i = 0; i < std::size(CASES); i++) {
+    names.Set(static_cast<uint32_t>(i), Napi::String::New(env, CASES[i].name));
+  }
+
+  return names;
+}
+
+static Napi::Value Run(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+  const qb::CallArena::Scope outer;
+
+  const auto [name, iterations] = QB_ARGS(qb::ReadRequiredString(info, 0), qb::ReadRequiredUint32(info, 1));
+
+  const Case *selected = nullptr;
+
+  for (const Case &entry : CASES) {
+    if (name == entry.name) {
+      selected = &entry;
+    }
+  }
+
+  if (selected == nullptr) {
+    Napi::TypeError::New(env, "Unknown benchmark " + std::string(name)).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const size_t allocationsBefore = allocations;
+  const auto start = std::chrono::steady_clock::now();
+
+  for (uint32_t i = 0; i < iterations; i++) {
+    const Napi::HandleScope scope(env);
+    const qb::CallArena::Scope arena;
+
+    selected->run(info);
+
+    // A reader that fails leaves an exception pending; stop instead of timing the error path.
+    if (qb::detail::ArgumentsFailed(env)) {
+      return env.Undefined();
+    }
+  }
+
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const size_t allocated = allocations - allocationsBefore;
+
+  const double count = iterations > 0 ? static_cast<double>(iterations) : 1.0;
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("nsPerOp", Napi::Number::New(env, std::chrono::duration<double, std::nano>(elapsed).count() / count));
+  result.Set("allocationsPerOp", Napi::Number::New(env, static_cast<double>(allocated) / count));
+
+  return result;
+}
+
+static Napi::Object Initialize(const Napi::Env env, Napi::Object exports) {
+  exports.Set("cases", Napi::Function::New(env, Cases, "cases"));
+  exports.Set("run", Napi::Function::New(env, Run, "run"));
+
+  return exports;
+}
+
+NODE_API_MODULE(quickbind_bench, Initialize)
@@ -0,0 +1,223 @@
+//@ts-check
+import { execFileSync } from 'node:child_process';
+import { existsSync, writeFileSync } from 'node:fs';
+import { constants } from 'node:os';
+import { isAbsolute } from 'node:path';
+import { fileURLToPath } from 'node:url';
+
+// Measures how long loading each package's addon takes and how much heap it retains, once for the bare addon and once
+// with every export read, which is what the named exports of a package's lib/index.ts do on import. Every sample runs
+// in a fresh process, so nothing is cached between them, and the median of all samples is reported as JSON.
+//
+// It then measures the cold start of an app that imports every package, once with each package loading its own addon
+// and once with all of them taken from the combined addon of @libwin/native, as LIBWIN_NATIVE=1 does. Both read every
+// export, like the packages' named exports do.
+//
+// Usage: node packages/common/bench/startup.js [--samples=15] [--output=file]
+//
+// Build the addons first with `npm run build`. Off Windows the win32-stub backend is loaded before the addon and is not
+// part of the measurement; build it with `npm run build:stub`. The combined addon is built in packages/native.
+const PACKAGES = ['comctl32', 'gdi32', 'kernel32', 'user32'];
+const MODES = ['addon', 'exports'];
+const APP_MODES = ['separate', 'native'];
+
+const options = process.argv.slice(2);
+
+const child = option('child');
+
+if (child) {
+  measure(...child.split(':'));
+} else {
+  const samples = Math.max(1, Number.parseInt(option('samples') ?? '15', 10) || 1);
+  const output = option('output');
+
+  /** @type {{ name: string, exports: number, requireMs: number, heapKb: number }[]} */
+  const results = [];
+
+  for (const name of PACKAGES) {
+    if (!existsSync(addonPath(name))) {
+      console.error(`${name}: not built, skipped`);
+      continue;
+    }
+
+    for (const mode of MODES) {
+      results.push(sample(name, mode, samples));
+    }
+  }
+
+  if (PACKAGES.some((name) => !existsSync(addonPath(name))) || !existsSync(nativeAddonPath())) {
+    console.error('app: every package and packages/native have to be built, skipped');
+  } else {
+    for (const mode of APP_MODES) {
+      results.push(sample('app', mode, samples));
+    }
+  }
+
+  const json = JSON.stringify(
+    { platform: process.platform, arch: process.arch, node: process.version, samples, results },
+    null,
+    2,
+  );
+
+  if (output) {
+    writeFileSync(output, `${json}\n`);
+  } else {
+    console.log(json);
+  }
+}
+
+/**
+ * Runs `samples` child processes measuring `name` in `mode` and returns their medians.
+ *
+ * @param {string} name A package, or `app` for all of them.
+ * @param {string} mode
+ * @param {number} samples
+ *
+ * @returns {{ name: string, exports: number, requireMs: number, heapKb: number }}
+ */
+function sample(name, mode, samples) {
+  /** @type {Sample[]} */
+  const runs = [];
+
+  for (let i = 0; i < samples; i++) {
+    const stdout = execFileSync(
+      process.execPath,
+      ['--expose-gc', fileURLToPath(import.meta.url), `--child=${name}:${mode}`],
+      { encoding: 'utf8' },
+    );
+
+    runs.push(JSON.parse(stdout));
+  }
+
+  const label = `${name} (${mode})`;
+  const requireMs = round(median(runs.map((run) => run.requireNs)) / 1e6);
+  const heapKb = round(median(runs.map((run) => run.heapBytes)) / 1024);
+
+  console.error(`${label}: ${requireMs} ms, ${heapKb} KiB retained, ${runs[0].exports} exports`);
+
+  return { name: label, exports: runs[0].exports, requireMs, heapKb };
+}
+
+/**
+ * @typedef {Object} Sample
+ * @property {number} exports
+ * @property {number} requireNs
+ * @property {number} heapBytes
+ */
+
+/**
+ * Runs in the child process: loads one addon, or every package's for `app`, optionally reads every export, and prints
+ * a Sample.
+ *
+ * @param {string} name
+ * @param {string} mode
+ */
+function measure(name, mode) {
+  const gc = /** @type {() => void} */ (globalThis.gc);
+
+  if (process.platform !== 'win32') {
+    load('../win32-stub/build/Release/win32_stub.node', constants.dlopen.RTLD_NOW | constants.dlopen.RTLD_GLOBAL);
+  }
+
+  gc();
+
+  const heapBefore = process.memoryUsage().heapUsed;
+  const start = process.hrtime.bigint();
+
+  /** @type {any[]} */
+  let addons;
+
+  if (name !== 'app') {
+    addons = [load(addonPath(name))];
+  } else if (mode === 'native') {
+    const native = load(nativeAddonPath());
+
+    addons = PACKAGES.map((pkg) => native[pkg]);
+  } else {
+    addons = PACKAGES.map((pkg) => load(addonPath(pkg)));
+  }
+
+  let exports = 0;
+
+  for (const addon of addons) {
+    const names = Object.keys(addon);
+
+    if (mode !== 'addon') {
+      for (const key of names) {
+        void addon[key];
+      }
+    }
+
+    exports += names.length;
+  }
+
+  const requireNs = Number(process.hrtime.bigint() - start);
+
+  gc();
+
+  const heapBytes = process.memoryUsage().heapUsed - heapBefore;
+
+  /** @type {Sample} */
+  const sample = { exports, requireNs, heapBytes };
+
+  process.stdout.write(JSON.stringify(sample));
+}
+
+/**
+ * @param {string} name
+ *
+ * @returns {string}
+ */
+function addonPath(name) {
+  return fileURLToPath(new URL(`../../${name}/build/Release/${name}.node`, import.meta.url));
+}
+
+/**
+ * @returns {string}
+ */
+function nativeAddonPath() {
+  return fileURLToPath(new URL('../../native/build/Release/libwin.node', import.meta.url));
+}
+
+/**
+ * @param {string} name
+ *
+ * @returns {string | undefined}
+ */
+function option(name) {
+  return options.find((arg) => arg.startsWith(`--${name}=`))?.slice(name.length + 3);
+}
+
+/**
+ * @param {string} path Absolute, or relative to this file.
+ * @param {number} [flags] Defaults to RTLD_LAZY, as for require().
+ *
+ * @returns {any}
+ */
+function load(path, flags = constants.dlopen.RTLD_LAZY) {
+  const module = { exports: {} };
+
+  process.dlopen(module, isAbsolute(path) ? path : fileURLToPath(new URL(path, import.meta.url)), flags);
+
+  return module.exports;
+}
+
+/**
+ * @param {number[]} values
+ *
+ * @returns {number}
+ */
+function median(values) {
+  const sorted = values.toSorted((a, b) => a - b);
+
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+/**
+ * @param {number} value
+ *
+ * @returns {number}
+ */
+function round(value) {
+  return Math.round(value * 100) / 100;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+// Headers shared by every translation unit of every package. When configured with `-Dpch=true` this is precompiled
+// once per target (MSVC only) and force-included into every source, so nothing needs to include it directly.
+#include <napi.h>
+#include <windows.h>
+
+#include "callback_handler.hpp"
+#include "quickbind.hpp"
+#include "quickbind_handle.hpp"
+#include "quickbind_instance.hpp"
+#include "quickbind_struct.hpp"
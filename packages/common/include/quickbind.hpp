@@ -4,10 +4,9 @@
  * A header-only C++20 utility library for simplifying argument parsing and validation in Node.js native addons using
  * the Node-API (N-API) and the Napi C++ wrapper.
  *
- * Note: Might be worth looking into size checks for the integer types, particularly when going from (U)Int32 to
- * (U)Int16 or (U)Int8. Currently I just silently truncate the value, which aligns with how the Win32 API would handle
- * it, but extra validation and better errors to the developer might be useful. We'll see how I feel in a few months
- * when I inevitably have to debug some weird bug caused by this.
+ * Note: The (U)Int16 and (U)Int8 readers truncate by default, which aligns with how the Win32 API would handle a
+ * wider value. Bindings can ask for range checks or saturation per call with qb::Narrowing, and Debug builds check
+ * every narrowing read (see QB_CHECKED_NARROWING).
  *
  * Another note: Maybe it would be worth adding lower overhead functions that don't do any type checking or validation,
  * for functions that are called many times per second; e.x. GetMessageW, TranslateMessage, DispatchMessageW, etc.
@@ -20,22 +19,62 @@
 
 #pragma once
 
+#include <algorithm>
 #include <charconv>
+#include <cmath>
 #include <concepts>
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <napi.h>
 #include <windows.h>
 
+#include "quickbind_arena.hpp"
+#include "quickbind_handle.hpp"
+
+#ifdef QB_ENABLE_STATS
+#include "quickbind_stats.hpp"
+
+#define QB_STATS_MARK() qb::stats::Mark();
+#define QB_STATS_WRAP(function) qb::stats::Instrumented<function>
+#define QB_STATS_SLOT(function) , &qb::stats::slot<function>
+#else
+#define QB_STATS_MARK()
+#define QB_STATS_WRAP(function) function
+#define QB_STATS_SLOT(function)
+#endif
+
 #define QB_ARG(variable, expression)                                                                                   \
   auto variable = expression;                                                                                          \
-  if (info.Env().IsExceptionPending()) {                                                                               \
+  if (qb::detail::ArgumentsFailed(info.Env())) {                                                                       \
     return info.Env().Undefined();                                                                                     \
-  }
+  }                                                                                                                    \
+  QB_STATS_MARK()
+
+/**
+ * Reads several arguments in order and checks for a pending exception once, rather than once per argument like
+ * QB_ARG. Readers after a failed one return an empty value without touching their argument, not even fetching it
+ * when it is a property, so the error thrown is still the one for the first bad argument. Meant to be destructured:
+ *
+ *   const auto [hWnd, nCmdShow] = QB_ARGS(qb::ReadRequiredHandle<HWND>(info, 0), qb::ReadRequiredInt32(info, 1));
+ *
+ * Property reads need the object they are read from, so read the object itself with QB_ARG first.
+ */
+#define QB_ARGS(...)                                                                                                   \
+  std::tuple{__VA_ARGS__};                                                                                             \
+  if (qb::detail::ArgumentsFailed(info.Env())) {                                                                       \
+    return info.Env().Undefined();                                                                                     \
+  }                                                                                                                    \
+  QB_STATS_MARK()
 
 #define QB_SET(obj, optional, expression)                                                                              \
   do {                                                                                                                 \
@@ -45,17 +84,18 @@
   } while (0);
 
 #define QB_EXPORT(function)                                                                                            \
-  do {                                                                                                                 \
-    constexpr std::string_view name = qb::detail::UnqualifiedName(#function);                                          \
-    exports.Set(Napi::String::New(env, name.data(), name.size()),                                                      \
-                Napi::Function::New(env, function, std::string(name)));                                                \
-  } while (0);
+  qb::Export {                                                                                                         \
+    qb::detail::UnqualifiedName(#function), &qb::detail::Trampoline<QB_STATS_WRAP(function)> QB_STATS_SLOT(function)   \
+  }
 
 #define QB_CHECK_NULLISH(value, required, prefix, location)                                                            \
   do {                                                                                                                 \
+    if (qb::detail::readFailed) {                                                                                      \
+      return std::nullopt;                                                                                             \
+    }                                                                                                                  \
     if (value.IsNull() || value.IsUndefined()) {                                                                       \
       if (required) {                                                                                                  \
-        qb::detail::ThrowTypeError(value.Env(), prefix, location);                                                     \
+        qb::detail::Fail(value.Env(), prefix, location);                                                               \
       }                                                                                                                \
       return std::nullopt;                                                                                             \
     }                                                                                                                  \
@@ -68,6 +108,12 @@ namespace qb {
   template <typename T, typename... U>
   concept IsAnyOf = (std::is_same_v<T, U> || ...);
 
+  /**
+   * Handle types from headers quickbind doesn't include itself. The addon that includes the header opts its types in
+   * right after it, with `template <> inline constexpr bool IsExtraHandle<HIORING> = true;` inside namespace qb.
+   */
+  template <typename T> inline constexpr bool IsExtraHandle = false;
+
   template <typename T>
   concept WinHandle = qb::IsAnyOf<T,
                                   HWND,
@@ -98,7 +144,31 @@ namespace qb {
                                   HMETAFILE,
                                   HENHMETAFILE,
                                   HKEY,
-                                  HGDIOBJ>;
+                                  HGDIOBJ> ||
+                       qb::IsExtraHandle<T>;
+
+  /**
+   * Element types a JS buffer can be viewed as. Use a const element type for buffers that are only read.
+   */
+  template <typename T>
+  concept SpanElement = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>;
+
+  /**
+   * How the 16 and 8-bit readers narrow the Number they read, picked per call with e.g.
+   * `qb::ReadRequiredUint16<qb::Narrowing::Checked>(info, 4)` and qb::DEFAULT_NARROWING otherwise.
+   *
+   * - Truncate keeps the low bits, like the cast to WORD or BYTE the Win32 API would do. It is the exact conversion the
+   *   readers have always made, so it costs nothing over a plain static_cast.
+   * - Checked throws a TypeError naming the accepted range for anything outside of it, NaN included.
+   * - Saturate clamps to the nearest value in range, with NaN read as 0.
+   */
+  enum class Narrowing { Truncate, Checked, Saturate };
+
+#ifdef QB_CHECKED_NARROWING
+  inline constexpr qb::Narrowing DEFAULT_NARROWING = qb::Narrowing::Checked;
+#else
+  inline constexpr qb::Narrowing DEFAULT_NARROWING = qb::Narrowing::Truncate;
+#endif
 
   namespace detail {
     consteval std::string_view UnqualifiedName(const std::string_view name) {
@@ -108,10 +178,19 @@ namespace qb {
 
     inline constexpr std::string_view EXPECTED_BIGINT = "Expected a BigInt ";
     inline constexpr std::string_view EXPECTED_NUMBER = "Expected a Number ";
+    inline constexpr std::string_view EXPECTED_NUMBER_BETWEEN = "Expected a Number between ";
+    inline constexpr std::string_view EXPECTED_INTEGER = "Expected a BigInt or a safe integer Number ";
+    inline constexpr std::string_view EXPECTED_BOOLEAN = "Expected a Boolean ";
     inline constexpr std::string_view EXPECTED_STRING = "Expected a String ";
     inline constexpr std::string_view EXPECTED_OBJECT = "Expected an Object ";
     inline constexpr std::string_view EXPECTED_FUNCTION = "Expected a Function ";
+    inline constexpr std::string_view EXPECTED_ARRAY = "Expected an Array ";
+    inline constexpr std::string_view EXPECTED_BIGUINT64_ARRAY = "Expected a BigUint64Array ";
+    inline constexpr std::string_view EXPECTED_BUFFER = "Expected an ArrayBuffer, TypedArray or DataView ";
+    inline constexpr std::string_view BUFFER_MISALIGNED = "Buffer is not aligned to its element type ";
+    inline constexpr std::string_view BUFFER_PARTIAL_ELEMENT = "Buffer length is not a multiple of its element size ";
     inline constexpr std::string_view BIGINT_TOO_LARGE = "BigInt is too large to fit in ";
+    inline constexpr std::string_view OWNED_HANDLE_MISMATCH = " is the wrong handle type ";
     inline constexpr std::string_view AT_INDEX = "at index ";
     inline constexpr std::string_view FOR_PROPERTY = "for property ";
 
@@ -132,13 +211,46 @@ namespace qb {
       Napi::TypeError::New(env, std::string(prefix) + location.in + location.where).ThrowAsJavaScriptException();
     }
 
+    // For a value of the right type that is out of bounds for the call, such as a buffer too small for its count.
+    inline void ThrowRangeError(Napi::Env env, std::string_view prefix, const qb::detail::Location &location) {
+      Napi::RangeError::New(env, std::string(prefix) + location.in + location.where).ThrowAsJavaScriptException();
+    }
+
+    /**
+     * Set by the readers when they throw, so the readers that follow in the same QB_ARGS can bail out without calling
+     * into Node-API, and cleared again by ArgumentsFailed and around every call by Trampoline. Bindings always run on
+     * the thread of their environment, so one flag per thread is enough.
+     */
+    inline thread_local bool readFailed = false;
+
+    inline void Fail(Napi::Env env, std::string_view prefix, const qb::detail::Location &location) {
+      qb::detail::readFailed = true;
+      qb::detail::ThrowTypeError(env, prefix, location);
+    }
+
+    /**
+     * The single check QB_ARG and QB_ARGS make after reading. A failed reader is caught by the flag alone; the
+     * pending exception check still runs otherwise, since a property getter can throw without going through a reader.
+     */
+    [[nodiscard]] inline bool ArgumentsFailed(const Napi::Env env) {
+      return std::exchange(qb::detail::readFailed, false) || env.IsExceptionPending();
+    }
+
+    /**
+     * Fetches a property for a reader, unless an earlier reader in the same QB_ARGS failed. The read would be thrown
+     * away anyway, and skipping it keeps a getter on the object from running after the call has already failed.
+     */
+    [[nodiscard]] inline Napi::Value GetProperty(const Napi::Object &object, const std::string &key) {
+      return qb::detail::readFailed ? object.Env().Undefined() : object.Get(key);
+    }
+
     [[nodiscard]] std::optional<uint64_t> inline ReadUint64(const Napi::Value &value,
                                                             const qb::detail::Location &location,
                                                             const bool required) {
       QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_BIGINT, location);
 
       if (!value.IsBigInt()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_BIGINT, location);
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_BIGINT, location);
         return std::nullopt;
       }
 
@@ -147,7 +259,7 @@ namespace qb {
       const uint64_t uint64Value = value.As<Napi::BigInt>().Uint64Value(&lossless);
 
       if (!lossless) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::BIGINT_TOO_LARGE, location);
+        qb::detail::Fail(value.Env(), qb::detail::BIGINT_TOO_LARGE, location);
         return std::nullopt;
       }
 
@@ -160,7 +272,7 @@ namespace qb {
       QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_NUMBER, location);
 
       if (!value.IsNumber()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_NUMBER, location);
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_NUMBER, location);
         return std::nullopt;
       }
 
@@ -169,43 +281,13 @@ namespace qb {
       return uint32Value;
     };
 
-    [[nodiscard]] std::optional<uint16_t> inline ReadUint16(const Napi::Value &value,
-                                                            const qb::detail::Location &location,
-                                                            const bool required) {
-      QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_NUMBER, location);
-
-      if (!value.IsNumber()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_NUMBER, location);
-        return std::nullopt;
-      }
-
-      const uint16_t uint16Value = static_cast<uint16_t>(value.As<Napi::Number>().Uint32Value());
-
-      return uint16Value;
-    };
-
-    [[nodiscard]] std::optional<uint8_t> inline ReadUint8(const Napi::Value &value,
-                                                          const qb::detail::Location &location,
-                                                          const bool required) {
-      QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_NUMBER, location);
-
-      if (!value.IsNumber()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_NUMBER, location);
-        return std::nullopt;
-      }
-
-      const uint8_t uint8Value = static_cast<uint8_t>(value.As<Napi::Number>().Uint32Value());
-
-      return uint8Value;
-    };
-
     [[nodiscard]] std::optional<int64_t> inline ReadInt64(const Napi::Value &value,
                                                           const qb::detail::Location &location,
                                                           const bool required) {
       QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_BIGINT, location);
 
       if (!value.IsBigInt()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_BIGINT, location);
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_BIGINT, location);
         return std::nullopt;
       }
 
@@ -213,20 +295,62 @@ namespace qb {
       const int64_t int64Value = value.As<Napi::BigInt>().Int64Value(&lossless);
 
       if (!lossless) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::BIGINT_TOO_LARGE, location);
+        qb::detail::Fail(value.Env(), qb::detail::BIGINT_TOO_LARGE, location);
         return std::nullopt;
       }
 
       return int64Value;
     };
 
+    // Number.MAX_SAFE_INTEGER; every integer up to it converts between double and 64 bits exactly.
+    inline constexpr double MAX_SAFE_INTEGER = 9007199254740991.0;
+
+    /**
+     * Reads a pointer-sized integer (WPARAM, LPARAM, LRESULT, ...) from a BigInt or a Number, so callers don't have to
+     * allocate a BigInt for the small values most messages carry. Numbers have to be integers within
+     * Number.MAX_SAFE_INTEGER, where they convert exactly; anything larger has to be passed as a BigInt.
+     */
+    template <typename T>
+      requires qb::IsAnyOf<T, uintptr_t, intptr_t>
+    [[nodiscard]] std::optional<T> inline ReadPointerSized(const Napi::Value &value,
+                                                           const qb::detail::Location &location,
+                                                           const bool required) {
+      QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_INTEGER, location);
+
+      if (value.IsNumber()) {
+        constexpr double min = std::is_signed_v<T> ? -qb::detail::MAX_SAFE_INTEGER : 0.0;
+
+        const double number = value.As<Napi::Number>().DoubleValue();
+
+        if (!((number >= min) & (number <= qb::detail::MAX_SAFE_INTEGER)) || std::trunc(number) != number) {
+          qb::detail::Fail(value.Env(), qb::detail::EXPECTED_INTEGER, location);
+          return std::nullopt;
+        }
+
+        return static_cast<T>(number);
+      }
+
+      if (!value.IsBigInt()) {
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_INTEGER, location);
+        return std::nullopt;
+      }
+
+      if constexpr (std::is_signed_v<T>) {
+        const std::optional<int64_t> int64Value = qb::detail::ReadInt64(value, location, required);
+        return int64Value.has_value() ? std::optional<T>(static_cast<T>(int64Value.value())) : std::nullopt;
+      } else {
+        const std::optional<uint64_t> uint64Value = qb::detail::ReadUint64(value, location, required);
+        return uint64Value.has_value() ? std::optional<T>(static_cast<T>(uint64Value.value())) : std::nullopt;
+      }
+    };
+
     [[nodiscard]] std::optional<int32_t> inline ReadInt32(const Napi::Value &value,
                                                           const qb::detail::Location &location,
                                                           const bool required) {
       QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_NUMBER, location);
 
       if (!value.IsNumber()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_NUMBER, location);
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_NUMBER, location);
         return std::nullopt;
       }
 
@@ -235,74 +359,193 @@ namespace qb {
       return int32Value;
     };
 
-    [[nodiscard]] std::optional<int16_t> inline ReadInt16(const Napi::Value &value,
-                                                          const qb::detail::Location &location,
-                                                          const bool required) {
+    /**
+     * Reads a Number into an integer narrower than 32 bits according to `Policy`. Truncate goes through the same
+     * Int32Value/Uint32Value conversion as the 32-bit readers; Checked and Saturate look at the full double instead, so
+     * 2^32 + 1 isn't mistaken for 1.
+     */
+    template <std::integral T, qb::Narrowing Policy>
+    [[nodiscard]] std::optional<T> inline ReadNarrowInteger(const Napi::Value &value,
+                                                            const qb::detail::Location &location,
+                                                            const bool required) {
       QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_NUMBER, location);
 
       if (!value.IsNumber()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_NUMBER, location);
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_NUMBER, location);
         return std::nullopt;
       }
 
-      const int16_t int16Value = static_cast<int16_t>(value.As<Napi::Number>().Int32Value());
-
-      return int16Value;
+      if constexpr (Policy == qb::Narrowing::Truncate) {
+        if constexpr (std::is_signed_v<T>) {
+          return static_cast<T>(value.As<Napi::Number>().Int32Value());
+        } else {
+          return static_cast<T>(value.As<Napi::Number>().Uint32Value());
+        }
+      } else {
+        constexpr double min = std::numeric_limits<T>::min();
+        constexpr double max = std::numeric_limits<T>::max();
+
+        const double number = value.As<Napi::Number>().DoubleValue();
+
+        if constexpr (Policy == qb::Narrowing::Saturate) {
+          return std::isnan(number) ? T{0} : static_cast<T>(std::clamp(number, min, max));
+        } else {
+          // `&` rather than `&&` so both comparisons are evaluated without a branch between them; NaN fails both.
+          if (!((number >= min) & (number <= max))) {
+            const std::string prefix = std::string(qb::detail::EXPECTED_NUMBER_BETWEEN) +
+                                       std::to_string(std::numeric_limits<T>::min()) + " and " +
+                                       std::to_string(std::numeric_limits<T>::max()) + " ";
+
+            qb::detail::Fail(value.Env(), prefix, location);
+            return std::nullopt;
+          }
+
+          return static_cast<T>(number);
+        }
+      }
     };
 
-    [[nodiscard]] std::optional<int8_t> inline ReadInt8(const Napi::Value &value,
-                                                        const qb::detail::Location &location,
-                                                        const bool required) {
-      QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_NUMBER, location);
+    [[nodiscard]] std::optional<bool> inline ReadBoolean(const Napi::Value &value,
+                                                         const qb::detail::Location &location,
+                                                         const bool required) {
+      QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_BOOLEAN, location);
 
-      if (!value.IsNumber()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_NUMBER, location);
+      if (!value.IsBoolean()) {
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_BOOLEAN, location);
         return std::nullopt;
       }
 
-      const int8_t int8Value = static_cast<int8_t>(value.As<Napi::Number>().Int32Value());
+      const bool booleanValue = value.As<Napi::Boolean>().Value();
 
-      return int8Value;
+      return booleanValue;
     };
 
-    [[nodiscard]] std::optional<std::string> inline ReadString(const Napi::Value &value,
-                                                               const qb::detail::Location &location,
-                                                               const bool required) {
+    /**
+     * Strings are copied straight from V8 into storage from the thread's CallArena, rather than into a heap allocated
+     * std::string first, so marshalling them doesn't touch the heap. Strings short enough for the small string
+     * optimization never reach the arena at all.
+     */
+    [[nodiscard]] std::optional<std::pmr::string> inline ReadString(const Napi::Value &value,
+                                                                    const qb::detail::Location &location,
+                                                                    const bool required) {
       QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_STRING, location);
 
       if (!value.IsString()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_STRING, location);
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_STRING, location);
         return std::nullopt;
       }
 
-      const std::string stringValue = value.As<Napi::String>().Utf8Value();
+      size_t length = 0;
+      napi_get_value_string_utf8(value.Env(), value, nullptr, 0, &length);
+
+      std::pmr::string stringValue(length, '\0', &qb::CallArena::Current());
+      napi_get_value_string_utf8(value.Env(), value, stringValue.data(), length + 1, &length);
 
       return stringValue;
     };
 
-    [[nodiscard]] std::optional<std::wstring> inline ReadWideString(const Napi::Value &value,
-                                                                    const qb::detail::Location &location,
-                                                                    const bool required) {
+    [[nodiscard]] std::optional<std::pmr::wstring> inline ReadWideString(const Napi::Value &value,
+                                                                         const qb::detail::Location &location,
+                                                                         const bool required) {
       QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_STRING, location);
 
       if (!value.IsString()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_STRING, location);
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_STRING, location);
         return std::nullopt;
       }
 
-      const std::u16string stringValue = value.As<Napi::String>().Utf16Value();
-      const std::wstring wideStringValue(stringValue.begin(), stringValue.end());
+      size_t length = 0;
+      napi_get_value_string_utf16(value.Env(), value, nullptr, 0, &length);
+
+      std::pmr::wstring wideStringValue(length, L'\0', &qb::CallArena::Current());
+
+      if constexpr (sizeof(wchar_t) == sizeof(char16_t)) {
+        napi_get_value_string_utf16(
+            value.Env(), value, reinterpret_cast<char16_t *>(wideStringValue.data()), length + 1, &length);
+      } else {
+        std::pmr::u16string utf16(length, u'\0', &qb::CallArena::Current());
+        napi_get_value_string_utf16(value.Env(), value, utf16.data(), length + 1, &length);
+        std::copy(utf16.begin(), utf16.end(), wideStringValue.begin());
+      }
 
       return wideStringValue;
     };
 
+    /**
+     * The ANSI code page is fixed for the lifetime of the process, so it's only looked up once.
+     */
+    [[nodiscard]] inline UINT AnsiCodePage() {
+      static const UINT codePage = ::GetACP();
+      return codePage;
+    }
+
+    /**
+     * Reads a string for an "A" API, which interprets its bytes in the ANSI code page rather than as UTF-8. ASCII is
+     * the same in every ANSI code page, as is Latin-1 from U+00A0 onwards in Windows-1252, so strings made up only of
+     * those are narrowed one code unit at a time; anything else goes through a single WideCharToMultiByte(CP_ACP) call.
+     * Characters the code page can't represent come out as its default character, same as the system's own A -> W
+     * thunks would produce. Both the UTF-16 copy and the result live in the thread's CallArena.
+     *
+     * napi_get_value_string_latin1 isn't used for the fast path because it silently truncates code units above U+00FF,
+     * so "Ł" (U+0141) would come out as "A" with no way of telling that it happened.
+     */
+    [[nodiscard]] std::optional<std::pmr::string> inline ReadAnsiString(const Napi::Value &value,
+                                                                        const qb::detail::Location &location,
+                                                                        const bool required) {
+      QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_STRING, location);
+
+      if (!value.IsString()) {
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_STRING, location);
+        return std::nullopt;
+      }
+
+      qb::CallArena &arena = qb::CallArena::Current();
+
+      size_t length = 0;
+      napi_get_value_string_utf16(value.Env(), value, nullptr, 0, &length);
+
+      std::pmr::u16string utf16(length, u'\0', &arena);
+      napi_get_value_string_utf16(value.Env(), value, utf16.data(), length + 1, &length);
+
+      const bool latin1 = qb::detail::AnsiCodePage() == 1252;
+      const bool direct = std::all_of(utf16.begin(), utf16.end(), [latin1](const char16_t unit) {
+        return unit < 0x80 || (latin1 && unit >= 0xA0 && unit <= 0xFF);
+      });
+
+      if (direct) {
+        std::pmr::string ansiValue(length, '\0', &arena);
+        std::transform(utf16.begin(), utf16.end(), ansiValue.begin(), [](const char16_t unit) {
+          return static_cast<char>(unit);
+        });
+
+        return ansiValue;
+      }
+
+      // Where wchar_t is wider than a UTF-16 code unit, i.e. off Windows, the units are widened one by one.
+      std::pmr::wstring widened(&arena);
+
+      if constexpr (sizeof(wchar_t) != sizeof(char16_t)) {
+        widened.assign(utf16.begin(), utf16.end());
+      }
+
+      const LPCWSTR wide =
+          sizeof(wchar_t) == sizeof(char16_t) ? reinterpret_cast<LPCWSTR>(utf16.data()) : widened.c_str();
+      const int wideLength = static_cast<int>(length);
+      const int ansiLength = ::WideCharToMultiByte(CP_ACP, 0, wide, wideLength, nullptr, 0, nullptr, nullptr);
+
+      std::pmr::string ansiValue(ansiLength, '\0', &arena);
+      ::WideCharToMultiByte(CP_ACP, 0, wide, wideLength, ansiValue.data(), ansiLength, nullptr, nullptr);
+
+      return ansiValue;
+    };
+
     [[nodiscard]] std::optional<Napi::Object> inline ReadObject(const Napi::Value &value,
                                                                 const qb::detail::Location &location,
                                                                 const bool required) {
       QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_OBJECT, location);
 
       if (!value.IsObject()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_OBJECT, location);
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_OBJECT, location);
         return std::nullopt;
       }
 
@@ -317,7 +560,7 @@ namespace qb {
       QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_FUNCTION, location);
 
       if (!value.IsFunction()) {
-        qb::detail::ThrowTypeError(value.Env(), qb::detail::EXPECTED_FUNCTION, location);
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_FUNCTION, location);
         return std::nullopt;
       }
 
@@ -330,6 +573,21 @@ namespace qb {
     [[nodiscard]] std::optional<T> inline ReadHandle(const Napi::Value &value,
                                                      const qb::detail::Location &location,
                                                      const bool required) {
+      // An owned handle reads as the handle it owns, which is null once it has been disposed or released. One of
+      // another type is rejected rather than read as its raw value, as that is always a mix-up, e.g. an HMENU for an
+      // HWND.
+      if (const std::optional<qb::OwnedHandle::Unwrapped> owned = qb::OwnedHandle::Unwrap<T>(value)) {
+        if (!owned->matches) {
+          const std::string prefix =
+              "Owned " + std::string(owned->type) + std::string(qb::detail::OWNED_HANDLE_MISMATCH);
+
+          qb::detail::Fail(value.Env(), prefix, location);
+          return std::nullopt;
+        }
+
+        return static_cast<T>(owned->handle);
+      }
+
       const std::optional<uint64_t> handle = qb::detail::ReadUint64(value, location, required);
 
       if (!handle.has_value()) {
@@ -340,6 +598,70 @@ namespace qb {
 
       return handleValue;
     };
+
+    [[nodiscard]] inline constexpr size_t TypedArrayElementSize(const napi_typedarray_type type) {
+      switch (type) {
+      case napi_int16_array:
+      case napi_uint16_array:
+        return 2;
+      case napi_int32_array:
+      case napi_uint32_array:
+      case napi_float32_array:
+        return 4;
+      case napi_float64_array:
+      case napi_bigint64_array:
+      case napi_biguint64_array:
+        return 8;
+      default:
+        return 1;
+      }
+    }
+
+    /**
+     * Views the memory behind an ArrayBuffer, any TypedArray (including Buffer) or a DataView as a span of T, without
+     * copying. Writes through the span land directly in the JS buffer, which is how out-parameters are returned. The
+     * span is only valid for the duration of the binding call, since nothing keeps the buffer alive or attached after
+     * that.
+     */
+    template <SpanElement T>
+    [[nodiscard]] std::optional<std::span<T>> inline ReadSpan(const Napi::Value &value,
+                                                               const qb::detail::Location &location,
+                                                               const bool required) {
+      QB_CHECK_NULLISH(value, required, qb::detail::EXPECTED_BUFFER, location);
+
+      void *data = nullptr;
+      size_t byteLength = 0;
+
+      // The raw Node-API calls are used so no intermediate ArrayBuffer handle is created for views; the data pointers
+      // they return already include the view's byte offset.
+      if (value.IsTypedArray()) {
+        napi_typedarray_type type;
+        size_t length = 0;
+
+        napi_get_typedarray_info(value.Env(), value, &type, &length, &data, nullptr, nullptr);
+
+        byteLength = length * qb::detail::TypedArrayElementSize(type);
+      } else if (value.IsDataView()) {
+        napi_get_dataview_info(value.Env(), value, &byteLength, &data, nullptr, nullptr);
+      } else if (value.IsArrayBuffer()) {
+        napi_get_arraybuffer_info(value.Env(), value, &data, &byteLength);
+      } else {
+        qb::detail::Fail(value.Env(), qb::detail::EXPECTED_BUFFER, location);
+        return std::nullopt;
+      }
+
+      if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0) {
+        qb::detail::Fail(value.Env(), qb::detail::BUFFER_MISALIGNED, location);
+        return std::nullopt;
+      }
+
+      if (byteLength % sizeof(T) != 0) {
+        qb::detail::Fail(value.Env(), qb::detail::BUFFER_PARTIAL_ELEMENT, location);
+        return std::nullopt;
+      }
+
+      return std::span<T>(static_cast<T *>(data), byteLength / sizeof(T));
+    };
   } // namespace detail
 
   /**** Unsigned 64-bit integers *************************************************************************************/
@@ -349,7 +671,7 @@ namespace qb {
   };
 
   [[nodiscard]] inline uint64_t ReadRequiredUint64(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadUint64(object.Get(key), qb::detail::Property(key), true).value_or(0);
+    return qb::detail::ReadUint64(qb::detail::GetProperty(object, key), qb::detail::Property(key), true).value_or(0);
   };
 
   [[nodiscard]] inline std::optional<uint64_t> ReadOptionalUint64(const Napi::CallbackInfo &info,
@@ -358,7 +680,7 @@ namespace qb {
   };
 
   [[nodiscard]] inline std::optional<uint64_t> ReadOptionalUint64(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadUint64(object.Get(key), qb::detail::Property(key), false);
+    return qb::detail::ReadUint64(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
   };
 
   /**** Unsigned 32-bit integers *************************************************************************************/
@@ -368,7 +690,7 @@ namespace qb {
   };
 
   [[nodiscard]] inline uint32_t ReadRequiredUint32(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadUint32(object.Get(key), qb::detail::Property(key), true).value_or(0);
+    return qb::detail::ReadUint32(qb::detail::GetProperty(object, key), qb::detail::Property(key), true).value_or(0);
   };
 
   [[nodiscard]] inline std::optional<uint32_t> ReadOptionalUint32(const Napi::CallbackInfo &info,
@@ -377,44 +699,97 @@ namespace qb {
   };
 
   [[nodiscard]] inline std::optional<uint32_t> ReadOptionalUint32(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadUint32(object.Get(key), qb::detail::Property(key), false);
+    return qb::detail::ReadUint32(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
   };
 
   /**** Unsigned 16-bit integers *************************************************************************************/
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline uint16_t ReadRequiredUint16(const Napi::CallbackInfo &info, const uint16_t index) {
-    return qb::detail::ReadUint16(info[index], qb::detail::Argument(index), true).value_or(0);
+    return qb::detail::ReadNarrowInteger<uint16_t, Policy>(info[index], qb::detail::Argument(index), true).value_or(0);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline uint16_t ReadRequiredUint16(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadUint16(object.Get(key), qb::detail::Property(key), true).value_or(0);
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadNarrowInteger<uint16_t, Policy>(value, qb::detail::Property(key), true).value_or(0);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline std::optional<uint16_t> ReadOptionalUint16(const Napi::CallbackInfo &info,
                                                                   const uint16_t index) {
-    return qb::detail::ReadUint16(info[index], qb::detail::Argument(index), false);
+    return qb::detail::ReadNarrowInteger<uint16_t, Policy>(info[index], qb::detail::Argument(index), false);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline std::optional<uint16_t> ReadOptionalUint16(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadUint16(object.Get(key), qb::detail::Property(key), false);
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadNarrowInteger<uint16_t, Policy>(value, qb::detail::Property(key), false);
   };
 
   /**** Unsigned 8-bit integers **************************************************************************************/
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline uint8_t ReadRequiredUint8(const Napi::CallbackInfo &info, const uint16_t index) {
-    return qb::detail::ReadUint8(info[index], qb::detail::Argument(index), true).value_or(0);
+    return qb::detail::ReadNarrowInteger<uint8_t, Policy>(info[index], qb::detail::Argument(index), true).value_or(0);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline uint8_t ReadRequiredUint8(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadUint8(object.Get(key), qb::detail::Property(key), true).value_or(0);
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadNarrowInteger<uint8_t, Policy>(value, qb::detail::Property(key), true).value_or(0);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline std::optional<uint8_t> ReadOptionalUint8(const Napi::CallbackInfo &info, const uint16_t index) {
-    return qb::detail::ReadUint8(info[index], qb::detail::Argument(index), false);
+    return qb::detail::ReadNarrowInteger<uint8_t, Policy>(info[index], qb::detail::Argument(index), false);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline std::optional<uint8_t> ReadOptionalUint8(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadUint8(object.Get(key), qb::detail::Property(key), false);
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadNarrowInteger<uint8_t, Policy>(value, qb::detail::Property(key), false);
+  };
+
+  /**** Pointer-sized integers **************************************************************************************/
+
+  [[nodiscard]] inline uintptr_t ReadRequiredUintPtr(const Napi::CallbackInfo &info, const uint16_t index) {
+    return qb::detail::ReadPointerSized<uintptr_t>(info[index], qb::detail::Argument(index), true).value_or(0);
+  };
+
+  [[nodiscard]] inline uintptr_t ReadRequiredUintPtr(const Napi::Object &object, const std::string &key) {
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadPointerSized<uintptr_t>(value, qb::detail::Property(key), true).value_or(0);
+  };
+
+  [[nodiscard]] inline std::optional<uintptr_t> ReadOptionalUintPtr(const Napi::CallbackInfo &info,
+                                                                    const uint16_t index) {
+    return qb::detail::ReadPointerSized<uintptr_t>(info[index], qb::detail::Argument(index), false);
+  };
+
+  [[nodiscard]] inline std::optional<uintptr_t> ReadOptionalUintPtr(const Napi::Object &object,
+                                                                    const std::string &key) {
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadPointerSized<uintptr_t>(value, qb::detail::Property(key), false);
+  };
+
+  [[nodiscard]] inline intptr_t ReadRequiredIntPtr(const Napi::CallbackInfo &info, const uint16_t index) {
+    return qb::detail::ReadPointerSized<intptr_t>(info[index], qb::detail::Argument(index), true).value_or(0);
+  };
+
+  [[nodiscard]] inline intptr_t ReadRequiredIntPtr(const Napi::Object &object, const std::string &key) {
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadPointerSized<intptr_t>(value, qb::detail::Property(key), true).value_or(0);
+  };
+
+  [[nodiscard]] inline std::optional<intptr_t> ReadOptionalIntPtr(const Napi::CallbackInfo &info,
+                                                                  const uint16_t index) {
+    return qb::detail::ReadPointerSized<intptr_t>(info[index], qb::detail::Argument(index), false);
+  };
+
+  [[nodiscard]] inline std::optional<intptr_t> ReadOptionalIntPtr(const Napi::Object &object, const std::string &key) {
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadPointerSized<intptr_t>(value, qb::detail::Property(key), false);
   };
 
   /**** Signed 64-bit integers ***************************************************************************************/
@@ -424,7 +799,7 @@ namespace qb {
   };
 
   [[nodiscard]] inline int64_t ReadRequiredInt64(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadInt64(object.Get(key), qb::detail::Property(key), true).value_or(0);
+    return qb::detail::ReadInt64(qb::detail::GetProperty(object, key), qb::detail::Property(key), true).value_or(0);
   };
 
   [[nodiscard]] inline std::optional<int64_t> ReadOptionalInt64(const Napi::CallbackInfo &info, const uint16_t index) {
@@ -432,7 +807,7 @@ namespace qb {
   };
 
   [[nodiscard]] inline std::optional<int64_t> ReadOptionalInt64(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadInt64(object.Get(key), qb::detail::Property(key), false);
+    return qb::detail::ReadInt64(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
   };
 
   /**** Signed 32-bit integers ***************************************************************************************/
@@ -442,7 +817,7 @@ namespace qb {
   };
 
   [[nodiscard]] inline int32_t ReadRequiredInt32(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadInt32(object.Get(key), qb::detail::Property(key), true).value_or(0);
+    return qb::detail::ReadInt32(qb::detail::GetProperty(object, key), qb::detail::Property(key), true).value_or(0);
   };
 
   [[nodiscard]] inline std::optional<int32_t> ReadOptionalInt32(const Napi::CallbackInfo &info, const uint16_t index) {
@@ -450,93 +825,147 @@ namespace qb {
   };
 
   [[nodiscard]] inline std::optional<int32_t> ReadOptionalInt32(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadInt32(object.Get(key), qb::detail::Property(key), false);
+    return qb::detail::ReadInt32(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
   };
 
   /**** Signed 16-bit integers ***************************************************************************************/
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline int16_t ReadRequiredInt16(const Napi::CallbackInfo &info, const uint16_t index) {
-    return qb::detail::ReadInt16(info[index], qb::detail::Argument(index), true).value_or(0);
+    return qb::detail::ReadNarrowInteger<int16_t, Policy>(info[index], qb::detail::Argument(index), true).value_or(0);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline int16_t ReadRequiredInt16(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadInt16(object.Get(key), qb::detail::Property(key), true).value_or(0);
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadNarrowInteger<int16_t, Policy>(value, qb::detail::Property(key), true).value_or(0);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline std::optional<int16_t> ReadOptionalInt16(const Napi::CallbackInfo &info, const uint16_t index) {
-    return qb::detail::ReadInt16(info[index], qb::detail::Argument(index), false);
+    return qb::detail::ReadNarrowInteger<int16_t, Policy>(info[index], qb::detail::Argument(index), false);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline std::optional<int16_t> ReadOptionalInt16(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadInt16(object.Get(key), qb::detail::Property(key), false);
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadNarrowInteger<int16_t, Policy>(value, qb::detail::Property(key), false);
   };
 
   /**** Signed 8-bit integers ****************************************************************************************/
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline int8_t ReadRequiredInt8(const Napi::CallbackInfo &info, const uint16_t index) {
-    return qb::detail::ReadInt8(info[index], qb::detail::Argument(index), true).value_or(0);
+    return qb::detail::ReadNarrowInteger<int8_t, Policy>(info[index], qb::detail::Argument(index), true).value_or(0);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline int8_t ReadRequiredInt8(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadInt8(object.Get(key), qb::detail::Property(key), true).value_or(0);
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadNarrowInteger<int8_t, Policy>(value, qb::detail::Property(key), true).value_or(0);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline std::optional<int8_t> ReadOptionalInt8(const Napi::CallbackInfo &info, const uint16_t index) {
-    return qb::detail::ReadInt8(info[index], qb::detail::Argument(index), false);
+    return qb::detail::ReadNarrowInteger<int8_t, Policy>(info[index], qb::detail::Argument(index), false);
   };
 
+  template <qb::Narrowing Policy = qb::DEFAULT_NARROWING>
   [[nodiscard]] inline std::optional<int8_t> ReadOptionalInt8(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadInt8(object.Get(key), qb::detail::Property(key), false);
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadNarrowInteger<int8_t, Policy>(value, qb::detail::Property(key), false);
+  };
+
+  /**** Booleans *****************************************************************************************************/
+
+  [[nodiscard]] inline bool ReadRequiredBoolean(const Napi::CallbackInfo &info, const uint16_t index) {
+    return qb::detail::ReadBoolean(info[index], qb::detail::Argument(index), true).value_or(false);
+  };
+
+  [[nodiscard]] inline bool ReadRequiredBoolean(const Napi::Object &object, const std::string &key) {
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadBoolean(value, qb::detail::Property(key), true).value_or(false);
+  };
+
+  [[nodiscard]] inline std::optional<bool> ReadOptionalBoolean(const Napi::CallbackInfo &info, const uint16_t index) {
+    return qb::detail::ReadBoolean(info[index], qb::detail::Argument(index), false);
+  };
+
+  [[nodiscard]] inline std::optional<bool> ReadOptionalBoolean(const Napi::Object &object, const std::string &key) {
+    return qb::detail::ReadBoolean(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
   };
 
   /**** Strings ******************************************************************************************************/
 
-  [[nodiscard]] inline std::string ReadRequiredString(const Napi::CallbackInfo &info, const uint16_t index) {
+  [[nodiscard]] inline std::pmr::string ReadRequiredString(const Napi::CallbackInfo &info, const uint16_t index) {
     return qb::detail::ReadString(info[index], qb::detail::Argument(index), true).value_or("");
   };
 
-  [[nodiscard]] inline std::string ReadRequiredString(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadString(object.Get(key), qb::detail::Property(key), true).value_or("");
+  [[nodiscard]] inline std::pmr::string ReadRequiredString(const Napi::Object &object, const std::string &key) {
+    return qb::detail::ReadString(qb::detail::GetProperty(object, key), qb::detail::Property(key), true).value_or("");
   };
 
-  [[nodiscard]] inline std::optional<std::string> ReadOptionalString(const Napi::CallbackInfo &info,
-                                                                     const uint16_t index) {
+  [[nodiscard]] inline std::optional<std::pmr::string> ReadOptionalString(const Napi::CallbackInfo &info,
+                                                                          const uint16_t index) {
     return qb::detail::ReadString(info[index], qb::detail::Argument(index), false);
   };
 
-  [[nodiscard]] inline std::optional<std::string> ReadOptionalString(const Napi::Object &object,
-                                                                     const std::string &key) {
-    return qb::detail::ReadString(object.Get(key), qb::detail::Property(key), false);
+  [[nodiscard]] inline std::optional<std::pmr::string> ReadOptionalString(const Napi::Object &object,
+                                                                          const std::string &key) {
+    return qb::detail::ReadString(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
+  };
+
+  /**** ANSI strings *************************************************************************************************/
+
+  [[nodiscard]] inline std::pmr::string ReadRequiredAnsiString(const Napi::CallbackInfo &info, const uint16_t index) {
+    return qb::detail::ReadAnsiString(info[index], qb::detail::Argument(index), true).value_or("");
+  };
+
+  [[nodiscard]] inline std::pmr::string ReadRequiredAnsiString(const Napi::Object &object, const std::string &key) {
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadAnsiString(value, qb::detail::Property(key), true).value_or("");
+  };
+
+  [[nodiscard]] inline std::optional<std::pmr::string> ReadOptionalAnsiString(const Napi::CallbackInfo &info,
+                                                                              const uint16_t index) {
+    return qb::detail::ReadAnsiString(info[index], qb::detail::Argument(index), false);
+  };
+
+  [[nodiscard]] inline std::optional<std::pmr::string> ReadOptionalAnsiString(const Napi::Object &object,
+                                                                              const std::string &key) {
+    return qb::detail::ReadAnsiString(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
   };
 
   /**** Wide strings *************************************************************************************************/
 
-  [[nodiscard]] inline std::wstring ReadRequiredWideString(const Napi::CallbackInfo &info, const uint16_t index) {
+  [[nodiscard]] inline std::pmr::wstring ReadRequiredWideString(const Napi::CallbackInfo &info, const uint16_t index) {
     return qb::detail::ReadWideString(info[index], qb::detail::Argument(index), true).value_or(L"");
   };
 
-  [[nodiscard]] inline std::wstring ReadRequiredWideString(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadWideString(object.Get(key), qb::detail::Property(key), true).value_or(L"");
+  [[nodiscard]] inline std::pmr::wstring ReadRequiredWideString(const Napi::Object &object, const std::string &key) {
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadWideString(value, qb::detail::Property(key), true).value_or(L"");
   };
 
-  [[nodiscard]] inline std::optional<std::wstring> ReadOptionalWideString(const Napi::CallbackInfo &info,
-                                                                          const uint16_t index) {
+  [[nodiscard]] inline std::optional<std::pmr::wstring> ReadOptionalWideString(const Napi::CallbackInfo &info,
+                                                                               const uint16_t index) {
     return qb::detail::ReadWideString(info[index], qb::detail::Argument(index), false);
   };
 
-  [[nodiscard]] inline std::optional<std::wstring> ReadOptionalWideString(const Napi::Object &object,
-                                                                          const std::string &key) {
-    return qb::detail::ReadWideString(object.Get(key), qb::detail::Property(key), false);
+  [[nodiscard]] inline std::optional<std::pmr::wstring> ReadOptionalWideString(const Napi::Object &object,
+                                                                               const std::string &key) {
+    return qb::detail::ReadWideString(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
   };
 
   /**** Objects ******************************************************************************************************/
 
   [[nodiscard]] inline Napi::Object ReadRequiredObject(const Napi::CallbackInfo &info, const uint16_t index) {
-    return qb::detail::ReadObject(info[index], qb::detail::Argument(index), true).value_or({});
+    return qb::detail::ReadObject(info[index], qb::detail::Argument(index), true).value_or(Napi::Object());
   };
 
   [[nodiscard]] inline Napi::Object ReadRequiredObject(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadObject(object.Get(key), qb::detail::Property(key), true).value_or({});
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadObject(value, qb::detail::Property(key), true).value_or(Napi::Object());
   };
 
   [[nodiscard]] inline std::optional<Napi::Object> ReadOptionalObject(const Napi::CallbackInfo &info,
@@ -546,17 +975,18 @@ namespace qb {
 
   [[nodiscard]] inline std::optional<Napi::Object> ReadOptionalObject(const Napi::Object &object,
                                                                       const std::string &key) {
-    return qb::detail::ReadObject(object.Get(key), qb::detail::Property(key), false);
+    return qb::detail::ReadObject(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
   };
 
   /**** Functions ****************************************************************************************************/
 
   [[nodiscard]] inline Napi::Function ReadRequiredFunction(const Napi::CallbackInfo &info, const uint16_t index) {
-    return qb::detail::ReadFunction(info[index], qb::detail::Argument(index), true).value_or({});
+    return qb::detail::ReadFunction(info[index], qb::detail::Argument(index), true).value_or(Napi::Function());
   };
 
   [[nodiscard]] inline Napi::Function ReadRequiredFunction(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadFunction(object.Get(key), qb::detail::Property(key), true).value_or({});
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadFunction(value, qb::detail::Property(key), true).value_or(Napi::Function());
   };
 
   [[nodiscard]] inline std::optional<Napi::Function> ReadOptionalFunction(const Napi::CallbackInfo &info,
@@ -566,19 +996,20 @@ namespace qb {
 
   [[nodiscard]] inline std::optional<Napi::Function> ReadOptionalFunction(const Napi::Object &object,
                                                                           const std::string &key) {
-    return qb::detail::ReadFunction(object.Get(key), qb::detail::Property(key), false);
+    return qb::detail::ReadFunction(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
   };
 
   /**** Handles ******************************************************************************************************/
 
   template <qb::WinHandle T>
   [[nodiscard]] inline T ReadRequiredHandle(const Napi::CallbackInfo &info, const uint16_t index) {
-    return qb::detail::ReadHandle<T>(info[index], qb::detail::Argument(index), true).value_or({});
+    return qb::detail::ReadHandle<T>(info[index], qb::detail::Argument(index), true).value_or(T{});
   };
 
   template <qb::WinHandle T>
   [[nodiscard]] inline T ReadRequiredHandle(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadHandle<T>(object.Get(key), qb::detail::Property(key), true).value_or({});
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadHandle<T>(value, qb::detail::Property(key), true).value_or(T{});
   };
 
   template <qb::WinHandle T>
@@ -588,13 +1019,293 @@ namespace qb {
 
   template <qb::WinHandle T>
   [[nodiscard]] inline std::optional<T> ReadOptionalHandle(const Napi::Object &object, const std::string &key) {
-    return qb::detail::ReadHandle<T>(object.Get(key), qb::detail::Property(key), false);
+    return qb::detail::ReadHandle<T>(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
+  };
+
+  /**** Buffers ******************************************************************************************************/
+
+  template <qb::SpanElement T>
+  [[nodiscard]] inline std::span<T> ReadRequiredSpan(const Napi::CallbackInfo &info, const uint16_t index) {
+    return qb::detail::ReadSpan<T>(info[index], qb::detail::Argument(index), true).value_or(std::span<T>{});
+  };
+
+  template <qb::SpanElement T>
+  [[nodiscard]] inline std::span<T> ReadRequiredSpan(const Napi::Object &object, const std::string &key) {
+    const Napi::Value value = qb::detail::GetProperty(object, key);
+    return qb::detail::ReadSpan<T>(value, qb::detail::Property(key), true).value_or(std::span<T>{});
+  };
+
+  template <qb::SpanElement T>
+  [[nodiscard]] inline std::optional<std::span<T>> ReadOptionalSpan(const Napi::CallbackInfo &info,
+                                                                    const uint16_t index) {
+    return qb::detail::ReadSpan<T>(info[index], qb::detail::Argument(index), false);
+  };
+
+  template <qb::SpanElement T>
+  [[nodiscard]] inline std::optional<std::span<T>> ReadOptionalSpan(const Napi::Object &object,
+                                                                    const std::string &key) {
+    return qb::detail::ReadSpan<T>(qb::detail::GetProperty(object, key), qb::detail::Property(key), false);
   };
 
   /**** Convertors ***************************************************************************************************/
   template <qb::WinHandle T> inline Napi::BigInt HandleToBigInt(const Napi::CallbackInfo &info, const T &value) {
     return Napi::BigInt::New(info.Env(), reinterpret_cast<uintptr_t>(value));
   }
+
+  /**
+   * A Number when `value` is within Number.MAX_SAFE_INTEGER and a BigInt otherwise, for WPARAM, LPARAM and LRESULT
+   * values that are almost always small. Read back with ReadRequiredUintPtr / ReadRequiredIntPtr, which take either.
+   */
+  inline Napi::Value ToNumberOrBigInt(const Napi::Env env, const uintptr_t value) {
+    if (value <= static_cast<uintptr_t>(qb::detail::MAX_SAFE_INTEGER)) {
+      return Napi::Number::New(env, static_cast<double>(value));
+    }
+
+    return Napi::BigInt::New(env, static_cast<uint64_t>(value));
+  }
+
+  inline Napi::Value ToNumberOrBigInt(const Napi::Env env, const intptr_t value) {
+    const intptr_t limit = static_cast<intptr_t>(qb::detail::MAX_SAFE_INTEGER);
+
+    if (value >= -limit && value <= limit) {
+      return Napi::Number::New(env, static_cast<double>(value));
+    }
+
+    return Napi::BigInt::New(env, static_cast<int64_t>(value));
+  }
+
+  /**** Returned text ************************************************************************************************/
+  /**
+   * Copies `length` WCHARs into a JS string. WCHARs are UTF-16 code units on Windows and are handed over as is; where
+   * wchar_t is wider, as with the win32-stub headers, each one is narrowed back to the code unit it holds.
+   */
+  [[nodiscard]] inline Napi::String WideToString(const Napi::Env env, const wchar_t *text, const size_t length) {
+    if constexpr (sizeof(wchar_t) == sizeof(char16_t)) {
+      return Napi::String::New(env, reinterpret_cast<const char16_t *>(text), length);
+    } else {
+      return Napi::String::New(env, std::u16string(text, text + length));
+    }
+  }
+
+  /**
+   * Grow-only per-thread buffer for bindings that return text. The API writes straight into it and the result is
+   * turned into a JS string with at most one copy, instead of going through a std::wstring and a std::u16string first:
+   *
+   *   qb::TextBuffer &buffer = qb::TextBuffer::Current();
+   *   const int length = ::GetWindowTextW(hWnd, buffer.Reserve(nMaxCount), nMaxCount);
+   *   lpString.Set("value", buffer.ToString(env, length));
+   */
+  class TextBuffer {
+  public:
+    // Shorter results are cheaper to copy onto the V8 heap than to track as external strings.
+    static constexpr size_t EXTERNAL_STRING_THRESHOLD = 4096;
+
+    [[nodiscard]] static TextBuffer &Current() {
+      thread_local TextBuffer buffer;
+      return buffer;
+    }
+
+    /**
+     * Storage for at least `capacity` characters. Nothing written to it is kept from one call to the next.
+     */
+    [[nodiscard]] wchar_t *Reserve(const size_t capacity) {
+      if (capacity > this->capacity) {
+        this->data = std::make_unique_for_overwrite<wchar_t[]>(capacity);
+        this->capacity = capacity;
+      }
+
+      return this->data.get();
+    }
+
+    /**
+     * Turns the first `length` characters into a JS string. A long result that fills at least half of the buffer is
+     * handed to V8 as an external string where Node-API supports them, and the buffer starts over empty, so the text
+     * is never copied at all. Everything else is copied once with napi_create_string_utf16.
+     */
+    [[nodiscard]] Napi::String ToString(const Napi::Env env, const size_t length) {
+#if NAPI_VERSION >= 10 || defined(NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS)
+      if constexpr (sizeof(wchar_t) == sizeof(char16_t)) {
+        if (length >= EXTERNAL_STRING_THRESHOLD && length * 2 >= this->capacity) {
+          const size_t capacity = std::exchange(this->capacity, 0);
+          wchar_t *text = this->data.release();
+
+          napi_value result = nullptr;
+          bool copied = false;
+
+          // Node-API owns the text from here on and frees it through the finalizer, even when it decides to copy.
+          const napi_status status = node_api_create_external_string_utf16(
+              env,
+              reinterpret_cast<char16_t *>(text),
+              length,
+              [](auto, void *data, void *) { delete[] static_cast<wchar_t *>(data); },
+              nullptr,
+              &result,
+              &copied);
+
+          if (status == napi_ok) {
+            return Napi::String(env, result);
+          }
+
+          // Rejected before taking ownership; fall back to copying.
+          this->data.reset(text);
+          this->capacity = capacity;
+        }
+      }
+#endif
+
+      return qb::WideToString(env, this->data.get(), length);
+    }
+
+  private:
+    std::unique_ptr<wchar_t[]> data;
+    size_t capacity = 0;
+  };
+
+  /**** Exports ******************************************************************************************************/
+  /**
+   * A single entry of a module's static export table. `name` always points into the string literal produced by
+   * QB_EXPORT, so it is null terminated and can be handed to Node-API as is.
+   */
+  struct Export {
+    std::string_view name;
+    napi_callback callback;
+#ifdef QB_ENABLE_STATS
+    size_t *slot;
+#endif
+  };
+
+  namespace detail {
+    template <auto Function> napi_value Trampoline(napi_env env, napi_callback_info cbinfo) {
+      const qb::CallArena::Scope arena;
+      const Napi::CallbackInfo info(env, cbinfo);
+
+      // A reader whose result never went through ArgumentsFailed leaves readFailed set, which would make every read of
+      // the next call fail. Clearing it on the way in and out keeps it from leaking into the next call or back into the
+      // binding that called this one through JS.
+      qb::detail::readFailed = false;
+      const napi_value result = Function(info);
+      qb::detail::readFailed = false;
+
+      return result;
+    }
+
+    /**
+     * What each export's accessor gets as its data: the table entry and the exports object it was defined on. The
+     * accessor can also be reached through an object inheriting from exports, so the receiver isn't necessarily it.
+     */
+    struct LazyExport {
+      const qb::Export *entry;
+      napi_ref *exports;
+    };
+
+    /**
+     * Owns the accessor data of one DefineExports call, and is freed along with the exports object it was defined on.
+     */
+    struct LazyExports {
+      napi_ref exports = nullptr;
+      std::vector<LazyExport> entries;
+    };
+
+    /**
+     * Getter installed for every export. Creates the function the first time the export is read and then replaces the
+     * accessor on the exports object with a plain data property, so later reads never come back through here.
+     */
+    inline napi_value MaterializeExport(napi_env env, napi_callback_info cbinfo) {
+      void *data = nullptr;
+
+      if (napi_get_cb_info(env, cbinfo, nullptr, nullptr, nullptr, &data) != napi_ok) {
+        return nullptr;
+      }
+
+      const LazyExport *lazy = static_cast<const LazyExport *>(data);
+      const qb::Export *entry = lazy->entry;
+
+      napi_value exports = nullptr;
+      napi_value function = nullptr;
+
+      if (napi_get_reference_value(env, *lazy->exports, &exports) != napi_ok || exports == nullptr ||
+          napi_create_function(env, entry->name.data(), entry->name.size(), entry->callback, nullptr, &function) !=
+              napi_ok) {
+        return nullptr;
+      }
+
+      const napi_property_descriptor descriptor = {
+          entry->name.data(),
+          nullptr,
+          nullptr,
+          nullptr,
+          nullptr,
+          function,
+          static_cast<napi_property_attributes>(napi_writable | napi_enumerable | napi_configurable),
+          nullptr,
+      };
+
+      napi_define_properties(env, exports, 1, &descriptor);
+
+      return function;
+    }
+  } // namespace detail
+
+  /**
+   * Defines every entry of a module's export table on `exports` with a single napi_define_properties call. Each export
+   * starts out as a lazy accessor, so module load only pays for the descriptors and no function object or name string
+   * is created until the export is first read. The named exports of each package's lib/index.ts read every export on
+   * import, so only code holding the addon object itself creates just the functions it uses. Both are measured by
+   * packages/common/bench/startup.js.
+   */
+  template <size_t N>
+  inline Napi::Object DefineExports(const Napi::Env env, Napi::Object exports, const qb::Export (&table)[N]) {
+    qb::detail::LazyExports *lazy = new qb::detail::LazyExports();
+    lazy->entries.reserve(N + 1);
+
+    // Weak, since the reference lives exactly as long as the object it points to.
+    napi_create_reference(env, exports, 0, &lazy->exports);
+    napi_add_finalizer(
+        env,
+        exports,
+        lazy,
+        [](auto finalizeEnv, void *data, void *) {
+          qb::detail::LazyExports *finalized = static_cast<qb::detail::LazyExports *>(data);
+          napi_delete_reference(finalizeEnv, finalized->exports);
+          delete finalized;
+        },
+        nullptr,
+        nullptr);
+
+    for (const qb::Export &entry : table) {
+#ifdef QB_ENABLE_STATS
+      qb::stats::Register(*entry.slot, entry.name);
+#endif
+
+      lazy->entries.push_back({&entry, &lazy->exports});
+    }
+
+#ifdef QB_ENABLE_STATS
+    static constexpr qb::Export STATS = {"__qbStats", &qb::detail::Trampoline<qb::stats::Snapshot>, nullptr};
+
+    lazy->entries.push_back({&STATS, &lazy->exports});
+#endif
+
+    std::vector<napi_property_descriptor> descriptors;
+    descriptors.reserve(lazy->entries.size());
+
+    for (qb::detail::LazyExport &entry : lazy->entries) {
+      descriptors.push_back({
+          entry.entry->name.data(),
+          nullptr,
+          nullptr,
+          qb::detail::MaterializeExport,
+          nullptr,
+          nullptr,
+          static_cast<napi_property_attributes>(napi_enumerable | napi_configurable),
+          &entry,
+      });
+    }
+
+    napi_define_properties(env, exports, descriptors.size(), descriptors.data());
+
+    return exports;
+  }
 }; // namespace qb
 
 #undef QB_CHECK_NULLISH
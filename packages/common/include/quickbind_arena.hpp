@@ -0,0 +1,142 @@
+/**
+ * QuickBind Call Arena
+ *
+ * A per-thread bump allocator for the temporaries a binding needs only until it returns: marshalled strings, struct
+ * copies and arrays handed to the Win32 call. Every binding called through a QB_EXPORT table opens a CallArena::Scope,
+ * and everything allocated from the arena inside it is released in bulk when the binding returns, without a single
+ * call into the heap once the arena has grown to the size the bindings actually need.
+ *
+ * The arena is a std::pmr::memory_resource, so anything with a pmr allocator can use it:
+ *
+ *   std::pmr::vector<RAWINPUTDEVICE> devices(count, &qb::CallArena::Current());
+ *
+ * Nothing allocated from the arena may outlive the binding call it was allocated in.
+ *
+ * Copyright (c) 2025-present, Kasim Ahmic. (https://kasimahmic.com)
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace qb {
+  class CallArena final : public std::pmr::memory_resource {
+    struct Block {
+      std::unique_ptr<std::byte[]> data;
+      size_t size;
+    };
+
+    struct Position {
+      size_t block = 0;
+      size_t offset = 0;
+      // Bytes in the blocks before `block`, so the bytes in use are always `consumed + offset`.
+      size_t consumed = 0;
+    };
+
+  public:
+    static constexpr size_t INITIAL_BLOCK_SIZE = 4 * 1024;
+
+    [[nodiscard]] static CallArena &Current() {
+      thread_local CallArena arena;
+      return arena;
+    }
+
+    /**
+     * Releases everything allocated from the arena since the scope was opened. Scopes nest, so a binding re-entered
+     * from a callback (DispatchMessageW -> WndProc -> DefWindowProcW) only releases its own allocations.
+     */
+    class Scope {
+    public:
+      Scope() : arena(CallArena::Current()), mark(arena.position) {}
+      ~Scope() { this->arena.Rewind(this->mark); }
+
+      Scope(const Scope &) = delete;
+      Scope &operator=(const Scope &) = delete;
+
+    private:
+      CallArena &arena;
+      const Position mark;
+    };
+
+    /**
+     * Most bytes that were ever in use at once, including alignment padding.
+     */
+    [[nodiscard]] size_t HighWaterMark() const { return this->highWaterMark; }
+
+    /**
+     * Bytes currently reserved from the heap.
+     */
+    [[nodiscard]] size_t Capacity() const {
+      size_t capacity = 0;
+
+      for (const Block &block : this->blocks) {
+        capacity += block.size;
+      }
+
+      return capacity;
+    }
+
+  private:
+    std::vector<Block> blocks;
+    Position position;
+    size_t highWaterMark = 0;
+
+    void *do_allocate(const size_t bytes, const size_t alignment) override {
+      while (true) {
+        if (this->position.block < this->blocks.size()) {
+          Block &block = this->blocks[this->position.block];
+
+          const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+          const size_t aligned = ((base + this->position.offset + alignment - 1) & ~(alignment - 1)) - base;
+
+          if (aligned + bytes <= block.size) {
+            this->position.offset = aligned + bytes;
+            this->highWaterMark = std::max(this->highWaterMark, this->position.consumed + this->position.offset);
+
+            return block.data.get() + aligned;
+          }
+
+          // Move on to the next block, which is either one kept from an earlier call or the one allocated below.
+          this->position.consumed += block.size;
+          this->position.block++;
+          this->position.offset = 0;
+          continue;
+        }
+
+        // Blocks double in size, so a binding that needs N bytes causes at most log2(N) growths in total.
+        const size_t previous = this->blocks.empty() ? INITIAL_BLOCK_SIZE / 2 : this->blocks.back().size;
+        const size_t size = std::max(previous * 2, bytes + alignment);
+
+        this->blocks.push_back({std::make_unique_for_overwrite<std::byte[]>(size), size});
+      }
+    }
+
+    // Individual deallocations are no-ops; memory comes back when the enclosing Scope closes.
+    void do_deallocate(void *, size_t, size_t) override {}
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+      return this == &other;
+    }
+
+    void Rewind(const Position &mark) {
+      this->position = mark;
+
+      // Once the outermost scope closes, a chain of blocks is merged into a single one large enough for everything
+      // that was needed at once, so later calls bump through one block instead of walking the chain.
+      if (mark.block == 0 && mark.offset == 0 && this->blocks.size() > 1) {
+        const size_t size = this->Capacity();
+
+        this->blocks.clear();
+        this->blocks.push_back({std::make_unique_for_overwrite<std::byte[]>(size), size});
+      }
+    }
+  };
+} // namespace qb
@@ -0,0 +1,541 @@
+/**
+ * QuickBind Owned Handles
+ *
+ * Opt-in JS objects that own a Win32 handle and destroy it with the matching function (DestroyMenu, DestroyWindow,
+ * DeleteObject, ...) when they are disposed, either explicitly through `dispose()` / `using`, or when the object is
+ * garbage collected without having been disposed:
+ *
+ *   return qb::OwnedHandle::New(env, hMenu);
+ *
+ * Every reader of the same handle type accepts an owned handle in place of the raw BigInt, so an owned handle can be
+ * passed to any binding of the addon that created it. Readers of another handle type reject it. Other addons only see a
+ * plain object; pass `.value` to them.
+ *
+ * Handles whose objects are collected are not destroyed from the GC finalizer itself. They are queued and destroyed in
+ * one batch on the env's thread, which is also the only thread DestroyWindow is allowed to run on, and counted as
+ * collected: every one of those is a handle the program forgot to dispose. A handle type is made ownable by
+ * specializing qb::HandleTraits with its name and destroy function, and with a `Base` type when readers of a more
+ * general handle type, like HGDIOBJ for DeleteObject, should accept it too.
+ *
+ * A handle destroyed some other way while it is owned has to be reported through OwnedHandle::Orphan, or its owner
+ * would later destroy whatever reused the handle value.
+ *
+ * Copyright (c) 2025-present, Kasim Ahmic. (https://kasimahmic.com)
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <napi.h>
+#include <windows.h>
+
+#include "quickbind_instance.hpp"
+
+namespace qb {
+  /**
+   * Specialized for every handle type that can be owned, with its name and the function that destroys it.
+   */
+  template <typename T> struct HandleTraits;
+
+  // HandleTraits<T>::Base when it is declared, otherwise T itself.
+  template <typename T> struct HandleBase {
+    using Type = T;
+  };
+
+  template <typename T>
+    requires requires { typename HandleTraits<T>::Base; }
+  struct HandleBase<T> {
+    using Type = typename HandleTraits<T>::Base;
+  };
+
+  class OwnedHandle {
+  public:
+    /**
+     * Per handle type counts for the env. Handles still owned are
+     * `created - disposed - collected - released - failed - orphaned`.
+     */
+    struct Stats {
+      uint64_t created = 0;
+      uint64_t disposed = 0;
+      uint64_t collected = 0;
+      uint64_t released = 0;
+      uint64_t failed = 0;
+      uint64_t orphaned = 0;
+    };
+
+    /**
+     * What Unwrap found: the owned handle, nullptr once it has been disposed, released or orphaned, and its type name.
+     * `matches` is false when the object owns a handle of a type the reader doesn't accept.
+     */
+    struct Unwrapped {
+      void *handle;
+      std::string_view type;
+      bool matches;
+    };
+
+    /**
+     * An object owning `handle`, or null if `handle` is null, so a failed create call never produces an owned handle.
+     */
+    template <typename T> [[nodiscard]] static Napi::Value New(const Napi::Env env, const T handle) {
+      if (handle == nullptr) {
+        return env.Null();
+      }
+
+      Registry &registry = qb::InstanceData::Get<Registry>(env);
+
+      napi_value object = nullptr;
+      napi_new_instance(env, registry.Constructor(env), 0, nullptr, &object);
+
+      void *data = nullptr;
+      napi_unwrap(env, object, &data);
+
+      Instance *instance = static_cast<Instance *>(data);
+      instance->handle = handle;
+      instance->kind = registry.KindOf<T>();
+      instance->key = &KindKey<T>;
+      instance->baseKey = &KindKey<typename HandleBase<T>::Type>;
+      instance->destroy = DestroyHandle<T>;
+      instance->type = HandleTraits<T>::NAME;
+
+      registry.kinds[instance->kind].stats.created++;
+      registry.owned.emplace(handle, instance);
+
+      return Napi::Value(env, object);
+    }
+
+    /**
+     * The handle owned by `value` for a reader of T, or std::nullopt if `value` isn't an owned handle created by this
+     * addon. An owned handle of type T is accepted, and so is one whose HandleTraits declare T as its Base.
+     */
+    template <typename T> [[nodiscard]] static std::optional<Unwrapped> Unwrap(const Napi::Value &value) {
+      if (const Instance *instance = Find(value)) {
+        return Unwrapped{instance->handle, instance->type, Accepts<T>(*instance)};
+      }
+
+      return std::nullopt;
+    }
+
+    /**
+     * Disposes `value` if it is an owned handle of type T, for the Destroy* bindings, which would otherwise destroy the
+     * handle and leave the object to destroy it a second time. std::nullopt if `value` isn't one; read it with
+     * ReadHandle<T> first, which rejects owned handles of other types.
+     */
+    template <typename T> [[nodiscard]] static std::optional<BOOL> Dispose(const Napi::Value &value) {
+      if (Instance *instance = Find(value); instance != nullptr && Accepts<T>(*instance)) {
+        return qb::InstanceData::Get<Registry>(value.Env()).Dispose(*instance);
+      }
+
+      return std::nullopt;
+    }
+
+    /**
+     * Forgets `handle` in every object owning it as a T, for handles destroyed by something other than their owner,
+     * such as a window destroyed along with its parent. Without this, the owner would destroy the handle again, or
+     * whatever handle later reused its value. Runs on the env's thread; does nothing once the env is gone.
+     */
+    template <typename T> static void Orphan(const T handle) {
+      if (Registry *registry = qb::InstanceData::Find<Registry>()) {
+        registry->Orphan(handle, &KindKey<T>);
+      }
+    }
+
+    /**
+     * `{ [type]: { live, created, disposed, collected, released, failed } }` for every handle type owned in the env.
+     */
+    [[nodiscard]] static Napi::Object GetStats(const Napi::Env env) {
+      const Registry &registry = qb::InstanceData::Get<Registry>(env);
+
+      Napi::Object result = Napi::Object::New(env);
+
+      for (const Kind &kind : registry.kinds) {
+        const Stats &stats = kind.stats;
+        const uint64_t live =
+            stats.created - stats.disposed - stats.collected - stats.released - stats.failed - stats.orphaned;
+
+        Napi::Object counts = Napi::Object::New(env);
+        counts.Set("live", Napi::Number::New(env, static_cast<double>(live)));
+        counts.Set("created", Napi::Number::New(env, static_cast<double>(stats.created)));
+        counts.Set("disposed", Napi::Number::New(env, static_cast<double>(stats.disposed)));
+        counts.Set("collected", Napi::Number::New(env, static_cast<double>(stats.collected)));
+        counts.Set("released", Napi::Number::New(env, static_cast<double>(stats.released)));
+        counts.Set("failed", Napi::Number::New(env, static_cast<double>(stats.failed)));
+        counts.Set("orphaned", Napi::Number::New(env, static_cast<double>(stats.orphaned)));
+
+        result.Set(std::string(kind.name), counts);
+      }
+
+      return result;
+    }
+
+  private:
+    struct Instance {
+      void *handle = nullptr;
+      size_t kind = 0;
+      const void *key = nullptr;
+      const void *baseKey = nullptr;
+      BOOL (*destroy)(void *) = nullptr;
+      std::string_view type;
+    };
+
+    // Only the address matters; it identifies T within this module without RTTI.
+    template <typename T> static inline const char KindKey = 0;
+
+    template <typename T> [[nodiscard]] static bool Accepts(const Instance &instance) {
+      return instance.key == &KindKey<T> || instance.baseKey == &KindKey<T>;
+    }
+
+    struct Kind {
+      const void *key;
+      std::string_view name;
+      Stats stats;
+    };
+
+    // Owned by the env through qb::InstanceData. Handles collected while the env is running are destroyed from a
+    // thread-safe function call, which runs on the env's thread once the current GC pass and its finalizers are done.
+    class Registry {
+    public:
+      std::vector<Kind> kinds;
+
+      // Every instance still owning a handle, by that handle, so Orphan can find the owners of a destroyed one.
+      std::unordered_multimap<void *, Instance *> owned;
+
+      explicit Registry(Napi::Env env) {
+        napi_value name = nullptr;
+        napi_create_string_utf8(env, "OwnedHandle", NAPI_AUTO_LENGTH, &name);
+
+        napi_create_threadsafe_function(
+            env,
+            nullptr,
+            nullptr,
+            name,
+            0,
+            1,
+            nullptr,
+            nullptr,
+            this,
+            [](napi_env callEnv, napi_value, void *context, void *) {
+              if (callEnv != nullptr) {
+                static_cast<Registry *>(context)->Drain();
+              }
+            },
+            &this->drain);
+
+        // Queued handles must not keep the event loop alive.
+        if (this->drain != nullptr) {
+          napi_unref_threadsafe_function(env, this->drain);
+        }
+
+        // Anything still queued at shutdown is destroyed before the env goes away, and anything collected after this
+        // point is destroyed straight from its finalizer.
+        env.AddCleanupHook([this]() {
+          this->closing = true;
+          this->Drain();
+
+          if (this->drain != nullptr) {
+            napi_release_threadsafe_function(this->drain, napi_tsfn_abort);
+            this->drain = nullptr;
+          }
+        });
+      }
+
+      Registry(const Registry &) = delete;
+      Registry &operator=(const Registry &) = delete;
+
+      template <typename T> size_t KindOf() {
+        for (size_t i = 0; i < this->kinds.size(); i++) {
+          if (this->kinds[i].key == &KindKey<T>) {
+            return i;
+          }
+        }
+
+        this->kinds.push_back({&KindKey<T>, HandleTraits<T>::NAME, {}});
+
+        return this->kinds.size() - 1;
+      }
+
+      [[nodiscard]] Napi::Function Constructor(const Napi::Env env) {
+        if (!this->constructor.IsEmpty()) {
+          return this->constructor.Value();
+        }
+
+        std::vector<napi_property_descriptor> descriptors = {
+            {"value", nullptr, nullptr, GetValue, nullptr, nullptr, napi_enumerable, nullptr},
+            {"type", nullptr, nullptr, GetType, nullptr, nullptr, napi_enumerable, nullptr},
+            {"dispose", nullptr, DisposeMethod, nullptr, nullptr, nullptr, napi_default, nullptr},
+            {"release", nullptr, ReleaseMethod, nullptr, nullptr, nullptr, napi_default, nullptr},
+        };
+
+        // Symbol.dispose only exists on runtimes with explicit resource management.
+        const Napi::Value dispose = env.Global().Get("Symbol").As<Napi::Object>().Get("dispose");
+
+        if (dispose.IsSymbol()) {
+          descriptors.push_back({nullptr, dispose, DisposeMethod, nullptr, nullptr, nullptr, napi_default, nullptr});
+        }
+
+        napi_value value = nullptr;
+        napi_define_class(
+            env, "OwnedHandle", NAPI_AUTO_LENGTH, New, nullptr, descriptors.size(), descriptors.data(), &value);
+
+        this->constructor = Napi::Persistent(Napi::Function(env, value));
+
+        return this->constructor.Value();
+      }
+
+      BOOL Dispose(Instance &instance) {
+        this->Forget(instance);
+
+        return this->Destroy(std::exchange(instance.handle, nullptr), instance, &Stats::disposed);
+      }
+
+      void Release(Instance &instance) {
+        this->Forget(instance);
+
+        if (std::exchange(instance.handle, nullptr) != nullptr) {
+          this->kinds[instance.kind].stats.released++;
+        }
+      }
+
+      void Orphan(void *handle, const void *key) {
+        for (auto [owner, end] = this->owned.equal_range(handle); owner != end;) {
+          if (owner->second->key == key) {
+            this->kinds[owner->second->kind].stats.orphaned++;
+            owner->second->handle = nullptr;
+            owner = this->owned.erase(owner);
+          } else {
+            ++owner;
+          }
+        }
+
+        // Collected owners waiting for the next drain.
+        for (Instance &instance : this->pending) {
+          if (instance.handle == handle && instance.key == key) {
+            this->kinds[instance.kind].stats.orphaned++;
+            instance.handle = nullptr;
+          }
+        }
+      }
+
+      void Collect(const Instance &instance) {
+        this->Forget(instance);
+
+        if (this->closing || this->drain == nullptr) {
+          this->Destroy(instance.handle, instance, &Stats::collected);
+          return;
+        }
+
+        this->pending.push_back(instance);
+
+        if (this->pending.size() == 1) {
+          napi_call_threadsafe_function(this->drain, nullptr, napi_tsfn_nonblocking);
+        }
+      }
+
+    private:
+      Napi::FunctionReference constructor;
+      std::vector<Instance> pending;
+      napi_threadsafe_function drain = nullptr;
+      bool closing = false;
+
+      void Forget(const Instance &instance) {
+        for (auto [owner, end] = this->owned.equal_range(instance.handle); owner != end; ++owner) {
+          if (owner->second == &instance) {
+            this->owned.erase(owner);
+            return;
+          }
+        }
+      }
+
+      BOOL Destroy(void *handle, const Instance &instance, uint64_t Stats::*counter) {
+        if (handle == nullptr) {
+          return FALSE;
+        }
+
+        Stats &stats = this->kinds[instance.kind].stats;
+        const BOOL result = instance.destroy(handle);
+
+        if (result) {
+          stats.*counter += 1;
+        } else {
+          stats.failed++;
+        }
+
+        return result;
+      }
+
+      void Drain() {
+        // DestroyWindow calls back into the WndProc, which may collect or dispose more handles while this runs.
+        const std::vector<Instance> batch = std::exchange(this->pending, {});
+
+        for (const Instance &instance : batch) {
+          this->Destroy(instance.handle, instance, &Stats::collected);
+        }
+      }
+    };
+
+    // Only the address matters; it makes the type tag unique to this module.
+    static inline const char tagAnchor = 0;
+    static inline const napi_type_tag TAG = {static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&tagAnchor)),
+                                             0x716248616e646c65}; // "qbHandle"
+
+    template <typename T> static BOOL DestroyHandle(void *handle) {
+      return HandleTraits<T>::Destroy(static_cast<T>(handle));
+    }
+
+    static Instance *Find(const Napi::Value &value) {
+      if (!value.IsObject()) {
+        return nullptr;
+      }
+
+      bool tagged = false;
+
+      if (napi_check_object_type_tag(value.Env(), value, &TAG, &tagged) != napi_ok || !tagged) {
+        return nullptr;
+      }
+
+      void *instance = nullptr;
+      napi_unwrap(value.Env(), value, &instance);
+
+      return static_cast<Instance *>(instance);
+    }
+
+    static Instance *This(const napi_env env, const napi_callback_info cbinfo) {
+      napi_value self = nullptr;
+      napi_get_cb_info(env, cbinfo, nullptr, nullptr, &self, nullptr);
+
+      Instance *instance = Find(Napi::Value(env, self));
+
+      if (instance == nullptr) {
+        Napi::TypeError::New(env, "Illegal invocation").ThrowAsJavaScriptException();
+      }
+
+      return instance;
+    }
+
+    static napi_value New(napi_env env, napi_callback_info cbinfo) {
+      napi_value self = nullptr;
+      napi_get_cb_info(env, cbinfo, nullptr, nullptr, &self, nullptr);
+
+      napi_wrap(
+          env,
+          self,
+          new Instance(),
+          [](auto, void *data, void *) {
+            Instance *finalized = static_cast<Instance *>(data);
+
+            if (finalized->handle != nullptr) {
+              // The registry is gone once the env has been torn down; the handle is still destroyed, just not counted.
+              if (Registry *registry = qb::InstanceData::Find<Registry>()) {
+                registry->Collect(*finalized);
+              } else {
+                finalized->destroy(finalized->handle);
+              }
+            }
+
+            delete finalized;
+          },
+          nullptr,
+          nullptr);
+      napi_type_tag_object(env, self, &TAG);
+
+      return self;
+    }
+
+    static napi_value GetValue(napi_env env, napi_callback_info cbinfo) {
+      const Instance *instance = This(env, cbinfo);
+
+      if (instance == nullptr) {
+        return nullptr;
+      }
+
+      return Napi::BigInt::New(env, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(instance->handle)));
+    }
+
+    static napi_value GetType(napi_env env, napi_callback_info cbinfo) {
+      const Instance *instance = This(env, cbinfo);
+
+      if (instance == nullptr) {
+        return nullptr;
+      }
+
+      return Napi::String::New(env, instance->type.data(), instance->type.size());
+    }
+
+    static napi_value DisposeMethod(napi_env env, napi_callback_info cbinfo) {
+      Instance *instance = This(env, cbinfo);
+
+      if (instance == nullptr) {
+        return nullptr;
+      }
+
+      const BOOL result = qb::InstanceData::Get<Registry>(env).Dispose(*instance);
+
+      return Napi::Boolean::New(env, result);
+    }
+
+    static napi_value ReleaseMethod(napi_env env, napi_callback_info cbinfo) {
+      Instance *instance = This(env, cbinfo);
+
+      if (instance == nullptr) {
+        return nullptr;
+      }
+
+      const void *handle = instance->handle;
+
+      qb::InstanceData::Get<Registry>(env).Release(*instance);
+
+      return Napi::BigInt::New(env, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle)));
+    }
+  };
+
+  /**** Handle types *************************************************************************************************/
+
+  template <> struct HandleTraits<HWND> {
+    static constexpr std::string_view NAME = "HWND";
+    static BOOL Destroy(const HWND handle) { return ::DestroyWindow(handle); }
+  };
+
+  template <> struct HandleTraits<HMENU> {
+    static constexpr std::string_view NAME = "HMENU";
+    static BOOL Destroy(const HMENU handle) { return ::DestroyMenu(handle); }
+  };
+
+  template <> struct HandleTraits<HBRUSH> {
+    using Base = HGDIOBJ;
+    static constexpr std::string_view NAME = "HBRUSH";
+    static BOOL Destroy(const HBRUSH handle) { return ::DeleteObject(handle); }
+  };
+
+  template <> struct HandleTraits<HFONT> {
+    using Base = HGDIOBJ;
+    static constexpr std::string_view NAME = "HFONT";
+    static BOOL Destroy(const HFONT handle) { return ::DeleteObject(handle); }
+  };
+
+  template <> struct HandleTraits<HPEN> {
+    using Base = HGDIOBJ;
+    static constexpr std::string_view NAME = "HPEN";
+    static BOOL Destroy(const HPEN handle) { return ::DeleteObject(handle); }
+  };
+
+  template <> struct HandleTraits<HBITMAP> {
+    using Base = HGDIOBJ;
+    static constexpr std::string_view NAME = "HBITMAP";
+    static BOOL Destroy(const HBITMAP handle) { return ::DeleteObject(handle); }
+  };
+
+  template <> struct HandleTraits<HRGN> {
+    using Base = HGDIOBJ;
+    static constexpr std::string_view NAME = "HRGN";
+    static BOOL Destroy(const HRGN handle) { return ::DeleteObject(handle); }
+  };
+} // namespace qb
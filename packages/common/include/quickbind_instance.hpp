@@ -0,0 +1,118 @@
+/**
+ * QuickBind Instance Data
+ *
+ * Per-environment state for bindings. The main thread and every worker_threads Worker that loads an addon get their
+ * own napi_env, and anything holding JS values (callbacks, references, pinned buffers) has to belong to exactly one of
+ * them and be released while that env is shutting down, not whenever the thread or process happens to exit. State is
+ * declared as a plain default-constructible struct and fetched by type:
+ *
+ *   struct WindowState {
+ *     std::unique_ptr<CallbackHandler<Napi::Value>> wndProc;
+ *   };
+ *
+ *   WindowState &state = qb::InstanceData::Get<WindowState>(env);
+ *
+ * Each struct is created the first time it is asked for in an env and destroyed, in reverse order of creation, when
+ * the env is torn down. A struct with a `T(Napi::Env)` constructor is given the env, for instance to add a cleanup hook
+ * that has to run before the env stops accepting calls.
+ *
+ * Win32 callbacks (WndProc, MsgBoxCallback) arrive without an env. An env only ever runs on the thread that created
+ * it, so InstanceData::Find returns the state of the env running on the calling thread without needing one.
+ *
+ * Copyright (c) 2025-present, Kasim Ahmic. (https://kasimahmic.com)
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+#include <napi.h>
+
+namespace qb {
+  class InstanceData {
+  public:
+    InstanceData(const InstanceData &) = delete;
+    InstanceData &operator=(const InstanceData &) = delete;
+
+    /**
+     * The env's T, created on first use.
+     */
+    template <typename T> [[nodiscard]] static T &Get(const Napi::Env env) {
+      InstanceData &data = Current(env);
+
+      for (const Entry &entry : data.entries) {
+        if (entry.key == &Key<T>) {
+          return *static_cast<T *>(entry.value);
+        }
+      }
+
+      T *value = nullptr;
+
+      if constexpr (std::is_constructible_v<T, Napi::Env>) {
+        value = new T(env);
+      } else {
+        value = new T();
+      }
+
+      data.entries.push_back({&Key<T>, value, [](void *destroyed) {
+                                if (threadValue<T> == destroyed) {
+                                  threadValue<T> = nullptr;
+                                }
+
+                                delete static_cast<T *>(destroyed);
+                              }});
+      threadValue<T> = value;
+
+      return *value;
+    }
+
+    /**
+     * The T of the env running on the calling thread, or nullptr if it hasn't been created or its env has already been
+     * torn down.
+     */
+    template <typename T> [[nodiscard]] static T *Find() { return threadValue<T>; }
+
+  private:
+    struct Entry {
+      const void *key;
+      void *value;
+      void (*destroy)(void *);
+    };
+
+    // Only the address matters; it identifies T within this module without RTTI.
+    template <typename T> static inline const char Key = 0;
+
+    template <typename T> static inline thread_local T *threadValue = nullptr;
+
+    std::vector<Entry> entries;
+
+    InstanceData() = default;
+
+    ~InstanceData() {
+      for (auto entry = this->entries.rbegin(); entry != this->entries.rend(); ++entry) {
+        entry->destroy(entry->value);
+      }
+    }
+
+    static InstanceData &Current(const Napi::Env env) {
+      void *data = nullptr;
+      napi_get_instance_data(env, &data);
+
+      if (data == nullptr) {
+        data = new InstanceData();
+
+        napi_set_instance_data(
+            env,
+            data,
+            [](auto, void *finalized, void *) { delete static_cast<InstanceData *>(finalized); },
+            nullptr);
+      }
+
+      return *static_cast<InstanceData *>(data);
+    }
+  };
+} // namespace qb
@@ -0,0 +1,318 @@
+/**
+ * QuickBind Stats
+ *
+ * Opt-in per-export instrumentation for QuickBind. When QB_ENABLE_STATS is defined, every function in a QB_EXPORT
+ * table is wrapped so that each call records its call count, total native time, the time spent reading arguments
+ * (up to the last QB_ARG) versus the rest of the call, and a log-linear latency histogram. Counters live per thread and
+ * are only summed when read through the `__qbStats` export, so the hot path never takes a lock.
+ *
+ * Without QB_ENABLE_STATS this header is never included and QB_EXPORT/QB_ARG carry no instrumentation at all.
+ *
+ * Copyright (c) 2025-present, Kasim Ahmic. (https://kasimahmic.com)
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include <napi.h>
+
+#include "quickbind_arena.hpp"
+
+namespace qb::stats {
+  /**
+   * Latency buckets per export. The first 8 buckets are exact nanosecond values, after which every power of two is
+   * split into 4 linear sub-buckets, giving at most 25% relative error up to ~8.6 seconds.
+   */
+  inline constexpr size_t HISTOGRAM_BUCKETS = 128;
+
+  inline constexpr size_t NO_SLOT = SIZE_MAX;
+
+  namespace detail {
+    struct Counter {
+      std::atomic<uint64_t> calls{0};
+      std::atomic<uint64_t> totalNs{0};
+      std::atomic<uint64_t> marshalNs{0};
+      std::atomic<uint64_t> callNs{0};
+      std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKETS> histogram{};
+    };
+
+    struct Totals {
+      uint64_t calls = 0;
+      uint64_t totalNs = 0;
+      uint64_t marshalNs = 0;
+      uint64_t callNs = 0;
+      std::array<uint64_t, HISTOGRAM_BUCKETS> histogram{};
+    };
+
+    struct ThreadCounters;
+
+    struct Registry {
+      std::mutex mutex;
+      std::vector<std::string_view> names;
+      std::vector<ThreadCounters *> threads;
+      // Counts from threads that have already exited, so their calls don't vanish from the snapshot.
+      std::vector<Totals> retired;
+    };
+
+    inline Registry &GetRegistry() {
+      static Registry registry;
+      return registry;
+    }
+
+    inline uint64_t Now() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+    }
+
+    [[nodiscard]] inline constexpr size_t BucketOf(const uint64_t ns) {
+      if (ns < 8) {
+        return static_cast<size_t>(ns);
+      }
+
+      const size_t exponent = std::bit_width(ns) - 1;
+      const size_t subBucket = (ns >> (exponent - 2)) & 3;
+
+      return std::min<size_t>(8 + (exponent - 3) * 4 + subBucket, HISTOGRAM_BUCKETS - 1);
+    }
+
+    [[nodiscard]] inline constexpr uint64_t BucketLowerBound(const size_t bucket) {
+      if (bucket < 8) {
+        return bucket;
+      }
+
+      const size_t exponent = 3 + (bucket - 8) / 4;
+      const size_t subBucket = (bucket - 8) % 4;
+
+      return (uint64_t{4} + subBucket) << (exponent - 2);
+    }
+
+    /**
+     * Only the owning thread ever writes to its counters, so a relaxed load/store pair is enough and avoids paying for
+     * a locked add on every call. Readers may observe a slightly stale value, which is fine for statistics.
+     */
+    inline void Bump(std::atomic<uint64_t> &counter, const uint64_t amount) {
+      counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    struct ThreadCounters {
+      std::unique_ptr<Counter[]> counters;
+      size_t size = 0;
+      uint64_t mark = 0;
+
+      ThreadCounters() {
+        Registry &registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        this->size = registry.names.size();
+        this->counters = std::make_unique<Counter[]>(this->size);
+        registry.threads.push_back(this);
+      }
+
+      ~ThreadCounters() {
+        Registry &registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        for (size_t i = 0; i < this->size; i++) {
+          Totals &totals = registry.retired[i];
+          const Counter &counter = this->counters[i];
+
+          totals.calls += counter.calls.load(std::memory_order_relaxed);
+          totals.totalNs += counter.totalNs.load(std::memory_order_relaxed);
+          totals.marshalNs += counter.marshalNs.load(std::memory_order_relaxed);
+          totals.callNs += counter.callNs.load(std::memory_order_relaxed);
+
+          for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+            totals.histogram[bucket] += counter.histogram[bucket].load(std::memory_order_relaxed);
+          }
+        }
+
+        std::erase(registry.threads, this);
+      }
+
+      ThreadCounters(const ThreadCounters &) = delete;
+      ThreadCounters &operator=(const ThreadCounters &) = delete;
+
+      /**
+       * Makes room for every export registered so far. A thread sizes its counters on its first call, so exports of
+       * an addon loaded after that, e.g. a second package or a worker's own copy, only fit once they are grown. Only
+       * the owning thread writes its counters, and Snapshot only reads them with the registry locked, so swapping the
+       * array under that lock is safe.
+       */
+      void Grow() {
+        Registry &registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        const size_t grown = registry.names.size();
+        std::unique_ptr<Counter[]> counters = std::make_unique<Counter[]>(grown);
+
+        for (size_t i = 0; i < this->size; i++) {
+          const Counter &from = this->counters[i];
+          Counter &to = counters[i];
+
+          to.calls.store(from.calls.load(std::memory_order_relaxed), std::memory_order_relaxed);
+          to.totalNs.store(from.totalNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+          to.marshalNs.store(from.marshalNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+          to.callNs.store(from.callNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+          for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+            to.histogram[bucket].store(from.histogram[bucket].load(std::memory_order_relaxed),
+                                       std::memory_order_relaxed);
+          }
+        }
+
+        this->counters = std::move(counters);
+        this->size = grown;
+      }
+    };
+
+    inline ThreadCounters &GetThreadCounters() {
+      thread_local ThreadCounters counters;
+      return counters;
+    }
+  } // namespace detail
+
+  template <auto Function> inline size_t slot = NO_SLOT;
+
+  /**
+   * Assigns an export its counter slot. Called by qb::DefineExports while the module initializes, which is always
+   * before the first call to the export. Threads that sized their counters before it registered grow them on the
+   * export's first call.
+   */
+  inline void Register(size_t &slot, const std::string_view name) {
+    detail::Registry &registry = detail::GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    if (slot == NO_SLOT) {
+      registry.names.push_back(name);
+      registry.retired.emplace_back();
+      slot = registry.names.size() - 1;
+    }
+  }
+
+  /**
+   * Records the end of argument marshalling for the binding currently running on this thread. Emitted by QB_ARG, so
+   * the last argument read marks the split between marshalling time and Win32 call time.
+   */
+  inline void Mark() { detail::GetThreadCounters().mark = detail::Now(); }
+
+  template <auto Function> Napi::Value Instrumented(const Napi::CallbackInfo &info) {
+    detail::ThreadCounters &thread = detail::GetThreadCounters();
+
+    // Bindings can re-enter each other (DispatchMessageW -> WndProc -> DefWindowProcW), so the caller's mark is saved
+    // and restored around this call.
+    const uint64_t outerMark = thread.mark;
+    const uint64_t start = detail::Now();
+
+    thread.mark = start;
+
+    Napi::Value result = Function(info);
+
+    const uint64_t end = detail::Now();
+    const size_t index = slot<Function>;
+
+    if (index != NO_SLOT && index >= thread.size) {
+      thread.Grow();
+    }
+
+    if (index < thread.size) {
+      detail::Counter &counter = thread.counters[index];
+      const uint64_t elapsed = end - start;
+
+      detail::Bump(counter.calls, 1);
+      detail::Bump(counter.totalNs, elapsed);
+      detail::Bump(counter.marshalNs, thread.mark - start);
+      detail::Bump(counter.callNs, end - thread.mark);
+      detail::Bump(counter.histogram[detail::BucketOf(elapsed)], 1);
+    }
+
+    thread.mark = outerMark;
+
+    return result;
+  }
+
+  /**
+   * Implementation of the `__qbStats()` export. Returns every export's counters summed across all threads, as
+   * parallel arrays indexed by the position of the export in `names`. `histogram` holds HISTOGRAM_BUCKETS counts per
+   * export, with bucket `b` of export `i` at `histogram[i * buckets + b]` and a lower bound of
+   * `bucketLowerBoundNs[b]`. `arenaHighWaterMark` is the most memory the calling thread's CallArena ever had in use.
+   */
+  inline Napi::Value Snapshot(const Napi::CallbackInfo &info) {
+    const Napi::Env env = info.Env();
+
+    detail::Registry &registry = detail::GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    const size_t count = registry.names.size();
+
+    std::vector<detail::Totals> totals = registry.retired;
+
+    for (const detail::ThreadCounters *thread : registry.threads) {
+      for (size_t i = 0; i < thread->size; i++) {
+        const detail::Counter &counter = thread->counters[i];
+
+        totals[i].calls += counter.calls.load(std::memory_order_relaxed);
+        totals[i].totalNs += counter.totalNs.load(std::memory_order_relaxed);
+        totals[i].marshalNs += counter.marshalNs.load(std::memory_order_relaxed);
+        totals[i].callNs += counter.callNs.load(std::memory_order_relaxed);
+
+        for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+          totals[i].histogram[bucket] += counter.histogram[bucket].load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    Napi::Array names = Napi::Array::New(env, count);
+    Napi::Float64Array calls = Napi::Float64Array::New(env, count, napi_float64_array);
+    Napi::Float64Array totalNs = Napi::Float64Array::New(env, count, napi_float64_array);
+    Napi::Float64Array marshalNs = Napi::Float64Array::New(env, count, napi_float64_array);
+    Napi::Float64Array callNs = Napi::Float64Array::New(env, count, napi_float64_array);
+    Napi::Float64Array histogram = Napi::Float64Array::New(env, count * HISTOGRAM_BUCKETS, napi_float64_array);
+    Napi::Float64Array bucketLowerBoundNs = Napi::Float64Array::New(env, HISTOGRAM_BUCKETS, napi_float64_array);
+
+    for (size_t i = 0; i < count; i++) {
+      names.Set(static_cast<uint32_t>(i), Napi::String::New(env, registry.names[i].data(), registry.names[i].size()));
+
+      calls[i] = static_cast<double>(totals[i].calls);
+      totalNs[i] = static_cast<double>(totals[i].totalNs);
+      marshalNs[i] = static_cast<double>(totals[i].marshalNs);
+      callNs[i] = static_cast<double>(totals[i].callNs);
+
+      for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        histogram[i * HISTOGRAM_BUCKETS + bucket] = static_cast<double>(totals[i].histogram[bucket]);
+      }
+    }
+
+    for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+      bucketLowerBoundNs[bucket] = static_cast<double>(detail::BucketLowerBound(bucket));
+    }
+
+    Napi::Object snapshot = Napi::Object::New(env);
+    snapshot.Set("names", names);
+    snapshot.Set("calls", calls);
+    snapshot.Set("totalNs", totalNs);
+    snapshot.Set("marshalNs", marshalNs);
+    snapshot.Set("callNs", callNs);
+    snapshot.Set("buckets", Napi::Number::New(env, HISTOGRAM_BUCKETS));
+    snapshot.Set("histogram", histogram);
+    snapshot.Set("bucketLowerBoundNs", bucketLowerBoundNs);
+    // The call arena is per thread, so this is the high-water mark of the thread the snapshot is taken on.
+    snapshot.Set("arenaHighWaterMark",
+                 Napi::Number::New(env, static_cast<double>(qb::CallArena::Current().HighWaterMark())));
+
+    return snapshot;
+  }
+} // namespace qb::stats
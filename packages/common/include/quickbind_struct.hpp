@@ -0,0 +1,407 @@
+/**
+ * QuickBind Native Structs
+ *
+ * JS classes backed directly by a Win32 struct. An object created with `new MSG()` owns a native MSG and its
+ * properties are accessors that read and write that MSG in place, so a binding handed one can pass the struct pointer
+ * straight to the API instead of reading and validating every property again:
+ *
+ *   if (MSG *msg = qb::NativeStruct<MSG>::Unwrap(lpMsg)) {
+ *     return Napi::Boolean::New(env, ::TranslateMessage(msg));
+ *   }
+ *
+ * Bindings keep reading plain objects property by property when Unwrap returns nullptr, so both work everywhere.
+ * Nested structs (MSG.pt, PAINTSTRUCT.rcPaint) are returned as views into their parent's memory that keep the parent
+ * alive. A struct is made available by specializing qb::StructLayout with the fields it exposes to JS.
+ *
+ * Copyright (c) 2025-present, Kasim Ahmic. (https://kasimahmic.com)
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+
+#include <napi.h>
+#include <windows.h>
+
+#include "quickbind.hpp"
+#include "quickbind_instance.hpp"
+
+namespace qb {
+  /**
+   * Specialized for every struct that can be wrapped, with the class name and a tuple of qb::Field.
+   */
+  template <typename T> struct StructLayout;
+
+  template <auto Member, typename Codec> struct Field {
+    const char *name;
+  };
+
+  template <typename T> class NativeStruct;
+
+  /**
+   * How a field is converted to and from JS. Conversions match what the bindings use for the same field of a plain
+   * object, so a wrapped struct and a plain object read the same from JS.
+   */
+  namespace codec {
+    struct Int32 {
+      template <typename F> static Napi::Value ToJs(const Napi::Env env, const Napi::Object &, const F &field) {
+        return Napi::Number::New(env, static_cast<int32_t>(field));
+      }
+
+      template <typename F>
+      static void FromJs(const Napi::Value &value, const qb::detail::Location &location, F &field) {
+        if (const std::optional<int32_t> int32Value = qb::detail::ReadInt32(value, location, true)) {
+          field = static_cast<F>(int32Value.value());
+        }
+      }
+    };
+
+    struct Uint32 {
+      template <typename F> static Napi::Value ToJs(const Napi::Env env, const Napi::Object &, const F &field) {
+        return Napi::Number::New(env, static_cast<uint32_t>(field));
+      }
+
+      template <typename F>
+      static void FromJs(const Napi::Value &value, const qb::detail::Location &location, F &field) {
+        if (const std::optional<uint32_t> uint32Value = qb::detail::ReadUint32(value, location, true)) {
+          field = static_cast<F>(uint32Value.value());
+        }
+      }
+    };
+
+    struct Boolean {
+      template <typename F> static Napi::Value ToJs(const Napi::Env env, const Napi::Object &, const F &field) {
+        return Napi::Boolean::New(env, field != 0);
+      }
+
+      template <typename F>
+      static void FromJs(const Napi::Value &value, const qb::detail::Location &location, F &field) {
+        if (const std::optional<bool> booleanValue = qb::detail::ReadBoolean(value, location, true)) {
+          field = static_cast<F>(booleanValue.value());
+        }
+      }
+    };
+
+    struct Uint64 {
+      template <typename F> static Napi::Value ToJs(const Napi::Env env, const Napi::Object &, const F &field) {
+        return Napi::BigInt::New(env, static_cast<uint64_t>(field));
+      }
+
+      template <typename F>
+      static void FromJs(const Napi::Value &value, const qb::detail::Location &location, F &field) {
+        if (const std::optional<uint64_t> uint64Value = qb::detail::ReadUint64(value, location, true)) {
+          field = static_cast<F>(uint64Value.value());
+        }
+      }
+    };
+
+    struct Int64 {
+      template <typename F> static Napi::Value ToJs(const Napi::Env env, const Napi::Object &, const F &field) {
+        return Napi::BigInt::New(env, static_cast<int64_t>(field));
+      }
+
+      template <typename F>
+      static void FromJs(const Napi::Value &value, const qb::detail::Location &location, F &field) {
+        if (const std::optional<int64_t> int64Value = qb::detail::ReadInt64(value, location, true)) {
+          field = static_cast<F>(int64Value.value());
+        }
+      }
+    };
+
+    /**
+     * Pointer-sized fields such as WPARAM and LPARAM. Read back as BigInts; assigning also takes a safe integer Number.
+     */
+    struct UintPtr : Uint64 {
+      template <typename F>
+      static void FromJs(const Napi::Value &value, const qb::detail::Location &location, F &field) {
+        const std::optional<uintptr_t> uintPtrValue = qb::detail::ReadPointerSized<uintptr_t>(value, location, true);
+
+        if (uintPtrValue.has_value()) {
+          field = static_cast<F>(uintPtrValue.value());
+        }
+      }
+    };
+
+    struct IntPtr : Int64 {
+      template <typename F>
+      static void FromJs(const Napi::Value &value, const qb::detail::Location &location, F &field) {
+        const std::optional<intptr_t> intPtrValue = qb::detail::ReadPointerSized<intptr_t>(value, location, true);
+
+        if (intPtrValue.has_value()) {
+          field = static_cast<F>(intPtrValue.value());
+        }
+      }
+    };
+
+    struct Handle {
+      template <qb::WinHandle F>
+      static Napi::Value ToJs(const Napi::Env env, const Napi::Object &, const F &field) {
+        return Napi::BigInt::New(env, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(field)));
+      }
+
+      template <qb::WinHandle F>
+      static void FromJs(const Napi::Value &value, const qb::detail::Location &location, F &field) {
+        if (const std::optional<F> handleValue = qb::detail::ReadHandle<F>(value, location, true)) {
+          field = handleValue.value();
+        }
+      }
+    };
+
+    /**
+     * A nested struct. Reading it returns a view into the parent; assigning copies from a wrapped struct or a plain
+     * object.
+     */
+    template <typename U> struct Struct {
+      static Napi::Value ToJs(const Napi::Env env, const Napi::Object &self, U &field) {
+        return qb::NativeStruct<U>::View(env, self, &field);
+      }
+
+      static void FromJs(const Napi::Value &value, const qb::detail::Location &location, U &field) {
+        qb::NativeStruct<U>::Assign(value, location, field);
+      }
+    };
+  } // namespace codec
+
+  template <typename T> class NativeStruct {
+  public:
+    /**
+     * The struct's JS class, created the first time it is asked for in `env`.
+     */
+    [[nodiscard]] static Napi::Function Constructor(const Napi::Env env) {
+      Napi::FunctionReference &constructor = qb::InstanceData::Get<Class>(env).constructor;
+
+      if (!constructor.IsEmpty()) {
+        return constructor.Value();
+      }
+
+      napi_value value = nullptr;
+
+      const auto descriptors = std::apply(
+          [](const auto &...fields) {
+            return std::array<napi_property_descriptor, sizeof...(fields)>{Describe(fields)...};
+          },
+          StructLayout<T>::FIELDS);
+
+      constexpr std::string_view name = StructLayout<T>::NAME;
+
+      napi_define_class(env, name.data(), name.size(), New, nullptr, descriptors.size(), descriptors.data(), &value);
+      constructor = Napi::Persistent(Napi::Function(env, value));
+
+      return constructor.Value();
+    }
+
+    /**
+     * The struct behind `value` if it is one of this class's objects, nullptr for anything else, including plain
+     * objects with the same properties.
+     */
+    [[nodiscard]] static T *Unwrap(const Napi::Value &value) {
+      if (!value.IsObject()) {
+        return nullptr;
+      }
+
+      bool tagged = false;
+
+      if (napi_check_object_type_tag(value.Env(), value, &TAG, &tagged) != napi_ok || !tagged) {
+        return nullptr;
+      }
+
+      void *instance = nullptr;
+      napi_unwrap(value.Env(), value, &instance);
+
+      return static_cast<Instance *>(instance)->target;
+    }
+
+    /**
+     * Copies `value` into `target`, straight from the struct if it is wrapped and property by property otherwise.
+     * Throws and sets qb::detail::readFailed like the readers when a property is missing or has the wrong type.
+     */
+    static void Assign(const Napi::Value &value, const qb::detail::Location &location, T &target) {
+      if (const T *source = Unwrap(value)) {
+        target = *source;
+        return;
+      }
+
+      const std::optional<Napi::Object> object = qb::detail::ReadObject(value, location, true);
+
+      if (!object.has_value()) {
+        return;
+      }
+
+      std::apply([&](const auto &...fields) { (AssignField(object.value(), fields, target), ...); },
+                 StructLayout<T>::FIELDS);
+    }
+
+    /**
+     * An object of this class that reads and writes `target`, which lives inside the struct wrapped by `owner`.
+     */
+    [[nodiscard]] static Napi::Object View(const Napi::Env env, const Napi::Object &owner, T *target) {
+      napi_value view = nullptr;
+      napi_new_instance(env, Constructor(env), 0, nullptr, &view);
+
+      void *data = nullptr;
+      napi_unwrap(env, view, &data);
+
+      Instance *instance = static_cast<Instance *>(data);
+      instance->target = target;
+      napi_create_reference(env, owner, 1, &instance->owner);
+
+      return Napi::Object(env, view);
+    }
+
+  private:
+    struct Instance {
+      T value{};
+      T *target = &this->value;
+      // Set for views, keeping the object whose struct `target` points into alive.
+      napi_ref owner = nullptr;
+    };
+
+    // Only the address matters; it makes the type tag unique to T within this module.
+    static inline const char tagAnchor = 0;
+    static inline const napi_type_tag TAG = {static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&tagAnchor)),
+                                             0x7162537472756374}; // "qbStruct"
+
+    // Classes can't be shared between envs, so every env that loads the addon defines its own.
+    struct Class {
+      Napi::FunctionReference constructor;
+    };
+
+    static napi_value New(napi_env env, napi_callback_info cbinfo) {
+      napi_value self = nullptr;
+      napi_get_cb_info(env, cbinfo, nullptr, nullptr, &self, nullptr);
+
+      Instance *instance = new Instance();
+
+      napi_wrap(
+          env,
+          self,
+          instance,
+          [](auto finalizeEnv, void *data, void *) {
+            Instance *finalized = static_cast<Instance *>(data);
+
+            if (finalized->owner != nullptr) {
+              napi_delete_reference(finalizeEnv, finalized->owner);
+            }
+
+            delete finalized;
+          },
+          nullptr,
+          nullptr);
+      napi_type_tag_object(env, self, &TAG);
+
+      return self;
+    }
+
+    template <auto Member, typename Codec>
+    static napi_property_descriptor Describe(const qb::Field<Member, Codec> &field) {
+      return {
+          field.name,
+          nullptr,
+          nullptr,
+          Get<Member, Codec>,
+          Set<Member, Codec>,
+          nullptr,
+          napi_enumerable,
+          const_cast<char *>(field.name),
+      };
+    }
+
+    template <auto Member, typename Codec>
+    static void AssignField(const Napi::Object &object, const qb::Field<Member, Codec> &field, T &target) {
+      Codec::FromJs(object.Get(field.name), qb::detail::Property(field.name), target.*Member);
+    }
+
+    static T *This(const Napi::Env env, const napi_value self) {
+      T *target = Unwrap(Napi::Value(env, self));
+
+      if (target == nullptr) {
+        Napi::TypeError::New(env, "Illegal invocation").ThrowAsJavaScriptException();
+      }
+
+      return target;
+    }
+
+    template <auto Member, typename Codec> static napi_value Get(napi_env env, napi_callback_info cbinfo) {
+      napi_value self = nullptr;
+      napi_get_cb_info(env, cbinfo, nullptr, nullptr, &self, nullptr);
+
+      T *target = This(env, self);
+
+      if (target == nullptr) {
+        return nullptr;
+      }
+
+      return Codec::ToJs(env, Napi::Object(env, self), target->*Member);
+    }
+
+    template <auto Member, typename Codec> static napi_value Set(napi_env env, napi_callback_info cbinfo) {
+      size_t argc = 1;
+      napi_value value = nullptr;
+      napi_value self = nullptr;
+      void *name = nullptr;
+      napi_get_cb_info(env, cbinfo, &argc, &value, &self, &name);
+
+      T *target = This(env, self);
+
+      if (target == nullptr) {
+        return nullptr;
+      }
+
+      Codec::FromJs(Napi::Value(env, value), qb::detail::Property(static_cast<const char *>(name)), target->*Member);
+
+      // A failed conversion has already thrown; only the flag is left to clear.
+      qb::detail::readFailed = false;
+
+      return nullptr;
+    }
+  };
+
+  /**** Layouts ******************************************************************************************************/
+
+  template <> struct StructLayout<POINT> {
+    static constexpr std::string_view NAME = "POINT";
+    static constexpr auto FIELDS = std::tuple{
+        qb::Field<&POINT::x, qb::codec::Int32>{"x"},
+        qb::Field<&POINT::y, qb::codec::Int32>{"y"},
+    };
+  };
+
+  template <> struct StructLayout<RECT> {
+    static constexpr std::string_view NAME = "RECT";
+    static constexpr auto FIELDS = std::tuple{
+        qb::Field<&RECT::left, qb::codec::Int32>{"left"},
+        qb::Field<&RECT::top, qb::codec::Int32>{"top"},
+        qb::Field<&RECT::right, qb::codec::Int32>{"right"},
+        qb::Field<&RECT::bottom, qb::codec::Int32>{"bottom"},
+    };
+  };
+
+  template <> struct StructLayout<MSG> {
+    static constexpr std::string_view NAME = "MSG";
+    static constexpr auto FIELDS = std::tuple{
+        qb::Field<&MSG::hwnd, qb::codec::Handle>{"hwnd"},
+        qb::Field<&MSG::message, qb::codec::Uint32>{"message"},
+        qb::Field<&MSG::wParam, qb::codec::UintPtr>{"wParam"},
+        qb::Field<&MSG::lParam, qb::codec::IntPtr>{"lParam"},
+        qb::Field<&MSG::time, qb::codec::Uint32>{"time"},
+        qb::Field<&MSG::pt, qb::codec::Struct<POINT>>{"pt"},
+    };
+  };
+
+  template <> struct StructLayout<PAINTSTRUCT> {
+    static constexpr std::string_view NAME = "PAINTSTRUCT";
+    static constexpr auto FIELDS = std::tuple{
+        qb::Field<&PAINTSTRUCT::hdc, qb::codec::Handle>{"hdc"},
+        qb::Field<&PAINTSTRUCT::fErase, qb::codec::Boolean>{"fErase"},
+        qb::Field<&PAINTSTRUCT::rcPaint, qb::codec::Struct<RECT>>{"rcPaint"},
+        qb::Field<&PAINTSTRUCT::fRestore, qb::codec::Boolean>{"fRestore"},
+        qb::Field<&PAINTSTRUCT::fIncUpdate, qb::codec::Boolean>{"fIncUpdate"},
+    };
+  };
+} // namespace qb
@@ -0,0 +1,2 @@
+// Compiled with /Yc to produce the precompiled header for libwin_pch.hpp; every other source uses it with /Yu.
+#include "libwin_pch.hpp"
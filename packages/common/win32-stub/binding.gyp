@@ -0,0 +1,32 @@
+{
+  "includes": [
+    "../../../common.gypi"
+  ],
+  "targets": [
+    {
+      "target_name": "win32_stub",
+      "sources": [
+        "src/control.cpp",
+        "src/directory_changes.cpp",
+        "src/file.cpp",
+        "src/gdi32.cpp",
+        "src/input.cpp",
+        "src/io_ring.cpp",
+        "src/kernel32.cpp",
+        "src/menu.cpp",
+        "src/message_box.cpp",
+        "src/window.cpp"
+      ],
+      "include_dirs": [
+        "<!(node -p \"require('node-addon-api').include\")"
+      ],
+      "dependencies": [
+        "<!(node -p \"require('node-addon-api').targets\"):node_addon_api"
+      ],
+      "libraries": [
+        "-ldl",
+        "-lpthread"
+      ]
+    }
+  ]
+}
@@ -0,0 +1,181 @@
+# This file is generated by gyp; do not edit.
+
+TOOLSET := target
+TARGET := win32_stub
+DEFS_Debug := \
+	'-DNODE_GYP_MODULE_NAME=win32_stub' \
+	'-DUSING_UV_SHARED=1' \
+	'-DUSING_V8_SHARED=1' \
+	'-DV8_DEPRECATION_WARNINGS=1' \
+	'-D_GLIBCXX_USE_CXX11_ABI=1' \
+	'-D_FILE_OFFSET_BITS=64' \
+	'-D_LARGEFILE_SOURCE' \
+	'-D__STDC_FORMAT_MACROS' \
+	'-DOPENSSL_NO_PINSHARED' \
+	'-DOPENSSL_THREADS' \
+	'-DBUILDING_NODE_EXTENSION' \
+	'-DDEBUG' \
+	'-D_DEBUG' \
+	'-DQB_CHECKED_NARROWING'
+
+# Flags passed to all source files.
+CFLAGS_Debug := \
+	-fno-exceptions \
+	-fPIC \
+	-pthread \
+	-Wall \
+	-Wextra \
+	-Wno-unused-parameter \
+	-m64 \
+	-g \
+	-O0
+
+# Flags passed to only C files.
+CFLAGS_C_Debug :=
+
+# Flags passed to only C++ files.
+CFLAGS_CC_Debug := \
+	-fno-exceptions \
+	-fno-rtti \
+	-fno-exceptions \
+	-fno-strict-aliasing \
+	-std=gnu++17 \
+	-std=c++20
+
+INCS_Debug := \
+	-I/root/.nvm/versions/node/v22.20.0/include/node \
+	-I/root/.nvm/versions/node/v22.20.0/src \
+	-I/root/.nvm/versions/node/v22.20.0/deps/openssl/config \
+	-I/root/.nvm/versions/node/v22.20.0/deps/openssl/openssl/include \
+	-I/root/.nvm/versions/node/v22.20.0/deps/uv/include \
+	-I/root/.nvm/versions/node/v22.20.0/deps/zlib \
+	-I/root/.nvm/versions/node/v22.20.0/deps/v8/include \
+	-I$(srcdir)/../../../packages/common/win32-stub/include \
+	-I/tmp/napi-rt
+
+DEFS_Release := \
+	'-DNODE_GYP_MODULE_NAME=win32_stub' \
+	'-DUSING_UV_SHARED=1' \
+	'-DUSING_V8_SHARED=1' \
+	'-DV8_DEPRECATION_WARNINGS=1' \
+	'-D_GLIBCXX_USE_CXX11_ABI=1' \
+	'-D_FILE_OFFSET_BITS=64' \
+	'-D_LARGEFILE_SOURCE' \
+	'-D__STDC_FORMAT_MACROS' \
+	'-DOPENSSL_NO_PINSHARED' \
+	'-DOPENSSL_THREADS' \
+	'-DBUILDING_NODE_EXTENSION'
+
+# Flags passed to all source files.
+CFLAGS_Release := \
+	-fno-exceptions \
+	-fPIC \
+	-pthread \
+	-Wall \
+	-Wextra \
+	-Wno-unused-parameter \
+	-m64 \
+	-O3 \
+	-fno-omit-frame-pointer
+
+# Flags passed to only C files.
+CFLAGS_C_Release :=
+
+# Flags passed to only C++ files.
+CFLAGS_CC_Release := \
+	-fno-exceptions \
+	-fno-rtti \
+	-fno-exceptions \
+	-fno-strict-aliasing \
+	-std=gnu++17 \
+	-std=c++20
+
+INCS_Release := \
+	-I/root/.nvm/versions/node/v22.20.0/include/node \
+	-I/root/.nvm/versions/node/v22.20.0/src \
+	-I/root/.nvm/versions/node/v22.20.0/deps/openssl/config \
+	-I/root/.nvm/versions/node/v22.20.0/deps/openssl/openssl/include \
+	-I/root/.nvm/versions/node/v22.20.0/deps/uv/include \
+	-I/root/.nvm/versions/node/v22.20.0/deps/zlib \
+	-I/root/.nvm/versions/node/v22.20.0/deps/v8/include \
+	-I$(srcdir)/../../../packages/common/win32-stub/include \
+	-I/tmp/napi-rt
+
+OBJS := \
+	$(obj).target/$(TARGET)/src/control.o \
+	$(obj).target/$(TARGET)/src/directory_changes.o \
+	$(obj).target/$(TARGET)/src/file.o \
+	$(obj).target/$(TARGET)/src/gdi32.o \
+	$(obj).target/$(TARGET)/src/input.o \
+	$(obj).target/$(TARGET)/src/io_ring.o \
+	$(obj).target/$(TARGET)/src/kernel32.o \
+	$(obj).target/$(TARGET)/src/menu.o \
+	$(obj).target/$(TARGET)/src/message_box.o \
+	$(obj).target/$(TARGET)/src/window.o
+
+# Add to the list of files we specially track dependencies for.
+all_deps += $(OBJS)
+
+# Make sure our dependencies are built before any of us.
+$(OBJS): | $(obj).target/../../../../../tmp/nm/node-addon-api/node_addon_api.stamp
+
+# CFLAGS et al overrides must be target-local.
+# See "Target-specific Variable Values" in the GNU Make manual.
+$(OBJS): TOOLSET := $(TOOLSET)
+$(OBJS): GYP_CFLAGS := $(DEFS_$(BUILDTYPE)) $(INCS_$(BUILDTYPE))  $(CFLAGS_$(BUILDTYPE)) $(CFLAGS_C_$(BUILDTYPE))
+$(OBJS): GYP_CXXFLAGS := $(DEFS_$(BUILDTYPE)) $(INCS_$(BUILDTYPE))  $(CFLAGS_$(BUILDTYPE)) $(CFLAGS_CC_$(BUILDTYPE))
+
+# Suffix rules, putting all outputs into $(obj).
+
+$(obj).$(TOOLSET)/$(TARGET)/%.o: $(srcdir)/%.cpp FORCE_DO_CMD
+	@$(call do_cmd,cxx,1)
+
+# Try building from generated source, too.
+
+$(obj).$(TOOLSET)/$(TARGET)/%.o: $(obj).$(TOOLSET)/%.cpp FORCE_DO_CMD
+	@$(call do_cmd,cxx,1)
+
+$(obj).$(TOOLSET)/$(TARGET)/%.o: $(obj)/%.cpp FORCE_DO_CMD
+	@$(call do_cmd,cxx,1)
+
+# End of this set of suffix rules
+### Rules for final target.
+LDFLAGS_Debug := \
+	-pthread \
+	-rdynamic \
+	-m64
+
+LDFLAGS_Release := \
+	-pthread \
+	-rdynamic \
+	-m64
+
+LIBS := \
+	-ldl \
+	-lpthread
+
+$(obj).target/win32_stub.node: GYP_LDFLAGS := $(LDFLAGS_$(BUILDTYPE))
+$(obj).target/win32_stub.node: LIBS := $(LIBS)
+$(obj).target/win32_stub.node: TOOLSET := $(TOOLSET)
+$(obj).target/win32_stub.node: $(OBJS) FORCE_DO_CMD
+	$(call do_cmd,solink_module)
+
+all_deps += $(obj).target/win32_stub.node
+# Add target alias
+.PHONY: win32_stub
+win32_stub: $(builddir)/win32_stub.node
+
+# Copy this to the executable output path.
+$(builddir)/win32_stub.node: TOOLSET := $(TOOLSET)
+$(builddir)/win32_stub.node: $(obj).target/win32_stub.node FORCE_DO_CMD
+	$(call do_cmd,copy)
+
+all_deps += $(builddir)/win32_stub.node
+# Short alias for building this executable.
+.PHONY: win32_stub.node
+win32_stub.node: $(obj).target/win32_stub.node $(builddir)/win32_stub.node
+
+# Add executable to "all" target.
+.PHONY: all
+all: $(builddir)/win32_stub.node
+
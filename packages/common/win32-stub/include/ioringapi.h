@@ -0,0 +1,115 @@
+/**
+ * Win32 Stub: ioringapi.h
+ *
+ * The subset of the Windows 11 IoRing API that kernel32 uses, declared so the bindings compile on hosts without the
+ * Windows SDK. See windows.h in this directory.
+ *
+ * Copyright (c) 2025-present, Kasim Ahmic. (https://kasimahmic.com)
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <windows.h>
+
+DECLARE_HANDLE(HIORING);
+
+typedef enum IORING_VERSION {
+  IORING_VERSION_INVALID = 0,
+  IORING_VERSION_1 = 1,
+  IORING_VERSION_2 = 2,
+  IORING_VERSION_3 = 300,
+} IORING_VERSION;
+
+typedef enum IORING_CREATE_REQUIRED_FLAGS { IORING_CREATE_REQUIRED_FLAGS_NONE = 0 } IORING_CREATE_REQUIRED_FLAGS;
+typedef enum IORING_CREATE_ADVISORY_FLAGS { IORING_CREATE_ADVISORY_FLAGS_NONE = 0 } IORING_CREATE_ADVISORY_FLAGS;
+
+typedef struct IORING_CREATE_FLAGS {
+  IORING_CREATE_REQUIRED_FLAGS Required;
+  IORING_CREATE_ADVISORY_FLAGS Advisory;
+} IORING_CREATE_FLAGS;
+
+typedef enum IORING_SQE_FLAGS { IOSQE_FLAGS_NONE = 0, IOSQE_FLAGS_DRAIN_PRECEDING_OPS = 1 } IORING_SQE_FLAGS;
+typedef enum IORING_REF_KIND { IORING_REF_RAW, IORING_REF_REGISTERED } IORING_REF_KIND;
+
+typedef struct IORING_REGISTERED_BUFFER {
+  UINT32 BufferIndex;
+  UINT32 Offset;
+} IORING_REGISTERED_BUFFER;
+
+typedef struct IORING_HANDLE_REF {
+  explicit IORING_HANDLE_REF(HANDLE h) : Kind(IORING_REF_RAW) { HandleUnion.Handle = h; }
+  explicit IORING_HANDLE_REF(UINT32 index) : Kind(IORING_REF_REGISTERED) { HandleUnion.Index = index; }
+
+  IORING_REF_KIND Kind;
+  union {
+    HANDLE Handle;
+    UINT32 Index;
+  } HandleUnion;
+} IORING_HANDLE_REF;
+
+typedef struct IORING_BUFFER_REF {
+  explicit IORING_BUFFER_REF(void *address) : Kind(IORING_REF_RAW) { BufferUnion.Address = address; }
+  explicit IORING_BUFFER_REF(IORING_REGISTERED_BUFFER registered) : Kind(IORING_REF_REGISTERED) {
+    BufferUnion.IndexAndOffset = registered;
+  }
+  IORING_BUFFER_REF(UINT32 index, UINT32 offset) : IORING_BUFFER_REF(IORING_REGISTERED_BUFFER{index, offset}) {}
+
+  IORING_REF_KIND Kind;
+  union {
+    void *Address;
+    IORING_REGISTERED_BUFFER IndexAndOffset;
+  } BufferUnion;
+} IORING_BUFFER_REF;
+
+#define IoRingHandleRefFromHandle(h) IORING_HANDLE_REF(static_cast<HANDLE>(h))
+#define IoRingHandleRefFromIndex(i) IORING_HANDLE_REF(static_cast<UINT32>(i))
+#define IoRingBufferRefFromPointer(p) IORING_BUFFER_REF(static_cast<void *>(p))
+#define IoRingBufferRefFromIndexAndOffset(i, o) IORING_BUFFER_REF((i), (o))
+
+typedef struct IORING_BUFFER_INFO {
+  void *Address;
+  UINT32 Length;
+} IORING_BUFFER_INFO;
+
+typedef struct IORING_CQE {
+  UINT_PTR UserData;
+  HRESULT ResultCode;
+  ULONG_PTR Information;
+} IORING_CQE;
+
+#define IORING_E_REQUIRED_FLAG_NOT_SUPPORTED ((HRESULT)0x80460001L)
+#define IORING_E_SUBMISSION_QUEUE_FULL ((HRESULT)0x80460002L)
+#define IORING_E_VERSION_NOT_SUPPORTED ((HRESULT)0x80460003L)
+#define IORING_E_SUBMISSION_QUEUE_TOO_BIG ((HRESULT)0x80460004L)
+#define IORING_E_COMPLETION_QUEUE_TOO_BIG ((HRESULT)0x80460005L)
+#define IORING_E_SUBMIT_IN_PROGRESS ((HRESULT)0x80460006L)
+#define IORING_E_CORRUPT ((HRESULT)0x80460007L)
+#define IORING_E_COMPLETION_QUEUE_TOO_FULL ((HRESULT)0x80460008L)
+
+typedef enum FILE_WRITE_FLAGS { FILE_WRITE_FLAGS_NONE = 0, FILE_WRITE_FLAGS_WRITE_THROUGH = 1 } FILE_WRITE_FLAGS;
+
+extern "C" {
+HRESULT WINAPI CreateIoRing(IORING_VERSION, IORING_CREATE_FLAGS, UINT32, UINT32, HIORING *);
+HRESULT WINAPI CloseIoRing(HIORING);
+HRESULT WINAPI BuildIoRingRegisterFileHandles(HIORING, UINT32, const HANDLE[], UINT_PTR);
+HRESULT WINAPI BuildIoRingRegisterBuffers(HIORING, UINT32, const IORING_BUFFER_INFO[], UINT_PTR);
+HRESULT WINAPI BuildIoRingReadFile(HIORING, IORING_HANDLE_REF, IORING_BUFFER_REF, UINT32, UINT64, UINT_PTR, IORING_SQE_FLAGS);
+HRESULT WINAPI BuildIoRingWriteFile(
+    HIORING, IORING_HANDLE_REF, IORING_BUFFER_REF, UINT32, UINT64, FILE_WRITE_FLAGS, UINT_PTR, IORING_SQE_FLAGS);
+HRESULT WINAPI BuildIoRingReadFileScatter(
+    HIORING, IORING_HANDLE_REF, UINT32, FILE_SEGMENT_ELEMENT[], UINT32, UINT64, UINT_PTR, IORING_SQE_FLAGS);
+HRESULT WINAPI BuildIoRingWriteFileGather(HIORING,
+                                          IORING_HANDLE_REF,
+                                          UINT32,
+                                          FILE_SEGMENT_ELEMENT[],
+                                          UINT32,
+                                          UINT64,
+                                          FILE_WRITE_FLAGS,
+                                          UINT_PTR,
+                                          IORING_SQE_FLAGS);
+HRESULT WINAPI SubmitIoRing(HIORING, UINT32, UINT32, UINT32 *);
+HRESULT WINAPI PopIoRingCompletion(HIORING, IORING_CQE *);
+}
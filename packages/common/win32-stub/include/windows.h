@@ -0,0 +1,685 @@
+/**
+ * Win32 Stub: windows.h
+ *
+ * Declarations for the parts of the Win32 API the bindings use, so every package compiles on Linux and macOS where
+ * there is no Windows SDK. common.gypi adds this directory to the include path on every OS other than Windows, which
+ * lets CI build the combined addon and time the build without a Windows runner.
+ *
+ * Types are declared with the sizes they have on 64-bit Windows, except WCHAR, which stays wchar_t and is 32 bits wide
+ * on these platforms; the bindings already fall back to converting through char16_t when the two differ. The
+ * functions are implemented by the in-memory backend in ../src, which must be loaded before an addon built against this
+ * header (see ../index.ts); without it the addon loads but fails with an unresolved symbol the first time it calls into
+ * Win32. Only add what a binding actually needs, and match the SDK's spelling and values exactly.
+ *
+ * Copyright (c) 2025-present, Kasim Ahmic. (https://kasimahmic.com)
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+
+#define WINAPI
+#define CALLBACK
+#define APIENTRY
+#define DUMMYUNIONNAME
+#define DUMMYSTRUCTNAME
+
+/**** Base Types ******************************************************************************************************/
+
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef unsigned short WORD;
+typedef uint32_t DWORD;
+typedef unsigned int UINT;
+typedef int INT;
+typedef int32_t LONG;
+typedef uint32_t ULONG;
+typedef short SHORT;
+typedef unsigned short USHORT;
+typedef char CHAR;
+typedef wchar_t WCHAR;
+typedef uint32_t UINT32;
+typedef uint64_t UINT64;
+typedef int64_t LONGLONG;
+typedef uint64_t ULONGLONG;
+typedef intptr_t INT_PTR;
+typedef uintptr_t UINT_PTR;
+typedef intptr_t LONG_PTR;
+typedef uintptr_t ULONG_PTR;
+typedef uintptr_t DWORD_PTR;
+typedef size_t SIZE_T;
+typedef UINT_PTR WPARAM;
+typedef LONG_PTR LPARAM;
+typedef LONG_PTR LRESULT;
+typedef LONG HRESULT;
+typedef WORD ATOM;
+typedef DWORD COLORREF;
+
+typedef void *PVOID;
+typedef void *PVOID64;
+typedef void *LPVOID;
+typedef const void *LPCVOID;
+typedef BYTE *PBYTE;
+typedef BYTE *LPBYTE;
+typedef DWORD *LPDWORD;
+typedef UINT *PUINT;
+typedef CHAR *LPSTR;
+typedef const CHAR *LPCSTR;
+typedef WCHAR *LPWSTR;
+typedef const WCHAR *LPCWSTR;
+
+#define TRUE 1
+#define FALSE 0
+
+#define MAX_PATH 260
+#define INFINITE 0xFFFFFFFF
+
+#define CP_ACP 0
+#define CP_UTF8 65001
+
+#define CSTR_LESS_THAN 1
+#define CSTR_EQUAL 2
+#define CSTR_GREATER_THAN 3
+
+/**** Handles *********************************************************************************************************/
+
+#define DECLARE_HANDLE(name)                                                                                           \
+  struct name##__ {                                                                                                    \
+    int unused;                                                                                                        \
+  };                                                                                                                   \
+  typedef struct name##__ *name
+
+typedef void *HANDLE;
+
+DECLARE_HANDLE(HWND);
+DECLARE_HANDLE(HINSTANCE);
+DECLARE_HANDLE(HDC);
+DECLARE_HANDLE(HICON);
+DECLARE_HANDLE(HMENU);
+DECLARE_HANDLE(HBRUSH);
+DECLARE_HANDLE(HBITMAP);
+DECLARE_HANDLE(HFONT);
+DECLARE_HANDLE(HPEN);
+DECLARE_HANDLE(HRGN);
+DECLARE_HANDLE(HPALETTE);
+DECLARE_HANDLE(HCOLORSPACE);
+DECLARE_HANDLE(HMONITOR);
+DECLARE_HANDLE(HACCEL);
+DECLARE_HANDLE(HGLRC);
+DECLARE_HANDLE(HDESK);
+DECLARE_HANDLE(HKL);
+DECLARE_HANDLE(HHOOK);
+DECLARE_HANDLE(HKEY);
+DECLARE_HANDLE(HRSRC);
+DECLARE_HANDLE(HSZ);
+DECLARE_HANDLE(HMETAFILE);
+DECLARE_HANDLE(HENHMETAFILE);
+DECLARE_HANDLE(HRAWINPUT);
+
+typedef HICON HCURSOR;
+typedef HINSTANCE HMODULE;
+typedef HANDLE HLOCAL;
+typedef HANDLE HGLOBAL;
+typedef HANDLE HGDIOBJ;
+
+#define INVALID_HANDLE_VALUE ((HANDLE)(LONG_PTR)-1)
+
+/**** Errors **********************************************************************************************************/
+
+#define ERROR_SUCCESS 0L
+#define ERROR_INVALID_FUNCTION 1L
+#define ERROR_FILE_NOT_FOUND 2L
+#define ERROR_PATH_NOT_FOUND 3L
+#define ERROR_TOO_MANY_OPEN_FILES 4L
+#define ERROR_ACCESS_DENIED 5L
+#define ERROR_INVALID_HANDLE 6L
+#define ERROR_NOT_ENOUGH_MEMORY 8L
+#define ERROR_NO_MORE_FILES 18L
+#define ERROR_GEN_FAILURE 31L
+#define ERROR_NOT_SUPPORTED 50L
+#define ERROR_FILE_EXISTS 80L
+#define ERROR_INVALID_PARAMETER 87L
+#define ERROR_DISK_FULL 112L
+#define ERROR_INSUFFICIENT_BUFFER 122L
+#define ERROR_ALREADY_EXISTS 183L
+#define ERROR_MOD_NOT_FOUND 126L
+#define ERROR_PROC_NOT_FOUND 127L
+#define ERROR_DIRECTORY 267L
+#define ERROR_MR_MID_NOT_FOUND 317L
+#define ERROR_OPERATION_ABORTED 995L
+#define ERROR_IO_INCOMPLETE 996L
+#define ERROR_IO_PENDING 997L
+#define ERROR_NOTIFY_ENUM_DIR 1022L
+#define ERROR_NOT_FOUND 1168L
+#define ERROR_INVALID_WINDOW_HANDLE 1400L
+#define ERROR_INVALID_MENU_HANDLE 1401L
+#define ERROR_CANNOT_FIND_WND_CLASS 1407L
+#define ERROR_CLASS_ALREADY_EXISTS 1410L
+#define ERROR_TIMEOUT 1460L
+
+#define S_OK ((HRESULT)0L)
+#define S_FALSE ((HRESULT)1L)
+#define E_NOTIMPL ((HRESULT)0x80004001L)
+#define E_FAIL ((HRESULT)0x80004005L)
+#define E_HANDLE ((HRESULT)0x80070006L)
+#define E_INVALIDARG ((HRESULT)0x80070057L)
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+#define HRESULT_FROM_WIN32(x)                                                                                          \
+  ((HRESULT)(x) <= 0 ? ((HRESULT)(x)) : ((HRESULT)(((x) & 0x0000FFFF) | (7 << 16) | 0x80000000)))
+
+#define WAIT_OBJECT_0 0L
+#define WAIT_TIMEOUT 258L
+#define WAIT_FAILED ((DWORD)0xFFFFFFFF)
+#define STATUS_PENDING ((DWORD)0x00000103L)
+
+/**** Geometry ********************************************************************************************************/
+
+typedef struct tagPOINT {
+  LONG x;
+  LONG y;
+} POINT, *PPOINT, *LPPOINT;
+
+typedef struct tagRECT {
+  LONG left;
+  LONG top;
+  LONG right;
+  LONG bottom;
+} RECT, *PRECT, *LPRECT;
+
+typedef const RECT *LPCRECT;
+
+/**** Windows and Messages ********************************************************************************************/
+
+typedef struct tagMSG {
+  HWND hwnd;
+  UINT message;
+  WPARAM wParam;
+  LPARAM lParam;
+  DWORD time;
+  POINT pt;
+} MSG, *PMSG, *LPMSG;
+
+typedef LRESULT(CALLBACK *WNDPROC)(HWND, UINT, WPARAM, LPARAM);
+typedef BOOL(CALLBACK *WNDENUMPROC)(HWND, LPARAM);
+
+typedef struct tagWNDCLASSEXW {
+  UINT cbSize;
+  UINT style;
+  WNDPROC lpfnWndProc;
+  int cbClsExtra;
+  int cbWndExtra;
+  HINSTANCE hInstance;
+  HICON hIcon;
+  HCURSOR hCursor;
+  HBRUSH hbrBackground;
+  LPCWSTR lpszMenuName;
+  LPCWSTR lpszClassName;
+  HICON hIconSm;
+} WNDCLASSEXW, *PWNDCLASSEXW, *LPWNDCLASSEXW;
+
+typedef struct tagCREATESTRUCTW {
+  LPVOID lpCreateParams;
+  HINSTANCE hInstance;
+  HMENU hMenu;
+  HWND hwndParent;
+  int cy;
+  int cx;
+  int y;
+  int x;
+  LONG style;
+  LPCWSTR lpszName;
+  LPCWSTR lpszClass;
+  DWORD dwExStyle;
+} CREATESTRUCTW, *LPCREATESTRUCTW;
+
+typedef struct tagPAINTSTRUCT {
+  HDC hdc;
+  BOOL fErase;
+  RECT rcPaint;
+  BOOL fRestore;
+  BOOL fIncUpdate;
+  BYTE rgbReserved[32];
+} PAINTSTRUCT, *PPAINTSTRUCT, *LPPAINTSTRUCT;
+
+#define WM_NULL 0x0000
+#define WM_CREATE 0x0001
+#define WM_DESTROY 0x0002
+#define WM_MOVE 0x0003
+#define WM_SIZE 0x0005
+#define WM_SETFOCUS 0x0007
+#define WM_KILLFOCUS 0x0008
+#define WM_SETTEXT 0x000C
+#define WM_GETTEXT 0x000D
+#define WM_GETTEXTLENGTH 0x000E
+#define WM_PAINT 0x000F
+#define WM_CLOSE 0x0010
+#define WM_QUIT 0x0012
+#define WM_ERASEBKGND 0x0014
+#define WM_SHOWWINDOW 0x0018
+#define WM_NCCREATE 0x0081
+#define WM_NCDESTROY 0x0082
+#define WM_KEYDOWN 0x0100
+#define WM_KEYUP 0x0101
+#define WM_CHAR 0x0102
+#define WM_COMMAND 0x0111
+#define WM_TIMER 0x0113
+#define WM_MOUSEMOVE 0x0200
+#define WM_LBUTTONDOWN 0x0201
+#define WM_LBUTTONUP 0x0202
+#define WM_USER 0x0400
+#define WM_APP 0x8000
+
+#define WS_OVERLAPPED 0x00000000L
+#define WS_CHILD 0x40000000L
+#define WS_VISIBLE 0x10000000L
+#define WS_CAPTION 0x00C00000L
+#define WS_SYSMENU 0x00080000L
+#define WS_THICKFRAME 0x00040000L
+#define WS_MINIMIZEBOX 0x00020000L
+#define WS_MAXIMIZEBOX 0x00010000L
+#define WS_OVERLAPPEDWINDOW                                                                                            \
+  (WS_OVERLAPPED | WS_CAPTION | WS_SYSMENU | WS_THICKFRAME | WS_MINIMIZEBOX | WS_MAXIMIZEBOX)
+
+#define CW_USEDEFAULT ((int)0x80000000)
+
+#define SW_HIDE 0
+#define SW_SHOWNORMAL 1
+#define SW_SHOW 5
+
+#define GCW_ATOM (-32)
+#define GWLP_USERDATA (-21)
+
+/**** Menus ***********************************************************************************************************/
+
+#define MF_BYCOMMAND 0x00000000L
+#define MF_STRING 0x00000000L
+#define MF_GRAYED 0x00000001L
+#define MF_DISABLED 0x00000002L
+#define MF_CHECKED 0x00000008L
+#define MF_POPUP 0x00000010L
+#define MF_SEPARATOR 0x00000800L
+#define MF_BYPOSITION 0x00000400L
+
+/**** Message Boxes ***************************************************************************************************/
+
+typedef struct tagHELPINFO {
+  UINT cbSize;
+  int iContextType;
+  int iCtrlId;
+  HANDLE hItemHandle;
+  DWORD_PTR dwContextId;
+  POINT MousePos;
+} HELPINFO, *LPHELPINFO;
+
+#define HELPINFO_WINDOW 0x0001
+#define HELPINFO_MENUITEM 0x0002
+
+typedef void(CALLBACK *MSGBOXCALLBACK)(LPHELPINFO lpHelpInfo);
+
+typedef struct tagMSGBOXPARAMSA {
+  UINT cbSize;
+  HWND hwndOwner;
+  HINSTANCE hInstance;
+  LPCSTR lpszText;
+  LPCSTR lpszCaption;
+  DWORD dwStyle;
+  LPCSTR lpszIcon;
+  DWORD_PTR dwContextHelpId;
+  MSGBOXCALLBACK lpfnMsgBoxCallback;
+  DWORD dwLanguageId;
+} MSGBOXPARAMSA, *PMSGBOXPARAMSA, *LPMSGBOXPARAMSA;
+
+typedef struct tagMSGBOXPARAMSW {
+  UINT cbSize;
+  HWND hwndOwner;
+  HINSTANCE hInstance;
+  LPCWSTR lpszText;
+  LPCWSTR lpszCaption;
+  DWORD dwStyle;
+  LPCWSTR lpszIcon;
+  DWORD_PTR dwContextHelpId;
+  MSGBOXCALLBACK lpfnMsgBoxCallback;
+  DWORD dwLanguageId;
+} MSGBOXPARAMSW, *PMSGBOXPARAMSW, *LPMSGBOXPARAMSW;
+
+#define MB_OK 0x00000000L
+#define MB_OKCANCEL 0x00000001L
+#define MB_YESNO 0x00000004L
+#define MB_HELP 0x00004000L
+
+#define IDOK 1
+#define IDCANCEL 2
+#define IDYES 6
+#define IDNO 7
+
+/**** Input ***********************************************************************************************************/
+
+typedef struct tagMOUSEINPUT {
+  LONG dx;
+  LONG dy;
+  DWORD mouseData;
+  DWORD dwFlags;
+  DWORD time;
+  ULONG_PTR dwExtraInfo;
+} MOUSEINPUT, *PMOUSEINPUT, *LPMOUSEINPUT;
+
+typedef struct tagKEYBDINPUT {
+  WORD wVk;
+  WORD wScan;
+  DWORD dwFlags;
+  DWORD time;
+  ULONG_PTR dwExtraInfo;
+} KEYBDINPUT, *PKEYBDINPUT, *LPKEYBDINPUT;
+
+typedef struct tagHARDWAREINPUT {
+  DWORD uMsg;
+  WORD wParamL;
+  WORD wParamH;
+} HARDWAREINPUT, *PHARDWAREINPUT, *LPHARDWAREINPUT;
+
+typedef struct tagINPUT {
+  DWORD type;
+  union {
+    MOUSEINPUT mi;
+    KEYBDINPUT ki;
+    HARDWAREINPUT hi;
+  } DUMMYUNIONNAME;
+} INPUT, *PINPUT, *LPINPUT;
+
+#define INPUT_MOUSE 0
+#define INPUT_KEYBOARD 1
+#define INPUT_HARDWARE 2
+
+typedef struct tagRAWINPUTDEVICE {
+  USHORT usUsagePage;
+  USHORT usUsage;
+  DWORD dwFlags;
+  HWND hwndTarget;
+} RAWINPUTDEVICE, *PRAWINPUTDEVICE, *LPRAWINPUTDEVICE;
+
+typedef const RAWINPUTDEVICE *PCRAWINPUTDEVICE;
+
+typedef struct tagRAWINPUTHEADER {
+  DWORD dwType;
+  DWORD dwSize;
+  HANDLE hDevice;
+  WPARAM wParam;
+} RAWINPUTHEADER, *PRAWINPUTHEADER, *LPRAWINPUTHEADER;
+
+typedef struct tagRAWMOUSE {
+  USHORT usFlags;
+  union {
+    ULONG ulButtons;
+    struct {
+      USHORT usButtonFlags;
+      USHORT usButtonData;
+    } DUMMYSTRUCTNAME;
+  } DUMMYUNIONNAME;
+  ULONG ulRawButtons;
+  LONG lLastX;
+  LONG lLastY;
+  ULONG ulExtraInformation;
+} RAWMOUSE, *PRAWMOUSE, *LPRAWMOUSE;
+
+typedef struct tagRAWKEYBOARD {
+  USHORT MakeCode;
+  USHORT Flags;
+  USHORT Reserved;
+  USHORT VKey;
+  UINT Message;
+  ULONG ExtraInformation;
+} RAWKEYBOARD, *PRAWKEYBOARD, *LPRAWKEYBOARD;
+
+typedef struct tagRAWHID {
+  DWORD dwSizeHid;
+  DWORD dwCount;
+  BYTE bRawData[1];
+} RAWHID, *PRAWHID, *LPRAWHID;
+
+typedef struct tagRAWINPUT {
+  RAWINPUTHEADER header;
+  union {
+    RAWMOUSE mouse;
+    RAWKEYBOARD keyboard;
+    RAWHID hid;
+  } data;
+} RAWINPUT, *PRAWINPUT, *LPRAWINPUT;
+
+#define RIM_TYPEMOUSE 0
+#define RIM_TYPEKEYBOARD 1
+#define RIM_TYPEHID 2
+
+#define RAWINPUT_ALIGN(x) (((ULONG_PTR)(x) + sizeof(ULONG_PTR) - 1) & ~(sizeof(ULONG_PTR) - 1))
+#define NEXTRAWINPUTBLOCK(ptr) ((PRAWINPUT)RAWINPUT_ALIGN((ULONG_PTR)((PBYTE)(ptr) + (ptr)->header.dwSize)))
+
+/**** Files ***********************************************************************************************************/
+
+typedef struct _FILETIME {
+  DWORD dwLowDateTime;
+  DWORD dwHighDateTime;
+} FILETIME, *PFILETIME, *LPFILETIME;
+
+typedef union _LARGE_INTEGER {
+  struct {
+    DWORD LowPart;
+    LONG HighPart;
+  } DUMMYSTRUCTNAME;
+  struct {
+    DWORD LowPart;
+    LONG HighPart;
+  } u;
+  LONGLONG QuadPart;
+} LARGE_INTEGER, *PLARGE_INTEGER;
+
+typedef struct _SECURITY_ATTRIBUTES {
+  DWORD nLength;
+  LPVOID lpSecurityDescriptor;
+  BOOL bInheritHandle;
+} SECURITY_ATTRIBUTES, *PSECURITY_ATTRIBUTES, *LPSECURITY_ATTRIBUTES;
+
+typedef struct _OVERLAPPED {
+  ULONG_PTR Internal;
+  ULONG_PTR InternalHigh;
+  union {
+    struct {
+      DWORD Offset;
+      DWORD OffsetHigh;
+    } DUMMYSTRUCTNAME;
+    PVOID Pointer;
+  } DUMMYUNIONNAME;
+  HANDLE hEvent;
+} OVERLAPPED, *LPOVERLAPPED;
+
+typedef void(CALLBACK *LPOVERLAPPED_COMPLETION_ROUTINE)(DWORD, DWORD, LPOVERLAPPED);
+
+typedef union _FILE_SEGMENT_ELEMENT {
+  PVOID64 Buffer;
+  ULONGLONG Alignment;
+} FILE_SEGMENT_ELEMENT, *PFILE_SEGMENT_ELEMENT;
+
+typedef struct _WIN32_FIND_DATAW {
+  DWORD dwFileAttributes;
+  FILETIME ftCreationTime;
+  FILETIME ftLastAccessTime;
+  FILETIME ftLastWriteTime;
+  DWORD nFileSizeHigh;
+  DWORD nFileSizeLow;
+  DWORD dwReserved0;
+  DWORD dwReserved1;
+  WCHAR cFileName[MAX_PATH];
+  WCHAR cAlternateFileName[14];
+} WIN32_FIND_DATAW, *PWIN32_FIND_DATAW, *LPWIN32_FIND_DATAW;
+
+typedef enum _FINDEX_INFO_LEVELS { FindExInfoStandard, FindExInfoBasic, FindExInfoMaxInfoLevel } FINDEX_INFO_LEVELS;
+
+typedef enum _FINDEX_SEARCH_OPS {
+  FindExSearchNameMatch,
+  FindExSearchLimitToDirectories,
+  FindExSearchLimitToDevices,
+  FindExSearchMaxSearchOp
+} FINDEX_SEARCH_OPS;
+
+typedef struct _FILE_NOTIFY_EXTENDED_INFORMATION {
+  DWORD NextEntryOffset;
+  DWORD Action;
+  LARGE_INTEGER CreationTime;
+  LARGE_INTEGER LastModificationTime;
+  LARGE_INTEGER LastChangeTime;
+  LARGE_INTEGER LastAccessTime;
+  LARGE_INTEGER AllocatedLength;
+  LARGE_INTEGER FileSize;
+  DWORD FileAttributes;
+  union {
+    DWORD ReparsePointTag;
+    DWORD EaSize;
+  } DUMMYUNIONNAME;
+  LARGE_INTEGER FileId;
+  LARGE_INTEGER ParentFileId;
+  DWORD FileNameLength;
+  WCHAR FileName[1];
+} FILE_NOTIFY_EXTENDED_INFORMATION, *PFILE_NOTIFY_EXTENDED_INFORMATION;
+
+typedef enum _READ_DIRECTORY_NOTIFY_INFORMATION_CLASS {
+  ReadDirectoryNotifyInformation = 1,
+  ReadDirectoryNotifyExtendedInformation
+} READ_DIRECTORY_NOTIFY_INFORMATION_CLASS;
+
+#define FIND_FIRST_EX_CASE_SENSITIVE 0x00000001
+#define FIND_FIRST_EX_LARGE_FETCH 0x00000002
+
+#define FILE_ATTRIBUTE_READONLY 0x00000001
+#define FILE_ATTRIBUTE_HIDDEN 0x00000002
+#define FILE_ATTRIBUTE_DIRECTORY 0x00000010
+#define FILE_ATTRIBUTE_NORMAL 0x00000080
+#define FILE_ATTRIBUTE_REPARSE_POINT 0x00000400
+
+#define FILE_ACTION_ADDED 0x00000001
+#define FILE_ACTION_REMOVED 0x00000002
+#define FILE_ACTION_MODIFIED 0x00000003
+#define FILE_ACTION_RENAMED_OLD_NAME 0x00000004
+#define FILE_ACTION_RENAMED_NEW_NAME 0x00000005
+
+#define FILE_NOTIFY_CHANGE_FILE_NAME 0x00000001
+#define FILE_NOTIFY_CHANGE_DIR_NAME 0x00000002
+#define FILE_NOTIFY_CHANGE_ATTRIBUTES 0x00000004
+#define FILE_NOTIFY_CHANGE_SIZE 0x00000008
+#define FILE_NOTIFY_CHANGE_LAST_WRITE 0x00000010
+#define FILE_NOTIFY_CHANGE_CREATION 0x00000040
+
+#define GENERIC_READ 0x80000000L
+#define GENERIC_WRITE 0x40000000L
+#define FILE_LIST_DIRECTORY 0x0001
+#define FILE_SHARE_READ 0x00000001
+#define FILE_SHARE_WRITE 0x00000002
+#define FILE_SHARE_DELETE 0x00000004
+#define CREATE_NEW 1
+#define CREATE_ALWAYS 2
+#define OPEN_EXISTING 3
+#define OPEN_ALWAYS 4
+#define TRUNCATE_EXISTING 5
+#define FILE_FLAG_BACKUP_SEMANTICS 0x02000000
+#define FILE_FLAG_OVERLAPPED 0x40000000
+
+/**** Strings and Modules *********************************************************************************************/
+
+typedef INT_PTR(WINAPI *FARPROC)();
+
+#define FORMAT_MESSAGE_ALLOCATE_BUFFER 0x00000100
+#define FORMAT_MESSAGE_IGNORE_INSERTS 0x00000200
+#define FORMAT_MESSAGE_FROM_STRING 0x00000400
+#define FORMAT_MESSAGE_FROM_HMODULE 0x00000800
+#define FORMAT_MESSAGE_FROM_SYSTEM 0x00001000
+#define FORMAT_MESSAGE_ARGUMENT_ARRAY 0x00002000
+
+/**** Functions *******************************************************************************************************/
+
+extern "C" {
+// kernel32
+DWORD WINAPI GetLastError();
+void WINAPI SetLastError(DWORD dwErrCode);
+UINT WINAPI GetACP();
+int WINAPI MultiByteToWideChar(UINT, DWORD, LPCSTR, int, LPWSTR, int);
+int WINAPI WideCharToMultiByte(UINT, DWORD, LPCWSTR, int, LPSTR, int, LPCSTR, BOOL *);
+int WINAPI CompareStringOrdinal(LPCWSTR, int, LPCWSTR, int, BOOL);
+HMODULE WINAPI GetModuleHandleW(LPCWSTR);
+DWORD WINAPI GetModuleFileNameW(HMODULE, LPWSTR, DWORD);
+FARPROC WINAPI GetProcAddress(HMODULE, LPCSTR);
+DWORD WINAPI FormatMessageW(DWORD, LPCVOID, DWORD, DWORD, LPWSTR, DWORD, va_list *);
+HLOCAL WINAPI LocalFree(HLOCAL);
+ULONGLONG WINAPI GetTickCount64();
+BOOL WINAPI QueryPerformanceCounter(LARGE_INTEGER *);
+BOOL WINAPI QueryPerformanceFrequency(LARGE_INTEGER *);
+BOOL WINAPI CloseHandle(HANDLE);
+HANDLE WINAPI CreateEventW(LPSECURITY_ATTRIBUTES, BOOL, BOOL, LPCWSTR);
+BOOL WINAPI SetEvent(HANDLE);
+BOOL WINAPI ResetEvent(HANDLE);
+DWORD WINAPI WaitForSingleObject(HANDLE, DWORD);
+DWORD WINAPI WaitForMultipleObjects(DWORD, const HANDLE *, BOOL, DWORD);
+HANDLE WINAPI CreateFileW(LPCWSTR, DWORD, DWORD, LPSECURITY_ATTRIBUTES, DWORD, DWORD, HANDLE);
+BOOL WINAPI CancelIoEx(HANDLE, LPOVERLAPPED);
+BOOL WINAPI GetOverlappedResult(HANDLE, LPOVERLAPPED, LPDWORD, BOOL);
+BOOL WINAPI ReadDirectoryChangesExW(HANDLE,
+                                    LPVOID,
+                                    DWORD,
+                                    BOOL,
+                                    DWORD,
+                                    LPDWORD,
+                                    LPOVERLAPPED,
+                                    LPOVERLAPPED_COMPLETION_ROUTINE,
+                                    READ_DIRECTORY_NOTIFY_INFORMATION_CLASS);
+HANDLE WINAPI FindFirstFileExW(LPCWSTR, FINDEX_INFO_LEVELS, LPVOID, FINDEX_SEARCH_OPS, LPVOID, DWORD);
+BOOL WINAPI FindNextFileW(HANDLE, LPWIN32_FIND_DATAW);
+BOOL WINAPI FindClose(HANDLE);
+
+// user32
+ATOM WINAPI RegisterClassExW(const WNDCLASSEXW *);
+HWND WINAPI CreateWindowExW(DWORD, LPCWSTR, LPCWSTR, DWORD, int, int, int, int, HWND, HMENU, HINSTANCE, LPVOID);
+BOOL WINAPI DestroyWindow(HWND);
+LRESULT WINAPI DefWindowProcW(HWND, UINT, WPARAM, LPARAM);
+BOOL WINAPI ShowWindow(HWND, int);
+BOOL WINAPI UpdateWindow(HWND);
+BOOL WINAPI IsWindowVisible(HWND);
+BOOL WINAPI IsWindow(HWND);
+int WINAPI GetClassNameW(HWND, LPWSTR, int);
+int WINAPI GetWindowTextW(HWND, LPWSTR, int);
+int WINAPI GetWindowTextLengthW(HWND);
+DWORD WINAPI GetWindowThreadProcessId(HWND, LPDWORD);
+BOOL WINAPI GetWindowRect(HWND, LPRECT);
+BOOL WINAPI GetClientRect(HWND, LPRECT);
+BOOL WINAPI EnumWindows(WNDENUMPROC, LPARAM);
+BOOL WINAPI EnumChildWindows(HWND, WNDENUMPROC, LPARAM);
+BOOL WINAPI GetMessageW(LPMSG, HWND, UINT, UINT);
+BOOL WINAPI TranslateMessage(const MSG *);
+LRESULT WINAPI DispatchMessageW(const MSG *);
+BOOL WINAPI PostMessageW(HWND, UINT, WPARAM, LPARAM);
+void WINAPI PostQuitMessage(int);
+HDC WINAPI BeginPaint(HWND, LPPAINTSTRUCT);
+BOOL WINAPI EndPaint(HWND, const PAINTSTRUCT *);
+BOOL WINAPI InvalidateRect(HWND, const RECT *, BOOL);
+BOOL WINAPI InvalidateRgn(HWND, HRGN, BOOL);
+HMENU WINAPI CreateMenu();
+BOOL WINAPI DestroyMenu(HMENU);
+HMENU WINAPI GetMenu(HWND);
+BOOL WINAPI SetMenu(HWND, HMENU);
+BOOL WINAPI AppendMenuA(HMENU, UINT, UINT_PTR, LPCSTR);
+BOOL WINAPI AppendMenuW(HMENU, UINT, UINT_PTR, LPCWSTR);
+int WINAPI GetMenuStringW(HMENU, UINT, LPWSTR, int, UINT);
+int WINAPI MessageBoxA(HWND, LPCSTR, LPCSTR, UINT);
+int WINAPI MessageBoxW(HWND, LPCWSTR, LPCWSTR, UINT);
+int WINAPI MessageBoxExA(HWND, LPCSTR, LPCSTR, UINT, WORD);
+int WINAPI MessageBoxExW(HWND, LPCWSTR, LPCWSTR, UINT, WORD);
+int WINAPI MessageBoxIndirectA(const MSGBOXPARAMSA *);
+int WINAPI MessageBoxIndirectW(const MSGBOXPARAMSW *);
+UINT WINAPI SendInput(UINT, LPINPUT, int);
+BOOL WINAPI RegisterRawInputDevices(PCRAWINPUTDEVICE, UINT, UINT);
+UINT WINAPI GetRawInputBuffer(PRAWINPUT, PUINT, UINT);
+
+// gdi32
+BOOL WINAPI DeleteObject(HGDIOBJ);
+}
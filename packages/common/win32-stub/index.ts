@@ -0,0 +1,100 @@
+import Module from 'node:module';
+import { constants } from 'node:os';
+import { fileURLToPath, pathToFileURL } from 'node:url';
+
+type ResolveFilename = (
+  request: string,
+  parent: { filename?: string | null } | undefined,
+  ...rest: unknown[]
+) => string;
+
+/**
+ * Control surface of the stub backend in ./src, for tests and benches that run the real addons off Windows. Everything
+ * here changes or inspects state a binding can't reach on its own.
+ */
+export type Win32Stub = {
+  /** Forgets every window, class, menu, queued message, recorded call and override. Open kernel handles are kept. */
+  reset(): void;
+
+  getWindowCount(): number;
+  getMenuCount(): number;
+  /** Open events, files and find handles. */
+  getObjectCount(): number;
+
+  /** How long GetMessageW waits on an empty queue before failing with ERROR_TIMEOUT. Defaults to 1000 ms. */
+  setMessageWaitTimeout(milliseconds: number): void;
+
+  /** The button every following message box is closed with, and how often Help is pressed first on MB_HELP boxes. */
+  setMessageBoxResult(result: number, helpRequests?: number): void;
+  takeMessageBoxCalls(): { hWnd: bigint; text: string; caption: string; type: number }[];
+
+  /** Every INPUT record passed to SendInput since the last call, back to back. */
+  takeSentInput(): ArrayBuffer;
+
+  queueRawMouse(
+    hDevice: bigint,
+    mouse: { usFlags: number; ulButtons: number; lLastX: number; lLastY: number; ulExtraInformation: number },
+  ): void;
+  queueRawKeyboard(
+    hDevice: bigint,
+    keyboard: { MakeCode: number; Flags: number; VKey: number; Message: number; ExtraInformation: number },
+  ): void;
+  queueRawHid(hDevice: bigint, dwSizeHid: number, reports: Uint8Array): void;
+
+  /** Overrides what GetModuleFileNameW(null) reports; an empty string restores the real executable path. */
+  setModuleFileName(path: string): void;
+
+  /** Makes GetProcAddress fail for `name`, as on a Windows version that doesn't export it. */
+  setProcAddressHidden(name: string, hidden: boolean): void;
+};
+
+const STUB_PATH = fileURLToPath(new URL('./build/Release/win32_stub.node', import.meta.url));
+
+let stub: Win32Stub | undefined;
+
+/**
+ * Loads the stub backend once. It has to be loaded with RTLD_GLOBAL, and before any addon calls into Win32, so that
+ * those calls resolve to it; build it first with `npm run build:stub --workspace=packages/common`.
+ */
+export function loadWin32Stub(): Win32Stub {
+  if (process.platform === 'win32') {
+    throw new Error('The Win32 stub replaces the real API and is only available off Windows');
+  }
+
+  if (!stub) {
+    const module = { exports: {} } as { exports: Win32Stub };
+
+    process.dlopen(module, STUB_PATH, constants.dlopen.RTLD_NOW | constants.dlopen.RTLD_GLOBAL);
+
+    stub = module.exports;
+  }
+
+  return stub;
+}
+
+/**
+ * Lets `lib/index.ts` of every package load its addon straight from `build/Release` when it is run from source, as in
+ * tests, instead of from the copy rollup puts next to the compiled `dist/index.js`.
+ */
+export function resolveAddonsFromBuild(): void {
+  const loader = Module as unknown as { _resolveFilename: ResolveFilename & { fromBuild?: true } };
+
+  if (loader._resolveFilename.fromBuild) {
+    return;
+  }
+
+  const resolveFilename = loader._resolveFilename;
+
+  const resolveFromBuild: ResolveFilename & { fromBuild?: true } = function (request, parent, ...rest) {
+    const match = /^\.\/(\w+\.node)$/.exec(request);
+
+    if (match && parent?.filename && /[\\/]lib[\\/][^\\/]+$/.test(parent.filename)) {
+      return fileURLToPath(new URL(`../build/Release/${match[1]}`, pathToFileURL(parent.filename)));
+    }
+
+    return resolveFilename.call(Module, request, parent, ...rest);
+  };
+
+  resolveFromBuild.fromBuild = true;
+  loader._resolveFilename = resolveFromBuild;
+}
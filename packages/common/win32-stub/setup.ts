@@ -0,0 +1,7 @@
+import { loadWin32Stub, resolveAddonsFromBuild } from './index.js';
+
+// Vitest setup file: off Windows, every addon runs against the stub backend straight out of build/Release.
+if (process.platform !== 'win32') {
+  loadWin32Stub().reset();
+  resolveAddonsFromBuild();
+}
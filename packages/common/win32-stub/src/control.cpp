@@ -0,0 +1,175 @@
+#include "win32_stub.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+#include <napi.h>
+
+/**
+ * The JS side of the stub: lets tests and benches reset it, inspect what the bindings did, and feed in what would come
+ * from the user or the system on Windows. Typed in ../index.ts.
+ */
+
+static Napi::Value Reset(const Napi::CallbackInfo &info) {
+  win32_stub::ResetKernel32();
+  win32_stub::ResetWindows();
+  win32_stub::ResetMenus();
+  win32_stub::ResetMessageBoxes();
+  win32_stub::ResetInput();
+
+  return info.Env().Undefined();
+}
+
+static Napi::Value GetWindowCount(const Napi::CallbackInfo &info) {
+  return Napi::Number::New(info.Env(), static_cast<double>(win32_stub::WindowCount()));
+}
+
+static Napi::Value GetMenuCount(const Napi::CallbackInfo &info) {
+  return Napi::Number::New(info.Env(), static_cast<double>(win32_stub::MenuCount()));
+}
+
+static Napi::Value GetObjectCount(const Napi::CallbackInfo &info) {
+  return Napi::Number::New(info.Env(), static_cast<double>(win32_stub::ObjectCount()));
+}
+
+static Napi::Value SetMessageWaitTimeout(const Napi::CallbackInfo &info) {
+  win32_stub::SetMessageWaitTimeout(info[0].As<Napi::Number>().Uint32Value());
+
+  return info.Env().Undefined();
+}
+
+static Napi::Value SetMessageBoxResult(const Napi::CallbackInfo &info) {
+  const uint32_t helpRequests = info[1].IsNumber() ? info[1].As<Napi::Number>().Uint32Value() : 0;
+
+  win32_stub::SetMessageBoxResult(info[0].As<Napi::Number>().Int32Value(), helpRequests);
+
+  return info.Env().Undefined();
+}
+
+static Napi::String ToString(const Napi::Env env, const std::wstring &value) {
+  return Napi::String::New(env, win32_stub::ToUtf8(value));
+}
+
+static Napi::Value TakeMessageBoxCalls(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const std::vector<win32_stub::MessageBoxCall> calls = win32_stub::TakeMessageBoxCalls();
+
+  Napi::Array result = Napi::Array::New(env, calls.size());
+
+  for (size_t i = 0; i < calls.size(); i++) {
+    Napi::Object call = Napi::Object::New(env);
+    call.Set("hWnd", Napi::BigInt::New(env, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(calls[i].owner))));
+    call.Set("text", ToString(env, calls[i].text));
+    call.Set("caption", ToString(env, calls[i].caption));
+    call.Set("type", Napi::Number::New(env, calls[i].type));
+
+    result.Set(static_cast<uint32_t>(i), call);
+  }
+
+  return result;
+}
+
+static Napi::Value TakeSentInput(const Napi::CallbackInfo &info) {
+  const std::vector<uint8_t> input = win32_stub::TakeSentInput();
+
+  Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(info.Env(), input.size());
+
+  if (!input.empty()) {
+    std::memcpy(buffer.Data(), input.data(), input.size());
+  }
+
+  return buffer;
+}
+
+static HANDLE ReadDevice(const Napi::Value value) {
+  bool lossless;
+  return reinterpret_cast<HANDLE>(static_cast<uintptr_t>(value.As<Napi::BigInt>().Uint64Value(&lossless)));
+}
+
+template <typename T>
+static std::vector<uint8_t> Bytes(const T &value, const size_t size = sizeof(T)) {
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(&value);
+  return std::vector<uint8_t>(data, data + size);
+}
+
+// queueRawMouse(hDevice, { usFlags, ulButtons, lLastX, lLastY, ulExtraInformation })
+static Napi::Value QueueRawMouse(const Napi::CallbackInfo &info) {
+  const Napi::Object fields = info[1].As<Napi::Object>();
+
+  RAWMOUSE mouse{};
+  mouse.usFlags = static_cast<USHORT>(fields.Get("usFlags").ToNumber().Uint32Value());
+  mouse.ulButtons = fields.Get("ulButtons").ToNumber().Uint32Value();
+  mouse.lLastX = fields.Get("lLastX").ToNumber().Int32Value();
+  mouse.lLastY = fields.Get("lLastY").ToNumber().Int32Value();
+  mouse.ulExtraInformation = fields.Get("ulExtraInformation").ToNumber().Uint32Value();
+
+  win32_stub::QueueRawInput(RIM_TYPEMOUSE, ReadDevice(info[0]), Bytes(mouse));
+
+  return info.Env().Undefined();
+}
+
+// queueRawKeyboard(hDevice, { MakeCode, Flags, VKey, Message, ExtraInformation })
+static Napi::Value QueueRawKeyboard(const Napi::CallbackInfo &info) {
+  const Napi::Object fields = info[1].As<Napi::Object>();
+
+  RAWKEYBOARD keyboard{};
+  keyboard.MakeCode = static_cast<USHORT>(fields.Get("MakeCode").ToNumber().Uint32Value());
+  keyboard.Flags = static_cast<USHORT>(fields.Get("Flags").ToNumber().Uint32Value());
+  keyboard.VKey = static_cast<USHORT>(fields.Get("VKey").ToNumber().Uint32Value());
+  keyboard.Message = fields.Get("Message").ToNumber().Uint32Value();
+  keyboard.ExtraInformation = fields.Get("ExtraInformation").ToNumber().Uint32Value();
+
+  win32_stub::QueueRawInput(RIM_TYPEKEYBOARD, ReadDevice(info[0]), Bytes(keyboard));
+
+  return info.Env().Undefined();
+}
+
+// queueRawHid(hDevice, dwSizeHid, reports: Uint8Array), with reports.length / dwSizeHid reports.
+static Napi::Value QueueRawHid(const Napi::CallbackInfo &info) {
+  const uint32_t sizeHid = info[1].As<Napi::Number>().Uint32Value();
+  const Napi::Uint8Array reports = info[2].As<Napi::Uint8Array>();
+
+  RAWHID hid{};
+  hid.dwSizeHid = sizeHid;
+  hid.dwCount = sizeHid > 0 ? static_cast<DWORD>(reports.ElementLength() / sizeHid) : 0;
+
+  std::vector<uint8_t> data = Bytes(hid, offsetof(RAWHID, bRawData));
+  data.insert(data.end(), reports.Data(), reports.Data() + reports.ElementLength());
+
+  win32_stub::QueueRawInput(RIM_TYPEHID, ReadDevice(info[0]), std::move(data));
+
+  return info.Env().Undefined();
+}
+
+static Napi::Value SetModuleFileName(const Napi::CallbackInfo &info) {
+  win32_stub::SetModuleFileName(win32_stub::FromUtf8(info[0].As<Napi::String>().Utf8Value()));
+
+  return info.Env().Undefined();
+}
+
+static Napi::Value SetProcAddressHidden(const Napi::CallbackInfo &info) {
+  win32_stub::SetProcAddressHidden(info[0].As<Napi::String>().Utf8Value(), info[1].ToBoolean().Value());
+
+  return info.Env().Undefined();
+}
+
+static Napi::Object Initialize(const Napi::Env env, Napi::Object exports) {
+  exports.Set("reset", Napi::Function::New(env, Reset, "reset"));
+  exports.Set("getWindowCount", Napi::Function::New(env, GetWindowCount, "getWindowCount"));
+  exports.Set("getMenuCount", Napi::Function::New(env, GetMenuCount, "getMenuCount"));
+  exports.Set("getObjectCount", Napi::Function::New(env, GetObjectCount, "getObjectCount"));
+  exports.Set("setMessageWaitTimeout", Napi::Function::New(env, SetMessageWaitTimeout, "setMessageWaitTimeout"));
+  exports.Set("setMessageBoxResult", Napi::Function::New(env, SetMessageBoxResult, "setMessageBoxResult"));
+  exports.Set("takeMessageBoxCalls", Napi::Function::New(env, TakeMessageBoxCalls, "takeMessageBoxCalls"));
+  exports.Set("takeSentInput", Napi::Function::New(env, TakeSentInput, "takeSentInput"));
+  exports.Set("queueRawMouse", Napi::Function::New(env, QueueRawMouse, "queueRawMouse"));
+  exports.Set("queueRawKeyboard", Napi::Function::New(env, QueueRawKeyboard, "queueRawKeyboard"));
+  exports.Set("queueRawHid", Napi::Function::New(env, QueueRawHid, "queueRawHid"));
+  exports.Set("setModuleFileName", Napi::Function::New(env, SetModuleFileName, "setModuleFileName"));
+  exports.Set("setProcAddressHidden", Napi::Function::New(env, SetProcAddressHidden, "setProcAddressHidden"));
+
+  return exports;
+}
+
+NODE_API_MODULE(win32_stub, Initialize)
@@ -0,0 +1,509 @@
+#include "win32_stub.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * ReadDirectoryChangesExW over inotify. Every directory handle that has been read from gets a thread that turns inotify
+ * events into FILE_NOTIFY_EXTENDED_INFORMATION records. Records are buffered until a read is outstanding, and, like
+ * Windows, once more of them are buffered than fit in the buffer of the first read, they are dropped and the next read
+ * completes successfully with no data.
+ *
+ * OVERLAPPED.Internal holds STATUS_PENDING until the read completes and the Win32 error it completed with afterwards,
+ * rather than the NTSTATUS Windows stores there; only GetOverlappedResult ever looks at it.
+ */
+
+#ifdef __linux__
+namespace {
+  struct ChangeRecord {
+    DWORD action;
+    std::wstring name;
+  };
+
+  struct PendingRead {
+    LPOVERLAPPED overlapped;
+    uint8_t *buffer;
+    DWORD length;
+  };
+
+  struct DirectoryChanges {
+    HANDLE hDirectory;
+    std::string root;
+    bool recursive;
+    DWORD notifyFilter;
+    size_t capacity;
+
+    int inotifyFd = -1;
+    int wakeFd = -1;
+    int rootWatch = -1;
+    // Path of every watched directory relative to the root, with a trailing slash unless it is the root.
+    std::unordered_map<int, std::string> watches;
+
+    std::vector<ChangeRecord> records;
+    size_t recordBytes = 0;
+    bool overflow = false;
+    DWORD error = ERROR_SUCCESS;
+
+    std::optional<PendingRead> pending;
+    bool stopping = false;
+    std::thread thread;
+
+    ~DirectoryChanges() {
+      if (this->inotifyFd >= 0) {
+        ::close(this->inotifyFd);
+      }
+
+      if (this->wakeFd >= 0) {
+        ::close(this->wakeFd);
+      }
+    }
+  };
+} // namespace
+
+static std::mutex changesMutex;
+static std::unordered_map<HANDLE, std::unique_ptr<DirectoryChanges>> changes;
+
+static size_t RecordSize(const ChangeRecord &record) {
+  const size_t size = offsetof(FILE_NOTIFY_EXTENDED_INFORMATION, FileName) + record.name.size() * sizeof(WCHAR);
+  return (size + 7) & ~static_cast<size_t>(7);
+}
+
+static uint64_t FileTimeOf(const timespec &time) { return win32_stub::ToFileTime(time.tv_sec, time.tv_nsec); }
+
+static void FillRecord(const DirectoryChanges &directory,
+                       const ChangeRecord &record,
+                       FILE_NOTIFY_EXTENDED_INFORMATION &information) {
+  std::memset(&information, 0, offsetof(FILE_NOTIFY_EXTENDED_INFORMATION, FileName));
+
+  information.Action = record.action;
+  information.FileNameLength = static_cast<DWORD>(record.name.size() * sizeof(WCHAR));
+  std::copy(record.name.begin(), record.name.end(), information.FileName);
+
+  // Whatever the file looks like now; a removed file reports zeros, the same as Windows.
+  struct stat status{};
+
+  if (::lstat((directory.root + win32_stub::ToHostPath(record.name)).c_str(), &status) != 0) {
+    return;
+  }
+
+  information.CreationTime.QuadPart = static_cast<LONGLONG>(FileTimeOf(status.st_ctim));
+  information.LastModificationTime.QuadPart = static_cast<LONGLONG>(FileTimeOf(status.st_mtim));
+  information.LastChangeTime.QuadPart = static_cast<LONGLONG>(FileTimeOf(status.st_ctim));
+  information.LastAccessTime.QuadPart = static_cast<LONGLONG>(FileTimeOf(status.st_atim));
+  information.FileId.QuadPart = static_cast<LONGLONG>(status.st_ino);
+  information.FileAttributes = S_ISDIR(status.st_mode) ? FILE_ATTRIBUTE_DIRECTORY : FILE_ATTRIBUTE_NORMAL;
+
+  if (!S_ISDIR(status.st_mode)) {
+    information.FileSize.QuadPart = status.st_size;
+    information.AllocatedLength.QuadPart = status.st_blocks * 512;
+  }
+}
+
+// Completes the outstanding read, if any, with everything buffered or with `directory.error`. Called with the lock held.
+static void Complete(DirectoryChanges &directory, const DWORD error = ERROR_SUCCESS) {
+  if (!directory.pending.has_value()) {
+    return;
+  }
+
+  const PendingRead read = directory.pending.value();
+  const DWORD status = error != ERROR_SUCCESS ? error : directory.error;
+
+  DWORD bytes = 0;
+
+  if (status == ERROR_SUCCESS && !directory.overflow) {
+    FILE_NOTIFY_EXTENDED_INFORMATION *previous = nullptr;
+
+    for (const ChangeRecord &record : directory.records) {
+      const size_t size = RecordSize(record);
+
+      // Buffered records always fit in the first read's buffer, but a later one may have been given a smaller one.
+      if (bytes + size > read.length) {
+        directory.overflow = true;
+        bytes = 0;
+        break;
+      }
+
+      FILE_NOTIFY_EXTENDED_INFORMATION *information =
+          reinterpret_cast<FILE_NOTIFY_EXTENDED_INFORMATION *>(read.buffer + bytes);
+
+      FillRecord(directory, record, *information);
+
+      if (previous != nullptr) {
+        previous->NextEntryOffset =
+            static_cast<DWORD>(reinterpret_cast<uint8_t *>(information) - reinterpret_cast<uint8_t *>(previous));
+      }
+
+      previous = information;
+      bytes += static_cast<DWORD>(size);
+    }
+  }
+
+  directory.records.clear();
+  directory.recordBytes = 0;
+  directory.overflow = false;
+  directory.pending.reset();
+
+  read.overlapped->InternalHigh = bytes;
+  read.overlapped->Internal = status;
+
+  win32_stub::SignalEvent(read.overlapped->hEvent);
+}
+
+static bool WantsChange(const DirectoryChanges &directory, const uint32_t mask) {
+  const bool isDirectory = (mask & IN_ISDIR) != 0;
+
+  if ((mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)) != 0) {
+    return (directory.notifyFilter & (isDirectory ? FILE_NOTIFY_CHANGE_DIR_NAME : FILE_NOTIFY_CHANGE_FILE_NAME)) != 0;
+  }
+
+  if ((mask & IN_MODIFY) != 0) {
+    return (directory.notifyFilter & (FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE)) != 0;
+  }
+
+  if ((mask & IN_ATTRIB) != 0) {
+    return (directory.notifyFilter & (FILE_NOTIFY_CHANGE_ATTRIBUTES | FILE_NOTIFY_CHANGE_LAST_WRITE)) != 0;
+  }
+
+  return false;
+}
+
+static constexpr uint32_t WATCH_MASK =
+    IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_DONT_FOLLOW;
+
+// Watches `relative` and, for recursive reads, everything below it.
+static void AddWatches(DirectoryChanges &directory, const std::string &relative) {
+  const int watch = ::inotify_add_watch(
+      directory.inotifyFd, (directory.root + relative).c_str(), WATCH_MASK | (relative.empty() ? IN_DELETE_SELF : 0));
+
+  if (watch < 0) {
+    return;
+  }
+
+  directory.watches[watch] = relative;
+
+  if (!directory.recursive) {
+    return;
+  }
+
+  DIR *dir = ::opendir((directory.root + relative).c_str());
+
+  if (dir == nullptr) {
+    return;
+  }
+
+  while (const dirent *entry = ::readdir(dir)) {
+    if (entry->d_type == DT_DIR && std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0) {
+      AddWatches(directory, relative + entry->d_name + "/");
+    }
+  }
+
+  ::closedir(dir);
+}
+
+static void Buffer(DirectoryChanges &directory, const DWORD action, const std::string &relative) {
+  std::wstring name = win32_stub::FromUtf8(relative);
+  std::replace(name.begin(), name.end(), L'/', L'\\');
+
+  ChangeRecord record{action, std::move(name)};
+  const size_t size = RecordSize(record);
+
+  if (directory.overflow || directory.recordBytes + size > directory.capacity) {
+    directory.overflow = true;
+    directory.records.clear();
+    directory.recordBytes = 0;
+    return;
+  }
+
+  directory.records.push_back(std::move(record));
+  directory.recordBytes += size;
+}
+
+static void HandleEvent(DirectoryChanges &directory, const inotify_event &event) {
+  if ((event.mask & IN_Q_OVERFLOW) != 0) {
+    directory.overflow = true;
+    return;
+  }
+
+  const auto watch = directory.watches.find(event.wd);
+
+  if (watch == directory.watches.end()) {
+    return;
+  }
+
+  if ((event.mask & (IN_DELETE_SELF | IN_IGNORED)) != 0) {
+    if (event.wd == directory.rootWatch) {
+      // The directory itself is gone; Windows fails the outstanding read and every read after it.
+      directory.error = ERROR_ACCESS_DENIED;
+    }
+
+    if ((event.mask & IN_IGNORED) != 0) {
+      directory.watches.erase(watch);
+    }
+
+    return;
+  }
+
+  if (event.len == 0 || !WantsChange(directory, event.mask)) {
+    return;
+  }
+
+  const std::string relative = watch->second + event.name;
+
+  if ((event.mask & IN_CREATE) != 0) {
+    Buffer(directory, FILE_ACTION_ADDED, relative);
+  } else if ((event.mask & IN_DELETE) != 0) {
+    Buffer(directory, FILE_ACTION_REMOVED, relative);
+  } else if ((event.mask & IN_MOVED_FROM) != 0) {
+    Buffer(directory, FILE_ACTION_RENAMED_OLD_NAME, relative);
+  } else if ((event.mask & IN_MOVED_TO) != 0) {
+    Buffer(directory, FILE_ACTION_RENAMED_NEW_NAME, relative);
+  } else {
+    Buffer(directory, FILE_ACTION_MODIFIED, relative);
+  }
+
+  // New directories are watched as soon as they are seen. Anything created in them before that is missed.
+  if (directory.recursive && (event.mask & IN_ISDIR) != 0 && (event.mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+    AddWatches(directory, relative + "/");
+  }
+}
+
+static void Run(DirectoryChanges *directory) {
+  alignas(inotify_event) char buffer[16 * 1024];
+
+  while (true) {
+    pollfd fds[2] = {{directory->inotifyFd, POLLIN, 0}, {directory->wakeFd, POLLIN, 0}};
+
+    if (::poll(fds, 2, -1) < 0 && errno != EINTR) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(changesMutex);
+
+    if (directory->stopping) {
+      return;
+    }
+
+    if ((fds[0].revents & POLLIN) == 0) {
+      continue;
+    }
+
+    const ssize_t length = ::read(directory->inotifyFd, buffer, sizeof(buffer));
+
+    for (ssize_t offset = 0; offset < length;) {
+      const inotify_event &event = *reinterpret_cast<const inotify_event *>(buffer + offset);
+
+      HandleEvent(*directory, event);
+
+      offset += static_cast<ssize_t>(sizeof(inotify_event) + event.len);
+    }
+
+    if (!directory->records.empty() || directory->overflow || directory->error != ERROR_SUCCESS) {
+      Complete(*directory);
+    }
+  }
+}
+
+static std::string DirectoryPath(const int fd) {
+  char path[4096];
+  const ssize_t length = ::readlink(("/proc/self/fd/" + std::to_string(fd)).c_str(), path, sizeof(path) - 1);
+
+  return length < 0 ? std::string() : std::string(path, length) + "/";
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI ReadDirectoryChangesExW(const HANDLE hDirectory,
+                                                      const LPVOID lpBuffer,
+                                                      const DWORD nBufferLength,
+                                                      const BOOL bWatchSubtree,
+                                                      const DWORD dwNotifyFilter,
+                                                      const LPDWORD lpBytesReturned,
+                                                      const LPOVERLAPPED lpOverlapped,
+                                                      const LPOVERLAPPED_COMPLETION_ROUTINE lpCompletionRoutine,
+                                                      const READ_DIRECTORY_NOTIFY_INFORMATION_CLASS ReadDirectoryNotifyInformationClass) {
+  // Only what the bindings use: extended records, read through an OVERLAPPED with an event.
+  if (ReadDirectoryNotifyInformationClass != ReadDirectoryNotifyExtendedInformation || lpOverlapped == nullptr ||
+      lpOverlapped->hEvent == nullptr || lpCompletionRoutine != nullptr) {
+    ::SetLastError(ERROR_NOT_SUPPORTED);
+    return FALSE;
+  }
+
+  if (dwNotifyFilter == 0 || lpBuffer == nullptr || (reinterpret_cast<uintptr_t>(lpBuffer) & 7) != 0) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return FALSE;
+  }
+
+  const int fd = win32_stub::FileDescriptor(hDirectory);
+
+  if (fd < 0) {
+    ::SetLastError(ERROR_INVALID_HANDLE);
+    return FALSE;
+  }
+
+  std::lock_guard<std::mutex> lock(changesMutex);
+
+  std::unique_ptr<DirectoryChanges> &slot = changes[hDirectory];
+
+  // The first read decides what is watched and how much is buffered between reads, same as on Windows.
+  if (!slot) {
+    const std::string root = DirectoryPath(fd);
+
+    struct stat status{};
+
+    if (root.empty() || ::stat(root.c_str(), &status) != 0 || !S_ISDIR(status.st_mode)) {
+      changes.erase(hDirectory);
+      ::SetLastError(ERROR_INVALID_FUNCTION);
+      return FALSE;
+    }
+
+    auto directory = std::make_unique<DirectoryChanges>();
+    directory->hDirectory = hDirectory;
+    directory->root = root;
+    directory->recursive = bWatchSubtree != FALSE;
+    directory->notifyFilter = dwNotifyFilter;
+    directory->capacity = nBufferLength;
+    directory->inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    directory->wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (directory->inotifyFd < 0 || directory->wakeFd < 0) {
+      changes.erase(hDirectory);
+      ::SetLastError(win32_stub::FromErrno(errno));
+      return FALSE;
+    }
+
+    AddWatches(*directory, "");
+
+    const auto root_watch = std::find_if(directory->watches.begin(),
+                                         directory->watches.end(),
+                                         [](const auto &watch) { return watch.second.empty(); });
+    directory->rootWatch = root_watch != directory->watches.end() ? root_watch->first : -1;
+    directory->thread = std::thread(Run, directory.get());
+
+    slot = std::move(directory);
+  }
+
+  DirectoryChanges &directory = *slot;
+
+  if (directory.pending.has_value()) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return FALSE;
+  }
+
+  lpOverlapped->Internal = STATUS_PENDING;
+  lpOverlapped->InternalHigh = 0;
+
+  directory.pending = PendingRead{lpOverlapped, static_cast<uint8_t *>(lpBuffer), nBufferLength};
+
+  if (!directory.records.empty() || directory.overflow || directory.error != ERROR_SUCCESS) {
+    Complete(directory);
+  }
+
+  return TRUE;
+}
+
+void win32_stub::CloseDirectoryChanges(const HANDLE hDirectory) {
+  std::unique_ptr<DirectoryChanges> directory;
+
+  {
+    std::lock_guard<std::mutex> lock(changesMutex);
+
+    const auto it = changes.find(hDirectory);
+
+    if (it == changes.end()) {
+      return;
+    }
+
+    directory = std::move(it->second);
+    changes.erase(it);
+
+    directory->stopping = true;
+
+    const uint64_t wake = 1;
+    [[maybe_unused]] const ssize_t written = ::write(directory->wakeFd, &wake, sizeof(wake));
+  }
+
+  directory->thread.join();
+
+  // Closing the handle cancels the read still outstanding on it.
+  std::lock_guard<std::mutex> lock(changesMutex);
+  Complete(*directory, ERROR_OPERATION_ABORTED);
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI CancelIoEx(const HANDLE hFile, const LPOVERLAPPED lpOverlapped) {
+  if (win32_stub::FileDescriptor(hFile) < 0) {
+    ::SetLastError(ERROR_INVALID_HANDLE);
+    return FALSE;
+  }
+
+  std::lock_guard<std::mutex> lock(changesMutex);
+
+  const auto it = changes.find(hFile);
+
+  if (it == changes.end() || !it->second->pending.has_value() ||
+      (lpOverlapped != nullptr && it->second->pending->overlapped != lpOverlapped)) {
+    ::SetLastError(ERROR_NOT_FOUND);
+    return FALSE;
+  }
+
+  Complete(*it->second, ERROR_OPERATION_ABORTED);
+
+  return TRUE;
+}
+#else
+WIN32_STUB_EXPORT BOOL WINAPI ReadDirectoryChangesExW(HANDLE,
+                                                      LPVOID,
+                                                      DWORD,
+                                                      BOOL,
+                                                      DWORD,
+                                                      LPDWORD,
+                                                      LPOVERLAPPED,
+                                                      LPOVERLAPPED_COMPLETION_ROUTINE,
+                                                      READ_DIRECTORY_NOTIFY_INFORMATION_CLASS) {
+  ::SetLastError(ERROR_NOT_SUPPORTED);
+  return FALSE;
+}
+
+void win32_stub::CloseDirectoryChanges(HANDLE) {}
+
+WIN32_STUB_EXPORT BOOL WINAPI CancelIoEx(HANDLE, LPOVERLAPPED) {
+  ::SetLastError(ERROR_NOT_FOUND);
+  return FALSE;
+}
+#endif
+
+WIN32_STUB_EXPORT BOOL WINAPI GetOverlappedResult(const HANDLE hFile,
+                                                  const LPOVERLAPPED lpOverlapped,
+                                                  const LPDWORD lpNumberOfBytesTransferred,
+                                                  const BOOL bWait) {
+  if (lpOverlapped->Internal == STATUS_PENDING) {
+    if (!bWait) {
+      ::SetLastError(ERROR_IO_INCOMPLETE);
+      return FALSE;
+    }
+
+    ::WaitForSingleObject(lpOverlapped->hEvent, INFINITE);
+  }
+
+  *lpNumberOfBytesTransferred = static_cast<DWORD>(lpOverlapped->InternalHigh);
+
+  if (lpOverlapped->Internal != ERROR_SUCCESS) {
+    ::SetLastError(static_cast<DWORD>(lpOverlapped->Internal));
+    return FALSE;
+  }
+
+  return TRUE;
+}
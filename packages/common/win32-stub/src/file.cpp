@@ -0,0 +1,251 @@
+#include "win32_stub.hpp"
+
+#include <cerrno>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+  struct File : win32_stub::Object {
+    const int fd;
+
+    explicit File(const int fd) : Object(win32_stub::ObjectKind::File), fd(fd) {}
+    ~File() override { ::close(this->fd); }
+  };
+
+  struct Find : win32_stub::Object {
+    DIR *const dir;
+    // Empty to match every entry, otherwise the one name to match.
+    const std::string name;
+
+    Find(DIR *dir, std::string name) : Object(win32_stub::ObjectKind::Find), dir(dir), name(std::move(name)) {}
+    ~Find() override { ::closedir(this->dir); }
+  };
+} // namespace
+
+int win32_stub::FileDescriptor(const HANDLE handle) {
+  const File *file = static_cast<const File *>(FindObject(handle, ObjectKind::File));
+  return file != nullptr ? file->fd : -1;
+}
+
+WIN32_STUB_EXPORT HANDLE WINAPI CreateFileW(const LPCWSTR lpFileName,
+                                            const DWORD dwDesiredAccess,
+                                            const DWORD dwShareMode,
+                                            const LPSECURITY_ATTRIBUTES lpSecurityAttributes,
+                                            const DWORD dwCreationDisposition,
+                                            const DWORD dwFlagsAndAttributes,
+                                            const HANDLE hTemplateFile) {
+  const std::string path = win32_stub::ToHostPath(lpFileName);
+
+  struct stat status{};
+  const bool exists = ::stat(path.c_str(), &status) == 0;
+
+  // Directories can only be opened with backup semantics, and only to list them or read changes from them.
+  if (exists && S_ISDIR(status.st_mode)) {
+    if ((dwFlagsAndAttributes & FILE_FLAG_BACKUP_SEMANTICS) == 0 || dwCreationDisposition != OPEN_EXISTING) {
+      ::SetLastError(ERROR_ACCESS_DENIED);
+      return INVALID_HANDLE_VALUE;
+    }
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (fd < 0) {
+      ::SetLastError(win32_stub::FromErrno(errno));
+      return INVALID_HANDLE_VALUE;
+    }
+
+    return win32_stub::AddObject(new File(fd));
+  }
+
+  const bool read = (dwDesiredAccess & GENERIC_READ) != 0;
+  const bool write = (dwDesiredAccess & GENERIC_WRITE) != 0;
+
+  int flags = O_CLOEXEC | (read && write ? O_RDWR : write ? O_WRONLY : O_RDONLY);
+
+  switch (dwCreationDisposition) {
+  case CREATE_NEW:
+    flags |= O_CREAT | O_EXCL;
+    break;
+  case CREATE_ALWAYS:
+    flags |= O_CREAT | O_TRUNC;
+    break;
+  case OPEN_EXISTING:
+    break;
+  case OPEN_ALWAYS:
+    flags |= O_CREAT;
+    break;
+  case TRUNCATE_EXISTING:
+    flags |= O_TRUNC;
+    break;
+  default:
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return INVALID_HANDLE_VALUE;
+  }
+
+  const int fd = ::open(path.c_str(), flags, 0666);
+
+  if (fd < 0) {
+    // A missing parent directory is a missing path, not a missing file.
+    ::SetLastError(errno == ENOENT && (flags & O_CREAT) != 0 ? ERROR_PATH_NOT_FOUND : win32_stub::FromErrno(errno));
+    return INVALID_HANDLE_VALUE;
+  }
+
+  // CREATE_ALWAYS and OPEN_ALWAYS report whether the file was already there.
+  ::SetLastError(exists && (dwCreationDisposition == CREATE_ALWAYS || dwCreationDisposition == OPEN_ALWAYS)
+                     ? ERROR_ALREADY_EXISTS
+                     : ERROR_SUCCESS);
+
+  return win32_stub::AddObject(new File(fd));
+}
+
+/**** Find ************************************************************************************************************/
+
+static FILETIME ToFileTime(const timespec &time) {
+  const uint64_t ticks = win32_stub::ToFileTime(time.tv_sec, time.tv_nsec);
+  return {static_cast<DWORD>(ticks), static_cast<DWORD>(ticks >> 32)};
+}
+
+/**
+ * Fills `data` for entry `name` of `dir`. Symbolic links are reported as reparse points, with the directory attribute
+ * set when they point at a directory, which is what a symbolic link or junction looks like on NTFS.
+ */
+static bool FillFindData(DIR *dir, const char *name, WIN32_FIND_DATAW &data) {
+  struct stat status{};
+
+  if (::fstatat(::dirfd(dir), name, &status, AT_SYMLINK_NOFOLLOW) != 0) {
+    return false;
+  }
+
+  DWORD attributes = 0;
+
+  if (S_ISLNK(status.st_mode)) {
+    struct stat target{};
+
+    attributes |= FILE_ATTRIBUTE_REPARSE_POINT;
+
+    if (::fstatat(::dirfd(dir), name, &target, 0) == 0 && S_ISDIR(target.st_mode)) {
+      attributes |= FILE_ATTRIBUTE_DIRECTORY;
+    }
+  } else if (S_ISDIR(status.st_mode)) {
+    attributes |= FILE_ATTRIBUTE_DIRECTORY;
+  }
+
+  if ((status.st_mode & S_IWUSR) == 0) {
+    attributes |= FILE_ATTRIBUTE_READONLY;
+  }
+
+  data = {};
+  data.dwFileAttributes = attributes != 0 ? attributes : FILE_ATTRIBUTE_NORMAL;
+
+  if (!S_ISDIR(status.st_mode)) {
+    data.nFileSizeHigh = static_cast<DWORD>(static_cast<uint64_t>(status.st_size) >> 32);
+    data.nFileSizeLow = static_cast<DWORD>(status.st_size);
+  }
+
+#ifdef __APPLE__
+  data.ftCreationTime = ToFileTime(status.st_birthtimespec);
+  data.ftLastAccessTime = ToFileTime(status.st_atimespec);
+  data.ftLastWriteTime = ToFileTime(status.st_mtimespec);
+#else
+  data.ftCreationTime = ToFileTime(status.st_ctim);
+  data.ftLastAccessTime = ToFileTime(status.st_atim);
+  data.ftLastWriteTime = ToFileTime(status.st_mtim);
+#endif
+
+  const std::wstring fileName = win32_stub::FromUtf8(name);
+  win32_stub::CopyString(fileName, data.cFileName, MAX_PATH);
+
+  return true;
+}
+
+// Advances `find` to its next matching entry. Fails with ERROR_NO_MORE_FILES at the end of the directory.
+static bool NextEntry(Find &find, WIN32_FIND_DATAW &data) {
+  while (true) {
+    errno = 0;
+
+    const dirent *entry = ::readdir(find.dir);
+
+    if (entry == nullptr) {
+      ::SetLastError(errno == 0 ? ERROR_NO_MORE_FILES : win32_stub::FromErrno(errno));
+      return false;
+    }
+
+    if (!find.name.empty() && find.name != entry->d_name) {
+      continue;
+    }
+
+    // Removed between being listed and being looked at.
+    if (!FillFindData(find.dir, entry->d_name, data)) {
+      continue;
+    }
+
+    return true;
+  }
+}
+
+WIN32_STUB_EXPORT HANDLE WINAPI FindFirstFileExW(const LPCWSTR lpFileName,
+                                                 const FINDEX_INFO_LEVELS fInfoLevelId,
+                                                 const LPVOID lpFindFileData,
+                                                 const FINDEX_SEARCH_OPS fSearchOp,
+                                                 const LPVOID lpSearchFilter,
+                                                 const DWORD dwAdditionalFlags) {
+  // FindExSearchLimitToDirectories is only advisory on Windows too, so it lists everything.
+  if (fInfoLevelId >= FindExInfoMaxInfoLevel || fSearchOp > FindExSearchLimitToDirectories ||
+      lpSearchFilter != nullptr) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return INVALID_HANDLE_VALUE;
+  }
+
+  const std::string pattern = win32_stub::ToHostPath(lpFileName);
+  const size_t separator = pattern.rfind('/');
+
+  const std::string directory = separator == std::string::npos ? "." : separator == 0 ? "/" : pattern.substr(0, separator);
+  std::string name = separator == std::string::npos ? pattern : pattern.substr(separator + 1);
+
+  if (name == "*" || name == "*.*") {
+    name.clear();
+  } else if (name.empty() || name.find_first_of("*?") != std::string::npos) {
+    // Only "every entry" and exact names are supported, which is all the bindings ask for.
+    ::SetLastError(name.empty() ? ERROR_FILE_NOT_FOUND : ERROR_NOT_SUPPORTED);
+    return INVALID_HANDLE_VALUE;
+  }
+
+  DIR *dir = ::opendir(directory.c_str());
+
+  if (dir == nullptr) {
+    ::SetLastError(errno == ENOENT ? ERROR_PATH_NOT_FOUND : win32_stub::FromErrno(errno));
+    return INVALID_HANDLE_VALUE;
+  }
+
+  Find *find = new Find(dir, std::move(name));
+
+  if (!NextEntry(*find, *static_cast<LPWIN32_FIND_DATAW>(lpFindFileData))) {
+    delete find;
+    ::SetLastError(ERROR_FILE_NOT_FOUND);
+    return INVALID_HANDLE_VALUE;
+  }
+
+  return win32_stub::AddObject(find);
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI FindNextFileW(const HANDLE hFindFile, const LPWIN32_FIND_DATAW lpFindFileData) {
+  Find *find = static_cast<Find *>(win32_stub::FindObject(hFindFile, win32_stub::ObjectKind::Find));
+
+  if (find == nullptr) {
+    ::SetLastError(ERROR_INVALID_HANDLE);
+    return FALSE;
+  }
+
+  return NextEntry(*find, *lpFindFileData) ? TRUE : FALSE;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI FindClose(const HANDLE hFindFile) {
+  if (win32_stub::FindObject(hFindFile, win32_stub::ObjectKind::Find) == nullptr) {
+    ::SetLastError(ERROR_INVALID_HANDLE);
+    return FALSE;
+  }
+
+  return ::CloseHandle(hFindFile);
+}
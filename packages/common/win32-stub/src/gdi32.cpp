@@ -0,0 +1,4 @@
+#include "win32_stub.hpp"
+
+// No GDI objects are ever created; DeleteObject only has to accept the handles bindings hand it.
+WIN32_STUB_EXPORT BOOL WINAPI DeleteObject(const HGDIOBJ ho) { return ho != nullptr ? TRUE : FALSE; }
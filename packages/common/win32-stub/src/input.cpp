@@ -0,0 +1,108 @@
+#include "win32_stub.hpp"
+
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/**
+ * Synthesized input is recorded instead of injected, and raw input only ever comes from records a test queued. Record
+ * sizes and alignment follow the 64-bit layout, so a buffer that is too small on Windows is too small here as well.
+ */
+
+static std::mutex inputMutex;
+static std::vector<uint8_t> sentInput;
+static std::deque<std::vector<uint8_t>> rawInput;
+
+WIN32_STUB_EXPORT UINT WINAPI SendInput(const UINT cInputs, const LPINPUT pInputs, const int cbSize) {
+  if (cbSize != sizeof(INPUT)) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return 0;
+  }
+
+  std::lock_guard<std::mutex> lock(inputMutex);
+
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(pInputs);
+  sentInput.insert(sentInput.end(), data, data + static_cast<size_t>(cInputs) * sizeof(INPUT));
+
+  return cInputs;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI RegisterRawInputDevices(const PCRAWINPUTDEVICE pRawInputDevices,
+                                                      const UINT uiNumDevices,
+                                                      const UINT cbSize) {
+  if (cbSize != sizeof(RAWINPUTDEVICE) || pRawInputDevices == nullptr || uiNumDevices == 0) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT UINT WINAPI GetRawInputBuffer(const PRAWINPUT pData, const PUINT pcbSize, const UINT cbSizeHeader) {
+  if (cbSizeHeader != sizeof(RAWINPUTHEADER) || pcbSize == nullptr) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return static_cast<UINT>(-1);
+  }
+
+  std::lock_guard<std::mutex> lock(inputMutex);
+
+  // Without a buffer, report how much the next record needs.
+  if (pData == nullptr) {
+    *pcbSize = rawInput.empty() ? 0 : static_cast<UINT>(rawInput.front().size());
+    return 0;
+  }
+
+  uint8_t *base = reinterpret_cast<uint8_t *>(pData);
+  size_t offset = 0;
+  UINT count = 0;
+
+  while (!rawInput.empty()) {
+    const std::vector<uint8_t> &record = rawInput.front();
+    const size_t start = RAWINPUT_ALIGN(offset);
+
+    if (start + record.size() > *pcbSize) {
+      break;
+    }
+
+    std::memcpy(base + start, record.data(), record.size());
+
+    offset = start + record.size();
+    count++;
+    rawInput.pop_front();
+  }
+
+  // A buffer that can't hold even the first record is an error, not an empty read, and the record stays queued.
+  if (count == 0 && !rawInput.empty()) {
+    *pcbSize = static_cast<UINT>(rawInput.front().size());
+    ::SetLastError(ERROR_INSUFFICIENT_BUFFER);
+    return static_cast<UINT>(-1);
+  }
+
+  return count;
+}
+
+std::vector<uint8_t> win32_stub::TakeSentInput() {
+  std::lock_guard<std::mutex> lock(inputMutex);
+
+  return std::exchange(sentInput, {});
+}
+
+void win32_stub::QueueRawInput(const DWORD type, const HANDLE hDevice, std::vector<uint8_t> data) {
+  const RAWINPUTHEADER header{type, static_cast<DWORD>(sizeof(RAWINPUTHEADER) + data.size()), hDevice, 0};
+
+  std::vector<uint8_t> record(sizeof(RAWINPUTHEADER));
+  std::memcpy(record.data(), &header, sizeof(RAWINPUTHEADER));
+  record.insert(record.end(), data.begin(), data.end());
+
+  std::lock_guard<std::mutex> lock(inputMutex);
+
+  rawInput.push_back(std::move(record));
+}
+
+void win32_stub::ResetInput() {
+  std::lock_guard<std::mutex> lock(inputMutex);
+
+  sentInput.clear();
+  rawInput.clear();
+}
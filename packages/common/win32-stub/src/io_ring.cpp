@@ -0,0 +1,348 @@
+#include "win32_stub.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <ioringapi.h>
+
+/**
+ * IoRing without a kernel queue. Build calls append to the submission queue and SubmitIoRing runs every queued entry
+ * synchronously with pread and pwrite, in order, so there is never anything left in flight to wait for. Queue sizes and
+ * the HRESULTs for a full queue, an unknown ring or a bad registration match Windows 11.
+ */
+
+namespace {
+  struct RegisterFiles {
+    std::vector<HANDLE> handles;
+  };
+
+  struct RegisterBuffers {
+    std::vector<IORING_BUFFER_INFO> buffers;
+  };
+
+  struct Transfer {
+    bool write;
+    IORING_HANDLE_REF file;
+    IORING_BUFFER_REF buffer;
+    UINT32 length;
+    UINT64 offset;
+    // Set for scatter/gather instead of `buffer`, one page each.
+    std::vector<FILE_SEGMENT_ELEMENT> segments;
+  };
+
+  struct Entry {
+    std::variant<RegisterFiles, RegisterBuffers, Transfer> operation;
+    UINT_PTR userData;
+  };
+
+  struct IoRing {
+    UINT32 submissionQueueSize;
+    UINT32 completionQueueSize;
+
+    std::vector<Entry> submissions;
+    std::deque<IORING_CQE> completions;
+
+    std::vector<HANDLE> files;
+    std::vector<IORING_BUFFER_INFO> buffers;
+  };
+} // namespace
+
+static std::mutex ringsMutex;
+static std::unordered_set<IoRing *> rings;
+
+// Scatter/gather segments are one page each, and IoRing is only available on x64 and ARM64.
+static constexpr UINT32 PAGE_SIZE = 4096;
+
+// Largest queues Windows accepts; bigger requests fail instead of being clamped.
+static constexpr UINT32 MAX_SUBMISSION_QUEUE_SIZE = 0x10000;
+static constexpr UINT32 MAX_COMPLETION_QUEUE_SIZE = 0x20000;
+
+static IoRing *FindRing(const HIORING ioRing) {
+  IoRing *ring = reinterpret_cast<IoRing *>(ioRing);
+  return rings.contains(ring) ? ring : nullptr;
+}
+
+WIN32_STUB_EXPORT HRESULT WINAPI CreateIoRing(const IORING_VERSION ioringVersion,
+                                              const IORING_CREATE_FLAGS flags,
+                                              const UINT32 submissionQueueSize,
+                                              const UINT32 completionQueueSize,
+                                              HIORING *h) {
+  if (ioringVersion != IORING_VERSION_1 && ioringVersion != IORING_VERSION_2 && ioringVersion != IORING_VERSION_3) {
+    return IORING_E_VERSION_NOT_SUPPORTED;
+  }
+
+  if (flags.Required != IORING_CREATE_REQUIRED_FLAGS_NONE) {
+    return IORING_E_REQUIRED_FLAG_NOT_SUPPORTED;
+  }
+
+  if (submissionQueueSize > MAX_SUBMISSION_QUEUE_SIZE) {
+    return IORING_E_SUBMISSION_QUEUE_TOO_BIG;
+  }
+
+  if (completionQueueSize > MAX_COMPLETION_QUEUE_SIZE) {
+    return IORING_E_COMPLETION_QUEUE_TOO_BIG;
+  }
+
+  if (h == nullptr || submissionQueueSize == 0 || completionQueueSize == 0) {
+    return E_INVALIDARG;
+  }
+
+  IoRing *ring = new IoRing{submissionQueueSize, completionQueueSize, {}, {}, {}, {}};
+
+  {
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    rings.insert(ring);
+  }
+
+  *h = reinterpret_cast<HIORING>(ring);
+
+  return S_OK;
+}
+
+WIN32_STUB_EXPORT HRESULT WINAPI CloseIoRing(const HIORING ioRing) {
+  std::lock_guard<std::mutex> lock(ringsMutex);
+
+  IoRing *ring = FindRing(ioRing);
+
+  if (ring == nullptr) {
+    return E_HANDLE;
+  }
+
+  rings.erase(ring);
+  delete ring;
+
+  return S_OK;
+}
+
+static HRESULT Queue(const HIORING ioRing, Entry entry) {
+  std::lock_guard<std::mutex> lock(ringsMutex);
+
+  IoRing *ring = FindRing(ioRing);
+
+  if (ring == nullptr) {
+    return E_HANDLE;
+  }
+
+  if (ring->submissions.size() >= ring->submissionQueueSize) {
+    return IORING_E_SUBMISSION_QUEUE_FULL;
+  }
+
+  ring->submissions.push_back(std::move(entry));
+
+  return S_OK;
+}
+
+WIN32_STUB_EXPORT HRESULT WINAPI BuildIoRingRegisterFileHandles(const HIORING ioRing,
+                                                                const UINT32 count,
+                                                                const HANDLE handles[],
+                                                                const UINT_PTR userData) {
+  return Queue(ioRing, {RegisterFiles{std::vector<HANDLE>(handles, handles + count)}, userData});
+}
+
+WIN32_STUB_EXPORT HRESULT WINAPI BuildIoRingRegisterBuffers(const HIORING ioRing,
+                                                            const UINT32 count,
+                                                            const IORING_BUFFER_INFO buffers[],
+                                                            const UINT_PTR userData) {
+  return Queue(ioRing, {RegisterBuffers{std::vector<IORING_BUFFER_INFO>(buffers, buffers + count)}, userData});
+}
+
+WIN32_STUB_EXPORT HRESULT WINAPI BuildIoRingReadFile(const HIORING ioRing,
+                                                     const IORING_HANDLE_REF fileRef,
+                                                     const IORING_BUFFER_REF dataRef,
+                                                     const UINT32 numberOfBytesToRead,
+                                                     const UINT64 fileOffset,
+                                                     const UINT_PTR userData,
+                                                     const IORING_SQE_FLAGS) {
+  return Queue(ioRing, {Transfer{false, fileRef, dataRef, numberOfBytesToRead, fileOffset, {}}, userData});
+}
+
+WIN32_STUB_EXPORT HRESULT WINAPI BuildIoRingWriteFile(const HIORING ioRing,
+                                                      const IORING_HANDLE_REF fileRef,
+                                                      const IORING_BUFFER_REF bufferRef,
+                                                      const UINT32 numberOfBytesToWrite,
+                                                      const UINT64 fileOffset,
+                                                      const FILE_WRITE_FLAGS,
+                                                      const UINT_PTR userData,
+                                                      const IORING_SQE_FLAGS) {
+  return Queue(ioRing, {Transfer{true, fileRef, bufferRef, numberOfBytesToWrite, fileOffset, {}}, userData});
+}
+
+// Shared by BuildIoRingReadFileScatter and BuildIoRingWriteFileGather; the segments have to cover the whole transfer.
+static HRESULT QueueSegments(const HIORING ioRing,
+                             const bool write,
+                             const IORING_HANDLE_REF fileRef,
+                             const UINT32 segmentCount,
+                             const FILE_SEGMENT_ELEMENT segmentArray[],
+                             const UINT32 length,
+                             const UINT64 fileOffset,
+                             const UINT_PTR userData) {
+  if (segmentArray == nullptr || segmentCount == 0 || static_cast<uint64_t>(segmentCount) * PAGE_SIZE < length) {
+    return E_INVALIDARG;
+  }
+
+  const IORING_BUFFER_REF unused(nullptr);
+  std::vector<FILE_SEGMENT_ELEMENT> segments(segmentArray, segmentArray + segmentCount);
+
+  return Queue(ioRing, {Transfer{write, fileRef, unused, length, fileOffset, std::move(segments)}, userData});
+}
+
+WIN32_STUB_EXPORT HRESULT WINAPI BuildIoRingReadFileScatter(const HIORING ioRing,
+                                                            const IORING_HANDLE_REF fileRef,
+                                                            const UINT32 segmentCount,
+                                                            FILE_SEGMENT_ELEMENT segmentArray[],
+                                                            const UINT32 numberOfBytesToRead,
+                                                            const UINT64 fileOffset,
+                                                            const UINT_PTR userData,
+                                                            const IORING_SQE_FLAGS) {
+  return QueueSegments(ioRing, false, fileRef, segmentCount, segmentArray, numberOfBytesToRead, fileOffset, userData);
+}
+
+WIN32_STUB_EXPORT HRESULT WINAPI BuildIoRingWriteFileGather(const HIORING ioRing,
+                                                            const IORING_HANDLE_REF fileRef,
+                                                            const UINT32 segmentCount,
+                                                            FILE_SEGMENT_ELEMENT segmentArray[],
+                                                            const UINT32 numberOfBytesToWrite,
+                                                            const UINT64 fileOffset,
+                                                            const FILE_WRITE_FLAGS,
+                                                            const UINT_PTR userData,
+                                                            const IORING_SQE_FLAGS) {
+  return QueueSegments(ioRing, true, fileRef, segmentCount, segmentArray, numberOfBytesToWrite, fileOffset, userData);
+}
+
+// Runs one read or write. Returns the CQE's result code and sets `transferred` to the bytes moved.
+static HRESULT RunTransfer(const IoRing &ring, const Transfer &transfer, ULONG_PTR &transferred) {
+  HANDLE file = transfer.file.HandleUnion.Handle;
+
+  if (transfer.file.Kind == IORING_REF_REGISTERED) {
+    if (transfer.file.HandleUnion.Index >= ring.files.size()) {
+      return E_INVALIDARG;
+    }
+
+    file = ring.files[transfer.file.HandleUnion.Index];
+  }
+
+  const int fd = win32_stub::FileDescriptor(file);
+
+  if (fd < 0) {
+    return HRESULT_FROM_WIN32(ERROR_INVALID_HANDLE);
+  }
+
+  if (!transfer.segments.empty()) {
+    std::vector<iovec> vectors;
+
+    for (UINT32 remaining = transfer.length; remaining > 0; remaining -= std::min(remaining, PAGE_SIZE)) {
+      vectors.push_back({transfer.segments[vectors.size()].Buffer, std::min(remaining, PAGE_SIZE)});
+    }
+
+    const ssize_t result =
+        transfer.write
+            ? ::pwritev(fd, vectors.data(), static_cast<int>(vectors.size()), static_cast<off_t>(transfer.offset))
+            : ::preadv(fd, vectors.data(), static_cast<int>(vectors.size()), static_cast<off_t>(transfer.offset));
+
+    if (result < 0) {
+      return HRESULT_FROM_WIN32(win32_stub::FromErrno(errno));
+    }
+
+    transferred = static_cast<ULONG_PTR>(result);
+
+    return S_OK;
+  }
+
+  uint8_t *data = static_cast<uint8_t *>(transfer.buffer.BufferUnion.Address);
+
+  if (transfer.buffer.Kind == IORING_REF_REGISTERED) {
+    const IORING_REGISTERED_BUFFER registered = transfer.buffer.BufferUnion.IndexAndOffset;
+
+    if (registered.BufferIndex >= ring.buffers.size()) {
+      return E_INVALIDARG;
+    }
+
+    const IORING_BUFFER_INFO &buffer = ring.buffers[registered.BufferIndex];
+
+    if (static_cast<uint64_t>(registered.Offset) + transfer.length > buffer.Length) {
+      return E_INVALIDARG;
+    }
+
+    data = static_cast<uint8_t *>(buffer.Address) + registered.Offset;
+  }
+
+  const ssize_t result = transfer.write ? ::pwrite(fd, data, transfer.length, static_cast<off_t>(transfer.offset))
+                                        : ::pread(fd, data, transfer.length, static_cast<off_t>(transfer.offset));
+
+  if (result < 0) {
+    return HRESULT_FROM_WIN32(win32_stub::FromErrno(errno));
+  }
+
+  transferred = static_cast<ULONG_PTR>(result);
+
+  return S_OK;
+}
+
+WIN32_STUB_EXPORT HRESULT WINAPI SubmitIoRing(const HIORING ioRing,
+                                              const UINT32,
+                                              const UINT32,
+                                              UINT32 *submittedEntries) {
+  std::lock_guard<std::mutex> lock(ringsMutex);
+
+  IoRing *ring = FindRing(ioRing);
+
+  if (ring == nullptr) {
+    return E_HANDLE;
+  }
+
+  UINT32 submitted = 0;
+
+  for (const Entry &entry : ring->submissions) {
+    // Windows stops submitting once the completion queue could overflow; whatever is left stays queued.
+    if (ring->completions.size() >= ring->completionQueueSize) {
+      break;
+    }
+
+    IORING_CQE completion{entry.userData, S_OK, 0};
+
+    if (const RegisterFiles *files = std::get_if<RegisterFiles>(&entry.operation)) {
+      ring->files = files->handles;
+    } else if (const RegisterBuffers *buffers = std::get_if<RegisterBuffers>(&entry.operation)) {
+      ring->buffers = buffers->buffers;
+    } else {
+      completion.ResultCode = RunTransfer(*ring, std::get<Transfer>(entry.operation), completion.Information);
+    }
+
+    ring->completions.push_back(completion);
+    submitted++;
+  }
+
+  ring->submissions.erase(ring->submissions.begin(), ring->submissions.begin() + submitted);
+
+  if (submittedEntries != nullptr) {
+    *submittedEntries = submitted;
+  }
+
+  return S_OK;
+}
+
+WIN32_STUB_EXPORT HRESULT WINAPI PopIoRingCompletion(const HIORING ioRing, IORING_CQE *cqe) {
+  std::lock_guard<std::mutex> lock(ringsMutex);
+
+  IoRing *ring = FindRing(ioRing);
+
+  if (ring == nullptr) {
+    return E_HANDLE;
+  }
+
+  if (ring->completions.empty()) {
+    return S_FALSE;
+  }
+
+  *cqe = ring->completions.front();
+  ring->completions.pop_front();
+
+  return S_OK;
+}
@@ -0,0 +1,865 @@
+#include "win32_stub.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <cwctype>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif
+
+/**** Strings *********************************************************************************************************/
+
+std::string win32_stub::ToUtf8(const std::wstring_view value) {
+  std::string result;
+  result.reserve(value.size());
+
+  for (size_t i = 0; i < value.size(); i++) {
+    uint32_t codePoint = static_cast<uint16_t>(value[i]);
+
+    if (codePoint >= 0xD800 && codePoint < 0xDC00 && i + 1 < value.size()) {
+      const uint32_t low = static_cast<uint16_t>(value[i + 1]);
+
+      if (low >= 0xDC00 && low < 0xE000) {
+        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+        i++;
+      }
+    }
+
+    if (codePoint < 0x80) {
+      result.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+      result.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+      result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+      result.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+      result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+      result.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+      result.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+  }
+
+  return result;
+}
+
+std::wstring win32_stub::FromUtf8(const std::string_view value) {
+  std::wstring result;
+  result.reserve(value.size());
+
+  for (size_t i = 0; i < value.size();) {
+    const uint8_t lead = static_cast<uint8_t>(value[i]);
+    const size_t length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+
+    if ((lead >= 0x80 && lead < 0xC0) || i + length > value.size()) {
+      result.push_back(static_cast<wchar_t>(0xFFFD));
+      i++;
+      continue;
+    }
+
+    uint32_t codePoint = length == 1 ? lead : lead & (0xFF >> (length + 1));
+
+    for (size_t j = 1; j < length; j++) {
+      codePoint = (codePoint << 6) | (static_cast<uint8_t>(value[i + j]) & 0x3F);
+    }
+
+    if (codePoint >= 0x10000) {
+      codePoint -= 0x10000;
+      result.push_back(static_cast<wchar_t>(0xD800 + (codePoint >> 10)));
+      result.push_back(static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF)));
+    } else {
+      result.push_back(static_cast<wchar_t>(codePoint));
+    }
+
+    i += length;
+  }
+
+  return result;
+}
+
+std::string win32_stub::ToHostPath(const std::wstring_view path) {
+  std::string result = ToUtf8(path);
+  std::replace(result.begin(), result.end(), '\\', '/');
+  return result;
+}
+
+int win32_stub::CopyString(const std::wstring_view value, const LPWSTR buffer, const int capacity) {
+  if (buffer == nullptr || capacity <= 0) {
+    return 0;
+  }
+
+  const int length = std::min(static_cast<int>(value.size()), capacity - 1);
+
+  std::copy_n(value.data(), length, buffer);
+  buffer[length] = L'\0';
+
+  return length;
+}
+
+/**** Errors and Time *************************************************************************************************/
+
+DWORD win32_stub::FromErrno(const int error) {
+  switch (error) {
+  case 0:
+    return ERROR_SUCCESS;
+  case ENOENT:
+    return ERROR_FILE_NOT_FOUND;
+  case ENOTDIR:
+    return ERROR_DIRECTORY;
+  case EACCES:
+  case EPERM:
+  case EISDIR:
+    return ERROR_ACCESS_DENIED;
+  case EEXIST:
+    return ERROR_FILE_EXISTS;
+  case EBADF:
+    return ERROR_INVALID_HANDLE;
+  case ENOMEM:
+    return ERROR_NOT_ENOUGH_MEMORY;
+  case EINVAL:
+    return ERROR_INVALID_PARAMETER;
+  case EMFILE:
+  case ENFILE:
+    return ERROR_TOO_MANY_OPEN_FILES;
+  case ENOSPC:
+    return ERROR_DISK_FULL;
+  default:
+    return ERROR_GEN_FAILURE;
+  }
+}
+
+uint64_t win32_stub::ToFileTime(const int64_t seconds, const int64_t nanoseconds) {
+  // Seconds between 1601-01-01 and 1970-01-01.
+  static constexpr int64_t EPOCH_DIFFERENCE = 11644473600;
+
+  return static_cast<uint64_t>((seconds + EPOCH_DIFFERENCE) * 10000000 + nanoseconds / 100);
+}
+
+DWORD win32_stub::CurrentThreadId() {
+#ifdef __linux__
+  return static_cast<DWORD>(::syscall(SYS_gettid));
+#else
+  uint64_t id = 0;
+  ::pthread_threadid_np(nullptr, &id);
+  return static_cast<DWORD>(id);
+#endif
+}
+
+static thread_local DWORD lastError = ERROR_SUCCESS;
+
+WIN32_STUB_EXPORT DWORD WINAPI GetLastError() { return lastError; }
+
+WIN32_STUB_EXPORT void WINAPI SetLastError(const DWORD dwErrCode) { lastError = dwErrCode; }
+
+WIN32_STUB_EXPORT ULONGLONG WINAPI GetTickCount64() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Matches the 10MHz counter modern Windows reports.
+static constexpr LONGLONG PERFORMANCE_FREQUENCY = 10000000;
+
+WIN32_STUB_EXPORT BOOL WINAPI QueryPerformanceCounter(LARGE_INTEGER *lpPerformanceCount) {
+  lpPerformanceCount->QuadPart =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count() /
+      (1000000000 / PERFORMANCE_FREQUENCY);
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI QueryPerformanceFrequency(LARGE_INTEGER *lpFrequency) {
+  lpFrequency->QuadPart = PERFORMANCE_FREQUENCY;
+  return TRUE;
+}
+
+/**** Code Pages ******************************************************************************************************/
+
+// The ANSI code page is Windows-1252, which is Latin-1 except for 0x80 - 0x9F. Unassigned bytes map to the C1 control
+// with the same value, same as on Windows.
+static constexpr uint16_t WINDOWS_1252_C1[32] = {
+    0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021, 0x02C6, 0x2030, 0x0160,
+    0x2039, 0x0152, 0x008D, 0x017D, 0x008F, 0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022,
+    0x2013, 0x2014, 0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178,
+};
+
+static constexpr UINT ANSI_CODE_PAGE = 1252;
+
+static bool IsAnsiCodePage(const UINT codePage) { return codePage == CP_ACP || codePage == ANSI_CODE_PAGE; }
+
+WIN32_STUB_EXPORT UINT WINAPI GetACP() { return ANSI_CODE_PAGE; }
+
+WIN32_STUB_EXPORT int WINAPI MultiByteToWideChar(const UINT CodePage,
+                                                 const DWORD dwFlags,
+                                                 const LPCSTR lpMultiByteStr,
+                                                 const int cbMultiByte,
+                                                 const LPWSTR lpWideCharStr,
+                                                 const int cchWideChar) {
+  if (lpMultiByteStr == nullptr || cbMultiByte == 0 || cchWideChar < 0) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return 0;
+  }
+
+  const std::string_view input(lpMultiByteStr, cbMultiByte < 0 ? std::strlen(lpMultiByteStr) + 1 : cbMultiByte);
+
+  std::wstring output;
+
+  if (CodePage == CP_UTF8) {
+    output = win32_stub::FromUtf8(input);
+  } else if (IsAnsiCodePage(CodePage)) {
+    output.reserve(input.size());
+
+    for (const char c : input) {
+      const uint8_t byte = static_cast<uint8_t>(c);
+      output.push_back(static_cast<wchar_t>(byte >= 0x80 && byte < 0xA0 ? WINDOWS_1252_C1[byte - 0x80] : byte));
+    }
+  } else {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return 0;
+  }
+
+  if (cchWideChar == 0) {
+    return static_cast<int>(output.size());
+  }
+
+  if (output.size() > static_cast<size_t>(cchWideChar)) {
+    ::SetLastError(ERROR_INSUFFICIENT_BUFFER);
+    return 0;
+  }
+
+  std::copy(output.begin(), output.end(), lpWideCharStr);
+
+  return static_cast<int>(output.size());
+}
+
+WIN32_STUB_EXPORT int WINAPI WideCharToMultiByte(const UINT CodePage,
+                                                 const DWORD dwFlags,
+                                                 const LPCWSTR lpWideCharStr,
+                                                 const int cchWideChar,
+                                                 const LPSTR lpMultiByteStr,
+                                                 const int cbMultiByte,
+                                                 const LPCSTR lpDefaultChar,
+                                                 BOOL *lpUsedDefaultChar) {
+  if (lpWideCharStr == nullptr || cchWideChar == 0 || cbMultiByte < 0) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return 0;
+  }
+
+  const std::wstring_view input(lpWideCharStr, cchWideChar < 0 ? std::wcslen(lpWideCharStr) + 1 : cchWideChar);
+
+  std::string output;
+  bool usedDefault = false;
+
+  if (CodePage == CP_UTF8) {
+    output = win32_stub::ToUtf8(input);
+  } else if (IsAnsiCodePage(CodePage)) {
+    const char defaultChar = lpDefaultChar != nullptr ? lpDefaultChar[0] : '?';
+
+    output.reserve(input.size());
+
+    for (const wchar_t c : input) {
+      const uint32_t unit = static_cast<uint16_t>(c);
+
+      if (unit < 0x80 || (unit >= 0xA0 && unit <= 0xFF)) {
+        output.push_back(static_cast<char>(unit));
+        continue;
+      }
+
+      const uint16_t *const mapped = std::find(std::begin(WINDOWS_1252_C1), std::end(WINDOWS_1252_C1), unit);
+
+      if (mapped != std::end(WINDOWS_1252_C1)) {
+        output.push_back(static_cast<char>(0x80 + (mapped - std::begin(WINDOWS_1252_C1))));
+      } else {
+        output.push_back(defaultChar);
+        usedDefault = true;
+      }
+    }
+  } else {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return 0;
+  }
+
+  if (lpUsedDefaultChar != nullptr) {
+    *lpUsedDefaultChar = usedDefault ? TRUE : FALSE;
+  }
+
+  if (cbMultiByte == 0) {
+    return static_cast<int>(output.size());
+  }
+
+  if (output.size() > static_cast<size_t>(cbMultiByte)) {
+    ::SetLastError(ERROR_INSUFFICIENT_BUFFER);
+    return 0;
+  }
+
+  std::copy(output.begin(), output.end(), lpMultiByteStr);
+
+  return static_cast<int>(output.size());
+}
+
+// Ordinal comparison by code unit. Ignoring case uppercases both sides first, as Windows does, but with the C library's
+// case table rather than the one Windows ships.
+WIN32_STUB_EXPORT int WINAPI CompareStringOrdinal(const LPCWSTR lpString1,
+                                                  const int cchCount1,
+                                                  const LPCWSTR lpString2,
+                                                  const int cchCount2,
+                                                  const BOOL bIgnoreCase) {
+  if (lpString1 == nullptr || lpString2 == nullptr) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return 0;
+  }
+
+  const std::wstring_view a(lpString1, cchCount1 < 0 ? std::wcslen(lpString1) : cchCount1);
+  const std::wstring_view b(lpString2, cchCount2 < 0 ? std::wcslen(lpString2) : cchCount2);
+
+  const auto fold = [&](const wchar_t c) {
+    return bIgnoreCase ? static_cast<wchar_t>(std::towupper(static_cast<wint_t>(c))) : c;
+  };
+
+  const auto [left, right] = std::mismatch(
+      a.begin(), a.end(), b.begin(), b.end(), [&](const wchar_t x, const wchar_t y) { return fold(x) == fold(y); });
+
+  if (left == a.end()) {
+    return right == b.end() ? CSTR_EQUAL : CSTR_LESS_THAN;
+  }
+
+  if (right == b.end()) {
+    return CSTR_GREATER_THAN;
+  }
+
+  return fold(*left) < fold(*right) ? CSTR_LESS_THAN : CSTR_GREATER_THAN;
+}
+
+/**** Modules *********************************************************************************************************/
+
+// The stub stands in for kernel32.dll, user32.dll and gdi32.dll, so all three resolve to the stub's own module.
+static void *StubModule() {
+  static void *const module = [] {
+    Dl_info info{};
+    ::dladdr(reinterpret_cast<void *>(&GetLastError), &info);
+    return ::dlopen(info.dli_fname, RTLD_LAZY | RTLD_NOLOAD);
+  }();
+
+  return module;
+}
+
+static void *MainModule() {
+  static void *const module = ::dlopen(nullptr, RTLD_LAZY);
+  return module;
+}
+
+static bool IsStubModuleName(std::wstring_view name) {
+  static constexpr std::wstring_view MODULES[] = {L"kernel32", L"kernelbase", L"user32", L"gdi32"};
+
+  std::wstring lower(name);
+  std::transform(lower.begin(), lower.end(), lower.begin(), [](const wchar_t c) { return std::towlower(c); });
+
+  if (lower.ends_with(L".dll")) {
+    lower.resize(lower.size() - 4);
+  }
+
+  return std::find(std::begin(MODULES), std::end(MODULES), lower) != std::end(MODULES);
+}
+
+static std::mutex modulesMutex;
+static std::wstring moduleFileNameOverride;
+
+void win32_stub::SetModuleFileName(const std::wstring_view path) {
+  std::lock_guard<std::mutex> lock(modulesMutex);
+  moduleFileNameOverride = path;
+}
+
+static std::wstring MainModuleFileName() {
+  {
+    std::lock_guard<std::mutex> lock(modulesMutex);
+
+    if (!moduleFileNameOverride.empty()) {
+      return moduleFileNameOverride;
+    }
+  }
+
+  char path[4096];
+
+#ifdef __APPLE__
+  uint32_t size = sizeof(path);
+
+  if (::_NSGetExecutablePath(path, &size) != 0) {
+    return {};
+  }
+
+  return win32_stub::FromUtf8(path);
+#else
+  const ssize_t length = ::readlink("/proc/self/exe", path, sizeof(path));
+
+  return length < 0 ? std::wstring() : win32_stub::FromUtf8(std::string_view(path, length));
+#endif
+}
+
+WIN32_STUB_EXPORT HMODULE WINAPI GetModuleHandleW(const LPCWSTR lpModuleName) {
+  if (lpModuleName == nullptr) {
+    return static_cast<HMODULE>(MainModule());
+  }
+
+  if (IsStubModuleName(lpModuleName)) {
+    return static_cast<HMODULE>(StubModule());
+  }
+
+  ::SetLastError(ERROR_MOD_NOT_FOUND);
+  return nullptr;
+}
+
+WIN32_STUB_EXPORT DWORD WINAPI GetModuleFileNameW(const HMODULE hModule, const LPWSTR lpFilename, const DWORD nSize) {
+  std::wstring path;
+
+  if (hModule == nullptr || hModule == MainModule()) {
+    path = MainModuleFileName();
+  } else if (hModule == StubModule()) {
+    Dl_info info{};
+    ::dladdr(reinterpret_cast<void *>(&GetLastError), &info);
+    path = win32_stub::FromUtf8(info.dli_fname);
+  } else {
+    ::SetLastError(ERROR_MOD_NOT_FOUND);
+    return 0;
+  }
+
+  if (nSize == 0) {
+    ::SetLastError(ERROR_INSUFFICIENT_BUFFER);
+    return 0;
+  }
+
+  // Vista and later: a path that doesn't fit is truncated to nSize - 1 characters, terminated, and nSize is returned.
+  const DWORD copied = static_cast<DWORD>(win32_stub::CopyString(path, lpFilename, static_cast<int>(nSize)));
+
+  if (copied < path.size()) {
+    ::SetLastError(ERROR_INSUFFICIENT_BUFFER);
+    return nSize;
+  }
+
+  ::SetLastError(ERROR_SUCCESS);
+  return copied;
+}
+
+static std::mutex hiddenProcsMutex;
+static std::vector<std::string> hiddenProcs;
+
+void win32_stub::SetProcAddressHidden(const std::string_view name, const bool hidden) {
+  std::lock_guard<std::mutex> lock(hiddenProcsMutex);
+
+  const auto it = std::find(hiddenProcs.begin(), hiddenProcs.end(), name);
+
+  if (hidden && it == hiddenProcs.end()) {
+    hiddenProcs.emplace_back(name);
+  } else if (!hidden && it != hiddenProcs.end()) {
+    hiddenProcs.erase(it);
+  }
+}
+
+WIN32_STUB_EXPORT FARPROC WINAPI GetProcAddress(const HMODULE hModule, const LPCSTR lpProcName) {
+  if (hModule != StubModule() && hModule != MainModule()) {
+    ::SetLastError(ERROR_MOD_NOT_FOUND);
+    return nullptr;
+  }
+
+  // Ordinals aren't supported.
+  if (reinterpret_cast<uintptr_t>(lpProcName) < 0x10000) {
+    ::SetLastError(ERROR_PROC_NOT_FOUND);
+    return nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(hiddenProcsMutex);
+
+    if (std::find(hiddenProcs.begin(), hiddenProcs.end(), lpProcName) != hiddenProcs.end()) {
+      ::SetLastError(ERROR_PROC_NOT_FOUND);
+      return nullptr;
+    }
+  }
+
+  void *const proc = ::dlsym(hModule, lpProcName);
+
+  if (proc == nullptr) {
+    ::SetLastError(ERROR_PROC_NOT_FOUND);
+    return nullptr;
+  }
+
+  return reinterpret_cast<FARPROC>(proc);
+}
+
+/**** Messages ********************************************************************************************************/
+
+struct SystemMessage {
+  DWORD id;
+  std::wstring_view text;
+};
+
+static constexpr SystemMessage SYSTEM_MESSAGES[] = {
+    {ERROR_SUCCESS, L"The operation completed successfully.\r\n"},
+    {ERROR_FILE_NOT_FOUND, L"The system cannot find the file specified.\r\n"},
+    {ERROR_PATH_NOT_FOUND, L"The system cannot find the path specified.\r\n"},
+    {ERROR_TOO_MANY_OPEN_FILES, L"The system cannot open the file.\r\n"},
+    {ERROR_ACCESS_DENIED, L"Access is denied.\r\n"},
+    {ERROR_INVALID_HANDLE, L"The handle is invalid.\r\n"},
+    {ERROR_NOT_ENOUGH_MEMORY, L"Not enough memory resources are available to process this command.\r\n"},
+    {ERROR_NO_MORE_FILES, L"There are no more files.\r\n"},
+    {ERROR_GEN_FAILURE, L"A device attached to the system is not functioning.\r\n"},
+    {ERROR_NOT_SUPPORTED, L"The request is not supported.\r\n"},
+    {ERROR_FILE_EXISTS, L"The file exists.\r\n"},
+    {ERROR_INVALID_PARAMETER, L"The parameter is incorrect.\r\n"},
+    {ERROR_DISK_FULL, L"There is not enough space on the disk.\r\n"},
+    {ERROR_INSUFFICIENT_BUFFER, L"The data area passed to a system call is too small.\r\n"},
+    {ERROR_MOD_NOT_FOUND, L"The specified module could not be found.\r\n"},
+    {ERROR_PROC_NOT_FOUND, L"The specified procedure could not be found.\r\n"},
+    {ERROR_DIRECTORY, L"The directory name is invalid.\r\n"},
+    {ERROR_OPERATION_ABORTED, L"The I/O operation has been aborted because of either a thread exit or an application "
+                              L"request.\r\n"},
+    {ERROR_IO_INCOMPLETE, L"Overlapped I/O event is not in a signaled state.\r\n"},
+    {ERROR_IO_PENDING, L"Overlapped I/O operation is in progress.\r\n"},
+    {ERROR_NOTIFY_ENUM_DIR, L"A notify change request is being completed and the information is not being returned "
+                            L"in the caller's buffer. The caller now needs to enumerate the files to find the "
+                            L"changes.\r\n"},
+    {ERROR_NOT_FOUND, L"Element not found.\r\n"},
+    {ERROR_INVALID_WINDOW_HANDLE, L"Invalid window handle.\r\n"},
+    {ERROR_INVALID_MENU_HANDLE, L"Invalid menu handle.\r\n"},
+    {ERROR_CANNOT_FIND_WND_CLASS, L"Cannot find window class.\r\n"},
+    {ERROR_CLASS_ALREADY_EXISTS, L"Class already exists.\r\n"},
+    {ERROR_TIMEOUT, L"This operation returned because the timeout period expired.\r\n"},
+};
+
+/**
+ * Expands the escape sequences of a message definition. Inserts are always left as they are: the bindings only ever
+ * pass FORMAT_MESSAGE_IGNORE_INSERTS, and without it the stub fails with ERROR_NOT_SUPPORTED.
+ */
+static std::wstring ExpandMessage(const std::wstring_view message) {
+  std::wstring result;
+  result.reserve(message.size());
+
+  for (size_t i = 0; i < message.size(); i++) {
+    if (message[i] != L'%' || i + 1 == message.size()) {
+      result.push_back(message[i]);
+      continue;
+    }
+
+    const wchar_t next = message[i + 1];
+
+    switch (next) {
+    case L'0':
+      return result;
+    case L'n':
+      result.append(L"\r\n");
+      i++;
+      break;
+    case L'%':
+    case L'.':
+    case L'!':
+    case L' ':
+      result.push_back(next);
+      i++;
+      break;
+    default:
+      result.push_back(L'%');
+      break;
+    }
+  }
+
+  return result;
+}
+
+WIN32_STUB_EXPORT DWORD WINAPI FormatMessageW(const DWORD dwFlags,
+                                              const LPCVOID lpSource,
+                                              const DWORD dwMessageId,
+                                              const DWORD dwLanguageId,
+                                              const LPWSTR lpBuffer,
+                                              const DWORD nSize,
+                                              va_list *Arguments) {
+  if ((dwFlags & FORMAT_MESSAGE_IGNORE_INSERTS) == 0) {
+    ::SetLastError(ERROR_NOT_SUPPORTED);
+    return 0;
+  }
+
+  std::wstring_view definition;
+
+  if ((dwFlags & FORMAT_MESSAGE_FROM_STRING) != 0) {
+    if (lpSource == nullptr) {
+      ::SetLastError(ERROR_INVALID_PARAMETER);
+      return 0;
+    }
+
+    definition = static_cast<LPCWSTR>(lpSource);
+  } else if ((dwFlags & FORMAT_MESSAGE_FROM_SYSTEM) != 0 && (dwFlags & FORMAT_MESSAGE_FROM_HMODULE) == 0) {
+    const auto it = std::find_if(std::begin(SYSTEM_MESSAGES),
+                                 std::end(SYSTEM_MESSAGES),
+                                 [dwMessageId](const SystemMessage &message) { return message.id == dwMessageId; });
+
+    if (it == std::end(SYSTEM_MESSAGES)) {
+      ::SetLastError(ERROR_MR_MID_NOT_FOUND);
+      return 0;
+    }
+
+    definition = it->text;
+  } else {
+    ::SetLastError(ERROR_NOT_SUPPORTED);
+    return 0;
+  }
+
+  const std::wstring message = ExpandMessage(definition);
+
+  if ((dwFlags & FORMAT_MESSAGE_ALLOCATE_BUFFER) != 0) {
+    wchar_t *allocated = static_cast<wchar_t *>(std::malloc((std::max<size_t>(message.size(), nSize) + 1) * sizeof(wchar_t)));
+
+    std::copy(message.begin(), message.end(), allocated);
+    allocated[message.size()] = L'\0';
+
+    *reinterpret_cast<LPWSTR *>(lpBuffer) = allocated;
+
+    return static_cast<DWORD>(message.size());
+  }
+
+  if (message.size() + 1 > nSize) {
+    ::SetLastError(ERROR_INSUFFICIENT_BUFFER);
+    return 0;
+  }
+
+  return static_cast<DWORD>(win32_stub::CopyString(message, lpBuffer, static_cast<int>(nSize)));
+}
+
+WIN32_STUB_EXPORT HLOCAL WINAPI LocalFree(const HLOCAL hMem) {
+  std::free(hMem);
+  return nullptr;
+}
+
+/**** Kernel Objects **************************************************************************************************/
+
+namespace {
+  struct Event : win32_stub::Object {
+    const bool manualReset;
+    bool signaled;
+
+    Event(const bool manualReset, const bool signaled)
+        : Object(win32_stub::ObjectKind::Event), manualReset(manualReset), signaled(signaled) {}
+  };
+} // namespace
+
+// Every kernel object, and every wait on one, goes through this lock; waits are woken whenever any event is set or any
+// handle is closed.
+static std::mutex objectsMutex;
+static std::condition_variable objectsChanged;
+static std::unordered_map<HANDLE, std::unique_ptr<win32_stub::Object>> objects;
+static uintptr_t nextObject = 0x100;
+
+HANDLE win32_stub::AddObject(Object *object) {
+  std::lock_guard<std::mutex> lock(objectsMutex);
+
+  // Kernel handles are multiples of 4, and never 0 or INVALID_HANDLE_VALUE.
+  const HANDLE handle = reinterpret_cast<HANDLE>(nextObject);
+  nextObject += 4;
+
+  objects.emplace(handle, object);
+
+  return handle;
+}
+
+win32_stub::Object *win32_stub::FindObject(const HANDLE handle, const ObjectKind kind) {
+  std::lock_guard<std::mutex> lock(objectsMutex);
+
+  const auto it = objects.find(handle);
+
+  return it != objects.end() && it->second->kind == kind ? it->second.get() : nullptr;
+}
+
+size_t win32_stub::ObjectCount() {
+  std::lock_guard<std::mutex> lock(objectsMutex);
+  return objects.size();
+}
+
+void win32_stub::ResetKernel32() {
+  SetModuleFileName({});
+
+  std::lock_guard<std::mutex> lock(hiddenProcsMutex);
+  hiddenProcs.clear();
+}
+
+static Event *FindEvent(const HANDLE handle) {
+  const auto it = objects.find(handle);
+
+  return it != objects.end() && it->second->kind == win32_stub::ObjectKind::Event
+             ? static_cast<Event *>(it->second.get())
+             : nullptr;
+}
+
+void win32_stub::SignalEvent(const HANDLE hEvent) {
+  {
+    std::lock_guard<std::mutex> lock(objectsMutex);
+
+    Event *event = FindEvent(hEvent);
+
+    if (event == nullptr) {
+      return;
+    }
+
+    event->signaled = true;
+  }
+
+  objectsChanged.notify_all();
+}
+
+WIN32_STUB_EXPORT HANDLE WINAPI CreateEventW(const LPSECURITY_ATTRIBUTES lpEventAttributes,
+                                             const BOOL bManualReset,
+                                             const BOOL bInitialState,
+                                             const LPCWSTR lpName) {
+  // Named events would have to be shared with other processes.
+  if (lpName != nullptr) {
+    ::SetLastError(ERROR_NOT_SUPPORTED);
+    return nullptr;
+  }
+
+  return win32_stub::AddObject(new Event(bManualReset != FALSE, bInitialState != FALSE));
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI SetEvent(const HANDLE hEvent) {
+  {
+    std::lock_guard<std::mutex> lock(objectsMutex);
+
+    Event *event = FindEvent(hEvent);
+
+    if (event == nullptr) {
+      ::SetLastError(ERROR_INVALID_HANDLE);
+      return FALSE;
+    }
+
+    event->signaled = true;
+  }
+
+  objectsChanged.notify_all();
+
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI ResetEvent(const HANDLE hEvent) {
+  std::lock_guard<std::mutex> lock(objectsMutex);
+
+  Event *event = FindEvent(hEvent);
+
+  if (event == nullptr) {
+    ::SetLastError(ERROR_INVALID_HANDLE);
+    return FALSE;
+  }
+
+  event->signaled = false;
+
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT DWORD WINAPI WaitForMultipleObjects(const DWORD nCount,
+                                                      const HANDLE *lpHandles,
+                                                      const BOOL bWaitAll,
+                                                      const DWORD dwMilliseconds) {
+  if (nCount == 0 || nCount > 64) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return WAIT_FAILED;
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(dwMilliseconds);
+
+  std::unique_lock<std::mutex> lock(objectsMutex);
+  std::vector<Event *> events(nCount);
+
+  while (true) {
+    // Only events are waitable in the stub; anything else, including a handle closed during the wait, fails the wait.
+    for (DWORD i = 0; i < nCount; i++) {
+      events[i] = FindEvent(lpHandles[i]);
+
+      if (events[i] == nullptr) {
+        ::SetLastError(ERROR_INVALID_HANDLE);
+        return WAIT_FAILED;
+      }
+    }
+
+    if (bWaitAll) {
+      if (std::all_of(events.begin(), events.end(), [](const Event *event) { return event->signaled; })) {
+        for (Event *event : events) {
+          event->signaled = event->manualReset;
+        }
+
+        return WAIT_OBJECT_0;
+      }
+    } else {
+      for (DWORD i = 0; i < nCount; i++) {
+        if (events[i]->signaled) {
+          events[i]->signaled = events[i]->manualReset;
+          return WAIT_OBJECT_0 + i;
+        }
+      }
+    }
+
+    if (dwMilliseconds == INFINITE) {
+      objectsChanged.wait(lock);
+    } else if (std::chrono::steady_clock::now() >= deadline) {
+      return WAIT_TIMEOUT;
+    } else {
+      objectsChanged.wait_until(lock, deadline);
+    }
+  }
+}
+
+WIN32_STUB_EXPORT DWORD WINAPI WaitForSingleObject(const HANDLE hHandle, const DWORD dwMilliseconds) {
+  return ::WaitForMultipleObjects(1, &hHandle, FALSE, dwMilliseconds);
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI CloseHandle(const HANDLE hObject) {
+  win32_stub::ObjectKind kind;
+
+  {
+    std::lock_guard<std::mutex> lock(objectsMutex);
+
+    const auto it = objects.find(hObject);
+
+    if (it == objects.end()) {
+      ::SetLastError(ERROR_INVALID_HANDLE);
+      return FALSE;
+    }
+
+    kind = it->second->kind;
+  }
+
+  // A directory's pending change notification is completed while its handle is still valid.
+  if (kind == win32_stub::ObjectKind::File) {
+    win32_stub::CloseDirectoryChanges(hObject);
+  }
+
+  std::unique_ptr<win32_stub::Object> object;
+
+  {
+    std::lock_guard<std::mutex> lock(objectsMutex);
+
+    const auto it = objects.find(hObject);
+
+    if (it == objects.end()) {
+      ::SetLastError(ERROR_INVALID_HANDLE);
+      return FALSE;
+    }
+
+    object = std::move(it->second);
+    objects.erase(it);
+  }
+
+  objectsChanged.notify_all();
+
+  return TRUE;
+}
@@ -0,0 +1,189 @@
+#include "win32_stub.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * Menus are item lists and nothing else; they are never shown, so none of the state that only matters on screen, like
+ * checked or grayed items, has any effect beyond being stored with the item.
+ */
+
+namespace {
+  struct MenuItem {
+    UINT flags;
+    // The command ID, or for MF_POPUP items the submenu.
+    UINT_PTR id;
+    std::wstring text;
+  };
+
+  struct Menu {
+    std::vector<MenuItem> items;
+  };
+} // namespace
+
+static std::mutex menusMutex;
+static std::unordered_map<HMENU, Menu> menus;
+static uintptr_t nextMenu = 0x30000;
+
+static Menu *RequireMenu(const HMENU hMenu) {
+  const auto it = menus.find(hMenu);
+
+  if (it == menus.end()) {
+    ::SetLastError(ERROR_INVALID_MENU_HANDLE);
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+bool win32_stub::MenuExists(const HMENU hMenu) {
+  std::lock_guard<std::mutex> lock(menusMutex);
+
+  return menus.contains(hMenu);
+}
+
+WIN32_STUB_EXPORT HMENU WINAPI CreateMenu() {
+  std::lock_guard<std::mutex> lock(menusMutex);
+
+  const HMENU hMenu = reinterpret_cast<HMENU>(nextMenu);
+  nextMenu += 2;
+
+  menus.emplace(hMenu, Menu{});
+
+  return hMenu;
+}
+
+// Destroys `hMenu` and, like DestroyMenu, every submenu it opens. Called with the lock held.
+static bool Destroy(const HMENU hMenu) {
+  const auto it = menus.find(hMenu);
+
+  if (it == menus.end()) {
+    return false;
+  }
+
+  const std::vector<MenuItem> items = std::move(it->second.items);
+  menus.erase(it);
+
+  for (const MenuItem &item : items) {
+    if ((item.flags & MF_POPUP) != 0) {
+      Destroy(reinterpret_cast<HMENU>(item.id));
+    }
+  }
+
+  return true;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI DestroyMenu(const HMENU hMenu) {
+  std::lock_guard<std::mutex> lock(menusMutex);
+
+  if (!Destroy(hMenu)) {
+    ::SetLastError(ERROR_INVALID_MENU_HANDLE);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI AppendMenuW(const HMENU hMenu,
+                                          const UINT uFlags,
+                                          const UINT_PTR uIDNewItem,
+                                          const LPCWSTR lpNewItem) {
+  std::lock_guard<std::mutex> lock(menusMutex);
+
+  Menu *menu = RequireMenu(hMenu);
+
+  if (menu == nullptr) {
+    return FALSE;
+  }
+
+  if ((uFlags & MF_POPUP) != 0 && !menus.contains(reinterpret_cast<HMENU>(uIDNewItem))) {
+    ::SetLastError(ERROR_INVALID_MENU_HANDLE);
+    return FALSE;
+  }
+
+  // Separators have no text, and lpNewItem only holds a string for MF_STRING items, which is when no other type is set.
+  const bool hasText = (uFlags & MF_SEPARATOR) == 0 && lpNewItem != nullptr;
+
+  menu->items.push_back({uFlags, uIDNewItem, hasText ? std::wstring(lpNewItem) : std::wstring()});
+
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI AppendMenuA(const HMENU hMenu,
+                                          const UINT uFlags,
+                                          const UINT_PTR uIDNewItem,
+                                          const LPCSTR lpNewItem) {
+  if ((uFlags & MF_SEPARATOR) != 0 || lpNewItem == nullptr) {
+    return ::AppendMenuW(hMenu, uFlags, uIDNewItem, nullptr);
+  }
+
+  const int length = ::MultiByteToWideChar(CP_ACP, 0, lpNewItem, -1, nullptr, 0);
+  std::wstring text(length, L'\0');
+  ::MultiByteToWideChar(CP_ACP, 0, lpNewItem, -1, text.data(), length);
+
+  return ::AppendMenuW(hMenu, uFlags, uIDNewItem, text.c_str());
+}
+
+// The item `uIDItem` identifies, searching submenus too when it is a command ID. Called with the lock held.
+static const MenuItem *FindItem(const Menu &menu, const UINT uIDItem, const UINT flags) {
+  if ((flags & MF_BYPOSITION) != 0) {
+    return uIDItem < menu.items.size() ? &menu.items[uIDItem] : nullptr;
+  }
+
+  for (const MenuItem &item : menu.items) {
+    if ((item.flags & MF_POPUP) == 0) {
+      if (item.id == uIDItem) {
+        return &item;
+      }
+
+      continue;
+    }
+
+    if (const auto submenu = menus.find(reinterpret_cast<HMENU>(item.id)); submenu != menus.end()) {
+      if (const MenuItem *found = FindItem(submenu->second, uIDItem, flags)) {
+        return found;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+WIN32_STUB_EXPORT int WINAPI GetMenuStringW(const HMENU hMenu,
+                                            const UINT uIDItem,
+                                            const LPWSTR lpString,
+                                            const int cchMax,
+                                            const UINT flags) {
+  std::lock_guard<std::mutex> lock(menusMutex);
+
+  const Menu *menu = RequireMenu(hMenu);
+
+  if (menu == nullptr) {
+    return 0;
+  }
+
+  const MenuItem *item = FindItem(*menu, uIDItem, flags);
+
+  if (item == nullptr) {
+    return 0;
+  }
+
+  // Without a buffer, only the length is reported.
+  if (lpString == nullptr || cchMax == 0) {
+    return static_cast<int>(item->text.size());
+  }
+
+  return win32_stub::CopyString(item->text, lpString, cchMax);
+}
+
+void win32_stub::ResetMenus() {
+  std::lock_guard<std::mutex> lock(menusMutex);
+
+  menus.clear();
+}
+
+size_t win32_stub::MenuCount() {
+  std::lock_guard<std::mutex> lock(menusMutex);
+
+  return menus.size();
+}
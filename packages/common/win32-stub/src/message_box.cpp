@@ -0,0 +1,128 @@
+#include "win32_stub.hpp"
+
+#include <mutex>
+#include <utility>
+
+/**
+ * Message boxes close themselves immediately with whatever result the test asked for, IDOK unless told otherwise.
+ * Every call is recorded so a test can check what would have been shown. A box with MB_HELP and a callback "presses"
+ * Help a configurable number of times before closing, which is the only way the callback is ever reached.
+ */
+
+static std::mutex messageBoxMutex;
+static std::vector<win32_stub::MessageBoxCall> messageBoxCalls;
+static int messageBoxResult = IDOK;
+static uint32_t messageBoxHelpRequests = 0;
+
+static std::wstring FromAnsi(const LPCSTR value) {
+  if (value == nullptr) {
+    return {};
+  }
+
+  const int length = ::MultiByteToWideChar(CP_ACP, 0, value, -1, nullptr, 0);
+  std::wstring result(length, L'\0');
+  ::MultiByteToWideChar(CP_ACP, 0, value, -1, result.data(), length);
+  result.resize(length > 0 ? length - 1 : 0);
+
+  return result;
+}
+
+static int Show(const HWND hWnd,
+                const LPCWSTR lpText,
+                const LPCWSTR lpCaption,
+                const UINT uType,
+                const MSGBOXCALLBACK callback,
+                const DWORD_PTR contextHelpId) {
+  uint32_t helpRequests = 0;
+  int result = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(messageBoxMutex);
+
+    // A null caption is shown as "Error", same as Windows.
+    messageBoxCalls.push_back({hWnd, lpText != nullptr ? lpText : L"", lpCaption != nullptr ? lpCaption : L"Error", uType});
+
+    helpRequests = (uType & MB_HELP) != 0 && callback != nullptr ? messageBoxHelpRequests : 0;
+    result = messageBoxResult;
+  }
+
+  for (uint32_t i = 0; i < helpRequests; i++) {
+    HELPINFO helpInfo{sizeof(HELPINFO), HELPINFO_WINDOW, 0, nullptr, contextHelpId, {0, 0}};
+    callback(&helpInfo);
+  }
+
+  return result;
+}
+
+WIN32_STUB_EXPORT int WINAPI MessageBoxW(const HWND hWnd, const LPCWSTR lpText, const LPCWSTR lpCaption, const UINT uType) {
+  return Show(hWnd, lpText, lpCaption, uType, nullptr, 0);
+}
+
+WIN32_STUB_EXPORT int WINAPI MessageBoxA(const HWND hWnd, const LPCSTR lpText, const LPCSTR lpCaption, const UINT uType) {
+  const std::wstring text = FromAnsi(lpText);
+  const std::wstring caption = FromAnsi(lpCaption);
+
+  return Show(hWnd, text.c_str(), lpCaption != nullptr ? caption.c_str() : nullptr, uType, nullptr, 0);
+}
+
+WIN32_STUB_EXPORT int WINAPI
+MessageBoxExW(const HWND hWnd, const LPCWSTR lpText, const LPCWSTR lpCaption, const UINT uType, const WORD) {
+  return ::MessageBoxW(hWnd, lpText, lpCaption, uType);
+}
+
+WIN32_STUB_EXPORT int WINAPI
+MessageBoxExA(const HWND hWnd, const LPCSTR lpText, const LPCSTR lpCaption, const UINT uType, const WORD) {
+  return ::MessageBoxA(hWnd, lpText, lpCaption, uType);
+}
+
+WIN32_STUB_EXPORT int WINAPI MessageBoxIndirectW(const MSGBOXPARAMSW *lpmbp) {
+  if (lpmbp == nullptr || lpmbp->cbSize != sizeof(MSGBOXPARAMSW)) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return 0;
+  }
+
+  return Show(lpmbp->hwndOwner,
+              lpmbp->lpszText,
+              lpmbp->lpszCaption,
+              lpmbp->dwStyle,
+              lpmbp->lpfnMsgBoxCallback,
+              lpmbp->dwContextHelpId);
+}
+
+WIN32_STUB_EXPORT int WINAPI MessageBoxIndirectA(const MSGBOXPARAMSA *lpmbp) {
+  if (lpmbp == nullptr || lpmbp->cbSize != sizeof(MSGBOXPARAMSA)) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return 0;
+  }
+
+  const std::wstring text = FromAnsi(lpmbp->lpszText);
+  const std::wstring caption = FromAnsi(lpmbp->lpszCaption);
+
+  return Show(lpmbp->hwndOwner,
+              text.c_str(),
+              lpmbp->lpszCaption != nullptr ? caption.c_str() : nullptr,
+              lpmbp->dwStyle,
+              lpmbp->lpfnMsgBoxCallback,
+              lpmbp->dwContextHelpId);
+}
+
+void win32_stub::SetMessageBoxResult(const int result, const uint32_t helpRequests) {
+  std::lock_guard<std::mutex> lock(messageBoxMutex);
+
+  messageBoxResult = result;
+  messageBoxHelpRequests = helpRequests;
+}
+
+std::vector<win32_stub::MessageBoxCall> win32_stub::TakeMessageBoxCalls() {
+  std::lock_guard<std::mutex> lock(messageBoxMutex);
+
+  return std::exchange(messageBoxCalls, {});
+}
+
+void win32_stub::ResetMessageBoxes() {
+  std::lock_guard<std::mutex> lock(messageBoxMutex);
+
+  messageBoxCalls.clear();
+  messageBoxResult = IDOK;
+  messageBoxHelpRequests = 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * Win32 Stub Backend
+ *
+ * In-memory implementations of the user32, kernel32 and gdi32 entry points the bindings call, so the real addon sources
+ * can be built and exercised on Linux and macOS. The library is itself a Node addon: loading it with RTLD_GLOBAL (see
+ * ../index.ts) makes its exports resolve the Win32 imports of every addon loaded after it, and its JS exports let tests
+ * drive the parts of the system a binding can't reach, like the button a message box is closed with.
+ *
+ * It models the behavior the bindings depend on, not Windows. Windows have no non-client area and are never painted,
+ * GetMessageW fails instead of blocking forever on a queue nothing else can post to, files map onto the host file
+ * system, and IoRing operations run synchronously when they are submitted. Anything not modelled fails the way Windows
+ * reports an unsupported request, with ERROR_NOT_SUPPORTED or E_NOTIMPL.
+ *
+ * Copyright (c) 2025-present, Kasim Ahmic. (https://kasimahmic.com)
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <windows.h>
+
+#define WIN32_STUB_EXPORT extern "C" __attribute__((visibility("default")))
+
+namespace win32_stub {
+  /**** Strings *******************************************************************************************************/
+
+  // WCHAR strings hold UTF-16 code units, one per wchar_t, exactly as the bindings copy them out of V8.
+  std::string ToUtf8(std::wstring_view value);
+  std::wstring FromUtf8(std::string_view value);
+
+  // Host path for a Win32 path. Backslashes become slashes; nothing else is translated.
+  std::string ToHostPath(std::wstring_view path);
+
+  // Copies `value` into a caller's buffer of `capacity` characters the way GetWindowTextW and friends do: truncated to
+  // capacity - 1 characters and always terminated. Returns the number of characters copied.
+  int CopyString(std::wstring_view value, LPWSTR buffer, int capacity);
+
+  /**** Errors and Time ***********************************************************************************************/
+
+  // errno of a failed host call as a Win32 error code.
+  DWORD FromErrno(int error);
+
+  // 100ns ticks since 1601-01-01, which is what FILETIMEs and the LARGE_INTEGER times in change records hold.
+  uint64_t ToFileTime(int64_t seconds, int64_t nanoseconds);
+
+  DWORD CurrentThreadId();
+
+  /**** Kernel Objects ************************************************************************************************/
+
+  enum class ObjectKind { Event, File, Find };
+
+  struct Object {
+    const ObjectKind kind;
+
+    explicit Object(const ObjectKind kind) : kind(kind) {}
+    virtual ~Object() = default;
+  };
+
+  HANDLE AddObject(Object *object);
+
+  // The object behind `handle` if it is of `kind`. Objects are only destroyed by CloseHandle, so the pointer stays valid
+  // for as long as the caller keeps the handle open.
+  Object *FindObject(HANDLE handle, ObjectKind kind);
+
+  size_t ObjectCount();
+
+  // Signals an event from inside the stub, e.g. when an overlapped read completes. Unknown handles are ignored.
+  void SignalEvent(HANDLE hEvent);
+
+  // The file descriptor of a file or directory handle, or -1.
+  int FileDescriptor(HANDLE handle);
+
+  // Called by CloseHandle for directory handles so the change notifications they were reading stop first.
+  void CloseDirectoryChanges(HANDLE hDirectory);
+
+  /**** user32 ********************************************************************************************************/
+
+  bool MenuExists(HMENU hMenu);
+
+  /**** Control *******************************************************************************************************/
+
+  // Everything the JS side of the stub can change or inspect; see control.cpp.
+  struct MessageBoxCall {
+    HWND owner;
+    std::wstring text;
+    std::wstring caption;
+    UINT type;
+  };
+
+  // Each forgets everything its file has created, without notifying anyone, so tests can start over.
+  void ResetKernel32();
+  void ResetWindows();
+  void ResetMenus();
+  void ResetMessageBoxes();
+  void ResetInput();
+
+  size_t WindowCount();
+  size_t MenuCount();
+
+  void SetMessageWaitTimeout(DWORD milliseconds);
+
+  void SetMessageBoxResult(int result, uint32_t helpRequests);
+  std::vector<MessageBoxCall> TakeMessageBoxCalls();
+
+  std::vector<uint8_t> TakeSentInput();
+
+  // Queues one record for GetRawInputBuffer. `data` is everything after the RAWINPUTHEADER.
+  void QueueRawInput(DWORD type, HANDLE hDevice, std::vector<uint8_t> data);
+
+  void SetModuleFileName(std::wstring_view path);
+
+  // Makes GetProcAddress fail for `name` as if it were running on a Windows version without that export.
+  void SetProcAddressHidden(std::string_view name, bool hidden);
+} // namespace win32_stub
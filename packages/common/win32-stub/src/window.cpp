@@ -0,0 +1,846 @@
+#include "win32_stub.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <cwctype>
+
+#include <unistd.h>
+
+/**
+ * Window classes, windows and per-thread message queues. Every window is a rectangle with no non-client area, so its
+ * window and client rects only differ in origin, and its update region is tracked as a single bounding rect, which is
+ * all BeginPaint reports anyway.
+ *
+ * One lock guards all of it and is released around every call into a WNDPROC, since those re-enter user32 freely.
+ */
+
+namespace {
+  struct WindowClass {
+    std::wstring name;
+    ATOM atom;
+    WNDPROC wndProc;
+  };
+
+  struct Window {
+    HWND parent;
+    DWORD threadId;
+    std::wstring className;
+    WNDPROC wndProc;
+    std::wstring text;
+    DWORD style;
+    DWORD exStyle;
+    int x;
+    int y;
+    int width;
+    int height;
+    HMENU menu;
+    bool visible = false;
+    bool destroying = false;
+
+    // Bounding rect of the update region; empty when the window is valid.
+    RECT update{};
+    bool erase = false;
+  };
+
+  struct MessageQueue {
+    std::deque<MSG> posted;
+    bool quit = false;
+    int exitCode = 0;
+    std::condition_variable changed;
+  };
+} // namespace
+
+static std::mutex user32Mutex;
+static std::vector<WindowClass> classes;
+// Keyed by handle value, and handles only ever grow, so iterating in order visits windows in creation order.
+static std::map<uintptr_t, Window> windows;
+static std::unordered_map<DWORD, MessageQueue> queues;
+
+static ATOM nextAtom = 0xC000;
+static uintptr_t nextWindow = 0x20000;
+static DWORD messageWaitTimeout = 1000;
+
+static constexpr int DEFAULT_WIDTH = 800;
+static constexpr int DEFAULT_HEIGHT = 600;
+
+static Window *FindWindow(const HWND hWnd) {
+  const auto it = windows.find(reinterpret_cast<uintptr_t>(hWnd));
+  return it != windows.end() ? &it->second : nullptr;
+}
+
+// Looks `hWnd` up, failing with ERROR_INVALID_WINDOW_HANDLE the way every user32 function does when it isn't a window.
+static Window *RequireWindow(const HWND hWnd) {
+  Window *window = FindWindow(hWnd);
+
+  if (window == nullptr) {
+    ::SetLastError(ERROR_INVALID_WINDOW_HANDLE);
+  }
+
+  return window;
+}
+
+static bool SameClassName(const std::wstring_view a, const std::wstring_view b) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const wchar_t x, const wchar_t y) {
+    return std::towlower(static_cast<wint_t>(x)) == std::towlower(static_cast<wint_t>(y));
+  });
+}
+
+static bool IsEmpty(const RECT &rect) { return rect.left >= rect.right || rect.top >= rect.bottom; }
+
+static void Invalidate(Window &window, const RECT *rect, const bool erase) {
+  RECT area{0, 0, window.width, window.height};
+
+  if (rect != nullptr) {
+    area = {std::max<LONG>(rect->left, 0),
+            std::max<LONG>(rect->top, 0),
+            std::min<LONG>(rect->right, window.width),
+            std::min<LONG>(rect->bottom, window.height)};
+  }
+
+  if (IsEmpty(area)) {
+    return;
+  }
+
+  if (IsEmpty(window.update)) {
+    window.update = area;
+  } else {
+    window.update = {std::min(window.update.left, area.left),
+                     std::min(window.update.top, area.top),
+                     std::max(window.update.right, area.right),
+                     std::max(window.update.bottom, area.bottom)};
+  }
+
+  window.erase = window.erase || erase;
+}
+
+static DWORD MessageTime() { return static_cast<DWORD>(::GetTickCount64()); }
+
+/**
+ * Calls the window's WNDPROC with the lock released, the same way SendMessageW would. Returns 0 if the window is gone by
+ * the time it is looked up.
+ */
+static LRESULT Send(std::unique_lock<std::mutex> &lock,
+                    const HWND hWnd,
+                    const UINT msg,
+                    const WPARAM wParam,
+                    const LPARAM lParam) {
+  const Window *window = FindWindow(hWnd);
+
+  if (window == nullptr || window->wndProc == nullptr) {
+    return 0;
+  }
+
+  const WNDPROC wndProc = window->wndProc;
+
+  lock.unlock();
+  const LRESULT result = wndProc(hWnd, msg, wParam, lParam);
+  lock.lock();
+
+  return result;
+}
+
+// `hWnd` followed by all of its descendants, parents before their children.
+static std::vector<HWND> Subtree(const HWND hWnd) {
+  // Indexed once up front, so the walk stays linear in the number of windows even for trees of 100k windows.
+  std::unordered_multimap<HWND, HWND> children;
+
+  for (const auto &[handle, window] : windows) {
+    if (window.parent != nullptr) {
+      children.emplace(window.parent, reinterpret_cast<HWND>(handle));
+    }
+  }
+
+  std::vector<HWND> result{hWnd};
+
+  for (size_t i = 0; i < result.size(); i++) {
+    const auto [first, last] = children.equal_range(result[i]);
+    const size_t start = result.size();
+
+    for (auto it = first; it != last; ++it) {
+      result.push_back(it->second);
+    }
+
+    // The multimap doesn't keep insertion order, so siblings are put back in creation order.
+    std::sort(result.begin() + start, result.end());
+  }
+
+  return result;
+}
+
+/**** Classes *********************************************************************************************************/
+
+WIN32_STUB_EXPORT ATOM WINAPI RegisterClassExW(const WNDCLASSEXW *lpWndClass) {
+  if (lpWndClass == nullptr || lpWndClass->cbSize != sizeof(WNDCLASSEXW) || lpWndClass->lpszClassName == nullptr) {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return 0;
+  }
+
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  const std::wstring_view name = lpWndClass->lpszClassName;
+
+  if (std::any_of(classes.begin(), classes.end(), [&](const WindowClass &c) { return SameClassName(c.name, name); })) {
+    ::SetLastError(ERROR_CLASS_ALREADY_EXISTS);
+    return 0;
+  }
+
+  const ATOM atom = nextAtom++;
+
+  classes.push_back({std::wstring(name), atom, lpWndClass->lpfnWndProc});
+
+  return atom;
+}
+
+static const WindowClass *FindClass(const LPCWSTR lpClassName) {
+  // MAKEINTATOM: an atom smuggled through the low word of the pointer.
+  const uintptr_t value = reinterpret_cast<uintptr_t>(lpClassName);
+
+  for (const WindowClass &windowClass : classes) {
+    if (value <= 0xFFFF ? windowClass.atom == value : SameClassName(windowClass.name, lpClassName)) {
+      return &windowClass;
+    }
+  }
+
+  return nullptr;
+}
+
+/**** Windows *********************************************************************************************************/
+
+WIN32_STUB_EXPORT HWND WINAPI CreateWindowExW(const DWORD dwExStyle,
+                                              const LPCWSTR lpClassName,
+                                              const LPCWSTR lpWindowName,
+                                              const DWORD dwStyle,
+                                              const int X,
+                                              const int Y,
+                                              const int nWidth,
+                                              const int nHeight,
+                                              const HWND hWndParent,
+                                              const HMENU hMenu,
+                                              const HINSTANCE hInstance,
+                                              const LPVOID lpParam) {
+  std::unique_lock<std::mutex> lock(user32Mutex);
+
+  const WindowClass *windowClass = lpClassName != nullptr ? FindClass(lpClassName) : nullptr;
+
+  if (windowClass == nullptr) {
+    ::SetLastError(ERROR_CANNOT_FIND_WND_CLASS);
+    return nullptr;
+  }
+
+  if (hWndParent != nullptr && FindWindow(hWndParent) == nullptr) {
+    ::SetLastError(ERROR_INVALID_WINDOW_HANDLE);
+    return nullptr;
+  }
+
+  const bool child = (dwStyle & WS_CHILD) != 0;
+
+  // A child window's "menu" is its control ID, anything else's must be a real menu.
+  if (!child && hMenu != nullptr && !win32_stub::MenuExists(hMenu)) {
+    ::SetLastError(ERROR_INVALID_MENU_HANDLE);
+    return nullptr;
+  }
+
+  Window window{};
+  window.parent = hWndParent;
+  window.threadId = win32_stub::CurrentThreadId();
+  window.className = windowClass->name;
+  window.wndProc = windowClass->wndProc;
+  window.style = dwStyle;
+  window.exStyle = dwExStyle;
+  window.x = X == CW_USEDEFAULT ? 0 : X;
+  window.y = X == CW_USEDEFAULT ? 0 : Y;
+  window.width = nWidth == CW_USEDEFAULT ? (child ? 0 : DEFAULT_WIDTH) : std::max(nWidth, 0);
+  window.height = nWidth == CW_USEDEFAULT ? (child ? 0 : DEFAULT_HEIGHT) : std::max(nHeight, 0);
+  window.menu = hMenu;
+
+  const HWND hWnd = reinterpret_cast<HWND>(nextWindow);
+  nextWindow += 2;
+
+  windows.emplace(reinterpret_cast<uintptr_t>(hWnd), std::move(window));
+
+  CREATESTRUCTW create{lpParam,
+                       hInstance,
+                       hMenu,
+                       hWndParent,
+                       nHeight,
+                       nWidth,
+                       Y,
+                       X,
+                       static_cast<LONG>(dwStyle),
+                       lpWindowName,
+                       lpClassName,
+                       dwExStyle};
+
+  // A window that refuses WM_NCCREATE is never really created; one that refuses WM_CREATE is destroyed properly.
+  if (Send(lock, hWnd, WM_NCCREATE, 0, reinterpret_cast<LPARAM>(&create)) == FALSE) {
+    windows.erase(reinterpret_cast<uintptr_t>(hWnd));
+    return nullptr;
+  }
+
+  if (Send(lock, hWnd, WM_CREATE, 0, reinterpret_cast<LPARAM>(&create)) == -1) {
+    lock.unlock();
+    ::DestroyWindow(hWnd);
+    return nullptr;
+  }
+
+  Window *created = FindWindow(hWnd);
+
+  if (created == nullptr) {
+    return nullptr;
+  }
+
+  if ((dwStyle & WS_VISIBLE) != 0) {
+    created->visible = true;
+    Invalidate(*created, nullptr, true);
+  }
+
+  return hWnd;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI DestroyWindow(const HWND hWnd) {
+  std::unique_lock<std::mutex> lock(user32Mutex);
+
+  Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr) {
+    return FALSE;
+  }
+
+  // Called again from one of its own WM_DESTROY handlers; the outer call finishes the job.
+  if (window->destroying) {
+    return TRUE;
+  }
+
+  const std::vector<HWND> subtree = Subtree(hWnd);
+
+  for (const HWND handle : subtree) {
+    FindWindow(handle)->destroying = true;
+  }
+
+  // WM_DESTROY goes to the parent before its children, WM_NCDESTROY to the children before their parent, and a window
+  // is only gone once its WM_NCDESTROY has returned.
+  for (const HWND handle : subtree) {
+    Send(lock, handle, WM_DESTROY, 0, 0);
+  }
+
+  for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+    Send(lock, *it, WM_NCDESTROY, 0, 0);
+
+    const auto destroyed = windows.find(reinterpret_cast<uintptr_t>(*it));
+    const bool child = (destroyed->second.style & WS_CHILD) != 0;
+    const HMENU menu = destroyed->second.menu;
+    const DWORD threadId = destroyed->second.threadId;
+
+    windows.erase(destroyed);
+
+    // Messages still queued for the window are dropped with it.
+    if (const auto queue = queues.find(threadId); queue != queues.end()) {
+      std::erase_if(queue->second.posted, [&](const MSG &msg) { return msg.hwnd == *it; });
+    }
+
+    // So is the menu attached to it.
+    if (!child && menu != nullptr) {
+      lock.unlock();
+      ::DestroyMenu(menu);
+      lock.lock();
+    }
+  }
+
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT LRESULT WINAPI DefWindowProcW(const HWND hWnd, const UINT Msg, const WPARAM, const LPARAM lParam) {
+  switch (Msg) {
+  // The title is set here rather than by CreateWindowExW, same as on Windows, so it is read from lpszName only after
+  // the window procedure had its chance to handle WM_NCCREATE.
+  case WM_NCCREATE: {
+    const CREATESTRUCTW *create = reinterpret_cast<const CREATESTRUCTW *>(lParam);
+
+    if (create != nullptr && create->lpszName != nullptr) {
+      std::lock_guard<std::mutex> lock(user32Mutex);
+
+      if (Window *window = FindWindow(hWnd)) {
+        window->text = create->lpszName;
+      }
+    }
+
+    return TRUE;
+  }
+
+  case WM_CLOSE:
+    ::DestroyWindow(hWnd);
+    return 0;
+
+  case WM_PAINT: {
+    PAINTSTRUCT ps{};
+    ::BeginPaint(hWnd, &ps);
+    ::EndPaint(hWnd, &ps);
+    return 0;
+  }
+
+  case WM_ERASEBKGND:
+    return 1;
+
+  case WM_SETTEXT: {
+    std::lock_guard<std::mutex> lock(user32Mutex);
+
+    Window *window = FindWindow(hWnd);
+
+    if (window == nullptr) {
+      return FALSE;
+    }
+
+    window->text = lParam != 0 ? reinterpret_cast<LPCWSTR>(lParam) : L"";
+    return TRUE;
+  }
+
+  default:
+    return 0;
+  }
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI IsWindow(const HWND hWnd) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  return FindWindow(hWnd) != nullptr ? TRUE : FALSE;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI ShowWindow(const HWND hWnd, const int nCmdShow) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr) {
+    return FALSE;
+  }
+
+  const bool wasVisible = window->visible;
+
+  window->visible = nCmdShow != SW_HIDE;
+
+  if (window->visible && !wasVisible) {
+    Invalidate(*window, nullptr, true);
+  }
+
+  return wasVisible ? TRUE : FALSE;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI UpdateWindow(const HWND hWnd) {
+  std::unique_lock<std::mutex> lock(user32Mutex);
+
+  const Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr) {
+    return FALSE;
+  }
+
+  // Sent straight to the window, bypassing the queue, only if there is something to paint.
+  if (window->visible && !IsEmpty(window->update)) {
+    Send(lock, hWnd, WM_PAINT, 0, 0);
+  }
+
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI IsWindowVisible(const HWND hWnd) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  // Visible only if every ancestor is too.
+  for (const Window *window = FindWindow(hWnd); window != nullptr; window = FindWindow(window->parent)) {
+    if (!window->visible) {
+      return FALSE;
+    }
+
+    if (window->parent == nullptr) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+WIN32_STUB_EXPORT int WINAPI GetClassNameW(const HWND hWnd, const LPWSTR lpClassName, const int nMaxCount) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  const Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr) {
+    return 0;
+  }
+
+  if (nMaxCount <= 0) {
+    ::SetLastError(ERROR_INSUFFICIENT_BUFFER);
+    return 0;
+  }
+
+  return win32_stub::CopyString(window->className, lpClassName, nMaxCount);
+}
+
+WIN32_STUB_EXPORT int WINAPI GetWindowTextW(const HWND hWnd, const LPWSTR lpString, const int nMaxCount) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  const Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr || nMaxCount <= 0) {
+    return 0;
+  }
+
+  return win32_stub::CopyString(window->text, lpString, nMaxCount);
+}
+
+WIN32_STUB_EXPORT int WINAPI GetWindowTextLengthW(const HWND hWnd) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  const Window *window = RequireWindow(hWnd);
+
+  return window != nullptr ? static_cast<int>(window->text.size()) : 0;
+}
+
+WIN32_STUB_EXPORT DWORD WINAPI GetWindowThreadProcessId(const HWND hWnd, const LPDWORD lpdwProcessId) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  const Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr) {
+    return 0;
+  }
+
+  if (lpdwProcessId != nullptr) {
+    *lpdwProcessId = static_cast<DWORD>(::getpid());
+  }
+
+  return window->threadId;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI GetWindowRect(const HWND hWnd, const LPRECT lpRect) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  const Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr) {
+    return FALSE;
+  }
+
+  // Child positions are relative to the parent's client area, which starts at the parent's own origin here.
+  LONG left = window->x;
+  LONG top = window->y;
+
+  for (const Window *parent = FindWindow(window->parent); parent != nullptr; parent = FindWindow(parent->parent)) {
+    left += parent->x;
+    top += parent->y;
+  }
+
+  *lpRect = {left, top, left + window->width, top + window->height};
+
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI GetClientRect(const HWND hWnd, const LPRECT lpRect) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  const Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr) {
+    return FALSE;
+  }
+
+  *lpRect = {0, 0, window->width, window->height};
+
+  return TRUE;
+}
+
+static BOOL Enumerate(std::vector<HWND> hWnds, const WNDENUMPROC lpEnumFunc, const LPARAM lParam) {
+  for (const HWND hWnd : hWnds) {
+    // Skip windows destroyed by an earlier callback.
+    if (::IsWindow(hWnd) && lpEnumFunc(hWnd, lParam) == FALSE) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI EnumWindows(const WNDENUMPROC lpEnumFunc, const LPARAM lParam) {
+  std::vector<HWND> hWnds;
+
+  {
+    std::lock_guard<std::mutex> lock(user32Mutex);
+
+    // Top-level windows in Z order, which without activation is newest first.
+    for (auto it = windows.rbegin(); it != windows.rend(); ++it) {
+      if (it->second.parent == nullptr) {
+        hWnds.push_back(reinterpret_cast<HWND>(it->first));
+      }
+    }
+  }
+
+  return Enumerate(std::move(hWnds), lpEnumFunc, lParam);
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI EnumChildWindows(const HWND hWndParent, const WNDENUMPROC lpEnumFunc, const LPARAM lParam) {
+  if (hWndParent == nullptr) {
+    return ::EnumWindows(lpEnumFunc, lParam);
+  }
+
+  std::vector<HWND> hWnds;
+
+  {
+    std::lock_guard<std::mutex> lock(user32Mutex);
+
+    if (RequireWindow(hWndParent) == nullptr) {
+      return FALSE;
+    }
+
+    hWnds = Subtree(hWndParent);
+    hWnds.erase(hWnds.begin());
+  }
+
+  return Enumerate(std::move(hWnds), lpEnumFunc, lParam);
+}
+
+/**** Messages ********************************************************************************************************/
+
+static bool Matches(const MSG &msg, const HWND hWnd, const UINT wMsgFilterMin, const UINT wMsgFilterMax) {
+  if (hWnd == reinterpret_cast<HWND>(-1) ? msg.hwnd != nullptr : hWnd != nullptr && msg.hwnd != hWnd) {
+    return false;
+  }
+
+  return (wMsgFilterMin == 0 && wMsgFilterMax == 0) || (msg.message >= wMsgFilterMin && msg.message <= wMsgFilterMax);
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI GetMessageW(const LPMSG lpMsg,
+                                          const HWND hWnd,
+                                          const UINT wMsgFilterMin,
+                                          const UINT wMsgFilterMax) {
+  std::unique_lock<std::mutex> lock(user32Mutex);
+
+  if (hWnd != nullptr && hWnd != reinterpret_cast<HWND>(-1) && FindWindow(hWnd) == nullptr) {
+    ::SetLastError(ERROR_INVALID_WINDOW_HANDLE);
+    return -1;
+  }
+
+  const DWORD threadId = win32_stub::CurrentThreadId();
+  MessageQueue &queue = queues[threadId];
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(messageWaitTimeout);
+
+  while (true) {
+    // Posted messages first, then WM_QUIT, then WM_PAINT for windows with something to paint, as on Windows.
+    const auto posted = std::find_if(queue.posted.begin(), queue.posted.end(), [&](const MSG &msg) {
+      return Matches(msg, hWnd, wMsgFilterMin, wMsgFilterMax);
+    });
+
+    if (posted != queue.posted.end()) {
+      *lpMsg = *posted;
+      queue.posted.erase(posted);
+      return lpMsg->message != WM_QUIT ? TRUE : FALSE;
+    }
+
+    if (queue.quit) {
+      queue.quit = false;
+      *lpMsg = {nullptr, WM_QUIT, static_cast<WPARAM>(queue.exitCode), 0, MessageTime(), {0, 0}};
+      return FALSE;
+    }
+
+    for (const auto &[handle, window] : windows) {
+      const MSG paint{reinterpret_cast<HWND>(handle), WM_PAINT, 0, 0, MessageTime(), {0, 0}};
+
+      if (window.threadId == threadId && window.visible && !IsEmpty(window.update) &&
+          Matches(paint, hWnd, wMsgFilterMin, wMsgFilterMax)) {
+        *lpMsg = paint;
+        return TRUE;
+      }
+    }
+
+    // Nothing else can post to this queue while the thread is blocked here, so rather than hang, give up eventually.
+    if (queue.changed.wait_until(lock, deadline) == std::cv_status::timeout) {
+      ::SetLastError(ERROR_TIMEOUT);
+      return -1;
+    }
+  }
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI PostMessageW(const HWND hWnd, const UINT Msg, const WPARAM wParam, const LPARAM lParam) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  DWORD threadId = win32_stub::CurrentThreadId();
+
+  // A null window posts to the calling thread's own queue, like PostThreadMessageW.
+  if (hWnd != nullptr) {
+    const Window *window = RequireWindow(hWnd);
+
+    if (window == nullptr) {
+      return FALSE;
+    }
+
+    threadId = window->threadId;
+  }
+
+  MessageQueue &queue = queues[threadId];
+
+  queue.posted.push_back({hWnd, Msg, wParam, lParam, MessageTime(), {0, 0}});
+  queue.changed.notify_all();
+
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT void WINAPI PostQuitMessage(const int nExitCode) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  MessageQueue &queue = queues[win32_stub::CurrentThreadId()];
+
+  queue.quit = true;
+  queue.exitCode = nExitCode;
+  queue.changed.notify_all();
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI TranslateMessage(const MSG *) {
+  // There is no keyboard layout to turn key messages into characters with.
+  return FALSE;
+}
+
+WIN32_STUB_EXPORT LRESULT WINAPI DispatchMessageW(const MSG *lpMsg) {
+  if (lpMsg->hwnd == nullptr) {
+    return 0;
+  }
+
+  std::unique_lock<std::mutex> lock(user32Mutex);
+
+  if (RequireWindow(lpMsg->hwnd) == nullptr) {
+    return 0;
+  }
+
+  return Send(lock, lpMsg->hwnd, lpMsg->message, lpMsg->wParam, lpMsg->lParam);
+}
+
+/**** Painting ********************************************************************************************************/
+
+WIN32_STUB_EXPORT HDC WINAPI BeginPaint(const HWND hWnd, const LPPAINTSTRUCT lpPaint) {
+  std::unique_lock<std::mutex> lock(user32Mutex);
+
+  Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr) {
+    return nullptr;
+  }
+
+  // Device contexts are never drawn to, so any value that isn't null will do.
+  const HDC hdc = reinterpret_cast<HDC>(reinterpret_cast<uintptr_t>(hWnd) | 1);
+
+  const RECT update = IsEmpty(window->update) ? RECT{} : window->update;
+  const bool erase = std::exchange(window->erase, false);
+
+  window->update = {};
+
+  *lpPaint = {};
+  lpPaint->hdc = hdc;
+  lpPaint->rcPaint = update;
+
+  // fErase tells the caller the background still needs erasing because the WM_ERASEBKGND handler didn't do it.
+  if (erase) {
+    lpPaint->fErase = Send(lock, hWnd, WM_ERASEBKGND, reinterpret_cast<WPARAM>(hdc), 0) == 0 ? TRUE : FALSE;
+  }
+
+  return hdc;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI EndPaint(const HWND, const PAINTSTRUCT *) { return TRUE; }
+
+WIN32_STUB_EXPORT BOOL WINAPI InvalidateRect(const HWND hWnd, const RECT *lpRect, const BOOL bErase) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  // A null window invalidates every window.
+  if (hWnd == nullptr) {
+    for (auto &[handle, window] : windows) {
+      Invalidate(window, nullptr, bErase != FALSE);
+    }
+
+    return TRUE;
+  }
+
+  Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr) {
+    return FALSE;
+  }
+
+  Invalidate(*window, lpRect, bErase != FALSE);
+
+  return TRUE;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI InvalidateRgn(const HWND hWnd, const HRGN, const BOOL bErase) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr) {
+    return FALSE;
+  }
+
+  // There are no region objects, so any region invalidates the whole client area, which contains every region.
+  Invalidate(*window, nullptr, bErase != FALSE);
+
+  return TRUE;
+}
+
+/**** Menus ***********************************************************************************************************/
+
+WIN32_STUB_EXPORT HMENU WINAPI GetMenu(const HWND hWnd) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  const Window *window = RequireWindow(hWnd);
+
+  return window != nullptr && (window->style & WS_CHILD) == 0 ? window->menu : nullptr;
+}
+
+WIN32_STUB_EXPORT BOOL WINAPI SetMenu(const HWND hWnd, const HMENU hMenu) {
+  if (hMenu != nullptr && !win32_stub::MenuExists(hMenu)) {
+    ::SetLastError(ERROR_INVALID_MENU_HANDLE);
+    return FALSE;
+  }
+
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  Window *window = RequireWindow(hWnd);
+
+  if (window == nullptr) {
+    return FALSE;
+  }
+
+  // The previous menu is only detached; destroying it is up to the caller.
+  window->menu = hMenu;
+
+  return TRUE;
+}
+
+/**** Control *********************************************************************************************************/
+
+void win32_stub::ResetWindows() {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  // Dropped without any messages; the WNDPROCs they would go to may belong to an environment that no longer exists.
+  windows.clear();
+  classes.clear();
+  queues.clear();
+  messageWaitTimeout = 1000;
+}
+
+size_t win32_stub::WindowCount() {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  return windows.size();
+}
+
+void win32_stub::SetMessageWaitTimeout(const DWORD milliseconds) {
+  std::lock_guard<std::mutex> lock(user32Mutex);
+
+  messageWaitTimeout = milliseconds;
+}
@@ -0,0 +1 @@
+#include "../../src/gdi32.cpp"
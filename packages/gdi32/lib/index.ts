@@ -2,6 +2,30 @@ import { createRequire } from 'node:module';
 
 const require = createRequire(import.meta.url);
 
+/**
+ * Loads this package's own addon, or the gdi32 part of the combined libwin addon from @libwin/native when
+ * LIBWIN_NATIVE=1 is set, so every package shares one native runtime. The combined addon is opt-in, since it has to be
+ * installed and built separately: it is an optional peer dependency, and a workspace checkout links it even when it was
+ * never built.
+ */
+function loadAddon() {
+  if (process.env.LIBWIN_NATIVE !== '1') {
+    return require('./gdi32.node');
+  }
+
+  try {
+    return require('@libwin/native').gdi32;
+  } catch (error) {
+    if ((error as NodeJS.ErrnoException).code === 'MODULE_NOT_FOUND') {
+      throw new Error('LIBWIN_NATIVE=1 is set, but @libwin/native is not installed or not built', { cause: error });
+    }
+
+    throw error;
+  }
+}
+
+// ESM needs every named export's value at import, so this reads, and thereby creates, each function the addon
+// defines lazily.
 export const {
   AbortDoc,
   AbortPath,
@@ -996,4 +1020,4 @@ export const {
   pGdiSharedMemory,
   pldcGet,
   vSetPldc,
-} = require('./gdi32.node');
+} = loadAddon();
@@ -1,5 +1,9 @@
 #include "gdi32.hpp"
 
-Napi::Object Initialize(const Napi::Env env, Napi::Object exports) { return exports; }
+Napi::Object Gdi32::Initialize(const Napi::Env env, Napi::Object exports) { return exports; }
+
+#ifndef LIBWIN_MONOLITHIC
+static Napi::Object Initialize(const Napi::Env env, Napi::Object exports) { return Gdi32::Initialize(env, exports); }
 
 NODE_API_MODULE(gdi32, Initialize)
+#endif
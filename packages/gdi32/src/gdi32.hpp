@@ -7,6 +7,10 @@
 #include "../../common/include/quickbind.hpp"
 
 namespace Gdi32 {
+  // Defines every gdi32 binding on `exports`. Called by this addon's module entry point, or by the combined libwin
+  // addon when building with LIBWIN_MONOLITHIC.
+  Napi::Object Initialize(const Napi::Env env, Napi::Object exports);
+
   Napi::Value AbortDoc(const Napi::CallbackInfo &info);
   Napi::Value AbortPath(const Napi::CallbackInfo &info);
   Napi::Value AddFontMemResourceEx(const Napi::CallbackInfo &info);
@@ -0,0 +1,177 @@
+# This file is generated by gyp; do not edit.
+
+TOOLSET := target
+TARGET := kernel32
+DEFS_Debug := \
+	'-DNODE_GYP_MODULE_NAME=kernel32' \
+	'-DUSING_UV_SHARED=1' \
+	'-DUSING_V8_SHARED=1' \
+	'-DV8_DEPRECATION_WARNINGS=1' \
+	'-D_GLIBCXX_USE_CXX11_ABI=1' \
+	'-D_FILE_OFFSET_BITS=64' \
+	'-D_LARGEFILE_SOURCE' \
+	'-D__STDC_FORMAT_MACROS' \
+	'-DOPENSSL_NO_PINSHARED' \
+	'-DOPENSSL_THREADS' \
+	'-DBUILDING_NODE_EXTENSION' \
+	'-DDEBUG' \
+	'-D_DEBUG' \
+	'-DQB_CHECKED_NARROWING'
+
+# Flags passed to all source files.
+CFLAGS_Debug := \
+	-fno-exceptions \
+	-fPIC \
+	-pthread \
+	-Wall \
+	-Wextra \
+	-Wno-unused-parameter \
+	-m64 \
+	-g \
+	-O0
+
+# Flags passed to only C files.
+CFLAGS_C_Debug :=
+
+# Flags passed to only C++ files.
+CFLAGS_CC_Debug := \
+	-fno-exceptions \
+	-fno-rtti \
+	-fno-exceptions \
+	-fno-strict-aliasing \
+	-std=gnu++17 \
+	-std=c++20
+
+INCS_Debug := \
+	-I/root/.nvm/versions/node/v22.20.0/include/node \
+	-I/root/.nvm/versions/node/v22.20.0/src \
+	-I/root/.nvm/versions/node/v22.20.0/deps/openssl/config \
+	-I/root/.nvm/versions/node/v22.20.0/deps/openssl/openssl/include \
+	-I/root/.nvm/versions/node/v22.20.0/deps/uv/include \
+	-I/root/.nvm/versions/node/v22.20.0/deps/zlib \
+	-I/root/.nvm/versions/node/v22.20.0/deps/v8/include \
+	-I$(srcdir)/../../packages/common/win32-stub/include \
+	-I/tmp/napi-rt
+
+DEFS_Release := \
+	'-DNODE_GYP_MODULE_NAME=kernel32' \
+	'-DUSING_UV_SHARED=1' \
+	'-DUSING_V8_SHARED=1' \
+	'-DV8_DEPRECATION_WARNINGS=1' \
+	'-D_GLIBCXX_USE_CXX11_ABI=1' \
+	'-D_FILE_OFFSET_BITS=64' \
+	'-D_LARGEFILE_SOURCE' \
+	'-D__STDC_FORMAT_MACROS' \
+	'-DOPENSSL_NO_PINSHARED' \
+	'-DOPENSSL_THREADS' \
+	'-DBUILDING_NODE_EXTENSION'
+
+# Flags passed to all source files.
+CFLAGS_Release := \
+	-fno-exceptions \
+	-fPIC \
+	-pthread \
+	-Wall \
+	-Wextra \
+	-Wno-unused-parameter \
+	-m64 \
+	-O3 \
+	-fno-omit-frame-pointer
+
+# Flags passed to only C files.
+CFLAGS_C_Release :=
+
+# Flags passed to only C++ files.
+CFLAGS_CC_Release := \
+	-fno-exceptions \
+	-fno-rtti \
+	-fno-exceptions \
+	-fno-strict-aliasing \
+	-std=gnu++17 \
+	-std=c++20
+
+INCS_Release := \
+	-I/root/.nvm/versions/node/v22.20.0/include/node \
+	-I/root/.nvm/versions/node/v22.20.0/src \
+	-I/root/.nvm/versions/node/v22.20.0/deps/openssl/config \
+	-I/root/.nvm/versions/node/v22.20.0/deps/openssl/openssl/include \
+	-I/root/.nvm/versions/node/v22.20.0/deps/uv/include \
+	-I/root/.nvm/versions/node/v22.20.0/deps/zlib \
+	-I/root/.nvm/versions/node/v22.20.0/deps/v8/include \
+	-I$(srcdir)/../../packages/common/win32-stub/include \
+	-I/tmp/napi-rt
+
+OBJS := \
+	$(obj).target/$(TARGET)/src/directory_watcher.o \
+	$(obj).target/$(TARGET)/src/enumerate_directory.o \
+	$(obj).target/$(TARGET)/src/format_message.o \
+	$(obj).target/$(TARGET)/src/get_last_error.o \
+	$(obj).target/$(TARGET)/src/get_module_file_name.o \
+	$(obj).target/$(TARGET)/src/get_module_handle.o \
+	$(obj).target/$(TARGET)/src/io_ring.o \
+	$(obj).target/$(TARGET)/src/kernel32.o
+
+# Add to the list of files we specially track dependencies for.
+all_deps += $(OBJS)
+
+# Make sure our dependencies are built before any of us.
+$(OBJS): | $(obj).target/../../../../tmp/nm/node-addon-api/node_addon_api.stamp
+
+# CFLAGS et al overrides must be target-local.
+# See "Target-specific Variable Values" in the GNU Make manual.
+$(OBJS): TOOLSET := $(TOOLSET)
+$(OBJS): GYP_CFLAGS := $(DEFS_$(BUILDTYPE)) $(INCS_$(BUILDTYPE))  $(CFLAGS_$(BUILDTYPE)) $(CFLAGS_C_$(BUILDTYPE))
+$(OBJS): GYP_CXXFLAGS := $(DEFS_$(BUILDTYPE)) $(INCS_$(BUILDTYPE))  $(CFLAGS_$(BUILDTYPE)) $(CFLAGS_CC_$(BUILDTYPE))
+
+# Suffix rules, putting all outputs into $(obj).
+
+$(obj).$(TOOLSET)/$(TARGET)/%.o: $(srcdir)/%.cpp FORCE_DO_CMD
+	@$(call do_cmd,cxx,1)
+
+# Try building from generated source, too.
+
+$(obj).$(TOOLSET)/$(TARGET)/%.o: $(obj).$(TOOLSET)/%.cpp FORCE_DO_CMD
+	@$(call do_cmd,cxx,1)
+
+$(obj).$(TOOLSET)/$(TARGET)/%.o: $(obj)/%.cpp FORCE_DO_CMD
+	@$(call do_cmd,cxx,1)
+
+# End of this set of suffix rules
+### Rules for final target.
+LDFLAGS_Debug := \
+	-pthread \
+	-rdynamic \
+	-m64
+
+LDFLAGS_Release := \
+	-pthread \
+	-rdynamic \
+	-m64
+
+LIBS :=
+
+$(obj).target/kernel32.node: GYP_LDFLAGS := $(LDFLAGS_$(BUILDTYPE))
+$(obj).target/kernel32.node: LIBS := $(LIBS)
+$(obj).target/kernel32.node: TOOLSET := $(TOOLSET)
+$(obj).target/kernel32.node: $(OBJS) FORCE_DO_CMD
+	$(call do_cmd,solink_module)
+
+all_deps += $(obj).target/kernel32.node
+# Add target alias
+.PHONY: kernel32
+kernel32: $(builddir)/kernel32.node
+
+# Copy this to the executable output path.
+$(builddir)/kernel32.node: TOOLSET := $(TOOLSET)
+$(builddir)/kernel32.node: $(obj).target/kernel32.node FORCE_DO_CMD
+	$(call do_cmd,copy)
+
+all_deps += $(builddir)/kernel32.node
+# Short alias for building this executable.
+.PHONY: kernel32.node
+kernel32.node: $(obj).target/kernel32.node $(builddir)/kernel32.node
+
+# Add executable to "all" target.
+.PHONY: all
+all: $(builddir)/kernel32.node
+
@@ -0,0 +1,144 @@
+import { mkdtempSync, renameSync, rmSync, unlinkSync, writeFileSync } from 'node:fs';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
+
+import { afterEach, describe, expect, test } from 'vitest';
+
+import {
+  CloseDirectoryWatcher,
+  CreateDirectoryWatcher,
+  DIRECTORY_CHANGE_ADDED,
+  DIRECTORY_CHANGE_REMOVED,
+  DIRECTORY_CHANGE_RENAMED,
+  type DirectoryChangeBatch,
+  getDirectoryChangeName,
+  getDirectoryChangeOldName,
+} from './index.js';
+
+type Change = { action: number; name: string; oldName: string };
+
+const LATENCY = 50;
+
+let directory: string | undefined;
+let watcher = 0;
+let batches = 0;
+
+afterEach(() => {
+  CloseDirectoryWatcher(watcher);
+  rmSync(directory!, { recursive: true, force: true });
+});
+
+/**
+ * Watches a fresh directory, runs `act` in it and collects the coalesced changes until no batch has arrived for a few
+ * times the latency.
+ */
+async function watch(
+  act: (directory: string) => void | Promise<void>,
+  prepare?: (directory: string) => void,
+  options?: { latency?: number; maxBatchSize?: number },
+): Promise<Change[]> {
+  directory = mkdtempSync(join(tmpdir(), 'libwin-watcher-'));
+  prepare?.(directory);
+
+  const changes: Change[] = [];
+  const latency = options?.latency ?? LATENCY;
+  let last = Date.now();
+
+  batches = 0;
+
+  watcher = CreateDirectoryWatcher(directory, { latency: LATENCY, ...options }, (batch: DirectoryChangeBatch) => {
+    batches++;
+
+    for (let i = 0; i < batch.count; i++) {
+      changes.push({
+        action: batch.Action[i],
+        name: getDirectoryChangeName(batch, i),
+        oldName: getDirectoryChangeOldName(batch, i),
+      });
+    }
+
+    last = Date.now();
+  });
+
+  expect(watcher).not.toBe(0);
+
+  await act(directory);
+  last = Date.now();
+
+  while (Date.now() - last < latency * 6) {
+    await new Promise((resolve) => setTimeout(resolve, latency));
+  }
+
+  return changes;
+}
+
+describe('CreateDirectoryWatcher', () => {
+  test('reports an added file once, however often it was written', async () => {
+    const changes = await watch((directory) => {
+      writeFileSync(join(directory, 'a.txt'), 'a');
+      writeFileSync(join(directory, 'a.txt'), 'ab');
+    });
+
+    expect(changes).toEqual([{ action: DIRECTORY_CHANGE_ADDED, name: 'a.txt', oldName: '' }]);
+  });
+
+  test('drops a file that was added and removed again', async () => {
+    const changes = await watch((directory) => {
+      writeFileSync(join(directory, 'a.txt'), 'a');
+      unlinkSync(join(directory, 'a.txt'));
+    });
+
+    expect(changes).toEqual([]);
+  });
+
+  test('joins both halves of a rename', async () => {
+    const changes = await watch(
+      (directory) => renameSync(join(directory, 'a.txt'), join(directory, 'b.txt')),
+      (directory) => writeFileSync(join(directory, 'a.txt'), 'a'),
+    );
+
+    expect(changes).toEqual([{ action: DIRECTORY_CHANGE_RENAMED, name: 'b.txt', oldName: 'a.txt' }]);
+  });
+
+  test('keeps both halves of a rename in one batch when maxBatchSize is reached', async () => {
+    const changes = await watch(
+      (directory) => {
+        writeFileSync(join(directory, 'c.txt'), 'c');
+        renameSync(join(directory, 'a.txt'), join(directory, 'b.txt'));
+      },
+      (directory) => writeFileSync(join(directory, 'a.txt'), 'a'),
+      { maxBatchSize: 1 },
+    );
+
+    expect(changes).toContainEqual({ action: DIRECTORY_CHANGE_RENAMED, name: 'b.txt', oldName: 'a.txt' });
+    expect(changes.some((change) => change.action === DIRECTORY_CHANGE_REMOVED)).toBe(false);
+  });
+
+  test('postpones delivery while changes keep arriving', async () => {
+    const latency = 200;
+
+    // Spans well over one latency, with every gap well under it.
+    const changes = await watch(
+      async (directory) => {
+        for (let i = 0; i < 8; i++) {
+          writeFileSync(join(directory, `${i}.txt`), '');
+          await new Promise((resolve) => setTimeout(resolve, latency / 5));
+        }
+      },
+      undefined,
+      { latency },
+    );
+
+    expect(changes).toHaveLength(8);
+    expect(batches).toBe(1);
+  });
+
+  test('reports a removed file', async () => {
+    const changes = await watch(
+      (directory) => unlinkSync(join(directory, 'a.txt')),
+      (directory) => writeFileSync(join(directory, 'a.txt'), 'a'),
+    );
+
+    expect(changes).toEqual([{ action: DIRECTORY_CHANGE_REMOVED, name: 'a.txt', oldName: '' }]);
+  });
+});
@@ -0,0 +1,84 @@
+export const FILE_NOTIFY_CHANGE_FILE_NAME = 0x00000001;
+export const FILE_NOTIFY_CHANGE_DIR_NAME = 0x00000002;
+export const FILE_NOTIFY_CHANGE_ATTRIBUTES = 0x00000004;
+export const FILE_NOTIFY_CHANGE_SIZE = 0x00000008;
+export const FILE_NOTIFY_CHANGE_LAST_WRITE = 0x00000010;
+export const FILE_NOTIFY_CHANGE_LAST_ACCESS = 0x00000020;
+export const FILE_NOTIFY_CHANGE_CREATION = 0x00000040;
+export const FILE_NOTIFY_CHANGE_SECURITY = 0x00000100;
+
+export const DIRECTORY_CHANGE_ADDED = 1;
+export const DIRECTORY_CHANGE_REMOVED = 2;
+export const DIRECTORY_CHANGE_MODIFIED = 3;
+/**
+ * A FILE_ACTION_RENAMED_OLD_NAME / FILE_ACTION_RENAMED_NEW_NAME pair joined into one change. The new name is in
+ * `names`, the old one in `oldNames`.
+ */
+export const DIRECTORY_CHANGE_RENAMED = 4;
+
+export type DirectoryWatcherOptions = {
+  /**
+   * Watch the whole subtree rather than only the directory itself.
+   */
+  recursive?: boolean;
+
+  /**
+   * FILE_NOTIFY_CHANGE_* flags. Defaults to file and directory names, size, last write and creation time.
+   */
+  dwNotifyFilter?: number;
+
+  /**
+   * Size of each notification buffer in bytes, between 4096 and 65536. Defaults to 65536.
+   */
+  bufferSize?: number;
+
+  /**
+   * Milliseconds without new changes after which the pending changes are delivered. Every new change postpones delivery
+   * again, but never past 10 times `latency` after the first pending change, so a steady trickle of changes is still
+   * delivered. Defaults to 50.
+   */
+  latency?: number;
+
+  /**
+   * Number of pending changes after which they are delivered without waiting for `latency`. Defaults to 4096.
+   */
+  maxBatchSize?: number;
+};
+
+/**
+ * One batch of coalesced changes, with one element per change in each column. Names are relative to the watched
+ * directory; see getDirectoryChangeName and getDirectoryChangeOldName. LastModificationTime is a raw FILETIME.
+ *
+ * When `overflow` is set, more changes happened than the notification buffer could hold and some were lost, so anything
+ * derived from the watched tree should be rescanned. A non-zero `error` is the Win32 error that stopped the watcher,
+ * e.g. because the watched directory was deleted; no further batches follow it.
+ *
+ * Both halves of a rename always end up in the same batch, even when `maxBatchSize` is reached between them.
+ */
+export type DirectoryChangeBatch = {
+  count: number;
+  Action: Uint32Array;
+  names: Uint16Array;
+  nameOffsets: Uint32Array;
+  oldNames: Uint16Array;
+  oldNameOffsets: Uint32Array;
+  FileId: BigUint64Array;
+  FileSize: BigUint64Array;
+  LastModificationTime: BigUint64Array;
+  FileAttributes: Uint32Array;
+  overflow: boolean;
+  error: number;
+};
+
+const decoder = new TextDecoder('utf-16le');
+
+export function getDirectoryChangeName(batch: DirectoryChangeBatch, index: number): string {
+  return decoder.decode(batch.names.subarray(batch.nameOffsets[index], batch.nameOffsets[index + 1]));
+}
+
+/**
+ * Name a DIRECTORY_CHANGE_RENAMED change was renamed from. Empty for every other action.
+ */
+export function getDirectoryChangeOldName(batch: DirectoryChangeBatch, index: number): string {
+  return decoder.decode(batch.oldNames.subarray(batch.oldNameOffsets[index], batch.oldNameOffsets[index + 1]));
+}
@@ -0,0 +1,86 @@
+import { mkdirSync, mkdtempSync, rmSync, writeFileSync } from 'node:fs';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
+
+import { afterAll, describe, expect, test } from 'vitest';
+
+import { type DirectoryListing, EnumerateDirectory, getDirectoryEntryName } from './index.js';
+
+const ERROR_PATH_NOT_FOUND = 3;
+
+const root = mkdtempSync(join(tmpdir(), 'libwin-directory-'));
+
+for (let i = 0; i < 4; i++) {
+  mkdirSync(join(root, `d${i}`));
+
+  for (let j = 0; j < 25; j++) {
+    writeFileSync(join(root, `d${i}`, `f${j}.txt`), '');
+  }
+}
+
+// 4 directories with 25 files each.
+const TOTAL = 104;
+
+afterAll(() => {
+  rmSync(root, { recursive: true, force: true });
+});
+
+function names(listing: DirectoryListing): string[] {
+  return Array.from({ length: listing.count }, (_, i) => getDirectoryEntryName(listing, i));
+}
+
+describe('EnumerateDirectory', () => {
+  test('lists a single directory', () => {
+    const listing = EnumerateDirectory(root);
+
+    expect(names(listing).sort()).toEqual(['d0', 'd1', 'd2', 'd3']);
+    expect(listing).toMatchObject({ error: 0, failedDirectories: 0 });
+  });
+
+  test('walks the tree with any number of threads', () => {
+    for (const threads of [1, 4]) {
+      const listing = EnumerateDirectory(root, { recursive: true, threads });
+
+      expect(listing.count).toBe(TOTAL);
+      expect(names(listing)).toContain('d3\\f24.txt');
+      expect(listing.error).toBe(0);
+    }
+  });
+
+  test('reports why the root could not be listed', () => {
+    expect(EnumerateDirectory(join(root, 'missing'), { recursive: true, threads: 4 })).toMatchObject({
+      count: 0,
+      error: ERROR_PATH_NOT_FOUND,
+      failedDirectories: 0,
+    });
+  });
+
+  test('delivers full batches to the callback and returns the rest', () => {
+    for (const threads of [1, 3]) {
+      const batches: string[][] = [];
+
+      const rest = EnumerateDirectory(root, { recursive: true, threads, batchSize: 10 }, (batch: DirectoryListing) =>
+        batches.push(names(batch)),
+      );
+
+      expect(batches).toHaveLength(Math.floor(TOTAL / 10));
+      expect(batches.every((batch) => batch.length === 10)).toBe(true);
+      expect(rest.count).toBe(TOTAL % 10);
+      expect(new Set([...batches.flat(), ...names(rest)]).size).toBe(TOTAL);
+    }
+  });
+
+  test('stops when the callback throws', () => {
+    let calls = 0;
+
+    expect(() =>
+      EnumerateDirectory(root, { recursive: true, threads: 2, batchSize: 1 }, () => {
+        calls++;
+        throw new Error('stop');
+      }),
+    ).toThrow(/^stop$/);
+    expect(calls).toBe(1);
+
+    expect(() => EnumerateDirectory(root, { batchSize: 0 })).toThrow(/^Expected batchSize to be at least 1 /);
+  });
+});
@@ -0,0 +1,77 @@
+export const FILE_ATTRIBUTE_READONLY = 0x00000001;
+export const FILE_ATTRIBUTE_HIDDEN = 0x00000002;
+export const FILE_ATTRIBUTE_SYSTEM = 0x00000004;
+export const FILE_ATTRIBUTE_DIRECTORY = 0x00000010;
+export const FILE_ATTRIBUTE_ARCHIVE = 0x00000020;
+export const FILE_ATTRIBUTE_NORMAL = 0x00000080;
+export const FILE_ATTRIBUTE_TEMPORARY = 0x00000100;
+export const FILE_ATTRIBUTE_SPARSE_FILE = 0x00000200;
+export const FILE_ATTRIBUTE_REPARSE_POINT = 0x00000400;
+export const FILE_ATTRIBUTE_COMPRESSED = 0x00000800;
+export const FILE_ATTRIBUTE_OFFLINE = 0x00001000;
+
+export type EnumerateDirectoryOptions = {
+  /**
+   * Descend into subdirectories. Reparse points such as junctions and symlinks are listed but never descended into.
+   */
+  recursive?: boolean;
+
+  /**
+   * Number of threads a recursive walk is spread over, between 1 and 64. Defaults to 1. With more than one thread the
+   * order of the entries is unspecified.
+   */
+  threads?: number;
+
+  /**
+   * Largest number of entries passed to each call of EnumerateDirectory's `onBatch` callback. Defaults to 4096.
+   */
+  batchSize?: number;
+};
+
+/**
+ * Result of EnumerateDirectory, with one element per entry in each column. Names are relative to the enumerated
+ * directory and use `\` as the separator; entry `i`'s name is the UTF-16 code units
+ * `names[nameOffsets[i]]` up to `names[nameOffsets[i + 1]]`, see getDirectoryEntryName. Times are raw FILETIME values.
+ *
+ * When EnumerateDirectory is given an `onBatch` callback, it calls it with a listing of `batchSize` entries whenever
+ * that many have been found, while the walk is still going, and returns only the entries left over. A callback that
+ * throws stops the walk, and EnumerateDirectory rethrows.
+ */
+export type DirectoryListing = {
+  count: number;
+  /**
+   * Only set on the listing EnumerateDirectory returns. The Win32 error that kept the enumerated directory itself from
+   * being listed completely, e.g. ERROR_PATH_NOT_FOUND or ERROR_ACCESS_DENIED, or 0. Entries found before a failure
+   * are still listed.
+   */
+  error?: number;
+  /**
+   * Only set on the listing EnumerateDirectory returns. Subdirectories of a recursive walk that couldn't be listed
+   * completely, e.g. for lack of access. Their other entries are still listed, and the walk goes on without them.
+   */
+  failedDirectories?: number;
+  names: Uint16Array;
+  nameOffsets: Uint32Array;
+  dwFileAttributes: Uint32Array;
+  nFileSize: BigUint64Array;
+  ftCreationTime: BigUint64Array;
+  ftLastAccessTime: BigUint64Array;
+  ftLastWriteTime: BigUint64Array;
+};
+
+const decoder = new TextDecoder('utf-16le');
+
+/**
+ * Decodes the name of a single entry. Only call this for the entries whose names are actually needed; the point of the
+ * packed layout is that the rest never become JS strings.
+ */
+export function getDirectoryEntryName(listing: DirectoryListing, index: number): string {
+  return decoder.decode(listing.names.subarray(listing.nameOffsets[index], listing.nameOffsets[index + 1]));
+}
+
+/**
+ * Converts a FILETIME tick count (100ns intervals since 1601-01-01) to a Date.
+ */
+export function fileTimeToDate(fileTime: bigint): Date {
+  return new Date(Number(fileTime / 10000n - 11644473600000n));
+}
@@ -0,0 +1,18 @@
+import { describe, expect, test } from 'vitest';
+
+import { FORMAT_MESSAGE_FROM_STRING, FormatMessageW } from './index.js';
+
+describe('FormatMessageW', () => {
+  test('formats a message string', () => {
+    const buffer = { value: '' };
+
+    expect(FormatMessageW(FORMAT_MESSAGE_FROM_STRING, 'Hello', 0, 0, buffer, 64)).toBe(5);
+    expect(buffer.value).toBe('Hello');
+  });
+
+  test('reports a bad lpSource before the arguments after it', () => {
+    expect(() => FormatMessageW(FORMAT_MESSAGE_FROM_STRING, 5, 'x', 0, {}, 64)).toThrow(/at index 1$/);
+    expect(() => FormatMessageW(0, 'x', 'y', 0, {}, 64)).toThrow(/at index 1$/);
+    expect(() => FormatMessageW('x', 5, 'y', 0, {}, 64)).toThrow(/at index 0$/);
+  });
+});
@@ -0,0 +1,5 @@
+export const FORMAT_MESSAGE_IGNORE_INSERTS = 0x00000200;
+export const FORMAT_MESSAGE_FROM_STRING = 0x00000400;
+export const FORMAT_MESSAGE_FROM_HMODULE = 0x00000800;
+export const FORMAT_MESSAGE_FROM_SYSTEM = 0x00001000;
+export const FORMAT_MESSAGE_MAX_WIDTH_MASK = 0x000000ff;
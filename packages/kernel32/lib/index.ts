@@ -2,4 +2,53 @@ import { createRequire } from 'node:module';
 
 const require = createRequire(import.meta.url);
 
-export const { GetLastError, GetModuleHandleW } = require('./kernel32.node');
+/**
+ * Loads this package's own addon, or the kernel32 part of the combined libwin addon from @libwin/native when
+ * LIBWIN_NATIVE=1 is set, so every package shares one native runtime. The combined addon is opt-in, since it has to be
+ * installed and built separately: it is an optional peer dependency, and a workspace checkout links it even when it was
+ * never built.
+ */
+function loadAddon() {
+  if (process.env.LIBWIN_NATIVE !== '1') {
+    return require('./kernel32.node');
+  }
+
+  try {
+    return require('@libwin/native').kernel32;
+  } catch (error) {
+    if ((error as NodeJS.ErrnoException).code === 'MODULE_NOT_FOUND') {
+      throw new Error('LIBWIN_NATIVE=1 is set, but @libwin/native is not installed or not built', { cause: error });
+    }
+
+    throw error;
+  }
+}
+
+export * from './directory-watcher.js';
+export * from './directory.js';
+export * from './format-message.js';
+export * from './io-ring.js';
+
+// ESM needs every named export's value at import, so this reads, and thereby creates, each function the addon
+// defines lazily.
+export const {
+  BuildIoRingOperations,
+  BuildIoRingReadFileScatter,
+  BuildIoRingRegisterBuffers,
+  BuildIoRingRegisterFileHandles,
+  BuildIoRingWriteFileGather,
+  CloseDirectoryWatcher,
+  CloseIoRing,
+  CreateDirectoryWatcher,
+  CreateIoRing,
+  EnumerateDirectory,
+  FormatMessageW,
+  GetIoRingSegmentOffset,
+  GetLastError,
+  GetModuleFileNameW,
+  GetModuleHandleW,
+  PopIoRingCompletion,
+  PopIoRingCompletions,
+  SubmitIoRing,
+  __qbStats,
+} = loadAddon();
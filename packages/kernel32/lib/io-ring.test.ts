@@ -0,0 +1,158 @@
+import { afterEach, beforeEach, describe, expect, test } from 'vitest';
+
+import { loadWin32Stub } from '../../common/win32-stub/index.js';
+import {
+  BuildIoRingOperations,
+  BuildIoRingReadFileScatter,
+  BuildIoRingRegisterBuffers,
+  BuildIoRingRegisterFileHandles,
+  BuildIoRingWriteFileGather,
+  CloseIoRing,
+  CreateIoRing,
+  FILE_WRITE_FLAGS_NONE,
+  GetIoRingSegmentOffset,
+  IORING_CREATE_ADVISORY_FLAGS_NONE,
+  IORING_CREATE_REQUIRED_FLAGS_NONE,
+  IORING_E_SUBMISSION_QUEUE_FULL,
+  IORING_SEGMENT_SIZE,
+  IORING_VERSION_3,
+  type IORING_CQE,
+  IoRingOperationBuffer,
+  PopIoRingCompletion,
+  SubmitIoRing,
+} from './index.js';
+
+const S_OK = 0;
+const E_INVALIDARG = 0x80070057 | 0;
+
+let ioRing = 0n;
+
+function createIoRing(submissionQueueSize: number): bigint {
+  const h = { value: 0n };
+
+  const result = CreateIoRing(
+    IORING_VERSION_3,
+    { Required: IORING_CREATE_REQUIRED_FLAGS_NONE, Advisory: IORING_CREATE_ADVISORY_FLAGS_NONE },
+    submissionQueueSize,
+    submissionQueueSize * 2,
+    h,
+  );
+
+  expect(result).toBe(S_OK);
+
+  return h.value;
+}
+
+function allocateSegments(pages: number): Uint8Array {
+  const memory = new ArrayBuffer((pages + 1) * IORING_SEGMENT_SIZE);
+
+  return new Uint8Array(memory, GetIoRingSegmentOffset(memory), pages * IORING_SEGMENT_SIZE);
+}
+
+// Hides functions from GetProcAddress to act like an older Windows, which only the stub can do.
+describe.skipIf(process.platform === 'win32')('IoRing', () => {
+  const stub = process.platform === 'win32' ? undefined : loadWin32Stub();
+
+  beforeEach(() => {
+    ioRing = createIoRing(2);
+  });
+
+  afterEach(() => {
+    CloseIoRing(ioRing);
+  });
+
+  test('throws for a function this version of Windows lacks', () => {
+    stub!.setProcAddressHidden('BuildIoRingReadFileScatter', true);
+
+    try {
+      expect(() => BuildIoRingReadFileScatter(ioRing, 0, [allocateSegments(1)], 16, 0n, 1n)).toThrow(
+        /^BuildIoRingReadFileScatter is not available on this version of Windows$/,
+      );
+    } finally {
+      stub!.setProcAddressHidden('BuildIoRingReadFileScatter', false);
+    }
+
+    expect(BuildIoRingReadFileScatter(ioRing, 0, [allocateSegments(1)], 16, 0n, 1n)).toBe(S_OK);
+  });
+
+  test('rejects an unknown opcode before queueing anything', () => {
+    const operations = new IoRingOperationBuffer().read(0, 0, 0, 16, 0n, 1n).read(0, 0, 0, 16, 0n, 2n);
+
+    new Uint32Array(operations.bytes.buffer)[10] = 7;
+
+    expect(() => BuildIoRingOperations(ioRing, operations.bytes, operations.length)).toThrow(
+      /^Unknown opcode 7 in operation 1 at index 1$/,
+    );
+
+    const submitted = { value: -1 };
+
+    expect(SubmitIoRing(ioRing, 0, 0, submitted)).toBe(S_OK);
+    expect(submitted.value).toBe(0);
+  });
+
+  test('reports the HRESULT and index of the operation that was not queued', () => {
+    const operations = new IoRingOperationBuffer();
+
+    for (let i = 0; i < 3; i++) {
+      operations.read(0, 0, 0, 16, 0n, BigInt(i));
+    }
+
+    const result = { value: S_OK };
+
+    expect(BuildIoRingOperations(ioRing, operations.bytes, operations.length, result)).toBe(2);
+    expect(result.value).toBe(IORING_E_SUBMISSION_QUEUE_FULL);
+
+    SubmitIoRing(ioRing, 0, 0);
+
+    expect(BuildIoRingOperations(ioRing, operations.bytes.subarray(80), 1, result)).toBe(1);
+    expect(result.value).toBe(S_OK);
+  });
+
+  test('accepts only page aligned segments of whole pages', () => {
+    const segments = allocateSegments(2);
+
+    expect(() => BuildIoRingReadFileScatter(ioRing, 0, [segments.subarray(8)], 16, 0n, 1n)).toThrow(
+      /^Expected page aligned buffers of whole pages for property 0$/,
+    );
+    expect(() =>
+      BuildIoRingWriteFileGather(ioRing, 0, [segments, segments.subarray(0, 100)], 16, 0n, FILE_WRITE_FLAGS_NONE, 1n),
+    ).toThrow(/for property 1$/);
+    expect(() => BuildIoRingReadFileScatter(ioRing, 0, [segments], 3 * IORING_SEGMENT_SIZE, 0n, 1n)).toThrow(
+      RangeError,
+    );
+    expect(() => BuildIoRingReadFileScatter(ioRing, 0, segments, 16, 0n, 1n)).toThrow(TypeError);
+  });
+
+  test('rejects rings that are closed or unknown', () => {
+    const closed = createIoRing(2);
+
+    expect(CloseIoRing(closed)).toBe(S_OK);
+
+    for (const ring of [closed, 0x1234n]) {
+      expect(BuildIoRingRegisterBuffers(ring, [new Uint8Array(16)], 1n)).toBe(E_INVALIDARG);
+      expect(BuildIoRingRegisterFileHandles(ring, new BigUint64Array([0n]), 2n)).toBe(E_INVALIDARG);
+      expect(BuildIoRingReadFileScatter(ring, 0, [allocateSegments(1)], 16, 0n, 3n)).toBe(E_INVALIDARG);
+    }
+  });
+
+  test('queues scatter/gather operations until they complete', () => {
+    const segments = allocateSegments(2);
+
+    expect(BuildIoRingRegisterFileHandles(ioRing, new BigUint64Array([0n]), 0n)).toBe(S_OK);
+    expect(
+      BuildIoRingWriteFileGather(ioRing, 0, [segments], 2 * IORING_SEGMENT_SIZE, 0n, FILE_WRITE_FLAGS_NONE, 1n),
+    ).toBe(S_OK);
+
+    SubmitIoRing(ioRing, 0, 0);
+
+    const cqe: IORING_CQE = { UserData: 0n, ResultCode: 0, Information: 0n };
+
+    expect(PopIoRingCompletion(ioRing, cqe)).toBe(S_OK);
+    expect(PopIoRingCompletion(ioRing, cqe)).toBe(S_OK);
+
+    // Registered handle 0 is not a file.
+    expect(cqe).toMatchObject({ UserData: 1n });
+    expect(cqe.ResultCode).not.toBe(S_OK);
+    expect(cqe.ResultCode).not.toBe(E_INVALIDARG);
+  });
+});
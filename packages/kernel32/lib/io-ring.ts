@@ -0,0 +1,238 @@
+export const IORING_VERSION_1 = 1;
+export const IORING_VERSION_2 = 2;
+export const IORING_VERSION_3 = 300;
+export const IORING_VERSION_4 = 400;
+
+export const IORING_CREATE_REQUIRED_FLAGS_NONE = 0;
+export const IORING_CREATE_ADVISORY_FLAGS_NONE = 0;
+export const IORING_CREATE_SKIP_BUILDER_PARAM_CHECKS = 0x1;
+
+export const IOSQE_FLAGS_NONE = 0;
+export const IOSQE_FLAGS_DRAIN_PRECEDING_OPS = 0x1;
+
+export const FILE_WRITE_FLAGS_NONE = 0;
+export const FILE_WRITE_FLAGS_WRITE_THROUGH = 0x1;
+
+export const IORING_E_SUBMISSION_QUEUE_FULL = 0x80460002 | 0;
+
+export const IORING_OPERATION_READ = 0;
+export const IORING_OPERATION_WRITE = 1;
+
+/**
+ * Size in bytes of each operation record passed to BuildIoRingOperations.
+ */
+export const SIZEOF_IORING_OPERATION = 40;
+
+/**
+ * Size in bytes of each segment of BuildIoRingReadFileScatter and BuildIoRingWriteFileGather. Every buffer passed to
+ * them must start on a page boundary and be a whole number of pages long; each page becomes one segment.
+ *
+ * ArrayBuffers are not page aligned, so allocate one page more than needed and start at the offset
+ * GetIoRingSegmentOffset returns:
+ *
+ * @example
+ * const memory = new ArrayBuffer((pages + 1) * IORING_SEGMENT_SIZE);
+ * const segments = new Uint8Array(memory, GetIoRingSegmentOffset(memory), pages * IORING_SEGMENT_SIZE);
+ *
+ * BuildIoRingReadFileScatter(ioRing, 0, [segments], segments.byteLength, 0n, 1n);
+ *
+ * The buffers stay referenced until a completion with the same userData is popped, so give every scatter/gather
+ * operation that is in flight at the same time its own userData.
+ */
+export const IORING_SEGMENT_SIZE = 4096;
+
+/**
+ * Number of bytes each drained completion occupies in an IoRingCompletionBuffer.
+ */
+export const IORING_COMPLETION_RECORD_SIZE = 20;
+
+export type IORING_CREATE_FLAGS = {
+  Required: number;
+  Advisory: number;
+};
+
+export type IORING_CQE = {
+  UserData: bigint;
+  ResultCode: number;
+  Information: bigint;
+};
+
+/**
+ * Builds a packed array of read/write operations that BuildIoRingOperations queues in a single call. Operations
+ * reference files and buffers by their index in BuildIoRingRegisterFileHandles and BuildIoRingRegisterBuffers.
+ * Those, like the scatter/gather builders, return E_INVALIDARG for a ring that is closed or wasn't created by
+ * CreateIoRing, without keeping any of their arguments alive.
+ *
+ * Layout of each 40 byte record:
+ *
+ * | Offset | Field        | Type |
+ * | ------ | ------------ | ---- |
+ * | 0      | opcode       | u32  |
+ * | 4      | fileIndex    | u32  |
+ * | 8      | bufferIndex  | u32  |
+ * | 12     | bufferOffset | u32  |
+ * | 16     | length       | u32  |
+ * | 20     | sqeFlags     | u32  |
+ * | 24     | fileOffset   | u64  |
+ * | 32     | userData     | u64  |
+ *
+ * @example
+ * const operations = new IoRingOperationBuffer();
+ *
+ * for (let i = 0; i < 64; i++) {
+ *   operations.read(0, 0, i * 4096, 4096, BigInt(i * 4096), BigInt(i));
+ * }
+ *
+ * BuildIoRingOperations(ioRing, operations.bytes, operations.length);
+ * SubmitIoRing(ioRing, operations.length, INFINITE);
+ *
+ * BuildIoRingOperations validates every opcode before queueing anything and throws a TypeError for an unknown one. It
+ * then queues operations in order until the ring rejects one, and returns how many it queued, which is also the index
+ * of the rejected operation. Pass `{ value: 0 }` as the fourth argument to receive the HRESULT that stopped it, S_OK
+ * when every operation was queued, or IORING_E_SUBMISSION_QUEUE_FULL when the ring needs to be submitted first.
+ *
+ * IoRing only exists on Windows 11 and later. Its functions are looked up when first called, and throw an Error naming
+ * the missing function on older versions rather than keeping the addon from loading.
+ */
+export class IoRingOperationBuffer {
+  #buffer: ArrayBuffer;
+  #uint32: Uint32Array;
+  #uint64: BigUint64Array;
+  #length = 0;
+
+  constructor(capacity = 64) {
+    this.#buffer = new ArrayBuffer(Math.max(1, capacity) * SIZEOF_IORING_OPERATION);
+    this.#uint32 = new Uint32Array(this.#buffer);
+    this.#uint64 = new BigUint64Array(this.#buffer);
+  }
+
+  /**
+   * Number of operations written so far.
+   */
+  get length(): number {
+    return this.#length;
+  }
+
+  /**
+   * The written operations, without any of the unused capacity.
+   */
+  get bytes(): Uint8Array {
+    return new Uint8Array(this.#buffer, 0, this.#length * SIZEOF_IORING_OPERATION);
+  }
+
+  /**
+   * Appends a read of `length` bytes at `fileOffset` into registered buffer `bufferIndex` at `bufferOffset`.
+   */
+  read(
+    fileIndex: number,
+    bufferIndex: number,
+    bufferOffset: number,
+    length: number,
+    fileOffset: bigint,
+    userData: bigint,
+    sqeFlags = IOSQE_FLAGS_NONE,
+  ): this {
+    return this.#push(
+      IORING_OPERATION_READ,
+      fileIndex,
+      bufferIndex,
+      bufferOffset,
+      length,
+      fileOffset,
+      userData,
+      sqeFlags,
+    );
+  }
+
+  /**
+   * Appends a write of `length` bytes from registered buffer `bufferIndex` at `bufferOffset` to `fileOffset`.
+   */
+  write(
+    fileIndex: number,
+    bufferIndex: number,
+    bufferOffset: number,
+    length: number,
+    fileOffset: bigint,
+    userData: bigint,
+    sqeFlags = IOSQE_FLAGS_NONE,
+  ): this {
+    return this.#push(
+      IORING_OPERATION_WRITE,
+      fileIndex,
+      bufferIndex,
+      bufferOffset,
+      length,
+      fileOffset,
+      userData,
+      sqeFlags,
+    );
+  }
+
+  /**
+   * Drops all written operations while keeping the allocated capacity.
+   */
+  clear(): this {
+    this.#length = 0;
+
+    return this;
+  }
+
+  #push(
+    opcode: number,
+    fileIndex: number,
+    bufferIndex: number,
+    bufferOffset: number,
+    length: number,
+    fileOffset: bigint,
+    userData: bigint,
+    sqeFlags: number,
+  ): this {
+    if (this.#length * SIZEOF_IORING_OPERATION === this.#buffer.byteLength) {
+      const buffer = new ArrayBuffer(this.#buffer.byteLength * 2);
+      new Uint8Array(buffer).set(new Uint8Array(this.#buffer));
+
+      this.#buffer = buffer;
+      this.#uint32 = new Uint32Array(buffer);
+      this.#uint64 = new BigUint64Array(buffer);
+    }
+
+    const base = (this.#length * SIZEOF_IORING_OPERATION) >> 2;
+
+    this.#uint32[base] = opcode;
+    this.#uint32[base + 1] = fileIndex;
+    this.#uint32[base + 2] = bufferIndex;
+    this.#uint32[base + 3] = bufferOffset;
+    this.#uint32[base + 4] = length;
+    this.#uint32[base + 5] = sqeFlags;
+    this.#uint64[(base >> 1) + 3] = fileOffset;
+    this.#uint64[(base >> 1) + 4] = userData;
+
+    this.#length++;
+
+    return this;
+  }
+}
+
+/**
+ * Fixed capacity, column oriented destination for PopIoRingCompletions.
+ *
+ * PopIoRingCompletions(ioRing, completions.buffer) drains every available IORING_CQE into the columns below and returns
+ * how many were written; completion `i` is then read as `completions.userData[i]`, `completions.resultCode[i]`, etc.
+ */
+export class IoRingCompletionBuffer {
+  readonly buffer: ArrayBuffer;
+  readonly capacity: number;
+
+  readonly userData: BigUint64Array;
+  readonly information: BigUint64Array;
+  readonly resultCode: Int32Array;
+
+  constructor(capacity = 1024) {
+    this.capacity = capacity;
+    this.buffer = new ArrayBuffer(capacity * IORING_COMPLETION_RECORD_SIZE);
+
+    this.userData = new BigUint64Array(this.buffer, 0, capacity);
+    this.information = new BigUint64Array(this.buffer, capacity * 8, capacity);
+    this.resultCode = new Int32Array(this.buffer, capacity * 16, capacity);
+  }
+}
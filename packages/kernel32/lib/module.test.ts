@@ -0,0 +1,35 @@
+import { describe, expect, test } from 'vitest';
+
+import { loadWin32Stub } from '../../common/win32-stub/index.js';
+import { GetLastError, GetModuleFileNameW } from './index.js';
+
+const ERROR_INSUFFICIENT_BUFFER = 122;
+
+// Pins the module path to one whose length is known, which only the stub can do.
+describe.skipIf(process.platform === 'win32')('GetModuleFileNameW', () => {
+  const stub = process.platform === 'win32' ? undefined : loadWin32Stub();
+  const path = 'C:\\Program Files\\libwin\\test.exe';
+
+  test('returns the whole path when it fits', () => {
+    stub!.setModuleFileName(path);
+
+    const filename = { value: '' };
+
+    expect(GetModuleFileNameW(null, filename, 260)).toBe(path.length);
+    expect(filename.value).toBe(path);
+
+    stub!.setModuleFileName('');
+  });
+
+  test('returns the terminated prefix of a truncated path', () => {
+    stub!.setModuleFileName(path);
+
+    const filename = { value: '' };
+
+    expect(GetModuleFileNameW(null, filename, 8)).toBe(8);
+    expect(GetLastError()).toBe(ERROR_INSUFFICIENT_BUFFER);
+    expect(filename.value).toBe(path.slice(0, 7));
+
+    stub!.setModuleFileName('');
+  });
+});
@@ -0,0 +1,651 @@
+#include "kernel32.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+static constexpr std::string_view INVALID_BUFFER_SIZE = "Expected bufferSize to be between 4096 and 65536 ";
+
+static constexpr DWORD DEFAULT_NOTIFY_FILTER = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+                                               FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE |
+                                               FILE_NOTIFY_CHANGE_CREATION;
+
+static constexpr uint32_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+static constexpr uint32_t MIN_BUFFER_SIZE = 4 * 1024;
+// ReadDirectoryChangesW fails with ERROR_INVALID_PARAMETER on network shares for buffers larger than 64KB.
+static constexpr uint32_t MAX_BUFFER_SIZE = 64 * 1024;
+static constexpr uint32_t DEFAULT_LATENCY = 50;
+// A steady trickle of changes would otherwise keep postponing delivery forever.
+static constexpr uint32_t MAX_LATENCY_FACTOR = 10;
+static constexpr size_t DEFAULT_MAX_BATCH_SIZE = 4096;
+
+// Actions reported in a change batch. The first three match FILE_ACTION_*; FILE_ACTION_RENAMED_OLD_NAME and
+// FILE_ACTION_RENAMED_NEW_NAME pairs are joined into a single DIRECTORY_CHANGE_RENAMED entry.
+static constexpr uint32_t DIRECTORY_CHANGE_ADDED = FILE_ACTION_ADDED;
+static constexpr uint32_t DIRECTORY_CHANGE_REMOVED = FILE_ACTION_REMOVED;
+static constexpr uint32_t DIRECTORY_CHANGE_MODIFIED = FILE_ACTION_MODIFIED;
+static constexpr uint32_t DIRECTORY_CHANGE_RENAMED = 4;
+// Marks an entry that was cancelled out by a later change (e.g. added then removed) and is skipped when flushing.
+static constexpr uint32_t DIRECTORY_CHANGE_NONE = 0;
+
+struct DirectoryChange {
+  uint32_t action;
+  std::wstring name;
+  std::wstring oldName;
+  uint64_t fileId;
+  uint64_t fileSize;
+  uint64_t lastModificationTime;
+  uint32_t fileAttributes;
+};
+
+struct DirectoryChangeBatch {
+  std::vector<DirectoryChange> changes;
+  bool overflow = false;
+  DWORD error = ERROR_SUCCESS;
+};
+
+/**
+ * Collects the changes seen until the next delivery and folds repeated changes to the same path into one entry, so an
+ * editor's save or a checkout that creates, truncates and writes a file reports it once.
+ *
+ * | Pending  | Incoming | Result                                        |
+ * | -------- | -------- | --------------------------------------------- |
+ * | ADDED    | MODIFIED | ADDED                                         |
+ * | ADDED    | REMOVED  | nothing                                       |
+ * | ADDED    | RENAMED  | ADDED under the new name                      |
+ * | MODIFIED | REMOVED  | REMOVED                                       |
+ * | REMOVED  | ADDED    | MODIFIED (replace-by-rename style saves)      |
+ * | RENAMED  | RENAMED  | one RENAMED from the first to the last name   |
+ * | RENAMED  | REMOVED  | REMOVED under the old name                    |
+ */
+class DirectoryChangeCoalescer {
+public:
+  void Add(const FILE_NOTIFY_EXTENDED_INFORMATION &record) {
+    const std::wstring name(record.FileName, record.FileNameLength / sizeof(WCHAR));
+
+    switch (record.Action) {
+    case FILE_ACTION_ADDED:
+      this->Added(name, record);
+      break;
+    case FILE_ACTION_REMOVED:
+      this->Removed(name, record);
+      break;
+    case FILE_ACTION_MODIFIED:
+      this->Modified(name, record);
+      break;
+    case FILE_ACTION_RENAMED_OLD_NAME:
+      this->FinishRename();
+      this->renameFrom = name;
+      this->renameFromRecord = record;
+      this->hasRenameFrom = true;
+      return;
+    case FILE_ACTION_RENAMED_NEW_NAME:
+      if (this->hasRenameFrom) {
+        this->hasRenameFrom = false;
+        this->Renamed(this->renameFrom, name, record);
+      } else {
+        // Moved in from outside the watched tree.
+        this->Added(name, record);
+      }
+      return;
+    }
+
+    this->FinishRename();
+  }
+
+  [[nodiscard]] bool Empty() const { return this->changes.empty() && !this->hasRenameFrom; }
+
+  [[nodiscard]] size_t Size() const { return this->changes.size(); }
+
+  /**
+   * Takes the pending changes. The two halves of a rename can arrive in different reads, so a rename whose new name
+   * hasn't arrived yet stays pending for the next batch, unless `finishRename` says it never will.
+   */
+  std::vector<DirectoryChange> Take(const bool finishRename) {
+    if (finishRename) {
+      this->FinishRename();
+    }
+
+    std::vector<DirectoryChange> result;
+    result.reserve(this->changes.size());
+
+    for (DirectoryChange &change : this->changes) {
+      if (change.action != DIRECTORY_CHANGE_NONE) {
+        result.push_back(std::move(change));
+      }
+    }
+
+    this->changes.clear();
+    this->byName.clear();
+
+    return result;
+  }
+
+private:
+  std::vector<DirectoryChange> changes;
+  std::unordered_map<std::wstring, size_t> byName;
+
+  std::wstring renameFrom;
+  FILE_NOTIFY_EXTENDED_INFORMATION renameFromRecord{};
+  bool hasRenameFrom = false;
+
+  static void Update(DirectoryChange &change, const FILE_NOTIFY_EXTENDED_INFORMATION &record) {
+    change.fileId = static_cast<uint64_t>(record.FileId.QuadPart);
+    change.fileSize = static_cast<uint64_t>(record.FileSize.QuadPart);
+    change.lastModificationTime = static_cast<uint64_t>(record.LastModificationTime.QuadPart);
+    change.fileAttributes = record.FileAttributes;
+  }
+
+  DirectoryChange *Find(const std::wstring &name) {
+    const auto it = this->byName.find(name);
+    return it == this->byName.end() ? nullptr : &this->changes[it->second];
+  }
+
+  void Push(const uint32_t action,
+            const std::wstring &name,
+            const std::wstring &oldName,
+            const FILE_NOTIFY_EXTENDED_INFORMATION &record) {
+    DirectoryChange &change = this->changes.emplace_back();
+    change.action = action;
+    change.name = name;
+    change.oldName = oldName;
+    Update(change, record);
+
+    this->byName[name] = this->changes.size() - 1;
+  }
+
+  void Drop(const std::wstring &name) {
+    const auto it = this->byName.find(name);
+
+    if (it != this->byName.end()) {
+      this->changes[it->second].action = DIRECTORY_CHANGE_NONE;
+      this->byName.erase(it);
+    }
+  }
+
+  // A RENAMED_OLD_NAME that isn't immediately followed by its RENAMED_NEW_NAME was moved out of the watched tree.
+  void FinishRename() {
+    if (this->hasRenameFrom) {
+      this->hasRenameFrom = false;
+      this->Removed(this->renameFrom, this->renameFromRecord);
+    }
+  }
+
+  void Added(const std::wstring &name, const FILE_NOTIFY_EXTENDED_INFORMATION &record) {
+    if (DirectoryChange *existing = this->Find(name)) {
+      if (existing->action == DIRECTORY_CHANGE_REMOVED) {
+        existing->action = DIRECTORY_CHANGE_MODIFIED;
+      }
+
+      Update(*existing, record);
+      return;
+    }
+
+    this->Push(DIRECTORY_CHANGE_ADDED, name, {}, record);
+  }
+
+  void Modified(const std::wstring &name, const FILE_NOTIFY_EXTENDED_INFORMATION &record) {
+    if (DirectoryChange *existing = this->Find(name)) {
+      Update(*existing, record);
+      return;
+    }
+
+    this->Push(DIRECTORY_CHANGE_MODIFIED, name, {}, record);
+  }
+
+  void Removed(const std::wstring &name, const FILE_NOTIFY_EXTENDED_INFORMATION &record) {
+    if (DirectoryChange *existing = this->Find(name)) {
+      if (existing->action == DIRECTORY_CHANGE_ADDED) {
+        this->Drop(name);
+        return;
+      }
+
+      if (existing->action == DIRECTORY_CHANGE_RENAMED) {
+        const std::wstring oldName = existing->oldName;
+
+        this->Drop(name);
+        this->Removed(oldName, record);
+        return;
+      }
+
+      existing->action = DIRECTORY_CHANGE_REMOVED;
+      Update(*existing, record);
+      return;
+    }
+
+    this->Push(DIRECTORY_CHANGE_REMOVED, name, {}, record);
+  }
+
+  void Renamed(const std::wstring &oldName,
+               const std::wstring &newName,
+               const FILE_NOTIFY_EXTENDED_INFORMATION &record) {
+    // Whatever was pending for the target is replaced by the file renamed over it.
+    this->Drop(newName);
+
+    if (DirectoryChange *existing = this->Find(oldName)) {
+      const uint32_t action = existing->action;
+      const std::wstring originalName = action == DIRECTORY_CHANGE_RENAMED ? existing->oldName : oldName;
+
+      this->Drop(oldName);
+
+      if (action == DIRECTORY_CHANGE_ADDED) {
+        this->Push(DIRECTORY_CHANGE_ADDED, newName, {}, record);
+      } else if (originalName != newName) {
+        this->Push(DIRECTORY_CHANGE_RENAMED, newName, originalName, record);
+      } else {
+        this->Push(DIRECTORY_CHANGE_MODIFIED, newName, {}, record);
+      }
+
+      return;
+    }
+
+    this->Push(DIRECTORY_CHANGE_RENAMED, newName, oldName, record);
+  }
+};
+
+/**
+ * Owns the directory handle and the thread that reads changes from it. The thread always keeps a read outstanding: as
+ * soon as one completes, the next is queued on the other notification buffer before the completed one is parsed, so
+ * the time in which the kernel has nowhere to put changes is as short as possible. Changes are coalesced and handed
+ * to JS once no new changes arrived for `latency` milliseconds, MAX_LATENCY_FACTOR times `latency` after the first of
+ * them at the latest, or once `maxBatchSize` changes are pending.
+ */
+class DirectoryWatcher {
+public:
+  DirectoryWatcher(const HANDLE hDirectory,
+                   const bool recursive,
+                   const DWORD notifyFilter,
+                   const uint32_t bufferSize,
+                   const uint32_t latency,
+                   const size_t maxBatchSize,
+                   Napi::ThreadSafeFunction callback)
+      : hDirectory(hDirectory), recursive(recursive), notifyFilter(notifyFilter), latency(latency),
+        maxBatchSize(maxBatchSize), callback(std::move(callback)) {
+    for (NotifyBuffer &buffer : this->buffers) {
+      // FILE_NOTIFY_EXTENDED_INFORMATION records have to be 8 byte aligned.
+      buffer.data.resize(bufferSize / sizeof(uint64_t));
+    }
+  }
+
+  ~DirectoryWatcher() {
+    if (this->thread.joinable()) {
+      ::SetEvent(this->hStop);
+      this->thread.join();
+    }
+
+    for (NotifyBuffer &buffer : this->buffers) {
+      if (buffer.overlapped.hEvent != nullptr) {
+        ::CloseHandle(buffer.overlapped.hEvent);
+      }
+    }
+
+    if (this->hStop != nullptr) {
+      ::CloseHandle(this->hStop);
+    }
+
+    ::CloseHandle(this->hDirectory);
+
+    this->callback.Release();
+  }
+
+  /**
+   * Creates the events and starts the thread. Returns the Win32 error if an event couldn't be created, in which case
+   * nothing was started and the watcher only has to be destroyed.
+   */
+  DWORD Start() {
+    this->hStop = ::CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+    if (this->hStop == nullptr) {
+      return ::GetLastError();
+    }
+
+    for (NotifyBuffer &buffer : this->buffers) {
+      buffer.overlapped.hEvent = ::CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+      if (buffer.overlapped.hEvent == nullptr) {
+        return ::GetLastError();
+      }
+    }
+
+    // The first read is queued before CreateDirectoryWatcher returns, so no change made after that can be missed. A
+    // failure is reported through the callback like any later one.
+    const DWORD error = this->Read(this->buffers[0]) ? ERROR_SUCCESS : ::GetLastError();
+
+    this->thread = std::thread(&DirectoryWatcher::Run, this, error);
+
+    return ERROR_SUCCESS;
+  }
+
+  DirectoryWatcher(const DirectoryWatcher &) = delete;
+  DirectoryWatcher &operator=(const DirectoryWatcher &) = delete;
+
+private:
+  struct NotifyBuffer {
+    std::vector<uint64_t> data;
+    OVERLAPPED overlapped{};
+  };
+
+  const HANDLE hDirectory;
+  const bool recursive;
+  const DWORD notifyFilter;
+  const uint32_t latency;
+  const size_t maxBatchSize;
+
+  Napi::ThreadSafeFunction callback;
+  HANDLE hStop = nullptr;
+  NotifyBuffer buffers[2];
+  std::thread thread;
+
+  DirectoryChangeCoalescer coalescer;
+  bool overflow = false;
+
+  bool Read(NotifyBuffer &buffer) {
+    ::ResetEvent(buffer.overlapped.hEvent);
+
+    return ::ReadDirectoryChangesExW(this->hDirectory,
+                                     buffer.data.data(),
+                                     static_cast<DWORD>(buffer.data.size() * sizeof(uint64_t)),
+                                     this->recursive,
+                                     this->notifyFilter,
+                                     nullptr,
+                                     &buffer.overlapped,
+                                     nullptr,
+                                     ReadDirectoryNotifyExtendedInformation) != FALSE;
+  }
+
+  void Parse(const NotifyBuffer &buffer, const DWORD bytes) {
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(buffer.data.data());
+    size_t offset = 0;
+
+    while (offset < bytes) {
+      const FILE_NOTIFY_EXTENDED_INFORMATION &record =
+          *reinterpret_cast<const FILE_NOTIFY_EXTENDED_INFORMATION *>(data + offset);
+
+      this->coalescer.Add(record);
+
+      if (record.NextEntryOffset == 0) {
+        break;
+      }
+
+      offset += record.NextEntryOffset;
+    }
+  }
+
+  // Only a flush for reaching maxBatchSize keeps back half a rename; after a quiet latency or an error, the other half
+  // isn't coming.
+  void Flush(const DWORD error = ERROR_SUCCESS, const bool finishRename = true) {
+    if (this->coalescer.Empty() && !this->overflow && error == ERROR_SUCCESS) {
+      return;
+    }
+
+    std::vector<DirectoryChange> changes = this->coalescer.Take(finishRename);
+
+    if (changes.empty() && !this->overflow && error == ERROR_SUCCESS) {
+      return;
+    }
+
+    DirectoryChangeBatch *batch = new DirectoryChangeBatch{std::move(changes), this->overflow, error};
+    this->overflow = false;
+
+    // The queue is unbounded, so this never blocks the reader even if JS falls behind.
+    const napi_status status = this->callback.NonBlockingCall(batch, CallJs);
+
+    if (status != napi_ok) {
+      delete batch;
+    }
+  }
+
+  static void CallJs(Napi::Env env, Napi::Function callback, DirectoryChangeBatch *batch);
+
+  void Run(const DWORD readError) {
+    size_t current = 0;
+
+    if (readError != ERROR_SUCCESS) {
+      this->Flush(readError);
+      return;
+    }
+
+    ULONGLONG deadline = 0;
+    ULONGLONG latest = 0;
+
+    while (true) {
+      const HANDLE handles[2] = {this->hStop, this->buffers[current].overlapped.hEvent};
+
+      DWORD timeout = INFINITE;
+
+      if (!this->coalescer.Empty() || this->overflow) {
+        const ULONGLONG now = ::GetTickCount64();
+        timeout = now >= deadline ? 0 : static_cast<DWORD>(deadline - now);
+      }
+
+      const DWORD wait = ::WaitForMultipleObjects(2, handles, FALSE, timeout);
+
+      if (wait == WAIT_OBJECT_0) {
+        break;
+      }
+
+      if (wait == WAIT_TIMEOUT) {
+        this->Flush();
+        continue;
+      }
+
+      NotifyBuffer &completed = this->buffers[current];
+      DWORD bytes = 0;
+
+      const bool succeeded = ::GetOverlappedResult(this->hDirectory, &completed.overlapped, &bytes, FALSE) != FALSE;
+      const DWORD error = succeeded ? ERROR_SUCCESS : ::GetLastError();
+
+      current = 1 - current;
+
+      if ((succeeded || error == ERROR_NOTIFY_ENUM_DIR) && !this->Read(this->buffers[current])) {
+        this->Flush(::GetLastError());
+        return;
+      }
+
+      const bool wasEmpty = this->coalescer.Empty() && !this->overflow;
+
+      if (succeeded && bytes > 0) {
+        this->Parse(completed, bytes);
+      } else if (succeeded || error == ERROR_NOTIFY_ENUM_DIR) {
+        // More changes happened than fit in the buffer. The changes are lost, so JS has to rescan.
+        this->overflow = true;
+      } else {
+        // The directory was deleted or the volume went away; report it and stop.
+        this->Flush(error);
+        return;
+      }
+
+      // Every new change postpones delivery by another latency, up to a limit counted from the first pending one.
+      const ULONGLONG now = ::GetTickCount64();
+
+      if (wasEmpty) {
+        latest = now + static_cast<ULONGLONG>(this->latency) * MAX_LATENCY_FACTOR;
+      }
+
+      deadline = std::min(now + this->latency, latest);
+
+      if (this->coalescer.Size() >= this->maxBatchSize) {
+        this->Flush(ERROR_SUCCESS, false);
+      }
+    }
+
+    ::CancelIoEx(this->hDirectory, nullptr);
+
+    DWORD bytes = 0;
+    ::GetOverlappedResult(this->hDirectory, &this->buffers[current].overlapped, &bytes, TRUE);
+  }
+};
+
+static Napi::Uint16Array PackNames(const Napi::Env env,
+                                   const std::vector<DirectoryChange> &changes,
+                                   std::wstring DirectoryChange::*member,
+                                   Napi::Uint32Array &offsets) {
+  size_t length = 0;
+
+  for (const DirectoryChange &change : changes) {
+    length += (change.*member).size();
+  }
+
+  Napi::Uint16Array names = Napi::Uint16Array::New(env, length, napi_uint16_array);
+  offsets = Napi::Uint32Array::New(env, changes.size() + 1, napi_uint32_array);
+
+  size_t offset = 0;
+
+  for (size_t i = 0; i < changes.size(); i++) {
+    const std::wstring &name = changes[i].*member;
+
+    std::copy(name.begin(), name.end(), names.Data() + offset);
+    offsets[i] = static_cast<uint32_t>(offset);
+    offset += name.size();
+  }
+
+  offsets[changes.size()] = static_cast<uint32_t>(offset);
+
+  return names;
+}
+
+void DirectoryWatcher::CallJs(Napi::Env env, Napi::Function callback, DirectoryChangeBatch *batch) {
+  const std::unique_ptr<DirectoryChangeBatch> owned(batch);
+
+  if (env == nullptr || callback.IsEmpty()) {
+    return;
+  }
+
+  const std::vector<DirectoryChange> &changes = batch->changes;
+  const size_t count = changes.size();
+
+  Napi::Uint32Array nameOffsets;
+  Napi::Uint32Array oldNameOffsets;
+
+  Napi::Uint16Array names = PackNames(env, changes, &DirectoryChange::name, nameOffsets);
+  Napi::Uint16Array oldNames = PackNames(env, changes, &DirectoryChange::oldName, oldNameOffsets);
+
+  Napi::Uint32Array actions = Napi::Uint32Array::New(env, count, napi_uint32_array);
+  Napi::BigUint64Array fileIds = Napi::BigUint64Array::New(env, count, napi_biguint64_array);
+  Napi::BigUint64Array fileSizes = Napi::BigUint64Array::New(env, count, napi_biguint64_array);
+  Napi::BigUint64Array lastModificationTimes = Napi::BigUint64Array::New(env, count, napi_biguint64_array);
+  Napi::Uint32Array fileAttributes = Napi::Uint32Array::New(env, count, napi_uint32_array);
+
+  for (size_t i = 0; i < count; i++) {
+    actions[i] = changes[i].action;
+    fileIds[i] = changes[i].fileId;
+    fileSizes[i] = changes[i].fileSize;
+    lastModificationTimes[i] = changes[i].lastModificationTime;
+    fileAttributes[i] = changes[i].fileAttributes;
+  }
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("count", Napi::Number::New(env, static_cast<double>(count)));
+  result.Set("Action", actions);
+  result.Set("names", names);
+  result.Set("nameOffsets", nameOffsets);
+  result.Set("oldNames", oldNames);
+  result.Set("oldNameOffsets", oldNameOffsets);
+  result.Set("FileId", fileIds);
+  result.Set("FileSize", fileSizes);
+  result.Set("LastModificationTime", lastModificationTimes);
+  result.Set("FileAttributes", fileAttributes);
+  result.Set("overflow", Napi::Boolean::New(env, batch->overflow));
+  result.Set("error", Napi::Number::New(env, batch->error));
+
+  callback.Call({result});
+}
+
+// Every watcher opened in an env, which only ever creates and closes them from its own thread. Watchers still open when
+// the env shuts down have to be stopped while their callbacks can still be released, so they are closed from a cleanup
+// hook rather than when the registry itself is destroyed.
+struct DirectoryWatcherRegistry {
+  std::unordered_map<uint32_t, std::unique_ptr<DirectoryWatcher>> watchers;
+  uint32_t nextId = 1;
+
+  explicit DirectoryWatcherRegistry(Napi::Env env) {
+    env.AddCleanupHook([this]() { this->watchers.clear(); });
+  }
+
+  DirectoryWatcherRegistry(const DirectoryWatcherRegistry &) = delete;
+  DirectoryWatcherRegistry &operator=(const DirectoryWatcherRegistry &) = delete;
+};
+
+Napi::Value Kernel32::CreateDirectoryWatcher(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(lpPath, qb::ReadRequiredWideString(info, 0));
+  const QB_ARG(options, qb::ReadOptionalObject(info, 1));
+  const QB_ARG(callback, qb::ReadRequiredFunction(info, 2));
+
+  std::optional<bool> recursive;
+  std::optional<uint32_t> notifyFilter;
+  std::optional<uint32_t> bufferSize;
+  std::optional<uint32_t> latency;
+  std::optional<uint32_t> maxBatchSize;
+
+  if (options.has_value()) {
+    QB_ARG(optionsRecursive, qb::ReadOptionalBoolean(options.value(), "recursive"));
+    QB_ARG(optionsNotifyFilter, qb::ReadOptionalUint32(options.value(), "dwNotifyFilter"));
+    QB_ARG(optionsBufferSize, qb::ReadOptionalUint32(options.value(), "bufferSize"));
+    QB_ARG(optionsLatency, qb::ReadOptionalUint32(options.value(), "latency"));
+    QB_ARG(optionsMaxBatchSize, qb::ReadOptionalUint32(options.value(), "maxBatchSize"));
+
+    recursive = optionsRecursive;
+    notifyFilter = optionsNotifyFilter;
+    bufferSize = optionsBufferSize;
+    latency = optionsLatency;
+    maxBatchSize = optionsMaxBatchSize;
+  }
+
+  if (bufferSize.has_value() && (bufferSize.value() < MIN_BUFFER_SIZE || bufferSize.value() > MAX_BUFFER_SIZE)) {
+    qb::detail::ThrowTypeError(env, INVALID_BUFFER_SIZE, qb::detail::Property("bufferSize"));
+    return env.Undefined();
+  }
+
+  const HANDLE hDirectory = ::CreateFileW(lpPath.c_str(),
+                                         FILE_LIST_DIRECTORY,
+                                         FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                         nullptr,
+                                         OPEN_EXISTING,
+                                         FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+                                         nullptr);
+
+  // Failure is reported the Win32 way: 0 is returned and GetLastError says why.
+  if (hDirectory == INVALID_HANDLE_VALUE) {
+    return Napi::Number::New(env, 0);
+  }
+
+  DirectoryWatcherRegistry &registry = qb::InstanceData::Get<DirectoryWatcherRegistry>(env);
+
+  Napi::ThreadSafeFunction threadSafeCallback =
+      Napi::ThreadSafeFunction::New(env, callback, "CreateDirectoryWatcher", 0, 1);
+
+  auto watcher = std::make_unique<DirectoryWatcher>(hDirectory,
+                                                    recursive.value_or(false),
+                                                    notifyFilter.value_or(DEFAULT_NOTIFY_FILTER),
+                                                    bufferSize.value_or(DEFAULT_BUFFER_SIZE),
+                                                    latency.value_or(DEFAULT_LATENCY),
+                                                    maxBatchSize.value_or(DEFAULT_MAX_BATCH_SIZE),
+                                                    std::move(threadSafeCallback));
+
+  if (const DWORD error = watcher->Start(); error != ERROR_SUCCESS) {
+    // Destroying it closes the directory and releases the callback, which could overwrite the error.
+    watcher.reset();
+    ::SetLastError(error);
+
+    return Napi::Number::New(env, 0);
+  }
+
+  const uint32_t id = registry.nextId++;
+
+  registry.watchers.emplace(id, std::move(watcher));
+
+  return Napi::Number::New(env, id);
+}
+
+Napi::Value Kernel32::CloseDirectoryWatcher(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(id, qb::ReadRequiredUint32(info, 0));
+
+  // Destroying the watcher stops its thread, closes the directory and releases the callback.
+  return Napi::Boolean::New(env, qb::InstanceData::Get<DirectoryWatcherRegistry>(env).watchers.erase(id) != 0);
+}
@@ -0,0 +1,44 @@
+#include "kernel32.hpp"
+
+#include <algorithm>
+
+Napi::Value Kernel32::FormatMessageW(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(dwFlags, qb::ReadRequiredUint32(info, 0));
+
+  // lpSource is a message string with FORMAT_MESSAGE_FROM_STRING and a module handle otherwise. It is read before the
+  // arguments after it, so a bad lpSource is still the error reported when those are bad too.
+  std::optional<std::pmr::wstring> sourceString;
+  std::optional<HMODULE> sourceModule;
+
+  if ((dwFlags & FORMAT_MESSAGE_FROM_STRING) != 0) {
+    QB_ARG(source, qb::ReadRequiredWideString(info, 1));
+    sourceString = std::move(source);
+  } else {
+    QB_ARG(source, qb::ReadOptionalHandle<HMODULE>(info, 1));
+    sourceModule = source;
+  }
+
+  const auto [dwMessageId, dwLanguageId, lpBuffer, nSize] = QB_ARGS(qb::ReadRequiredUint32(info, 2),
+                                                                   qb::ReadRequiredUint32(info, 3),
+                                                                   qb::ReadRequiredObject(info, 4),
+                                                                   qb::ReadRequiredUint32(info, 5));
+
+  const LPCVOID lpSource = sourceString.has_value() ? static_cast<LPCVOID>(sourceString->c_str())
+                                                    : static_cast<LPCVOID>(sourceModule.value_or(nullptr));
+
+  // Insert arguments aren't marshalled, so inserts are always left as is, and the message is always written into the
+  // thread's text buffer rather than a LocalAlloc'd one the caller would have to free.
+  const DWORD flags = (dwFlags & ~(FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_ARGUMENT_ARRAY)) |
+                      FORMAT_MESSAGE_IGNORE_INSERTS;
+
+  qb::TextBuffer &buffer = qb::TextBuffer::Current();
+
+  const DWORD result =
+      ::FormatMessageW(flags, lpSource, dwMessageId, dwLanguageId, buffer.Reserve(std::max(nSize, 1u)), nSize, nullptr);
+
+  lpBuffer.Set("value", buffer.ToString(env, result));
+
+  return Napi::Number::New(env, result);
+}
@@ -0,0 +1,19 @@
+#include "kernel32.hpp"
+
+#include <algorithm>
+
+Napi::Value Kernel32::GetModuleFileNameW(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const auto [hModule, lpFilename, nSize] = QB_ARGS(
+      qb::ReadOptionalHandle<HMODULE>(info, 0), qb::ReadRequiredObject(info, 1), qb::ReadRequiredUint32(info, 2));
+
+  qb::TextBuffer &buffer = qb::TextBuffer::Current();
+
+  const DWORD result = ::GetModuleFileNameW(hModule.value_or(nullptr), buffer.Reserve(std::max(nSize, 1u)), nSize);
+
+  // A path that doesn't fit is truncated to nSize - 1 characters and terminated, and `result` is nSize.
+  lpFilename.Set("value", buffer.ToString(env, result == nSize && nSize > 0 ? nSize - 1 : result));
+
+  return Napi::Number::New(env, result);
+}
@@ -0,0 +1,617 @@
+#include "kernel32.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ioringapi.h>
+
+namespace qb {
+  template <> inline constexpr bool IsExtraHandle<HIORING> = true;
+} // namespace qb
+
+static constexpr std::string_view EXPECTED_BUFFER_ARRAY = "Expected an Array of ArrayBuffers or TypedArrays ";
+static constexpr std::string_view OPERATIONS_TOO_SMALL = "Buffer is too small to hold count operations ";
+static constexpr std::string_view BUFFER_TOO_LARGE = "Registered buffers are limited to 4GB ";
+static constexpr std::string_view SEGMENT_MISALIGNED = "Expected page aligned buffers of whole pages ";
+static constexpr std::string_view SEGMENTS_TOO_SMALL = "Segments are too small for the number of bytes ";
+
+// Every scatter/gather segment is one page. IoRing only exists on x64 and ARM64 Windows, where that is 4KB.
+static constexpr size_t IORING_SEGMENT_SIZE = 4096;
+
+static constexpr uint32_t IORING_OPERATION_READ = 0;
+static constexpr uint32_t IORING_OPERATION_WRITE = 1;
+
+// Operation record consumed by BuildIoRingOperations. Layout is mirrored by IoRingOperationBuffer in lib/io-ring.ts.
+struct IoRingOperation {
+  uint32_t opcode;
+  uint32_t fileIndex;
+  uint32_t bufferIndex;
+  uint32_t bufferOffset;
+  uint32_t length;
+  uint32_t sqeFlags;
+  uint64_t fileOffset;
+  uint64_t userData;
+};
+
+static_assert(sizeof(IoRingOperation) == 40);
+
+/**
+ * One IoRing function, looked up in KernelBase.dll on first use rather than imported, since IoRing only exists on
+ * Windows 11 and an import would keep the whole addon from loading anywhere older. Once found, it is cached.
+ */
+template <typename Function> class IoRingFunction {
+public:
+  explicit IoRingFunction(const char *name) : name(name) {}
+
+  // Throws an Error naming the function and returns nullptr when this version of Windows doesn't export it.
+  [[nodiscard]] Function *Get(const Napi::Env env) {
+    Function *function = this->function.load(std::memory_order_relaxed);
+
+    if (function == nullptr) {
+      if (const HMODULE kernelBase = ::GetModuleHandleW(L"kernelbase.dll")) {
+        // Through void *, since FARPROC and Function are unrelated function pointer types.
+        function = reinterpret_cast<Function *>(reinterpret_cast<void *>(::GetProcAddress(kernelBase, this->name)));
+      }
+
+      if (function == nullptr) {
+        Napi::Error::New(env, std::string(this->name) + " is not available on this version of Windows")
+            .ThrowAsJavaScriptException();
+        return nullptr;
+      }
+
+      this->function.store(function, std::memory_order_relaxed);
+    }
+
+    return function;
+  }
+
+  // For callers that only run once Get has succeeded, such as cleanup of a ring that was created through it.
+  [[nodiscard]] Function *Resolved() const { return this->function.load(std::memory_order_relaxed); }
+
+private:
+  const char *const name;
+  std::atomic<Function *> function = nullptr;
+};
+
+static struct {
+  IoRingFunction<decltype(::CreateIoRing)> CreateIoRing{"CreateIoRing"};
+  IoRingFunction<decltype(::CloseIoRing)> CloseIoRing{"CloseIoRing"};
+  IoRingFunction<decltype(::BuildIoRingRegisterFileHandles)> BuildIoRingRegisterFileHandles{
+      "BuildIoRingRegisterFileHandles"};
+  IoRingFunction<decltype(::BuildIoRingRegisterBuffers)> BuildIoRingRegisterBuffers{"BuildIoRingRegisterBuffers"};
+  IoRingFunction<decltype(::BuildIoRingReadFile)> BuildIoRingReadFile{"BuildIoRingReadFile"};
+  IoRingFunction<decltype(::BuildIoRingWriteFile)> BuildIoRingWriteFile{"BuildIoRingWriteFile"};
+  IoRingFunction<decltype(::BuildIoRingReadFileScatter)> BuildIoRingReadFileScatter{"BuildIoRingReadFileScatter"};
+  IoRingFunction<decltype(::BuildIoRingWriteFileGather)> BuildIoRingWriteFileGather{"BuildIoRingWriteFileGather"};
+  IoRingFunction<decltype(::SubmitIoRing)> SubmitIoRing{"SubmitIoRing"};
+  IoRingFunction<decltype(::PopIoRingCompletion)> PopIoRingCompletion{"PopIoRingCompletion"};
+} ioRingApi;
+
+// Each drained completion is stored as one element in each of these columns (see lib/io-ring.ts), so a buffer of N
+// completions is laid out as userData[N] (u64), information[N] (u64), resultCode[N] (i32).
+static constexpr size_t IORING_COMPLETION_RECORD_SIZE = 2 * sizeof(uint64_t) + sizeof(int32_t);
+
+// The segment array and JS buffers of one scatter/gather operation, kept until its completion is popped.
+struct IoRingSegments {
+  std::vector<FILE_SEGMENT_ELEMENT> elements;
+  std::vector<Napi::ObjectReference> pinned;
+};
+
+// Everything a ring's queued operations point at. The kernel reads the registered handle and buffer arrays when the
+// registration is submitted, not when it is built, and reads from or writes into registered buffers until the ring is
+// closed, so the arrays and the JS buffers backing them are kept alive here until CloseIoRing. Scatter/gather
+// operations are kept by their userData until a completion with that userData is popped, or the ring is closed.
+struct IoRingState {
+  std::deque<std::vector<HANDLE>> fileHandles;
+  std::deque<std::vector<IORING_BUFFER_INFO>> buffers;
+  std::vector<Napi::ObjectReference> pinned;
+  std::unordered_multimap<uint64_t, IoRingSegments> segments;
+};
+
+// Every ring created in an env. Rings still open when the env is torn down are closed before the buffers they read
+// from and write into are released.
+struct IoRingRegistry {
+  std::unordered_map<HIORING, IoRingState> rings;
+
+  IoRingRegistry() = default;
+
+  IoRingRegistry(const IoRingRegistry &) = delete;
+  IoRingRegistry &operator=(const IoRingRegistry &) = delete;
+
+  ~IoRingRegistry() {
+    for (const auto &[ring, state] : this->rings) {
+      ioRingApi.CloseIoRing.Resolved()(ring);
+    }
+  }
+
+  // The state of a ring created in this env and not yet closed, or nullptr for any other handle. Operations on those
+  // fail with E_INVALIDARG rather than pinning buffers under a handle nothing would ever close or release.
+  IoRingState *Find(const HIORING ring) {
+    const auto state = this->rings.find(ring);
+
+    return state == this->rings.end() ? nullptr : &state->second;
+  }
+
+  // Releases the segments of one scatter/gather operation that completed, if `userData` belongs to one.
+  void Completed(const HIORING ring, const uint64_t userData) {
+    const auto state = this->rings.find(ring);
+
+    if (state == this->rings.end() || state->second.segments.empty()) {
+      return;
+    }
+
+    if (const auto segments = state->second.segments.find(userData); segments != state->second.segments.end()) {
+      state->second.segments.erase(segments);
+    }
+  }
+};
+
+Napi::Value Kernel32::CreateIoRing(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(ioringVersion, qb::ReadRequiredInt32(info, 0));
+  const QB_ARG(flags, qb::ReadRequiredObject(info, 1));
+  const QB_ARG(submissionQueueSize, qb::ReadRequiredUint32(info, 2));
+  const QB_ARG(completionQueueSize, qb::ReadRequiredUint32(info, 3));
+  const QB_ARG(h, qb::ReadRequiredObject(info, 4));
+
+  const QB_ARG(required, qb::ReadRequiredUint32(flags, "Required"));
+  const QB_ARG(advisory, qb::ReadRequiredUint32(flags, "Advisory"));
+
+  const auto createIoRing = ioRingApi.CreateIoRing.Get(env);
+
+  // CloseIoRing is resolved up front as well, so a ring that was created can always be closed again.
+  if (createIoRing == nullptr || ioRingApi.CloseIoRing.Get(env) == nullptr) {
+    return env.Undefined();
+  }
+
+  const IORING_CREATE_FLAGS createFlags{static_cast<IORING_CREATE_REQUIRED_FLAGS>(required),
+                                        static_cast<IORING_CREATE_ADVISORY_FLAGS>(advisory)};
+
+  HIORING hIoRing = nullptr;
+
+  const HRESULT result = createIoRing(
+      static_cast<IORING_VERSION>(ioringVersion), createFlags, submissionQueueSize, completionQueueSize, &hIoRing);
+
+  if (SUCCEEDED(result)) {
+    qb::InstanceData::Get<IoRingRegistry>(env).rings.try_emplace(hIoRing);
+  }
+
+  h.Set("value", qb::HandleToBigInt(info, hIoRing));
+
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value Kernel32::CloseIoRing(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(ioRing, qb::ReadRequiredHandle<HIORING>(info, 0));
+
+  const auto closeIoRing = ioRingApi.CloseIoRing.Get(env);
+
+  if (closeIoRing == nullptr) {
+    return env.Undefined();
+  }
+
+  const HRESULT result = closeIoRing(ioRing);
+
+  // Closing the ring cancels anything still in flight, so the pinned buffers can be released either way.
+  qb::InstanceData::Get<IoRingRegistry>(env).rings.erase(ioRing);
+
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value Kernel32::BuildIoRingRegisterFileHandles(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(ioRing, qb::ReadRequiredHandle<HIORING>(info, 0));
+  const QB_ARG(userData, qb::ReadRequiredUint64(info, 2));
+
+  if (!info[1].IsTypedArray() || info[1].As<Napi::TypedArray>().TypedArrayType() != napi_biguint64_array) {
+    qb::detail::ThrowTypeError(env, qb::detail::EXPECTED_BIGUINT64_ARRAY, qb::detail::Argument(1));
+    return env.Undefined();
+  }
+
+  const auto buildIoRingRegisterFileHandles = ioRingApi.BuildIoRingRegisterFileHandles.Get(env);
+
+  if (buildIoRingRegisterFileHandles == nullptr) {
+    return env.Undefined();
+  }
+
+  IoRingState *state = qb::InstanceData::Get<IoRingRegistry>(env).Find(ioRing);
+
+  if (state == nullptr) {
+    return Napi::Number::New(env, E_INVALIDARG);
+  }
+
+  const Napi::BigUint64Array handles = info[1].As<Napi::BigUint64Array>();
+  const size_t count = handles.ElementLength();
+
+  std::vector<HANDLE> &fileHandles = state->fileHandles.emplace_back(count);
+
+  for (size_t i = 0; i < count; i++) {
+    fileHandles[i] = reinterpret_cast<HANDLE>(static_cast<uintptr_t>(handles[i]));
+  }
+
+  const HRESULT result =
+      buildIoRingRegisterFileHandles(ioRing, static_cast<UINT32>(count), fileHandles.data(), userData);
+
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value Kernel32::BuildIoRingRegisterBuffers(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(ioRing, qb::ReadRequiredHandle<HIORING>(info, 0));
+  const QB_ARG(userData, qb::ReadRequiredUint64(info, 2));
+
+  if (!info[1].IsArray()) {
+    qb::detail::ThrowTypeError(env, EXPECTED_BUFFER_ARRAY, qb::detail::Argument(1));
+    return env.Undefined();
+  }
+
+  const auto buildIoRingRegisterBuffers = ioRingApi.BuildIoRingRegisterBuffers.Get(env);
+
+  if (buildIoRingRegisterBuffers == nullptr) {
+    return env.Undefined();
+  }
+
+  const Napi::Array array = info[1].As<Napi::Array>();
+  const uint32_t count = array.Length();
+
+  std::vector<IORING_BUFFER_INFO> buffers(count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    const QB_ARG(buffer, qb::ReadRequiredSpan<uint8_t>(array, std::to_string(i)));
+
+    if (buffer.size() > UINT32_MAX) {
+      qb::detail::ThrowTypeError(env, BUFFER_TOO_LARGE, qb::detail::Property(std::to_string(i)));
+      return env.Undefined();
+    }
+
+    buffers[i] = {buffer.data(), static_cast<UINT32>(buffer.size())};
+  }
+
+  IoRingState *state = qb::InstanceData::Get<IoRingRegistry>(env).Find(ioRing);
+
+  if (state == nullptr) {
+    return Napi::Number::New(env, E_INVALIDARG);
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    state->pinned.push_back(Napi::Persistent(array.Get(i).As<Napi::Object>()));
+  }
+
+  const std::vector<IORING_BUFFER_INFO> &registered = state->buffers.emplace_back(std::move(buffers));
+
+  const HRESULT result = buildIoRingRegisterBuffers(ioRing, count, registered.data(), userData);
+
+  return Napi::Number::New(env, result);
+}
+
+/**
+ * Reads argument `index` of a scatter/gather binding, an Array of page aligned buffers that are each a whole number of
+ * pages, into one FILE_SEGMENT_ELEMENT per page. The buffers are pinned along with the elements, since the kernel
+ * reads from or writes into them until the operation completes. Returns false after throwing.
+ */
+static bool ReadSegments(const Napi::CallbackInfo &info, const uint16_t index, IoRingSegments &segments) {
+  const Napi::Env env = info.Env();
+
+  if (!info[index].IsArray()) {
+    qb::detail::ThrowTypeError(env, EXPECTED_BUFFER_ARRAY, qb::detail::Argument(index));
+    return false;
+  }
+
+  const Napi::Array array = info[index].As<Napi::Array>();
+  const uint32_t count = array.Length();
+
+  for (uint32_t i = 0; i < count; i++) {
+    const auto buffer = qb::ReadRequiredSpan<uint8_t>(array, std::to_string(i));
+
+    if (qb::detail::ArgumentsFailed(env)) {
+      return false;
+    }
+
+    if (reinterpret_cast<uintptr_t>(buffer.data()) % IORING_SEGMENT_SIZE != 0 ||
+        buffer.size() % IORING_SEGMENT_SIZE != 0) {
+      qb::detail::ThrowTypeError(env, SEGMENT_MISALIGNED, qb::detail::Property(std::to_string(i)));
+      return false;
+    }
+
+    for (size_t offset = 0; offset < buffer.size(); offset += IORING_SEGMENT_SIZE) {
+      FILE_SEGMENT_ELEMENT element{};
+      element.Buffer = buffer.data() + offset;
+
+      segments.elements.push_back(element);
+    }
+
+    segments.pinned.push_back(Napi::Persistent(array.Get(i).As<Napi::Object>()));
+  }
+
+  return true;
+}
+
+Napi::Value Kernel32::BuildIoRingReadFileScatter(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const auto [ioRing, fileIndex, numberOfBytesToRead, fileOffset, userData, sqeFlags] =
+      QB_ARGS(qb::ReadRequiredHandle<HIORING>(info, 0),
+              qb::ReadRequiredUint32(info, 1),
+              qb::ReadRequiredUint32(info, 3),
+              qb::ReadRequiredUint64(info, 4),
+              qb::ReadRequiredUint64(info, 5),
+              qb::ReadOptionalUint32(info, 6));
+
+  IoRingSegments segments;
+
+  if (!ReadSegments(info, 2, segments)) {
+    return env.Undefined();
+  }
+
+  if (numberOfBytesToRead > segments.elements.size() * IORING_SEGMENT_SIZE) {
+    qb::detail::ThrowRangeError(env, SEGMENTS_TOO_SMALL, qb::detail::Argument(2));
+    return env.Undefined();
+  }
+
+  const auto buildIoRingReadFileScatter = ioRingApi.BuildIoRingReadFileScatter.Get(env);
+
+  if (buildIoRingReadFileScatter == nullptr) {
+    return env.Undefined();
+  }
+
+  IoRingState *state = qb::InstanceData::Get<IoRingRegistry>(env).Find(ioRing);
+
+  if (state == nullptr) {
+    return Napi::Number::New(env, E_INVALIDARG);
+  }
+
+  const auto pending = state->segments.emplace(userData, std::move(segments));
+  std::vector<FILE_SEGMENT_ELEMENT> &elements = pending->second.elements;
+
+  const HRESULT result = buildIoRingReadFileScatter(ioRing,
+                                                    IoRingHandleRefFromIndex(fileIndex),
+                                                    static_cast<UINT32>(elements.size()),
+                                                    elements.data(),
+                                                    numberOfBytesToRead,
+                                                    fileOffset,
+                                                    userData,
+                                                    static_cast<IORING_SQE_FLAGS>(sqeFlags.value_or(IOSQE_FLAGS_NONE)));
+
+  // Nothing was queued, so there is no completion that would release the segments later.
+  if (FAILED(result)) {
+    state->segments.erase(pending);
+  }
+
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value Kernel32::BuildIoRingWriteFileGather(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const auto [ioRing, fileIndex, numberOfBytesToWrite, fileOffset, writeFlags, userData, sqeFlags] =
+      QB_ARGS(qb::ReadRequiredHandle<HIORING>(info, 0),
+              qb::ReadRequiredUint32(info, 1),
+              qb::ReadRequiredUint32(info, 3),
+              qb::ReadRequiredUint64(info, 4),
+              qb::ReadRequiredUint32(info, 5),
+              qb::ReadRequiredUint64(info, 6),
+              qb::ReadOptionalUint32(info, 7));
+
+  IoRingSegments segments;
+
+  if (!ReadSegments(info, 2, segments)) {
+    return env.Undefined();
+  }
+
+  if (numberOfBytesToWrite > segments.elements.size() * IORING_SEGMENT_SIZE) {
+    qb::detail::ThrowRangeError(env, SEGMENTS_TOO_SMALL, qb::detail::Argument(2));
+    return env.Undefined();
+  }
+
+  const auto buildIoRingWriteFileGather = ioRingApi.BuildIoRingWriteFileGather.Get(env);
+
+  if (buildIoRingWriteFileGather == nullptr) {
+    return env.Undefined();
+  }
+
+  IoRingState *state = qb::InstanceData::Get<IoRingRegistry>(env).Find(ioRing);
+
+  if (state == nullptr) {
+    return Napi::Number::New(env, E_INVALIDARG);
+  }
+
+  const auto pending = state->segments.emplace(userData, std::move(segments));
+  std::vector<FILE_SEGMENT_ELEMENT> &elements = pending->second.elements;
+
+  const HRESULT result = buildIoRingWriteFileGather(ioRing,
+                                                    IoRingHandleRefFromIndex(fileIndex),
+                                                    static_cast<UINT32>(elements.size()),
+                                                    elements.data(),
+                                                    numberOfBytesToWrite,
+                                                    fileOffset,
+                                                    static_cast<FILE_WRITE_FLAGS>(writeFlags),
+                                                    userData,
+                                                    static_cast<IORING_SQE_FLAGS>(sqeFlags.value_or(IOSQE_FLAGS_NONE)));
+
+  if (FAILED(result)) {
+    state->segments.erase(pending);
+  }
+
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value Kernel32::SubmitIoRing(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(ioRing, qb::ReadRequiredHandle<HIORING>(info, 0));
+  const QB_ARG(waitOperations, qb::ReadRequiredUint32(info, 1));
+  const QB_ARG(milliseconds, qb::ReadRequiredUint32(info, 2));
+  const QB_ARG(submittedEntries, qb::ReadOptionalObject(info, 3));
+
+  const auto submitIoRing = ioRingApi.SubmitIoRing.Get(env);
+
+  if (submitIoRing == nullptr) {
+    return env.Undefined();
+  }
+
+  UINT32 submitted = 0;
+
+  const HRESULT result = submitIoRing(ioRing, waitOperations, milliseconds, &submitted);
+
+  if (submittedEntries.has_value()) {
+    submittedEntries->Set("value", Napi::Number::New(env, submitted));
+  }
+
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value Kernel32::PopIoRingCompletion(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(ioRing, qb::ReadRequiredHandle<HIORING>(info, 0));
+  const QB_ARG(cqe, qb::ReadRequiredObject(info, 1));
+
+  const auto popIoRingCompletion = ioRingApi.PopIoRingCompletion.Get(env);
+
+  if (popIoRingCompletion == nullptr) {
+    return env.Undefined();
+  }
+
+  IORING_CQE completion{};
+
+  const HRESULT result = popIoRingCompletion(ioRing, &completion);
+
+  if (result == S_OK) {
+    qb::InstanceData::Get<IoRingRegistry>(env).Completed(ioRing, completion.UserData);
+
+    cqe.Set("UserData", Napi::BigInt::New(env, static_cast<uint64_t>(completion.UserData)));
+    cqe.Set("ResultCode", Napi::Number::New(env, completion.ResultCode));
+    cqe.Set("Information", Napi::BigInt::New(env, static_cast<uint64_t>(completion.Information)));
+  }
+
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value Kernel32::BuildIoRingOperations(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const auto [ioRing, operations, count, hResult] = QB_ARGS(qb::ReadRequiredHandle<HIORING>(info, 0),
+                                                            qb::ReadRequiredSpan<const IoRingOperation>(info, 1),
+                                                            qb::ReadRequiredUint32(info, 2),
+                                                            qb::ReadOptionalObject(info, 3));
+
+  if (count > operations.size()) {
+    qb::detail::ThrowRangeError(env, OPERATIONS_TOO_SMALL, qb::detail::Argument(1));
+    return env.Undefined();
+  }
+
+  // Checked before anything is queued, so an operation that can never be built doesn't leave the ones before it
+  // queued behind the caller's back.
+  for (uint32_t i = 0; i < count; i++) {
+    if (operations[i].opcode != IORING_OPERATION_READ && operations[i].opcode != IORING_OPERATION_WRITE) {
+      const std::string prefix =
+          "Unknown opcode " + std::to_string(operations[i].opcode) + " in operation " + std::to_string(i) + " ";
+
+      qb::detail::ThrowTypeError(env, prefix, qb::detail::Argument(1));
+      return env.Undefined();
+    }
+  }
+
+  const auto buildIoRingReadFile = ioRingApi.BuildIoRingReadFile.Get(env);
+  const auto buildIoRingWriteFile = buildIoRingReadFile != nullptr ? ioRingApi.BuildIoRingWriteFile.Get(env) : nullptr;
+
+  if (buildIoRingWriteFile == nullptr) {
+    return env.Undefined();
+  }
+
+  uint32_t built = 0;
+  HRESULT result = S_OK;
+
+  // Operations only reference registered handles and buffers, so nothing has to be pinned per operation. Stops at the
+  // first operation the ring rejects, which is usually IORING_E_SUBMISSION_QUEUE_FULL; submit and call again with the
+  // remaining operations.
+  for (; built < count; built++) {
+    const IoRingOperation &operation = operations[built];
+
+    const IORING_HANDLE_REF fileRef = IoRingHandleRefFromIndex(operation.fileIndex);
+    const IORING_BUFFER_REF bufferRef =
+        IoRingBufferRefFromIndexAndOffset(operation.bufferIndex, operation.bufferOffset);
+    const IORING_SQE_FLAGS sqeFlags = static_cast<IORING_SQE_FLAGS>(operation.sqeFlags);
+
+    if (operation.opcode == IORING_OPERATION_READ) {
+      result = buildIoRingReadFile(
+          ioRing, fileRef, bufferRef, operation.length, operation.fileOffset, operation.userData, sqeFlags);
+    } else {
+      result = buildIoRingWriteFile(ioRing,
+                                    fileRef,
+                                    bufferRef,
+                                    operation.length,
+                                    operation.fileOffset,
+                                    FILE_WRITE_FLAGS_NONE,
+                                    operation.userData,
+                                    sqeFlags);
+    }
+
+    if (FAILED(result)) {
+      break;
+    }
+  }
+
+  // The returned count doubles as the index of the operation `result` failed for.
+  if (hResult.has_value()) {
+    hResult->Set("value", Napi::Number::New(env, result));
+  }
+
+  return Napi::Number::New(env, built);
+}
+
+Napi::Value Kernel32::PopIoRingCompletions(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const auto [ioRing, buffer] =
+      QB_ARGS(qb::ReadRequiredHandle<HIORING>(info, 0), qb::ReadRequiredSpan<uint8_t>(info, 1));
+
+  const auto popIoRingCompletion = ioRingApi.PopIoRingCompletion.Get(env);
+
+  if (popIoRingCompletion == nullptr) {
+    return env.Undefined();
+  }
+
+  IoRingRegistry &registry = qb::InstanceData::Get<IoRingRegistry>(env);
+
+  const size_t capacity = buffer.size() / IORING_COMPLETION_RECORD_SIZE;
+
+  uint8_t *userData = buffer.data();
+  uint8_t *information = userData + capacity * sizeof(uint64_t);
+  uint8_t *resultCode = userData + capacity * 2 * sizeof(uint64_t);
+
+  size_t count = 0;
+
+  for (IORING_CQE completion; count < capacity && popIoRingCompletion(ioRing, &completion) == S_OK; count++) {
+    const uint64_t completionUserData = completion.UserData;
+    const uint64_t completionInformation = completion.Information;
+    const int32_t completionResultCode = completion.ResultCode;
+
+    registry.Completed(ioRing, completionUserData);
+
+    // TypedArray views over the caller's buffer may not be 8 byte aligned, so the columns are written byte-wise.
+    std::memcpy(userData + count * sizeof(uint64_t), &completionUserData, sizeof(uint64_t));
+    std::memcpy(information + count * sizeof(uint64_t), &completionInformation, sizeof(uint64_t));
+    std::memcpy(resultCode + count * sizeof(int32_t), &completionResultCode, sizeof(int32_t));
+  }
+
+  return Napi::Number::New(env, static_cast<double>(count));
+}
+
+Napi::Value Kernel32::GetIoRingSegmentOffset(const Napi::CallbackInfo &info) {
+  const QB_ARG(buffer, qb::ReadRequiredSpan<uint8_t>(info, 0));
+
+  const uintptr_t address = reinterpret_cast<uintptr_t>(buffer.data());
+  const size_t offset = (IORING_SEGMENT_SIZE - address % IORING_SEGMENT_SIZE) % IORING_SEGMENT_SIZE;
+
+  return Napi::Number::New(info.Env(), static_cast<double>(offset));
+}
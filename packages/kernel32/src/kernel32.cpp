@@ -1,10 +1,32 @@
 #include "kernel32.hpp"
 
-Napi::Object Initialize(const Napi::Env env, Napi::Object exports) {
-  QB_EXPORT(Kernel32::GetLastError);
-  QB_EXPORT(Kernel32::GetModuleHandleW);
+Napi::Object Kernel32::Initialize(const Napi::Env env, Napi::Object exports) {
+  static constexpr qb::Export EXPORTS[] = {
+      QB_EXPORT(Kernel32::GetLastError),
+      QB_EXPORT(Kernel32::GetModuleHandleW),
+      QB_EXPORT(Kernel32::GetModuleFileNameW),
+      QB_EXPORT(Kernel32::FormatMessageW),
+      QB_EXPORT(Kernel32::EnumerateDirectory),
+      QB_EXPORT(Kernel32::CreateDirectoryWatcher),
+      QB_EXPORT(Kernel32::CloseDirectoryWatcher),
+      QB_EXPORT(Kernel32::CreateIoRing),
+      QB_EXPORT(Kernel32::CloseIoRing),
+      QB_EXPORT(Kernel32::BuildIoRingRegisterFileHandles),
+      QB_EXPORT(Kernel32::BuildIoRingRegisterBuffers),
+      QB_EXPORT(Kernel32::BuildIoRingOperations),
+      QB_EXPORT(Kernel32::BuildIoRingReadFileScatter),
+      QB_EXPORT(Kernel32::BuildIoRingWriteFileGather),
+      QB_EXPORT(Kernel32::GetIoRingSegmentOffset),
+      QB_EXPORT(Kernel32::SubmitIoRing),
+      QB_EXPORT(Kernel32::PopIoRingCompletion),
+      QB_EXPORT(Kernel32::PopIoRingCompletions),
+  };
 
-  return exports;
+  return qb::DefineExports(env, exports, EXPORTS);
 }
 
+#ifndef LIBWIN_MONOLITHIC
+static Napi::Object Initialize(const Napi::Env env, Napi::Object exports) { return Kernel32::Initialize(env, exports); }
+
 NODE_API_MODULE(kernel32, Initialize)
+#endif
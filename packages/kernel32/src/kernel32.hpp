@@ -5,8 +5,13 @@
 
 #include "../../common/include/callback_handler.hpp"
 #include "../../common/include/quickbind.hpp"
+#include "../../common/include/quickbind_instance.hpp"
 
 namespace Kernel32 {
+  // Defines every kernel32 binding on `exports`. Called by this addon's module entry point, or by the combined libwin
+  // addon when building with LIBWIN_MONOLITHIC.
+  Napi::Object Initialize(const Napi::Env env, Napi::Object exports);
+
   Napi::Value AcquireSRWLockExclusive(const Napi::CallbackInfo &info);
   Napi::Value AcquireSRWLockShared(const Napi::CallbackInfo &info);
   Napi::Value ActivateActCtx(const Napi::CallbackInfo &info);
@@ -1698,4 +1703,12 @@ namespace Kernel32 {
   Napi::Value uaw_wcsicmp(const Napi::CallbackInfo &info);
   Napi::Value uaw_wcslen(const Napi::CallbackInfo &info);
   Napi::Value uaw_wcsrchr(const Napi::CallbackInfo &info);
+
+  // libwin extensions that have no kernel32.dll counterpart.
+  Napi::Value BuildIoRingOperations(const Napi::CallbackInfo &info);
+  Napi::Value CloseDirectoryWatcher(const Napi::CallbackInfo &info);
+  Napi::Value CreateDirectoryWatcher(const Napi::CallbackInfo &info);
+  Napi::Value EnumerateDirectory(const Napi::CallbackInfo &info);
+  Napi::Value GetIoRingSegmentOffset(const Napi::CallbackInfo &info);
+  Napi::Value PopIoRingCompletions(const Napi::CallbackInfo &info);
 } // namespace Kernel32
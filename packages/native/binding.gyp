@@ -0,0 +1,23 @@
+{
+  "includes": [
+    "../../common.gypi"
+  ],
+  "targets": [
+    {
+      "target_name": "libwin",
+      "product_name": "libwin",
+      "sources": [
+        "<!@(node ../../scripts/list-source-files.js --unity=<(unity) . ../comctl32 ../gdi32 ../kernel32 ../user32)"
+      ],
+      "defines": [
+        "LIBWIN_MONOLITHIC"
+      ],
+      "include_dirs": [
+        "<!(node -p \"require('node-addon-api').include\")"
+      ],
+      "dependencies": [
+        "<!(node -p \"require('node-addon-api').targets\"):node_addon_api"
+      ]
+    }
+  ]
+}
@@ -0,0 +1,22 @@
+#include "../../../comctl32/src/comctl32.cpp"
+#include "../../../gdi32/src/gdi32.cpp"
+#include "../../../kernel32/src/directory_watcher.cpp"
+#include "../../../kernel32/src/enumerate_directory.cpp"
+#include "../../../kernel32/src/format_message.cpp"
+#include "../../../kernel32/src/get_last_error.cpp"
+#include "../../../kernel32/src/get_module_file_name.cpp"
+#include "../../../kernel32/src/get_module_handle.cpp"
+#include "../../../kernel32/src/io_ring.cpp"
+#include "../../../kernel32/src/kernel32.cpp"
+#include "../../../user32/src/enum_windows.cpp"
+#include "../../../user32/src/get_client_rect.cpp"
+#include "../../../user32/src/input.cpp"
+#include "../../../user32/src/menu.cpp"
+#include "../../../user32/src/message.cpp"
+#include "../../../user32/src/message_box.cpp"
+#include "../../../user32/src/owned_handle.cpp"
+#include "../../../user32/src/paint.cpp"
+#include "../../../user32/src/raw_input.cpp"
+#include "../../../user32/src/user32.cpp"
+#include "../../../user32/src/window.cpp"
+#include "../../src/libwin.cpp"
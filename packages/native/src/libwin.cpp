@@ -0,0 +1,18 @@
+#include "../../comctl32/src/comctl32.hpp"
+#include "../../gdi32/src/gdi32.hpp"
+#include "../../kernel32/src/kernel32.hpp"
+#include "../../user32/src/user32.hpp"
+
+// Every package is compiled into this one addon, so they share a single copy of quickbind's runtime state (stats,
+// callback handlers, scratch buffers) and only one module has to be loaded. Each package's own entry point picks its
+// namespace off of this object when it is available.
+static Napi::Object Initialize(const Napi::Env env, Napi::Object exports) {
+  exports.Set("comctl32", Comctl32::Initialize(env, Napi::Object::New(env)));
+  exports.Set("gdi32", Gdi32::Initialize(env, Napi::Object::New(env)));
+  exports.Set("kernel32", Kernel32::Initialize(env, Napi::Object::New(env)));
+  exports.Set("user32", User32::Initialize(env, Napi::Object::New(env)));
+
+  return exports;
+}
+
+NODE_API_MODULE(libwin, Initialize)
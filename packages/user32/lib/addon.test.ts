@@ -0,0 +1,37 @@
+import { fileURLToPath } from 'node:url';
+
+import { describe, expect, test } from 'vitest';
+
+// Loads a fresh copy of the addon's exports, since lib/index.ts reads every export of the one require() caches.
+function loadExports(): Record<string, unknown> {
+  const module = { exports: {} as Record<string, unknown> };
+
+  process.dlopen(module, fileURLToPath(new URL('../build/Release/user32.node', import.meta.url)));
+
+  return module.exports;
+}
+
+describe('addon exports', () => {
+  test('are created on first read and then stored on the exports object', () => {
+    const exports = loadExports();
+
+    expect(Object.getOwnPropertyDescriptor(exports, 'DestroyWindow')?.get).toBeTypeOf('function');
+
+    const DestroyWindow = exports.DestroyWindow;
+
+    expect(DestroyWindow).toBeTypeOf('function');
+    expect(Object.getOwnPropertyDescriptor(exports, 'DestroyWindow')?.value).toBe(DestroyWindow);
+    expect(exports.DestroyWindow).toBe(DestroyWindow);
+  });
+
+  test('are stored on the exports object when read through an object inheriting from it', () => {
+    const exports = loadExports();
+    const derived = Object.create(exports) as Record<string, unknown>;
+
+    const GetClientRect = derived.GetClientRect;
+
+    expect(GetClientRect).toBeTypeOf('function');
+    expect(Object.hasOwn(derived, 'GetClientRect')).toBe(false);
+    expect(Object.getOwnPropertyDescriptor(exports, 'GetClientRect')?.value).toBe(GetClientRect);
+  });
+});
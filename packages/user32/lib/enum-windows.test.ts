@@ -0,0 +1,115 @@
+import { GetModuleHandleW } from '@libwin/kernel32';
+import { afterAll, beforeAll, describe, expect, test } from 'vitest';
+
+import { loadWin32Stub } from '../../common/win32-stub/index.js';
+import {
+  CreateWindowExW,
+  DefWindowProcW,
+  DestroyWindow,
+  EnumChildWindows,
+  EnumWindows,
+  GetWindowDetails,
+  RegisterClassExW,
+  WS_CHILD,
+  WS_OVERLAPPEDWINDOW,
+  WS_VISIBLE,
+} from './index.js';
+
+const PARENT_CLASS_NAME = 'LibwinEnumParent';
+const CHILD_CLASS_NAME = 'LibwinEnumChild';
+
+const PARENTS = 100;
+const CHILDREN = 999;
+
+for (const lpszClassName of [PARENT_CLASS_NAME, CHILD_CLASS_NAME]) {
+  RegisterClassExW({
+    cbSize: 80,
+    style: 0,
+    lpfnWndProc: DefWindowProcW,
+    cbClsExtra: 0,
+    cbWndExtra: 0,
+    hInstance: GetModuleHandleW(null),
+    lpszClassName,
+  });
+}
+
+function createWindow(className: string, dwStyle: number, X: number, hWndParent: bigint | null, text: string): bigint {
+  return CreateWindowExW(0, className, text, dwStyle, X, 0, 10, 20, hWndParent, null, null, null);
+}
+
+// A 100k window tree is built in the stub, since enumerating a real desktop would also return every other application's
+// windows.
+describe.skipIf(process.platform === 'win32')('EnumWindows', () => {
+  const stub = process.platform === 'win32' ? undefined : loadWin32Stub();
+
+  const parents: bigint[] = [];
+  const children: bigint[] = [];
+
+  beforeAll(() => {
+    for (let i = 0; i < PARENTS; i++) {
+      // Every other parent is visible, and every child is visible.
+      const dwStyle = WS_OVERLAPPEDWINDOW | (i % 2 === 0 ? WS_VISIBLE : 0);
+      const parent = createWindow(PARENT_CLASS_NAME, dwStyle, i, null, `P${i}`);
+
+      parents.push(parent);
+
+      for (let j = 0; j < CHILDREN; j++) {
+        children.push(createWindow(CHILD_CLASS_NAME, WS_CHILD | WS_VISIBLE, j, parent, `C${i}.${j}`));
+      }
+    }
+
+    expect(stub!.getWindowCount()).toBeGreaterThanOrEqual(PARENTS * (CHILDREN + 1));
+  });
+
+  afterAll(() => {
+    for (const parent of parents) {
+      DestroyWindow(parent);
+    }
+  });
+
+  test('returns every top-level window in one array', () => {
+    const hWnds = EnumWindows();
+    const topLevel = new Set(hWnds);
+
+    expect(hWnds).toBeInstanceOf(BigUint64Array);
+    expect(parents.every((parent) => topLevel.has(parent))).toBe(true);
+    expect(children.some((child) => topLevel.has(child))).toBe(false);
+  });
+
+  test('filters by class name ignoring case, visibility and process', () => {
+    expect(EnumWindows({ lpClassName: PARENT_CLASS_NAME })).toHaveLength(PARENTS);
+    expect(EnumWindows({ lpClassName: PARENT_CLASS_NAME.toLowerCase() })).toHaveLength(PARENTS);
+    expect(EnumWindows({ lpClassName: PARENT_CLASS_NAME, visible: true })).toHaveLength(PARENTS / 2);
+    expect(EnumWindows({ lpClassName: PARENT_CLASS_NAME, dwProcessId: process.pid })).toHaveLength(PARENTS);
+    expect(EnumWindows({ lpClassName: PARENT_CLASS_NAME, dwProcessId: process.pid + 1 })).toHaveLength(0);
+  });
+
+  test('returns every descendant of a parent', () => {
+    const hWnds = EnumChildWindows(parents[1]);
+
+    expect([...hWnds].sort()).toEqual(children.slice(CHILDREN, CHILDREN * 2).sort());
+    expect(EnumChildWindows(parents[1], { lpClassName: CHILD_CLASS_NAME.toUpperCase() })).toHaveLength(CHILDREN);
+    expect(EnumChildWindows(parents[1], { lpClassName: PARENT_CLASS_NAME })).toHaveLength(0);
+  });
+
+  test('fetches the class, text and rect of every window in bulk', () => {
+    const hWnds = EnumChildWindows(null, { lpClassName: CHILD_CLASS_NAME });
+    const all = new BigUint64Array(children);
+    const details = GetWindowDetails(all);
+
+    // Children aren't top-level windows.
+    expect(hWnds).toHaveLength(0);
+
+    expect(details.lpClassName).toHaveLength(children.length);
+    expect(details.lpClassName.every((className) => className === CHILD_CLASS_NAME)).toBe(true);
+    expect(details.lpString[0]).toBe('C0.0');
+    expect(details.lpString[children.length - 1]).toBe(`C${PARENTS - 1}.${CHILDREN - 1}`);
+    expect(details.rect).toHaveLength(children.length * 4);
+
+    // Child rects are in screen coordinates, offset by the parent's position.
+    const last = children.length - 1;
+
+    expect(details.rect[last * 4 + 2] - details.rect[last * 4]).toBe(10);
+    expect(details.rect[last * 4 + 3] - details.rect[last * 4 + 1]).toBe(20);
+  });
+});
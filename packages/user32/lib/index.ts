@@ -2,15 +2,43 @@ import { createRequire } from 'node:module';
 
 const require = createRequire(import.meta.url);
 
+/**
+ * Loads this package's own addon, or the user32 part of the combined libwin addon from @libwin/native when
+ * LIBWIN_NATIVE=1 is set, so every package shares one native runtime. The combined addon is opt-in, since it has to be
+ * installed and built separately: it is an optional peer dependency, and a workspace checkout links it even when it was
+ * never built.
+ */
+function loadAddon() {
+  if (process.env.LIBWIN_NATIVE !== '1') {
+    return require('./user32.node');
+  }
+
+  try {
+    return require('@libwin/native').user32;
+  } catch (error) {
+    if ((error as NodeJS.ErrnoException).code === 'MODULE_NOT_FOUND') {
+      throw new Error('LIBWIN_NATIVE=1 is set, but @libwin/native is not installed or not built', { cause: error });
+    }
+
+    throw error;
+  }
+}
+
 export * from './class-styles.js';
 export * from './window-styles.js';
 export * from './extended-window-styles.js';
+export * from './input.js';
 export * from './message-box.js';
 export * from './message.js';
+export * from './message-trace.js';
+export * from './owned-handle.js';
+export * from './raw-input.js';
 
 export const CW_USEDEFAULT = 0x80000000;
 
 // TODO: Not all functions are implemented nor will be. Just did this to make testing easier as I develop the addon.
+// ESM needs every named export's value at import, so this reads, and thereby creates, each function the addon
+// defines lazily.
 export const {
   ActivateKeyboardLayout,
   AddClipboardFormatListener,
@@ -30,6 +58,7 @@ export const {
   ArrangeIconicWindows,
   AttachThreadInput,
   BeginDeferWindowPos,
+  BeginMessageTrace,
   BeginPaint,
   BlockInput,
   BringWindowToTop,
@@ -261,6 +290,7 @@ export const {
   EndDeferWindowPosEx,
   EndDialog,
   EndMenu,
+  EndMessageTrace,
   EndPaint,
   EndTask,
   EnterMoveSizeLoop,
@@ -421,6 +451,7 @@ export const {
   GetNextDlgGroupItem,
   GetNextDlgTabItem,
   GetOpenClipboardWindow,
+  GetOwnedHandleStats,
   GetParent,
   GetPhysicalCursorPos,
   GetPointerCursorId,
@@ -506,6 +537,7 @@ export const {
   GetWindowCompositionInfo,
   GetWindowContextHelpId,
   GetWindowDC,
+  GetWindowDetails,
   GetWindowDisplayAffinity,
   GetWindowDpiAwarenessContext,
   GetWindowDpiHostingBehavior,
@@ -699,6 +731,8 @@ export const {
   OpenThreadDesktop,
   OpenWindowStationA,
   OpenWindowStationW,
+  OwnMenu,
+  OwnWindow,
   PackDDElParam,
   PackTouchHitTestingProximityEvaluation,
   PaintDesktop,
@@ -803,6 +837,7 @@ export const {
   RemovePropW,
   RemoveThreadTSFEventAwareness,
   RemoveVisualIdentifier,
+  ReplayMessageTrace,
   ReplyMessage,
   ReportInertia,
   ResolveDesktopForWOW,
@@ -940,6 +975,7 @@ export const {
   SetWindowsHookExAW,
   SetWindowsHookExW,
   SetWindowsHookW,
+  SetWndProcNumericParams,
   ShellForegroundBoostProcess,
   ShellHandwritingDelegateInput,
   ShellHandwritingHandleDelegatedInput,
@@ -1050,7 +1086,8 @@ export const {
   wsprintfW,
   wvsprintfA,
   wvsprintfW,
-} = require('./user32.node');
+  __qbStats,
+} = loadAddon();
 
 export type HELPINFO = {
   iContextType: number;
@@ -1063,6 +1100,72 @@ export type HELPINFO = {
   };
 };
 
+export type POINT = {
+  x: number;
+  y: number;
+};
+
+export type RECT = {
+  left: number;
+  top: number;
+  right: number;
+  bottom: number;
+};
+
+export type MSG = {
+  hwnd: bigint;
+  message: number;
+  wParam: number | bigint;
+  lParam: number | bigint;
+  time: number;
+  pt: POINT;
+};
+
+export type PAINTSTRUCT = {
+  hdc: bigint;
+  fErase: boolean;
+  rcPaint: RECT;
+  fRestore: boolean;
+  fIncUpdate: boolean;
+};
+
+/**
+ * Structs backed by native memory. Their objects can be passed anywhere a plain object of the same shape is accepted,
+ * and bindings then read and write the native struct directly instead of going through every property. Nested structs
+ * such as `msg.pt` are live views into their parent.
+ */
+export const {
+  MSG,
+  PAINTSTRUCT,
+  POINT,
+  RECT,
+}: {
+  MSG: new () => MSG;
+  PAINTSTRUCT: new () => PAINTSTRUCT;
+  POINT: new () => POINT;
+  RECT: new () => RECT;
+} = loadAddon();
+
+/**
+ * Native filter for EnumWindows and EnumChildWindows. Windows that don't match every provided field are skipped before
+ * they're added to the returned BigUint64Array.
+ */
+export type EnumWindowsFilter = {
+  lpClassName?: string;
+  visible?: boolean;
+  dwProcessId?: number;
+};
+
+/**
+ * Result of GetWindowDetails, one entry per handle in the same order. `rect` holds the GetWindowRect of window `i` at
+ * `rect[i * 4]` through `rect[i * 4 + 3]` as left, top, right, bottom.
+ */
+export type WINDOWDETAILS = {
+  lpClassName: string[];
+  lpString: string[];
+  rect: Int32Array;
+};
+
 /**
  * Macro to create a language identifier.
  *
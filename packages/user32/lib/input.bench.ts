@@ -0,0 +1,64 @@
+import { bench, describe } from 'vitest';
+
+import { loadWin32Stub } from '../../common/win32-stub/index.js';
+import { InputBuffer, KEYEVENTF_KEYUP, MOUSEEVENTF_MOVE, SIZEOF_INPUT, SendInput } from './index.js';
+
+// Events per iteration of the batched benchmarks, so their events/sec is this many times the reported hz.
+const BATCH = 64;
+
+function fill(inputs: InputBuffer): InputBuffer {
+  inputs.clear();
+
+  for (let i = 0; i < BATCH / 4; i++) {
+    inputs.keyboard(0x41, 0, 0).keyboard(0x41, 0, KEYEVENTF_KEYUP).mouse(1, -1, 0, MOUSEEVENTF_MOVE);
+    inputs.mouse(-1, 1, 0, MOUSEEVENTF_MOVE);
+  }
+
+  return inputs;
+}
+
+// Real input would move the cursor and type into whatever has focus, so this only runs against the stub, which
+// records it instead.
+describe.skipIf(process.platform === 'win32')('SendInput', () => {
+  const stub = process.platform === 'win32' ? undefined : loadWin32Stub();
+
+  // Drops the recorded input between runs, which would otherwise pile up for every iteration.
+  const options = { teardown: () => void stub?.takeSentInput() };
+
+  const single = new InputBuffer(1).keyboard(0x41, 0, 0);
+  const batch = fill(new InputBuffer(BATCH));
+  const refilled = new InputBuffer(BATCH);
+
+  bench(
+    '1 event per call',
+    () => {
+      SendInput(1, single.bytes, SIZEOF_INPUT);
+    },
+    options,
+  );
+
+  bench(
+    `${BATCH} events per call`,
+    () => {
+      SendInput(BATCH, batch.bytes, SIZEOF_INPUT);
+    },
+    options,
+  );
+
+  bench(
+    `${BATCH} events per call, packed each time`,
+    () => {
+      fill(refilled);
+      SendInput(BATCH, refilled.bytes, SIZEOF_INPUT);
+    },
+    options,
+  );
+});
+
+describe('InputBuffer', () => {
+  const inputs = new InputBuffer(BATCH);
+
+  bench(`pack ${BATCH} events`, () => {
+    fill(inputs);
+  });
+});
@@ -0,0 +1,51 @@
+import { describe, expect, test } from 'vitest';
+
+import { loadWin32Stub } from '../../common/win32-stub/index.js';
+import { InputBuffer, KEYEVENTF_KEYUP, MOUSEEVENTF_MOVE, SIZEOF_INPUT, SendInput } from './index.js';
+
+// Real input would go to whatever has focus, so this only runs against the stub, which records it instead.
+describe.skipIf(process.platform === 'win32')('SendInput', () => {
+  const stub = process.platform === 'win32' ? undefined : loadWin32Stub();
+
+  function inputs(): InputBuffer {
+    return new InputBuffer().keyboard(0x41, 0, 0).keyboard(0x41, 0, KEYEVENTF_KEYUP).mouse(5, -5, 0, MOUSEEVENTF_MOVE);
+  }
+
+  test('sends the records of an InputBuffer as they are', () => {
+    const buffer = inputs();
+
+    expect(SendInput(buffer.length, buffer.bytes, SIZEOF_INPUT)).toBe(3);
+    expect(new Uint8Array(stub!.takeSentInput())).toEqual(buffer.bytes);
+  });
+
+  test('takes an ArrayBuffer, a TypedArray or a DataView', () => {
+    const { bytes } = inputs();
+    const copy = bytes.slice().buffer;
+
+    expect(SendInput(3, copy, SIZEOF_INPUT)).toBe(3);
+    expect(SendInput(3, new DataView(copy), SIZEOF_INPUT)).toBe(3);
+    expect(SendInput(3, new BigUint64Array(copy), SIZEOF_INPUT)).toBe(3);
+
+    expect(new Uint8Array(stub!.takeSentInput())).toEqual(new Uint8Array([...bytes, ...bytes, ...bytes]));
+  });
+
+  test('rejects records that are not aligned', () => {
+    const misaligned = new Uint8Array(new ArrayBuffer(SIZEOF_INPUT + 8), 4, SIZEOF_INPUT);
+
+    expect(() => SendInput(1, misaligned, SIZEOF_INPUT)).toThrow(TypeError);
+    expect(() => SendInput(1, misaligned, SIZEOF_INPUT)).toThrow(/not aligned .*at index 1/);
+    expect(stub!.takeSentInput().byteLength).toBe(0);
+  });
+
+  test('rejects a buffer too small for cInputs records', () => {
+    const { bytes } = inputs();
+
+    expect(() => SendInput(4, bytes, SIZEOF_INPUT)).toThrow(RangeError);
+    expect(() => SendInput(1, bytes.subarray(0, SIZEOF_INPUT - 8), SIZEOF_INPUT)).toThrow(/too small .*at index 1/);
+    expect(stub!.takeSentInput().byteLength).toBe(0);
+  });
+
+  test('rejects anything but a buffer', () => {
+    expect(() => SendInput(1, [1, 2, 3], SIZEOF_INPUT)).toThrow(/^Expected an ArrayBuffer, TypedArray or DataView/);
+  });
+});
@@ -0,0 +1,156 @@
+export const INPUT_MOUSE = 0;
+export const INPUT_KEYBOARD = 1;
+export const INPUT_HARDWARE = 2;
+
+export const KEYEVENTF_EXTENDEDKEY = 0x0001;
+export const KEYEVENTF_KEYUP = 0x0002;
+export const KEYEVENTF_UNICODE = 0x0004;
+export const KEYEVENTF_SCANCODE = 0x0008;
+
+export const MOUSEEVENTF_MOVE = 0x0001;
+export const MOUSEEVENTF_LEFTDOWN = 0x0002;
+export const MOUSEEVENTF_LEFTUP = 0x0004;
+export const MOUSEEVENTF_RIGHTDOWN = 0x0008;
+export const MOUSEEVENTF_RIGHTUP = 0x0010;
+export const MOUSEEVENTF_MIDDLEDOWN = 0x0020;
+export const MOUSEEVENTF_MIDDLEUP = 0x0040;
+export const MOUSEEVENTF_XDOWN = 0x0080;
+export const MOUSEEVENTF_XUP = 0x0100;
+export const MOUSEEVENTF_WHEEL = 0x0800;
+export const MOUSEEVENTF_HWHEEL = 0x1000;
+export const MOUSEEVENTF_MOVE_NOCOALESCE = 0x2000;
+export const MOUSEEVENTF_VIRTUALDESK = 0x4000;
+export const MOUSEEVENTF_ABSOLUTE = 0x8000;
+
+/**
+ * Size of the x64 INPUT struct in bytes. Pass this as the cbSize argument of SendInput.
+ */
+export const SIZEOF_INPUT = 40;
+
+/**
+ * Builds a packed array of x64 INPUT structs that can be handed to SendInput in a single call.
+ *
+ * Layout of each 40 byte record:
+ *
+ * | Offset | INPUT_MOUSE        | INPUT_KEYBOARD     | INPUT_HARDWARE |
+ * | ------ | ------------------ | ------------------ | -------------- |
+ * | 0      | type               | type               | type           |
+ * | 8      | dx                 | wVk, wScan         | uMsg           |
+ * | 12     | dy                 | dwFlags            | wParamL, H     |
+ * | 16     | mouseData          | time               |                |
+ * | 20     | dwFlags            |                    |                |
+ * | 24     | time               | dwExtraInfo        |                |
+ * | 32     | dwExtraInfo        |                    |                |
+ *
+ * @example
+ * const inputs = new InputBuffer();
+ *
+ * inputs.keyboard(0x41, 0, 0);
+ * inputs.keyboard(0x41, 0, KEYEVENTF_KEYUP);
+ *
+ * SendInput(inputs.length, inputs.bytes, SIZEOF_INPUT);
+ */
+export class InputBuffer {
+  #buffer: ArrayBuffer;
+  #int32: Int32Array;
+  #uint32: Uint32Array;
+  #uint16: Uint16Array;
+  #uint64: BigUint64Array;
+  #length = 0;
+
+  constructor(capacity = 64) {
+    this.#buffer = new ArrayBuffer(Math.max(1, capacity) * SIZEOF_INPUT);
+    this.#int32 = new Int32Array(this.#buffer);
+    this.#uint32 = new Uint32Array(this.#buffer);
+    this.#uint16 = new Uint16Array(this.#buffer);
+    this.#uint64 = new BigUint64Array(this.#buffer);
+  }
+
+  /**
+   * Number of INPUT records written so far.
+   */
+  get length(): number {
+    return this.#length;
+  }
+
+  /**
+   * The written INPUT records, without any of the unused capacity.
+   */
+  get bytes(): Uint8Array {
+    return new Uint8Array(this.#buffer, 0, this.#length * SIZEOF_INPUT);
+  }
+
+  /**
+   * Appends a MOUSEINPUT record.
+   */
+  mouse(dx: number, dy: number, mouseData: number, dwFlags: number, time = 0, dwExtraInfo = 0n): this {
+    const index = this.#next();
+    const base = (index * SIZEOF_INPUT) >> 2;
+
+    this.#uint32[base] = INPUT_MOUSE;
+    this.#int32[base + 2] = dx;
+    this.#int32[base + 3] = dy;
+    this.#uint32[base + 4] = mouseData;
+    this.#uint32[base + 5] = dwFlags;
+    this.#uint32[base + 6] = time;
+    this.#uint64[(index * SIZEOF_INPUT + 32) >> 3] = dwExtraInfo;
+
+    return this;
+  }
+
+  /**
+   * Appends a KEYBDINPUT record.
+   */
+  keyboard(wVk: number, wScan: number, dwFlags: number, time = 0, dwExtraInfo = 0n): this {
+    const index = this.#next();
+    const base = (index * SIZEOF_INPUT) >> 2;
+
+    this.#uint32[base] = INPUT_KEYBOARD;
+    this.#uint16[(base + 2) << 1] = wVk;
+    this.#uint16[((base + 2) << 1) + 1] = wScan;
+    this.#uint32[base + 3] = dwFlags;
+    this.#uint32[base + 4] = time;
+    this.#uint64[(index * SIZEOF_INPUT + 24) >> 3] = dwExtraInfo;
+
+    return this;
+  }
+
+  /**
+   * Appends a HARDWAREINPUT record.
+   */
+  hardware(uMsg: number, wParamL: number, wParamH: number): this {
+    const index = this.#next();
+    const base = (index * SIZEOF_INPUT) >> 2;
+
+    this.#uint32[base] = INPUT_HARDWARE;
+    this.#uint32[base + 2] = uMsg;
+    this.#uint16[(base + 3) << 1] = wParamL;
+    this.#uint16[((base + 3) << 1) + 1] = wParamH;
+
+    return this;
+  }
+
+  /**
+   * Drops all written records while keeping the allocated capacity.
+   */
+  clear(): this {
+    this.#length = 0;
+
+    return this;
+  }
+
+  #next(): number {
+    if (this.#length * SIZEOF_INPUT === this.#buffer.byteLength) {
+      const buffer = new ArrayBuffer(this.#buffer.byteLength * 2);
+      new Uint8Array(buffer).set(new Uint8Array(this.#buffer));
+
+      this.#buffer = buffer;
+      this.#int32 = new Int32Array(buffer);
+      this.#uint32 = new Uint32Array(buffer);
+      this.#uint16 = new Uint16Array(buffer);
+      this.#uint64 = new BigUint64Array(buffer);
+    }
+
+    return this.#length++;
+  }
+}
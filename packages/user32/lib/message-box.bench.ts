@@ -0,0 +1,48 @@
+import { bench, describe } from 'vitest';
+
+import { loadWin32Stub } from '../../common/win32-stub/index.js';
+import { IDOK, MB_HELP, MB_ICONINFORMATION, MB_OK, MessageBoxIndirectW } from './index.js';
+
+// A real message box waits for the user, so this only runs against the stub, which closes it immediately.
+describe.skipIf(process.platform === 'win32')('MessageBoxIndirectW', () => {
+  const stub = process.platform === 'win32' ? undefined : loadWin32Stub();
+
+  // Drops the recorded calls between runs, which would otherwise pile up for every iteration.
+  const options = { teardown: () => void stub?.takeMessageBoxCalls() };
+
+  bench(
+    'text and caption',
+    () => {
+      MessageBoxIndirectW({
+        cbSize: 80,
+        hwndOwner: null,
+        lpszText: 'The quick brown fox jumps over the lazy dog.',
+        lpszCaption: 'Bench',
+        dwStyle: MB_OK | MB_ICONINFORMATION,
+      });
+    },
+    options,
+  );
+
+  bench(
+    'help callback',
+    () => {
+      MessageBoxIndirectW({
+        cbSize: 80,
+        hwndOwner: null,
+        lpszText: 'The quick brown fox jumps over the lazy dog.',
+        lpszCaption: 'Bench',
+        dwStyle: MB_OK | MB_HELP,
+        dwContextHelpId: 1n,
+        lpfnMsgBoxCallback: () => {},
+      });
+    },
+    {
+      setup: () => stub?.setMessageBoxResult(IDOK, 1),
+      teardown: () => {
+        stub?.takeMessageBoxCalls();
+        stub?.setMessageBoxResult(IDOK);
+      },
+    },
+  );
+});
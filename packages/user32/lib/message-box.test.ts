@@ -0,0 +1,49 @@
+import { describe, expect, test } from 'vitest';
+
+import { loadWin32Stub } from '../../common/win32-stub/index.js';
+import { IDOK, MB_OK, MessageBoxA, MessageBoxExW, MessageBoxIndirectW, MessageBoxW } from './index.js';
+
+// A real message box waits for the user, so this only runs against the stub, which closes it immediately.
+describe.skipIf(process.platform === 'win32')('message boxes', () => {
+  const stub = process.platform === 'win32' ? undefined : loadWin32Stub();
+
+  test('narrow wLanguageId only when it fits', () => {
+    expect(MessageBoxExW(0n, 'Text', 'Caption', MB_OK, 0xffff)).toBe(IDOK);
+
+    for (const wLanguageId of [0x10000, -1, Number.NaN]) {
+      expect(() => MessageBoxExW(0n, 'Text', 'Caption', MB_OK, wLanguageId)).toThrow(/^Expected a Number between .*4$/);
+    }
+
+    expect(stub!.takeMessageBoxCalls()).toHaveLength(1);
+  });
+
+  test('read properties of an object', () => {
+    MessageBoxIndirectW({ cbSize: 80, hwndOwner: null, lpszText: 'Text', lpszCaption: 'Caption', dwStyle: MB_OK });
+
+    expect(stub!.takeMessageBoxCalls()).toEqual([{ hWnd: 0n, text: 'Text', caption: 'Caption', type: MB_OK }]);
+
+    expect(() => MessageBoxIndirectW({ cbSize: 80, dwStyle: MB_OK })).toThrow(
+      /^Expected a String for property lpszText$/,
+    );
+    expect(() => MessageBoxIndirectW({ cbSize: 80, lpszText: 'Text', dwStyle: MB_OK, lpszCaption: 1 })).toThrow(
+      /for property lpszCaption$/,
+    );
+    expect(stub!.takeMessageBoxCalls()).toHaveLength(0);
+  });
+
+  test('convert strings to the ANSI code page', () => {
+    MessageBoxA(0n, 'Héllo €', 'Łódź', MB_OK);
+
+    // The stub's ANSI code page is 1252, which has no Ł or ź.
+    expect(stub!.takeMessageBoxCalls()).toMatchObject([{ text: 'Héllo €', caption: '?ód?' }]);
+  });
+
+  test('pass strings of any length', () => {
+    const text = 'The quick brown fox jumps over the lazy dog. '.repeat(4096);
+
+    MessageBoxW(0n, text, 'Caption', MB_OK);
+    MessageBoxA(0n, text, 'Caption', MB_OK);
+
+    expect(stub!.takeMessageBoxCalls().map((call) => call.text)).toEqual([text, text]);
+  });
+});
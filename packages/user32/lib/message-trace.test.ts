@@ -0,0 +1,225 @@
+import { GetModuleHandleW } from '@libwin/kernel32';
+import { describe, expect, test } from 'vitest';
+
+import {
+  BeginMessageTrace,
+  CW_USEDEFAULT,
+  CreateWindowExW,
+  DefWindowProcW,
+  DestroyWindow,
+  DispatchMessageW,
+  EndMessageTrace,
+  GetMessageW,
+  MESSAGE_TRACE_DISPATCHED,
+  MESSAGE_TRACE_HEADER_SIZE,
+  MESSAGE_TRACE_RECORD_SIZE,
+  PostMessageW,
+  RegisterClassExW,
+  ReplayMessageTrace,
+  WM_NCCREATE,
+  WM_USER,
+  WS_OVERLAPPEDWINDOW,
+  messageTraceLength,
+  readMessageTraceRecord,
+  summarizeMessageTrace,
+} from './index.js';
+
+const CLASS_NAME = 'LibwinMessageTraceTest';
+
+// Creates and destroys a window from inside its handler, so the messages those send are nested in it.
+const NESTING_MESSAGE = WM_USER + 5;
+
+const received: { hWnd: bigint; message: number; wParam: number | bigint; lParam: number | bigint }[] = [];
+
+function WndProc(hWnd: bigint, message: number, wParam: number | bigint, lParam: number | bigint): number | bigint {
+  if (message >= WM_USER) {
+    received.push({ hWnd, message, wParam, lParam });
+
+    if (message === NESTING_MESSAGE) {
+      DestroyWindow(createWindow());
+    }
+
+    return 0;
+  }
+
+  return DefWindowProcW(hWnd, message, wParam, lParam);
+}
+
+RegisterClassExW({
+  cbSize: 80,
+  style: 0,
+  lpfnWndProc: WndProc,
+  cbClsExtra: 0,
+  cbWndExtra: 0,
+  hInstance: GetModuleHandleW(null),
+  lpszClassName: CLASS_NAME,
+});
+
+function createWindow(): bigint {
+  return CreateWindowExW(
+    0,
+    CLASS_NAME,
+    'Test',
+    WS_OVERLAPPEDWINDOW,
+    CW_USEDEFAULT,
+    CW_USEDEFAULT,
+    500,
+    300,
+    null,
+    null,
+    null,
+    null,
+  );
+}
+
+function pumpOne(): void {
+  const msg = { hwnd: 0n, message: 0, wParam: 0n, lParam: 0n, time: 0, pt: { x: 0, y: 0 } };
+
+  GetMessageW(msg, null, 0, 0);
+  DispatchMessageW(msg);
+}
+
+describe('message trace', () => {
+  const hWnd = createWindow();
+
+  test('starts with a header', () => {
+    BeginMessageTrace();
+
+    const view = new DataView(EndMessageTrace());
+
+    expect(view.byteLength).toBe(MESSAGE_TRACE_HEADER_SIZE);
+    expect(view.getUint32(0, true)).toBe(0x544d4251);
+    expect(view.getUint32(4, true)).toBe(1);
+    expect(view.getUint32(8, true)).toBe(MESSAGE_TRACE_RECORD_SIZE);
+  });
+
+  test('records every WndProc call in the order they were delivered', () => {
+    BeginMessageTrace();
+
+    PostMessageW(hWnd, WM_USER, 0x1234, 0x5678);
+    pumpOne();
+
+    const created = createWindow();
+
+    const trace = EndMessageTrace();
+    const records = Array.from({ length: messageTraceLength(trace) }, (_, i) => readMessageTraceRecord(trace, i));
+
+    expect(trace.byteLength).toBe(MESSAGE_TRACE_HEADER_SIZE + records.length * MESSAGE_TRACE_RECORD_SIZE);
+    expect(records[0]).toMatchObject({
+      hwnd: hWnd,
+      message: WM_USER,
+      wParam: 0x1234n,
+      lParam: 0x5678n,
+      flags: MESSAGE_TRACE_DISPATCHED,
+    });
+
+    // Sent rather than dispatched.
+    expect(records.find((record) => record.message === WM_NCCREATE)).toMatchObject({ hwnd: created, flags: 0 });
+
+    for (let i = 1; i < records.length; i++) {
+      expect(records[i].timestamp).toBeGreaterThanOrEqual(records[i - 1].timestamp);
+    }
+
+    DestroyWindow(created);
+  });
+
+  test('flags only the message DispatchMessageW delivered, not those sent while handling it', () => {
+    BeginMessageTrace();
+
+    PostMessageW(hWnd, NESTING_MESSAGE, 0, 0);
+    pumpOne();
+
+    const trace = EndMessageTrace();
+    const records = Array.from({ length: messageTraceLength(trace) }, (_, i) => readMessageTraceRecord(trace, i));
+
+    expect(records[0]).toMatchObject({ hwnd: hWnd, message: NESTING_MESSAGE, flags: MESSAGE_TRACE_DISPATCHED });
+    expect(records.find((record) => record.message === WM_NCCREATE)).toMatchObject({ flags: 0 });
+    expect(records.slice(1).every((record) => record.flags === 0)).toBe(true);
+    expect(records.length).toBeGreaterThan(1);
+  });
+
+  test('is summarized by message', () => {
+    BeginMessageTrace();
+
+    for (let i = 0; i < 3; i++) {
+      PostMessageW(hWnd, WM_USER + 1, i, 0);
+      pumpOne();
+    }
+
+    PostMessageW(hWnd, WM_USER + 2, 0, 0);
+    pumpOne();
+
+    const costs = summarizeMessageTrace(EndMessageTrace());
+
+    expect(costs).toHaveLength(2);
+    expect(costs.find((cost) => cost.message === WM_USER + 1)?.count).toBe(3);
+    expect(costs.find((cost) => cost.message === WM_USER + 2)?.count).toBe(1);
+
+    for (const cost of costs) {
+      expect(cost.maxNs).toBeLessThanOrEqual(cost.totalNs);
+    }
+  });
+
+  test('is replayed to the WndProc without being recorded again', () => {
+    BeginMessageTrace();
+
+    PostMessageW(hWnd, WM_USER + 3, 1, 2);
+    PostMessageW(hWnd, WM_USER + 4, 3, 4);
+    pumpOne();
+    pumpOne();
+
+    const trace = EndMessageTrace();
+
+    received.length = 0;
+    BeginMessageTrace();
+
+    const handlerNs = ReplayMessageTrace(trace);
+
+    expect(messageTraceLength(EndMessageTrace())).toBe(0);
+    expect(handlerNs).toBeInstanceOf(Float64Array);
+    expect(handlerNs).toHaveLength(2);
+    expect(received.map(({ message, wParam, lParam }) => [message, BigInt(wParam), BigInt(lParam)])).toEqual([
+      [WM_USER + 3, 1n, 2n],
+      [WM_USER + 4, 3n, 4n],
+    ]);
+  });
+
+  test('replays only dispatched records to windows that still exist unless asked to deliver directly', () => {
+    BeginMessageTrace();
+
+    PostMessageW(hWnd, NESTING_MESSAGE, 0, 0);
+    pumpOne();
+
+    const gone = createWindow();
+
+    PostMessageW(gone, WM_USER + 6, 0, 0);
+    pumpOne();
+    DestroyWindow(gone);
+
+    const trace = EndMessageTrace();
+    const records = Array.from({ length: messageTraceLength(trace) }, (_, i) => readMessageTraceRecord(trace, i));
+
+    received.length = 0;
+
+    const dispatched = ReplayMessageTrace(trace);
+
+    // The nested window is created again by the handler rather than replayed from the trace.
+    expect(received.map(({ message }) => message)).toEqual([NESTING_MESSAGE]);
+    expect(Number.isNaN(dispatched[0])).toBe(false);
+    expect(records.filter((record, i) => !Number.isNaN(dispatched[i]))).toEqual([records[0]]);
+
+    received.length = 0;
+
+    const direct = ReplayMessageTrace(trace, false, true);
+
+    expect(received.map(({ message }) => message)).toEqual([NESTING_MESSAGE, WM_USER + 6]);
+    expect(direct.every((ns) => !Number.isNaN(ns))).toBe(true);
+  });
+
+  test('replays only traces', () => {
+    expect(() => ReplayMessageTrace(new ArrayBuffer(64))).toThrow(
+      /^Expected an ArrayBuffer containing a message trace/,
+    );
+    expect(() => ReplayMessageTrace(new ArrayBuffer(4))).toThrow(TypeError);
+  });
+});
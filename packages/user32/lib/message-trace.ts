@@ -0,0 +1,107 @@
+/**
+ * Size in bytes of the header at the start of every trace returned by EndMessageTrace.
+ */
+export const MESSAGE_TRACE_HEADER_SIZE = 16;
+
+/**
+ * Size in bytes of each record that follows the header.
+ */
+export const MESSAGE_TRACE_RECORD_SIZE = 48;
+
+/**
+ * Set in a record's flags when the WndProc call is the one DispatchMessageW delivered. Messages sent while a dispatched
+ * message is handled, e.g. WM_NCCREATE from a CreateWindowExW call in the handler, are not flagged.
+ *
+ * ReplayMessageTrace(trace, realTime?, direct?) only replays records with this flag, through DispatchMessageW, to
+ * windows that still exist. The messages sent while handling them are sent again by the handler, so replaying their
+ * records as well would count them twice. With `direct` set, every record goes straight to the JS WndProc instead,
+ * bypassing DispatchMessageW and the windows the trace was recorded from, so nested messages are delivered twice and
+ * nothing Windows does around delivery, such as calling a WM_TIMER callback, happens. Either way, the returned
+ * handler times are NaN for records that weren't replayed.
+ */
+export const MESSAGE_TRACE_DISPATCHED = 0x1;
+
+export type MessageTraceRecord = {
+  /** Nanoseconds since BeginMessageTrace. */
+  timestamp: bigint;
+  hwnd: bigint;
+  message: number;
+  wParam: bigint;
+  lParam: bigint;
+  flags: number;
+  /**
+   * Nanoseconds spent in the JS WndProc, including anything it sent or dispatched. Those nested messages have records
+   * of their own, so summing handlerNs over a trace counts their time once for every message they are nested in.
+   */
+  handlerNs: bigint;
+};
+
+export type MessageCost = {
+  message: number;
+  count: number;
+  totalNs: number;
+  maxNs: number;
+};
+
+/**
+ * Number of records in a trace returned by EndMessageTrace.
+ */
+export function messageTraceLength(trace: ArrayBuffer): number {
+  return Math.floor((trace.byteLength - MESSAGE_TRACE_HEADER_SIZE) / MESSAGE_TRACE_RECORD_SIZE);
+}
+
+/**
+ * Decodes record `index` of a trace returned by EndMessageTrace.
+ *
+ * | Offset | Field     | Type |
+ * | ------ | --------- | ---- |
+ * | 0      | timestamp | u64  |
+ * | 8      | hwnd      | u64  |
+ * | 16     | wParam    | u64  |
+ * | 24     | lParam    | i64  |
+ * | 32     | message   | u32  |
+ * | 36     | flags     | u32  |
+ * | 40     | handlerNs | u64  |
+ */
+export function readMessageTraceRecord(trace: ArrayBuffer, index: number): MessageTraceRecord {
+  const offset = MESSAGE_TRACE_HEADER_SIZE + index * MESSAGE_TRACE_RECORD_SIZE;
+  const view = new DataView(trace, offset, MESSAGE_TRACE_RECORD_SIZE);
+
+  return {
+    timestamp: view.getBigUint64(0, true),
+    hwnd: view.getBigUint64(8, true),
+    wParam: view.getBigUint64(16, true),
+    lParam: view.getBigInt64(24, true),
+    message: view.getUint32(32, true),
+    flags: view.getUint32(36, true),
+    handlerNs: view.getBigUint64(40, true),
+  };
+}
+
+/**
+ * Per message type cost breakdown of a trace, sorted by total handler time, most expensive first. Since handlerNs
+ * includes nested messages, a message's totalNs also contains the time of every message sent while it was handled.
+ */
+export function summarizeMessageTrace(trace: ArrayBuffer): MessageCost[] {
+  const view = new DataView(trace);
+  const costs = new Map<number, MessageCost>();
+
+  for (let i = 0, length = messageTraceLength(trace); i < length; i++) {
+    const offset = MESSAGE_TRACE_HEADER_SIZE + i * MESSAGE_TRACE_RECORD_SIZE;
+    const message = view.getUint32(offset + 32, true);
+    const handlerNs = Number(view.getBigUint64(offset + 40, true));
+
+    let cost = costs.get(message);
+
+    if (!cost) {
+      cost = { message, count: 0, totalNs: 0, maxNs: 0 };
+      costs.set(message, cost);
+    }
+
+    cost.count++;
+    cost.totalNs += handlerNs;
+    cost.maxNs = Math.max(cost.maxNs, handlerNs);
+  }
+
+  return [...costs.values()].sort((a, b) => b.totalNs - a.totalNs);
+}
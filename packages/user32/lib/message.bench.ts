@@ -0,0 +1,80 @@
+import { GetModuleHandleW } from '@libwin/kernel32';
+import { bench, describe } from 'vitest';
+
+import {
+  CW_USEDEFAULT,
+  CreateWindowExW,
+  DefWindowProcW,
+  DispatchMessageW,
+  GetMessageW,
+  MSG,
+  PostMessageW,
+  RegisterClassExW,
+  WM_USER,
+  WS_OVERLAPPEDWINDOW,
+} from './index.js';
+
+const CLASS_NAME = 'LibwinMessageBench';
+
+function WndProc(hWnd: bigint, message: number, wParam: number | bigint, lParam: number | bigint): number | bigint {
+  return message === WM_USER ? 0 : DefWindowProcW(hWnd, message, wParam, lParam);
+}
+
+RegisterClassExW({
+  cbSize: 80,
+  style: 0,
+  lpfnWndProc: WndProc,
+  cbClsExtra: 0,
+  cbWndExtra: 0,
+  hInstance: GetModuleHandleW(null),
+  lpszClassName: CLASS_NAME,
+});
+
+// Never shown, so the queue only ever holds what the benchmarks post and GetMessageW never has to wait.
+const hWnd: bigint = CreateWindowExW(
+  0,
+  CLASS_NAME,
+  'Bench',
+  WS_OVERLAPPEDWINDOW,
+  CW_USEDEFAULT,
+  CW_USEDEFAULT,
+  500,
+  300,
+  null,
+  null,
+  null,
+  null,
+);
+
+describe('GetMessageW', () => {
+  const plain = { hwnd: 0n, message: 0, wParam: 0n, lParam: 0n, time: 0, pt: { x: 0, y: 0 } };
+  const native = new MSG();
+
+  bench('plain object', () => {
+    PostMessageW(hWnd, WM_USER, 1, 2);
+    GetMessageW(plain, null, 0, 0);
+  });
+
+  bench('native MSG', () => {
+    PostMessageW(hWnd, WM_USER, 1, 2);
+    GetMessageW(native, null, 0, 0);
+  });
+});
+
+describe('DispatchMessageW', () => {
+  const plain = { hwnd: 0n, message: 0, wParam: 0n, lParam: 0n, time: 0, pt: { x: 0, y: 0 } };
+  const native = new MSG();
+
+  // Includes the PostMessageW and GetMessageW needed to have something to dispatch, see GetMessageW above.
+  bench('plain object', () => {
+    PostMessageW(hWnd, WM_USER, 1, 2);
+    GetMessageW(plain, null, 0, 0);
+    DispatchMessageW(plain);
+  });
+
+  bench('native MSG', () => {
+    PostMessageW(hWnd, WM_USER, 1, 2);
+    GetMessageW(native, null, 0, 0);
+    DispatchMessageW(native);
+  });
+});
@@ -0,0 +1,181 @@
+import { GetModuleHandleW } from '@libwin/kernel32';
+import { describe, expect, test } from 'vitest';
+
+import {
+  CW_USEDEFAULT,
+  CreateWindowExW,
+  DefWindowProcW,
+  DestroyWindow,
+  DispatchMessageW,
+  GetMessageW,
+  MSG,
+  PostMessageW,
+  RegisterClassExW,
+  SetWndProcNumericParams,
+  WM_USER,
+  WS_OVERLAPPEDWINDOW,
+} from './index.js';
+
+const CLASS_NAME = 'LibwinMessageTest';
+const RECORDING_CLASS_NAME = 'LibwinMessageRecordingTest';
+
+const received: bigint[] = [];
+
+RegisterClassExW({
+  cbSize: 80,
+  style: 0,
+  lpfnWndProc: DefWindowProcW,
+  cbClsExtra: 0,
+  cbWndExtra: 0,
+  hInstance: GetModuleHandleW(null),
+  lpszClassName: CLASS_NAME,
+});
+
+RegisterClassExW({
+  cbSize: 80,
+  style: 0,
+  lpfnWndProc: (hWnd: bigint, message: number, wParam: bigint, lParam: bigint) => {
+    if (message === WM_USER) {
+      received.push(lParam);
+
+      return 0n;
+    }
+
+    return DefWindowProcW(hWnd, message, wParam, lParam);
+  },
+  cbClsExtra: 0,
+  cbWndExtra: 0,
+  hInstance: GetModuleHandleW(null),
+  lpszClassName: RECORDING_CLASS_NAME,
+});
+
+function createWindow(className: string): bigint {
+  return CreateWindowExW(
+    0,
+    className,
+    'Test',
+    WS_OVERLAPPEDWINDOW,
+    CW_USEDEFAULT,
+    CW_USEDEFAULT,
+    500,
+    300,
+    null,
+    null,
+    null,
+    null,
+  );
+}
+
+const hWnd = createWindow(CLASS_NAME);
+
+function nextMessage() {
+  const msg = { hwnd: 0n, message: 0, wParam: 0n, lParam: 0n, time: 0, pt: { x: 0, y: 0 } };
+
+  GetMessageW(msg, null, 0, 0);
+
+  return msg;
+}
+
+describe('QB_ARGS', () => {
+  test('reports the first argument that fails to read', () => {
+    expect(() => PostMessageW(hWnd, 'x', 'y', 0)).toThrow(/^Expected a Number at index 1$/);
+    expect(() => PostMessageW(hWnd, WM_USER, 'y', 'z')).toThrow(/at index 2$/);
+  });
+
+  test('reads no property after one fails to read', () => {
+    const read: string[] = [];
+    const msg = {
+      hwnd: 'x',
+      get message() {
+        read.push('message');
+
+        return WM_USER;
+      },
+    };
+
+    expect(() => DispatchMessageW(msg)).toThrow(/^Expected a BigInt for property hwnd/);
+    expect(read).toEqual([]);
+  });
+
+  test('calls nothing when an argument fails to read', () => {
+    expect(() => PostMessageW(hWnd, WM_USER + 1, 1, 'z')).toThrow(TypeError);
+
+    PostMessageW(hWnd, WM_USER + 2, 0, 0);
+
+    expect(nextMessage().message).toBe(WM_USER + 2);
+  });
+});
+
+describe('pointer-sized readers', () => {
+  test('take a Number or a BigInt', () => {
+    PostMessageW(hWnd, WM_USER, 2 ** 40, 7);
+
+    expect(nextMessage()).toMatchObject({ hwnd: hWnd, message: WM_USER, wParam: 2n ** 40n, lParam: 7n });
+
+    PostMessageW(hWnd, WM_USER, 2n ** 64n - 1n, 2n ** 62n);
+
+    expect(nextMessage()).toMatchObject({ wParam: 2n ** 64n - 1n, lParam: 2n ** 62n });
+  });
+
+  test('read LPARAM back as a signed BigInt', () => {
+    PostMessageW(hWnd, WM_USER, 0, -1);
+
+    expect(nextMessage()).toMatchObject({ lParam: -1n });
+
+    PostMessageW(hWnd, WM_USER, 0, -(2n ** 63n));
+
+    expect(nextMessage()).toMatchObject({ lParam: -(2n ** 63n) });
+
+    const native = new MSG();
+
+    PostMessageW(hWnd, WM_USER, 0, -2);
+    GetMessageW(native, null, 0, 0);
+
+    expect(native.lParam).toBe(-2n);
+  });
+
+  test('pass LPARAM to the WndProc as a signed BigInt', () => {
+    const recording = createWindow(RECORDING_CLASS_NAME);
+
+    received.length = 0;
+
+    for (const lParam of [-1, -(2n ** 63n), 2n ** 63n - 1n]) {
+      PostMessageW(recording, WM_USER, 0, lParam);
+      DispatchMessageW(nextMessage());
+    }
+
+    expect(received).toEqual([-1n, -(2n ** 63n), 2n ** 63n - 1n]);
+
+    DestroyWindow(recording);
+  });
+
+  test('reject Numbers that are not safe integers', () => {
+    expect(() => PostMessageW(hWnd, WM_USER, 2 ** 53, 0)).toThrow(/safe integer Number at index 2/);
+    expect(() => PostMessageW(hWnd, WM_USER, 0, 0.5)).toThrow(/safe integer Number at index 3/);
+  });
+
+  test('reject BigInts that do not fit', () => {
+    expect(() => PostMessageW(hWnd, WM_USER, 2n ** 64n, 0)).toThrow(/too large/);
+    expect(() => PostMessageW(hWnd, WM_USER, -1n, 0)).toThrow(TypeError);
+  });
+});
+
+describe('SetWndProcNumericParams', () => {
+  test('applies to the LRESULT of every binding that returns one', () => {
+    PostMessageW(hWnd, WM_USER, 0, 0);
+
+    const msg = nextMessage();
+
+    expect(DefWindowProcW(hWnd, WM_USER, 0, 0)).toBe(0n);
+    expect(DispatchMessageW(msg)).toBe(0n);
+
+    expect(SetWndProcNumericParams(true)).toBe(false);
+
+    try {
+      expect(DefWindowProcW(hWnd, WM_USER, 0, 0)).toBe(0);
+      expect(DispatchMessageW(msg)).toBe(0);
+    } finally {
+      SetWndProcNumericParams(false);
+    }
+  });
+});
@@ -0,0 +1,120 @@
+import { GetModuleHandleW } from '@libwin/kernel32';
+import { describe, expect, test } from 'vitest';
+
+import { loadWin32Stub } from '../../common/win32-stub/index.js';
+
+import {
+  CW_USEDEFAULT,
+  CreateMenu,
+  CreateWindowExW,
+  DefWindowProcW,
+  DestroyMenu,
+  DestroyWindow,
+  GetOwnedHandleStats,
+  OwnMenu,
+  OwnWindow,
+  RegisterClassExW,
+  SetMenu,
+  WS_CHILD,
+  WS_OVERLAPPEDWINDOW,
+} from './index.js';
+
+const CLASS_NAME = 'LibwinOwnedHandleTest';
+
+RegisterClassExW({
+  cbSize: 80,
+  style: 0,
+  lpfnWndProc: DefWindowProcW,
+  cbClsExtra: 0,
+  cbWndExtra: 0,
+  hInstance: GetModuleHandleW(null),
+  lpszClassName: CLASS_NAME,
+});
+
+function createWindow(dwStyle = WS_OVERLAPPEDWINDOW, hWndParent: bigint | null = null): bigint {
+  return CreateWindowExW(
+    0,
+    CLASS_NAME,
+    'Test',
+    dwStyle,
+    CW_USEDEFAULT,
+    CW_USEDEFAULT,
+    500,
+    300,
+    hWndParent,
+    null,
+    null,
+    null,
+  );
+}
+
+function orphaned(type: string): number {
+  return GetOwnedHandleStats()[type]?.orphaned ?? 0;
+}
+
+describe('OwnedHandle', () => {
+  test('is rejected where another handle type is expected', () => {
+    const menu = OwnMenu(CreateMenu());
+    const window = OwnWindow(createWindow());
+
+    expect(() => DestroyWindow(menu)).toThrow(/^Owned HMENU is the wrong handle type at index 0$/);
+    expect(() => DestroyMenu(window)).toThrow(/^Owned HWND is the wrong handle type at index 0$/);
+    expect(() => SetMenu(window, window)).toThrow(/^Owned HWND is the wrong handle type at index 1$/);
+
+    // Neither was destroyed by the rejected calls.
+    expect(menu.value).not.toBe(0n);
+    expect(window.value).not.toBe(0n);
+
+    expect(window.dispose()).toBe(true);
+    expect(menu.dispose()).toBe(true);
+  });
+
+  test('is disposed by the matching Destroy function', () => {
+    const window = OwnWindow(createWindow());
+
+    expect(DestroyWindow(window)).toBe(true);
+    expect(window.value).toBe(0n);
+    expect(window.dispose()).toBe(false);
+  });
+
+  test('forgets a window destroyed through its raw handle', () => {
+    const before = orphaned('HWND');
+    const window = OwnWindow(createWindow());
+    const hWnd = window.value;
+
+    expect(DestroyWindow(hWnd)).toBe(true);
+    expect(window.value).toBe(0n);
+    expect(window.dispose()).toBe(false);
+    expect(orphaned('HWND')).toBe(before + 1);
+  });
+
+  test('forgets a child window destroyed along with its parent', () => {
+    const before = orphaned('HWND');
+    const parent = createWindow();
+    const child = OwnWindow(createWindow(WS_CHILD, parent));
+
+    expect(DestroyWindow(parent)).toBe(true);
+    expect(child.value).toBe(0n);
+    expect(orphaned('HWND')).toBe(before + 1);
+  });
+
+  // Counting menus needs the stub.
+  test.skipIf(process.platform === 'win32')('forgets a menu once a window takes it over', () => {
+    const stub = loadWin32Stub();
+    const before = orphaned('HMENU');
+    const menus = stub.getMenuCount();
+
+    const hWnd = createWindow();
+    const menu = OwnMenu(CreateMenu());
+
+    expect(SetMenu(hWnd, menu)).toBe(true);
+    expect(menu.value).toBe(0n);
+    expect(orphaned('HMENU')).toBe(before + 1);
+
+    // The window destroys the menu, and only once: disposing the owner afterwards does nothing.
+    expect(DestroyWindow(hWnd)).toBe(true);
+    expect(stub.getMenuCount()).toBe(menus);
+    expect(menu.dispose()).toBe(false);
+    expect(GetOwnedHandleStats().HMENU.failed).toBe(0);
+  });
+});
@@ -0,0 +1,46 @@
+/**
+ * A handle owned by a JS object, returned by OwnMenu and OwnWindow. The handle is destroyed with its matching
+ * function when `dispose()` is called, when a `using` declaration holding it goes out of scope, or, failing both, some
+ * time after the object is garbage collected. Owned handles can be passed to any user32 binding in place of a raw
+ * handle of the same type; passing one where another handle type is expected throws a TypeError.
+ *
+ * An owned window forgets its handle once the window receives WM_NCDESTROY, however it was destroyed, e.g. along with
+ * its parent, as long as its class was registered through RegisterClassExW. Windows of other classes are not tracked,
+ * so dispose or release their owner before destroying them any other way.
+ *
+ * A menu attached to a window, through CreateWindowExW or SetMenu, is destroyed together with that window, so its owner
+ * forgets it as soon as it is attached and never destroys it itself. Detaching it again with SetMenu(hWnd, null) leaves
+ * it unowned; pass it to OwnMenu again to have it destroyed.
+ */
+export type OwnedHandle = Disposable & {
+  /** The owned handle, 0n once it has been disposed, released or orphaned. */
+  readonly value: bigint;
+  /** Handle type, e.g. `"HMENU"`. */
+  readonly type: string;
+  /** Destroys the handle. Returns false if it was already disposed or released, or if destroying it failed. */
+  dispose(): boolean;
+  /** Gives up ownership without destroying the handle and returns it. */
+  release(): bigint;
+};
+
+export type OwnedHandleCounts = {
+  /** Handles currently owned, including collected ones still waiting to be destroyed. */
+  live: number;
+  created: number;
+  disposed: number;
+  /** Destroyed after their object was garbage collected without being disposed, i.e. leaked by the program. */
+  collected: number;
+  released: number;
+  /** Handles whose destroy function failed, usually because they had already been destroyed some other way. */
+  failed: number;
+  /**
+   * Handles destroyed, or handed over to be destroyed, by something other than their owner, which the owner then let go
+   * of without destroying: windows destroyed along with their parent, menus attached to a window.
+   */
+  orphaned: number;
+};
+
+/**
+ * Result of GetOwnedHandleStats, keyed by handle type. Only types that have been owned at least once are present.
+ */
+export type OwnedHandleStats = Record<string, OwnedHandleCounts>;
@@ -0,0 +1,139 @@
+import { GetModuleHandleW } from '@libwin/kernel32';
+import { afterAll, describe, expect, test } from 'vitest';
+
+import {
+  BeginPaint,
+  CreateWindowExW,
+  DefWindowProcW,
+  DestroyWindow,
+  EndPaint,
+  InvalidateRect,
+  InvalidateRgn,
+  PAINTSTRUCT,
+  RECT,
+  RegisterClassExW,
+  WS_OVERLAPPEDWINDOW,
+} from './index.js';
+
+const CLASS_NAME = 'LibwinPaintTest';
+
+const WIDTH = 500;
+const HEIGHT = 300;
+
+const EMPTY = { left: 0, top: 0, right: 0, bottom: 0 };
+
+RegisterClassExW({
+  cbSize: 80,
+  style: 0,
+  lpfnWndProc: DefWindowProcW,
+  cbClsExtra: 0,
+  cbWndExtra: 0,
+  hInstance: GetModuleHandleW(null),
+  lpszClassName: CLASS_NAME,
+});
+
+function paint(hWnd: bigint): RECT {
+  const ps = { hdc: 0n, fErase: false, rcPaint: { ...EMPTY }, fRestore: false, fIncUpdate: false };
+
+  expect(BeginPaint(hWnd, ps)).not.toBe(0n);
+  expect(EndPaint(hWnd, ps)).toBe(true);
+
+  return ps.rcPaint;
+}
+
+// The stub tracks the update region as its bounding rect, which is exactly what BeginPaint reports in rcPaint on
+// Windows too, so the merged rects can be checked without a real window manager.
+describe.skipIf(process.platform === 'win32')('BeginPaint', () => {
+  const hWnd = CreateWindowExW(
+    0,
+    CLASS_NAME,
+    'Paint',
+    WS_OVERLAPPEDWINDOW,
+    0,
+    0,
+    WIDTH,
+    HEIGHT,
+    null,
+    null,
+    null,
+    null,
+  );
+
+  afterAll(() => {
+    DestroyWindow(hWnd);
+  });
+
+  test('reports the bounding rect of every rect invalidated since the last paint', () => {
+    InvalidateRect(hWnd, { left: 10, top: 20, right: 30, bottom: 40 }, false);
+    InvalidateRect(hWnd, { left: 100, top: 5, right: 120, bottom: 25 }, false);
+
+    expect(paint(hWnd)).toEqual({ left: 10, top: 5, right: 120, bottom: 40 });
+
+    // Painting validates the window, so nothing is left for the next paint.
+    expect(paint(hWnd)).toEqual(EMPTY);
+  });
+
+  test('clips invalidated rects to the client area and ignores empty ones', () => {
+    InvalidateRect(hWnd, { left: -50, top: -50, right: 10, bottom: 10 }, false);
+    InvalidateRect(hWnd, { left: 490, top: 290, right: 600, bottom: 400 }, false);
+    InvalidateRect(hWnd, { left: 200, top: 200, right: 200, bottom: 250 }, false);
+
+    expect(paint(hWnd)).toEqual({ left: 0, top: 0, right: WIDTH, bottom: HEIGHT });
+
+    InvalidateRect(hWnd, { left: WIDTH, top: 0, right: WIDTH + 10, bottom: 10 }, false);
+
+    expect(paint(hWnd)).toEqual(EMPTY);
+  });
+
+  test('reports the whole client area after the whole window is invalidated', () => {
+    InvalidateRect(hWnd, null, false);
+
+    expect(paint(hWnd)).toEqual({ left: 0, top: 0, right: WIDTH, bottom: HEIGHT });
+
+    InvalidateRgn(hWnd, null, false);
+
+    expect(paint(hWnd)).toEqual({ left: 0, top: 0, right: WIDTH, bottom: HEIGHT });
+  });
+
+  test('merges a long stream of invalidations into one paint', () => {
+    const expected = { left: WIDTH, top: HEIGHT, right: 0, bottom: 0 };
+
+    // A fixed LCG, so a failure can be reproduced.
+    let seed = 1;
+    const next = (limit: number) => {
+      seed = (Math.imul(seed, 1103515245) + 12345) & 0x7fffffff;
+
+      return seed % limit;
+    };
+
+    for (let frame = 0; frame < 10; frame++) {
+      Object.assign(expected, { left: WIDTH, top: HEIGHT, right: 0, bottom: 0 });
+
+      // 1, 10, 100 and 1000 rects per paint, so the merged rect isn't always the same.
+      for (let i = 0; i < 10 ** (frame % 4); i++) {
+        const left = next(WIDTH / 2);
+        const top = next(HEIGHT / 2);
+        const rect = { left, top, right: left + 1 + next(50), bottom: top + 1 + next(30) };
+
+        InvalidateRect(hWnd, rect, false);
+
+        expected.left = Math.min(expected.left, rect.left);
+        expected.top = Math.min(expected.top, rect.top);
+        expected.right = Math.max(expected.right, rect.right);
+        expected.bottom = Math.max(expected.bottom, rect.bottom);
+      }
+
+      expect(paint(hWnd)).toEqual(expected);
+    }
+  });
+
+  test('fills a native PAINTSTRUCT in place', () => {
+    const ps = new PAINTSTRUCT();
+
+    InvalidateRect(hWnd, { left: 1, top: 2, right: 3, bottom: 4 }, false);
+
+    expect(BeginPaint(hWnd, ps)).toBe(ps.hdc);
+    expect(ps.rcPaint).toMatchObject({ left: 1, top: 2, right: 3, bottom: 4 });
+    expect(EndPaint(hWnd, ps)).toBe(true);
+  });
+});
@@ -0,0 +1,63 @@
+import { beforeEach, describe, expect, test } from 'vitest';
+
+import { loadWin32Stub } from '../../common/win32-stub/index.js';
+import { GetRawInputBuffer, RIM_TYPEHID, RIM_TYPEKEYBOARD, RIM_TYPEMOUSE, RawInputBuffer } from './index.js';
+
+const MOUSE = { usFlags: 0, ulButtons: 0, lLastX: 3, lLastY: -4, ulExtraInformation: 0 };
+const KEYBOARD = { MakeCode: 0x1e, Flags: 0, VKey: 0x41, Message: 0x100, ExtraInformation: 0 };
+
+// Raw input only comes from real devices on Windows, so this only runs against the stub, where tests queue it.
+describe.skipIf(process.platform === 'win32')('GetRawInputBuffer', () => {
+  const stub = process.platform === 'win32' ? undefined : loadWin32Stub();
+
+  beforeEach(() => {
+    while (GetRawInputBuffer(new RawInputBuffer(64).buffer) > 0) {
+      // Drops anything an earlier test left queued.
+    }
+  });
+
+  test('fills the last slot with a mouse or keyboard record', () => {
+    stub!.queueRawMouse(1n, MOUSE);
+    stub!.queueRawKeyboard(2n, KEYBOARD);
+
+    const rawInput = new RawInputBuffer(1);
+
+    expect(GetRawInputBuffer(rawInput.buffer)).toBe(1);
+    expect(rawInput.dwType[0]).toBe(RIM_TYPEMOUSE);
+    expect([rawInput.x[0], rawInput.y[0]]).toEqual([3, -4]);
+
+    expect(GetRawInputBuffer(rawInput.buffer)).toBe(1);
+    expect(rawInput.dwType[0]).toBe(RIM_TYPEKEYBOARD);
+    expect(rawInput.y[0]).toBe(0x41);
+
+    expect(GetRawInputBuffer(rawInput.buffer)).toBe(0);
+  });
+
+  test('drains until the buffer is full without overrunning it', () => {
+    for (let i = 0; i < 5; i++) {
+      stub!.queueRawKeyboard(BigInt(i), KEYBOARD);
+    }
+
+    const rawInput = new RawInputBuffer(3);
+
+    expect(GetRawInputBuffer(rawInput.buffer)).toBe(3);
+    expect(rawInput.hDevice).toEqual(new BigUint64Array([0n, 1n, 2n]));
+    expect(GetRawInputBuffer(rawInput.buffer)).toBe(2);
+  });
+
+  test('drains a HID record bigger than the slots that are left', () => {
+    // 8 reports of 64 bytes take more room than 3 slots of minimal records allow for.
+    stub!.queueRawHid(7n, 64, new Uint8Array(64 * 8));
+    stub!.queueRawKeyboard(8n, KEYBOARD);
+
+    const rawInput = new RawInputBuffer(3);
+
+    expect(GetRawInputBuffer(rawInput.buffer)).toBe(2);
+    expect(rawInput.hDevice.subarray(0, 2)).toEqual(new BigUint64Array([7n, 8n]));
+    expect(rawInput.dwType[0]).toBe(RIM_TYPEHID);
+    expect([rawInput.x[0], rawInput.y[0]]).toEqual([64, 8]);
+    expect(rawInput.dwType[1]).toBe(RIM_TYPEKEYBOARD);
+
+    expect(GetRawInputBuffer(rawInput.buffer)).toBe(0);
+  });
+});
@@ -0,0 +1,82 @@
+export const RIM_TYPEMOUSE = 0;
+export const RIM_TYPEKEYBOARD = 1;
+export const RIM_TYPEHID = 2;
+
+export const RIDEV_REMOVE = 0x00000001;
+export const RIDEV_EXCLUDE = 0x00000010;
+export const RIDEV_PAGEONLY = 0x00000020;
+export const RIDEV_NOLEGACY = 0x00000030;
+export const RIDEV_INPUTSINK = 0x00000100;
+export const RIDEV_CAPTUREMOUSE = 0x00000200;
+export const RIDEV_NOHOTKEYS = 0x00000200;
+export const RIDEV_APPKEYS = 0x00000400;
+export const RIDEV_EXINPUTSINK = 0x00001000;
+export const RIDEV_DEVNOTIFY = 0x00002000;
+
+export const HID_USAGE_PAGE_GENERIC = 0x01;
+export const HID_USAGE_GENERIC_MOUSE = 0x02;
+export const HID_USAGE_GENERIC_KEYBOARD = 0x06;
+
+/**
+ * Size of the x64 RAWINPUTDEVICE struct in bytes. Pass this as the cbSize argument of RegisterRawInputDevices.
+ */
+export const SIZEOF_RAWINPUTDEVICE = 16;
+
+export type RAWINPUTDEVICE = {
+  usUsagePage: number;
+  usUsage: number;
+  dwFlags: number;
+  hwndTarget?: bigint | null;
+};
+
+/**
+ * Number of bytes each drained record occupies in a RawInputBuffer.
+ */
+export const RAW_INPUT_RECORD_SIZE = 32;
+
+/**
+ * Fixed capacity, column oriented destination for GetRawInputBuffer.
+ *
+ * GetRawInputBuffer(rawInput.buffer) drains every pending RAWINPUT record into the columns below and returns how many
+ * were written; record `i` is then read as `rawInput.x[i]`, `rawInput.y[i]`, etc. Call it once per message pump
+ * iteration rather than once per WM_INPUT. HID records of any size are drained; only their sizes are copied.
+ *
+ * | Column  | RIM_TYPEMOUSE      | RIM_TYPEKEYBOARD | RIM_TYPEHID    |
+ * | ------- | ------------------ | ---------------- | -------------- |
+ * | hDevice | header.hDevice     | header.hDevice   | header.hDevice |
+ * | dwType  | RIM_TYPEMOUSE      | RIM_TYPEKEYBOARD | RIM_TYPEHID    |
+ * | x       | lLastX             | MakeCode         | dwSizeHid      |
+ * | y       | lLastY             | VKey             | dwCount        |
+ * | flags   | usFlags            | Flags            | 0              |
+ * | data    | ulButtons          | Message          | 0              |
+ * | extra   | ulExtraInformation | ExtraInformation | 0              |
+ *
+ * For mice, ulButtons holds usButtonFlags in the low word and usButtonData in the high word.
+ */
+export class RawInputBuffer {
+  readonly buffer: ArrayBuffer;
+  readonly capacity: number;
+
+  readonly hDevice: BigUint64Array;
+  readonly dwType: Uint32Array;
+  readonly x: Int32Array;
+  readonly y: Int32Array;
+  readonly flags: Uint32Array;
+  readonly data: Uint32Array;
+  readonly extra: Uint32Array;
+
+  constructor(capacity = 1024) {
+    this.capacity = capacity;
+    this.buffer = new ArrayBuffer(capacity * RAW_INPUT_RECORD_SIZE);
+
+    const column = capacity * 4;
+
+    this.hDevice = new BigUint64Array(this.buffer, 0, capacity);
+    this.dwType = new Uint32Array(this.buffer, capacity * 8, capacity);
+    this.x = new Int32Array(this.buffer, capacity * 8 + column, capacity);
+    this.y = new Int32Array(this.buffer, capacity * 8 + column * 2, capacity);
+    this.flags = new Uint32Array(this.buffer, capacity * 8 + column * 3, capacity);
+    this.data = new Uint32Array(this.buffer, capacity * 8 + column * 4, capacity);
+    this.extra = new Uint32Array(this.buffer, capacity * 8 + column * 5, capacity);
+  }
+}
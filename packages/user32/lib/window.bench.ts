@@ -0,0 +1,63 @@
+import { GetModuleHandleW } from '@libwin/kernel32';
+import { bench, describe } from 'vitest';
+
+import {
+  CW_USEDEFAULT,
+  CreateWindowExW,
+  DefWindowProcW,
+  DestroyWindow,
+  GetClientRect,
+  RECT,
+  RegisterClassExW,
+  WS_OVERLAPPEDWINDOW,
+} from './index.js';
+
+const CLASS_NAME = 'LibwinWindowBench';
+
+RegisterClassExW({
+  cbSize: 80,
+  style: 0,
+  lpfnWndProc: DefWindowProcW,
+  cbClsExtra: 0,
+  cbWndExtra: 0,
+  hInstance: GetModuleHandleW(null),
+  lpszClassName: CLASS_NAME,
+});
+
+function createWindow(): bigint {
+  return CreateWindowExW(
+    0,
+    CLASS_NAME,
+    'Bench',
+    WS_OVERLAPPEDWINDOW,
+    CW_USEDEFAULT,
+    CW_USEDEFAULT,
+    500,
+    300,
+    null,
+    null,
+    null,
+    null,
+  );
+}
+
+describe('CreateWindowExW', () => {
+  // Every window gets WM_NCCREATE, WM_CREATE, WM_DESTROY and WM_NCDESTROY through the JS window procedure.
+  bench('create and destroy', () => {
+    DestroyWindow(createWindow());
+  });
+});
+
+describe('GetClientRect', () => {
+  const hWnd = createWindow();
+  const plain = { left: 0, top: 0, right: 0, bottom: 0 };
+  const native = new RECT();
+
+  bench('plain object', () => {
+    GetClientRect(hWnd, plain);
+  });
+
+  bench('native RECT', () => {
+    GetClientRect(hWnd, native);
+  });
+});
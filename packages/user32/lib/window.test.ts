@@ -0,0 +1,80 @@
+import { GetModuleHandleW } from '@libwin/kernel32';
+import { describe, expect, test } from 'vitest';
+
+import {
+  CW_USEDEFAULT,
+  CreateWindowExW,
+  DefWindowProcW,
+  DestroyWindow,
+  GetWindowTextW,
+  MB_OK,
+  MessageBoxW,
+  RegisterClassExW,
+  WM_NCCREATE,
+  WS_OVERLAPPEDWINDOW,
+} from './index.js';
+
+const CLASS_NAME = 'LibwinWindowTest';
+
+// Set by a test to run something from inside the window procedure.
+let onNcCreate: (() => void) | undefined;
+
+function WndProc(hWnd: bigint, message: number, wParam: number | bigint, lParam: number | bigint): number | bigint {
+  if (message === WM_NCCREATE) {
+    onNcCreate?.();
+  }
+
+  return DefWindowProcW(hWnd, message, wParam, lParam);
+}
+
+RegisterClassExW({
+  cbSize: 80,
+  style: 0,
+  lpfnWndProc: WndProc,
+  cbClsExtra: 0,
+  cbWndExtra: 0,
+  hInstance: GetModuleHandleW(null),
+  lpszClassName: CLASS_NAME,
+});
+
+function createWindow(title: string): bigint {
+  return CreateWindowExW(
+    0,
+    CLASS_NAME,
+    title,
+    WS_OVERLAPPEDWINDOW,
+    CW_USEDEFAULT,
+    CW_USEDEFAULT,
+    500,
+    300,
+    null,
+    null,
+    null,
+    null,
+  );
+}
+
+function getWindowText(hWnd: bigint): string {
+  const text = { value: '' };
+
+  GetWindowTextW(hWnd, text, 1 << 20);
+
+  return text.value;
+}
+
+// Nests a message box in the window procedure, so this only runs against the stub, which closes it immediately.
+describe.skipIf(process.platform === 'win32')('CallArena', () => {
+  test('keeps the strings of a call alive while a nested call reads its own', () => {
+    const title = 'Window '.repeat(1024);
+
+    // The title is only read by DefWindowProcW, after the nested call had to grow the arena to fit its text.
+    onNcCreate = () => void MessageBoxW(0n, 'x'.repeat(1 << 18), 'Nested', MB_OK);
+
+    const hWnd = createWindow(title);
+
+    onNcCreate = undefined;
+
+    expect(getWindowText(hWnd)).toBe(title);
+    expect(DestroyWindow(hWnd)).toBe(true);
+  });
+});
@@ -0,0 +1,177 @@
+import { GetModuleHandleW } from '@libwin/kernel32';
+import { fileURLToPath } from 'node:url';
+import { Worker } from 'node:worker_threads';
+
+import { describe, expect, test } from 'vitest';
+
+import {
+  CreateWindowExW,
+  DefWindowProcW,
+  DestroyWindow,
+  DispatchMessageW,
+  GetMessageW,
+  PostMessageW,
+  RegisterClassExW,
+  WM_USER,
+  WS_OVERLAPPEDWINDOW,
+} from './index.js';
+
+const CLASS_NAME = 'LibwinWorkerTest';
+
+const WORKERS = 4;
+const MESSAGES = 100;
+
+type WorkerResult = { index: number; received: unknown[]; results: unknown[] };
+
+// Runs as a CommonJS worker. It loads its own copy of the addon, so the bindings run in the worker's env, then
+// registers a class of its own, creates a window of it and pumps the messages it posted to that window. The WndProc is
+// switched to numeric mode, so a WndProc that isn't this env's would see different types.
+const WORKER_SOURCE = `
+const { parentPort, workerData } = require('node:worker_threads');
+
+const { index, addon, className, messages, WM_USER, WS_OVERLAPPEDWINDOW } = workerData;
+
+const module = { exports: {} };
+process.dlopen(module, addon);
+
+const {
+  CreateWindowExW,
+  DefWindowProcW,
+  DestroyWindow,
+  DispatchMessageW,
+  GetMessageW,
+  PostMessageW,
+  RegisterClassExW,
+  SetWndProcNumericParams,
+} = module.exports;
+
+const received = [];
+
+SetWndProcNumericParams(true);
+
+RegisterClassExW({
+  cbSize: 80,
+  style: 0,
+  lpfnWndProc: (hWnd, message, wParam, lParam) => {
+    if (message === WM_USER) {
+      received.push(lParam);
+
+      return index * 1000 + lParam;
+    }
+
+    return DefWindowProcW(hWnd, message, wParam, lParam);
+  },
+  cbClsExtra: 0,
+  cbWndExtra: 0,
+  hInstance: 0n,
+  lpszClassName: className,
+});
+
+const hWnd = CreateWindowExW(0, className, className, WS_OVERLAPPEDWINDOW, 0, 0, 100, 100, null, null, null, null);
+const msg = { hwnd: 0n, message: 0, wParam: 0n, lParam: 0n, time: 0, pt: { x: 0, y: 0 } };
+const results = [];
+
+for (let i = 0; i < messages; i++) {
+  PostMessageW(hWnd, WM_USER, 0, i);
+}
+
+for (let i = 0; i < messages; i++) {
+  GetMessageW(msg, null, 0, 0);
+  results.push(DispatchMessageW(msg));
+}
+
+DestroyWindow(hWnd);
+
+parentPort.postMessage({ index, received, results });
+`;
+
+function runWorker(index: number): Promise<WorkerResult> {
+  const worker = new Worker(WORKER_SOURCE, {
+    eval: true,
+    workerData: {
+      index,
+      addon: fileURLToPath(new URL('../build/Release/user32.node', import.meta.url)),
+      className: `${CLASS_NAME}${index}`,
+      messages: MESSAGES,
+      WM_USER,
+      WS_OVERLAPPEDWINDOW,
+    },
+  });
+
+  return new Promise((resolve, reject) => {
+    worker.once('message', resolve);
+    worker.once('error', reject);
+    worker.once('exit', (code) => reject(new Error(`Worker ${index} exited with code ${code} before reporting`)));
+  });
+}
+
+const received: unknown[] = [];
+
+RegisterClassExW({
+  cbSize: 80,
+  style: 0,
+  lpfnWndProc: (hWnd: bigint, message: number, wParam: bigint, lParam: bigint) => {
+    if (message === WM_USER) {
+      received.push(lParam);
+
+      return -lParam;
+    }
+
+    return DefWindowProcW(hWnd, message, wParam, lParam);
+  },
+  cbClsExtra: 0,
+  cbWndExtra: 0,
+  hInstance: GetModuleHandleW(null),
+  lpszClassName: CLASS_NAME,
+});
+
+function pump(hWnd: bigint, lParam: number): unknown {
+  const msg = { hwnd: 0n, message: 0, wParam: 0n, lParam: 0n, time: 0, pt: { x: 0, y: 0 } };
+
+  PostMessageW(hWnd, WM_USER, 0, lParam);
+  GetMessageW(msg, null, 0, 0);
+
+  return DispatchMessageW(msg);
+}
+
+// Workers have their own env, so each one keeps its own WndProc and numeric mode, and a class registered in one never
+// replaces the WndProc of another. Off Windows every thread also gets its own message queue from the stub.
+describe.skipIf(process.platform === 'win32')('worker_threads', () => {
+  test('each env keeps its own WndProc and message state', async () => {
+    const hWnd = CreateWindowExW(
+      0,
+      CLASS_NAME,
+      'Main',
+      WS_OVERLAPPEDWINDOW,
+      0,
+      0,
+      100,
+      100,
+      null,
+      null,
+      null,
+      null,
+    );
+
+    received.length = 0;
+
+    expect(pump(hWnd, 1)).toBe(-1n);
+
+    const workers = await Promise.all(Array.from({ length: WORKERS }, (_, index) => runWorker(index)));
+
+    for (const { index, received: workerReceived, results } of workers) {
+      const expected = Array.from({ length: MESSAGES }, (_, i) => i);
+
+      // Numbers rather than BigInts: numeric mode was turned on in the worker's env only.
+      expect(workerReceived).toEqual(expected);
+      expect(results).toEqual(expected.map((i) => index * 1000 + i));
+    }
+
+    // The main env's WndProc is still the one it registered, still in BigInt mode, after every worker registered its
+    // own class and its env was torn down.
+    expect(pump(hWnd, 2)).toBe(-2n);
+    expect(received).toEqual([1n, 2n]);
+
+    DestroyWindow(hWnd);
+  });
+});
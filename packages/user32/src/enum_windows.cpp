@@ -0,0 +1,145 @@
+#include "user32.hpp"
+
+#include <cstring>
+#include <vector>
+
+// Class names are limited to 256 characters by RegisterClassEx.
+static constexpr int MAX_CLASS_NAME = 256;
+
+struct EnumWindowsContext {
+  std::pmr::vector<uint64_t> hWnds{&qb::CallArena::Current()};
+  std::optional<std::pmr::wstring> lpClassName;
+  std::optional<bool> visible;
+  std::optional<DWORD> dwProcessId;
+};
+
+static BOOL CALLBACK CollectWindow(HWND hWnd, LPARAM lParam) {
+  EnumWindowsContext *context = reinterpret_cast<EnumWindowsContext *>(lParam);
+
+  // Cheapest predicates first; the class name comparison is the only one that has to copy anything.
+  if (context->visible.has_value() && (::IsWindowVisible(hWnd) != FALSE) != context->visible.value()) {
+    return TRUE;
+  }
+
+  if (context->dwProcessId.has_value()) {
+    DWORD dwProcessId = 0;
+    ::GetWindowThreadProcessId(hWnd, &dwProcessId);
+
+    if (dwProcessId != context->dwProcessId.value()) {
+      return TRUE;
+    }
+  }
+
+  if (context->lpClassName.has_value()) {
+    wchar_t className[MAX_CLASS_NAME + 1];
+    const int length = ::GetClassNameW(hWnd, className, MAX_CLASS_NAME + 1);
+
+    // Class names are case-insensitive, the same as for RegisterClassExW and FindWindowW.
+    if (length != static_cast<int>(context->lpClassName->size()) ||
+        ::CompareStringOrdinal(className, length, context->lpClassName->data(), length, TRUE) != CSTR_EQUAL) {
+      return TRUE;
+    }
+  }
+
+  context->hWnds.push_back(reinterpret_cast<uintptr_t>(hWnd));
+
+  return TRUE;
+}
+
+static Napi::BigUint64Array ToBigUint64Array(const Napi::Env env, const std::pmr::vector<uint64_t> &values) {
+  Napi::BigUint64Array array = Napi::BigUint64Array::New(env, values.size(), napi_biguint64_array);
+
+  if (!values.empty()) {
+    std::memcpy(array.Data(), values.data(), values.size() * sizeof(uint64_t));
+  }
+
+  return array;
+}
+
+Napi::Value User32::EnumWindows(const Napi::CallbackInfo &info) {
+  const QB_ARG(filter, qb::ReadOptionalObject(info, 0));
+
+  EnumWindowsContext context{};
+
+  if (filter.has_value()) {
+    QB_ARG(lpClassName, qb::ReadOptionalWideString(filter.value(), "lpClassName"));
+    QB_ARG(visible, qb::ReadOptionalBoolean(filter.value(), "visible"));
+    QB_ARG(dwProcessId, qb::ReadOptionalUint32(filter.value(), "dwProcessId"));
+
+    context.lpClassName = std::move(lpClassName);
+    context.visible = visible;
+    context.dwProcessId = dwProcessId;
+  }
+
+  // Windows are collected natively and handed back in one typed array instead of calling into JS once per window.
+  ::EnumWindows(CollectWindow, reinterpret_cast<LPARAM>(&context));
+
+  return ToBigUint64Array(info.Env(), context.hWnds);
+}
+
+Napi::Value User32::EnumChildWindows(const Napi::CallbackInfo &info) {
+  const QB_ARG(hWndParent, qb::ReadOptionalHandle<HWND>(info, 0));
+  const QB_ARG(filter, qb::ReadOptionalObject(info, 1));
+
+  EnumWindowsContext context{};
+
+  if (filter.has_value()) {
+    QB_ARG(lpClassName, qb::ReadOptionalWideString(filter.value(), "lpClassName"));
+    QB_ARG(visible, qb::ReadOptionalBoolean(filter.value(), "visible"));
+    QB_ARG(dwProcessId, qb::ReadOptionalUint32(filter.value(), "dwProcessId"));
+
+    context.lpClassName = std::move(lpClassName);
+    context.visible = visible;
+    context.dwProcessId = dwProcessId;
+  }
+
+  ::EnumChildWindows(hWndParent ? hWndParent.value() : nullptr, CollectWindow, reinterpret_cast<LPARAM>(&context));
+
+  return ToBigUint64Array(info.Env(), context.hWnds);
+}
+
+Napi::Value User32::GetWindowDetails(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  if (!info[0].IsTypedArray() || info[0].As<Napi::TypedArray>().TypedArrayType() != napi_biguint64_array) {
+    qb::detail::ThrowTypeError(env, qb::detail::EXPECTED_BIGUINT64_ARRAY, qb::detail::Argument(0));
+    return env.Undefined();
+  }
+
+  const Napi::BigUint64Array hWnds = info[0].As<Napi::BigUint64Array>();
+  const size_t count = hWnds.ElementLength();
+
+  Napi::Array classNames = Napi::Array::New(env, count);
+  Napi::Array windowTexts = Napi::Array::New(env, count);
+  Napi::Int32Array rects = Napi::Int32Array::New(env, count * 4, napi_int32_array);
+
+  qb::TextBuffer &text = qb::TextBuffer::Current();
+
+  for (size_t i = 0; i < count; i++) {
+    const HWND hWnd = reinterpret_cast<HWND>(static_cast<uintptr_t>(hWnds[i]));
+
+    wchar_t className[MAX_CLASS_NAME + 1];
+    const int classNameLength = ::GetClassNameW(hWnd, className, MAX_CLASS_NAME + 1);
+
+    const int textLength = ::GetWindowTextLengthW(hWnd);
+    const int copied = textLength > 0 ? ::GetWindowTextW(hWnd, text.Reserve(textLength + 1), textLength + 1) : 0;
+
+    RECT rect{};
+    ::GetWindowRect(hWnd, &rect);
+
+    classNames.Set(static_cast<uint32_t>(i), qb::WideToString(env, className, classNameLength));
+    windowTexts.Set(static_cast<uint32_t>(i), text.ToString(env, copied));
+
+    rects[i * 4] = rect.left;
+    rects[i * 4 + 1] = rect.top;
+    rects[i * 4 + 2] = rect.right;
+    rects[i * 4 + 3] = rect.bottom;
+  }
+
+  Napi::Object details = Napi::Object::New(env);
+  details.Set("lpClassName", classNames);
+  details.Set("lpString", windowTexts);
+  details.Set("rect", rects);
+
+  return details;
+}
@@ -6,6 +6,12 @@ Napi::Value User32::GetClientRect(const Napi::CallbackInfo &info) {
   const QB_ARG(hWnd, qb::ReadRequiredHandle<HWND>(info, 0));
   const QB_ARG(lpRect, qb::ReadRequiredObject(info, 1));
 
+  if (RECT *native = qb::NativeStruct<RECT>::Unwrap(lpRect)) {
+    const BOOL error = GetClientRect(hWnd, native);
+
+    return Napi::Boolean::New(env, static_cast<bool>(error));
+  }
+
   auto rect = RECT{};
 
   const BOOL error = GetClientRect(hWnd, &rect);
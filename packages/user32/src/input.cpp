@@ -0,0 +1,28 @@
+#include "user32.hpp"
+
+static constexpr std::string_view INPUT_BUFFER_TOO_SMALL = "Buffer is too small to hold cInputs INPUT records ";
+
+Napi::Value User32::SendInput(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  // The INPUT records are packed by the caller (see lib/input.ts) so that thousands of events can be submitted with a
+  // single call and without creating a JS object per event.
+  const auto [cInputs, pInputs, cbSize] = QB_ARGS(
+      qb::ReadRequiredUint32(info, 0), qb::ReadRequiredSpan<uint8_t>(info, 1), qb::ReadRequiredInt32(info, 2));
+
+  // Read as bytes so the length can be checked against cbSize, which means the reader can't check the alignment.
+  if (reinterpret_cast<uintptr_t>(pInputs.data()) % alignof(INPUT) != 0) {
+    qb::detail::ThrowTypeError(env, qb::detail::BUFFER_MISALIGNED, qb::detail::Argument(1));
+    return env.Undefined();
+  }
+
+  if (cbSize > 0 && static_cast<uint64_t>(cInputs) * static_cast<uint64_t>(cbSize) > pInputs.size()) {
+    qb::detail::ThrowRangeError(env, INPUT_BUFFER_TOO_SMALL, qb::detail::Argument(1));
+    return env.Undefined();
+  }
+
+  // SendInput validates cbSize against sizeof(INPUT) itself and fails with ERROR_INVALID_PARAMETER on a mismatch.
+  const UINT result = ::SendInput(cInputs, reinterpret_cast<LPINPUT>(pInputs.data()), cbSize);
+
+  return Napi::Number::New(env, result);
+}
@@ -1,10 +1,12 @@
 #include "user32.hpp"
 
+#include <algorithm>
+
 Napi::Value User32::AppendMenuA(const Napi::CallbackInfo &info) {
   const QB_ARG(hMenu, qb::ReadRequiredHandle<HMENU>(info, 0));
   const QB_ARG(uFlags, qb::ReadRequiredUint32(info, 1));
   const QB_ARG(uIDNewItem, qb::ReadRequiredUint32(info, 2));
-  const QB_ARG(lpNewItem, qb::ReadOptionalString(info, 3));
+  const QB_ARG(lpNewItem, qb::ReadOptionalAnsiString(info, 3));
 
   const BOOL result = ::AppendMenuA(hMenu, uFlags, uIDNewItem, lpNewItem.has_value() ? lpNewItem->c_str() : nullptr);
 
@@ -45,6 +47,11 @@ Napi::Value User32::DeleteMenu(const Napi::CallbackInfo &info) {};
 Napi::Value User32::DestroyMenu(const Napi::CallbackInfo &info) {
   const QB_ARG(hMenu, qb::ReadRequiredHandle<HMENU>(info, 0));
 
+  // An owned menu is disposed instead, so its object doesn't destroy the handle a second time.
+  if (const std::optional<BOOL> disposed = qb::OwnedHandle::Dispose<HMENU>(info[0])) {
+    return Napi::Boolean::New(info.Env(), disposed.value());
+  }
+
   const BOOL result = ::DestroyMenu(hMenu);
 
   return Napi::Boolean::New(info.Env(), result);
@@ -90,7 +97,30 @@ Napi::Value User32::GetMenuState(const Napi::CallbackInfo &info) {};
 
 Napi::Value User32::GetMenuStringA(const Napi::CallbackInfo &info) {};
 
-Napi::Value User32::GetMenuStringW(const Napi::CallbackInfo &info) {};
+Napi::Value User32::GetMenuStringW(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const auto [hMenu, uIDItem, lpString, cchMax, flags] = QB_ARGS(qb::ReadRequiredHandle<HMENU>(info, 0),
+                                                                 qb::ReadRequiredUint32(info, 1),
+                                                                 qb::ReadOptionalObject(info, 2),
+                                                                 qb::ReadRequiredInt32(info, 3),
+                                                                 qb::ReadRequiredUint32(info, 4));
+
+  // Without a buffer the call only reports the length of the item's text.
+  if (!lpString.has_value()) {
+    const int result = ::GetMenuStringW(hMenu, uIDItem, nullptr, 0, flags);
+
+    return Napi::Number::New(env, result);
+  }
+
+  qb::TextBuffer &buffer = qb::TextBuffer::Current();
+
+  const int result = ::GetMenuStringW(hMenu, uIDItem, buffer.Reserve(std::max(cchMax, 1)), cchMax, flags);
+
+  lpString->Set("value", buffer.ToString(env, result));
+
+  return Napi::Number::New(env, result);
+};
 
 Napi::Value User32::GetSubMenu(const Napi::CallbackInfo &info) {};
 
@@ -136,6 +166,11 @@ Napi::Value User32::SetMenu(const Napi::CallbackInfo &info) {
 
   const BOOL result = ::SetMenu(hWnd, hMenu.has_value() ? hMenu.value() : nullptr);
 
+  // The window now destroys the menu along with itself, so an owner of the menu must not destroy it a second time.
+  if (result && hMenu.has_value() && hMenu.value() != nullptr) {
+    qb::OwnedHandle::Orphan(hMenu.value());
+  }
+
   return Napi::Boolean::New(info.Env(), result);
 };
 
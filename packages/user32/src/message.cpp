@@ -1,5 +1,16 @@
 #include "user32.hpp"
 
+Napi::Value User32::PostMessageW(const Napi::CallbackInfo &info) {
+  const auto [hWnd, Msg, wParam, lParam] = QB_ARGS(qb::ReadOptionalHandle<HWND>(info, 0),
+                                                   qb::ReadRequiredUint32(info, 1),
+                                                   qb::ReadRequiredUintPtr(info, 2),
+                                                   qb::ReadRequiredIntPtr(info, 3));
+
+  const BOOL result = ::PostMessageW(hWnd ? hWnd.value() : nullptr, Msg, wParam, lParam);
+
+  return Napi::Boolean::New(info.Env(), result);
+}
+
 Napi::Value User32::PostQuitMessage(const Napi::CallbackInfo &info) {
   const QB_ARG(nExitCode, qb::ReadRequiredInt32(info, 0));
 
@@ -1,10 +1,15 @@
 #include "user32.hpp"
 
-static thread_local std::unique_ptr<CallbackHandler<Napi::Value>> msgBoxCallbackHandler = nullptr;
+// Owned by the env that showed the message box; MsgBoxThunk finds it through qb::InstanceData::Find.
+struct MessageBoxState {
+  std::unique_ptr<CallbackHandler<Napi::Value>> msgBoxCallback;
+};
 
 static void CALLBACK MsgBoxThunk(const LPHELPINFO lpHelpInfo) {
-  if (msgBoxCallbackHandler) {
-    Napi::Env env = msgBoxCallbackHandler->GetEnv();
+  const MessageBoxState *state = qb::InstanceData::Find<MessageBoxState>();
+
+  if (state != nullptr && state->msgBoxCallback) {
+    Napi::Env env = state->msgBoxCallback->GetEnv();
 
     Napi::Object point = Napi::Object::New(env);
     point.Set("x", Napi::Number::New(env, lpHelpInfo->MousePos.x));
@@ -17,7 +22,7 @@ static void CALLBACK MsgBoxThunk(const LPHELPINFO lpHelpInfo) {
     obj.Set("hItemHandle", Napi::BigInt::New(env, reinterpret_cast<uintptr_t>(lpHelpInfo->hItemHandle)));
     obj.Set("MousePos", point);
 
-    msgBoxCallbackHandler->Invoke(obj);
+    state->msgBoxCallback->Invoke(obj);
   }
 }
 
@@ -34,8 +39,8 @@ Napi::Value User32::MessageBoxW(const Napi::CallbackInfo &info) {
 
 Napi::Value User32::MessageBoxA(const Napi::CallbackInfo &info) {
   const QB_ARG(hWnd, qb::ReadRequiredHandle<HWND>(info, 0));
-  const QB_ARG(lpText, qb::ReadRequiredString(info, 1));
-  const QB_ARG(lpCaption, qb::ReadRequiredString(info, 2));
+  const QB_ARG(lpText, qb::ReadRequiredAnsiString(info, 1));
+  const QB_ARG(lpCaption, qb::ReadRequiredAnsiString(info, 2));
   const QB_ARG(uType, qb::ReadRequiredUint32(info, 3));
 
   const int result = ::MessageBoxA(hWnd, lpText.c_str(), lpCaption.c_str(), uType);
@@ -48,7 +53,7 @@ Napi::Value User32::MessageBoxExW(const Napi::CallbackInfo &info) {
   const QB_ARG(lpText, qb::ReadRequiredWideString(info, 1));
   const QB_ARG(lpCaption, qb::ReadRequiredWideString(info, 2));
   const QB_ARG(uType, qb::ReadRequiredUint32(info, 3));
-  const QB_ARG(wLanguageId, qb::ReadRequiredUint16(info, 4));
+  const QB_ARG(wLanguageId, qb::ReadRequiredUint16<qb::Narrowing::Checked>(info, 4));
 
   const int result = ::MessageBoxExW(hWnd, lpText.c_str(), lpCaption.c_str(), uType, wLanguageId);
 
@@ -57,10 +62,10 @@ Napi::Value User32::MessageBoxExW(const Napi::CallbackInfo &info) {
 
 Napi::Value User32::MessageBoxExA(const Napi::CallbackInfo &info) {
   const QB_ARG(hWnd, qb::ReadRequiredHandle<HWND>(info, 0));
-  const QB_ARG(lpText, qb::ReadRequiredString(info, 1));
-  const QB_ARG(lpCaption, qb::ReadRequiredString(info, 2));
+  const QB_ARG(lpText, qb::ReadRequiredAnsiString(info, 1));
+  const QB_ARG(lpCaption, qb::ReadRequiredAnsiString(info, 2));
   const QB_ARG(uType, qb::ReadRequiredUint32(info, 3));
-  const QB_ARG(wLanguageId, qb::ReadRequiredUint16(info, 4));
+  const QB_ARG(wLanguageId, qb::ReadRequiredUint16<qb::Narrowing::Checked>(info, 4));
 
   const int result = ::MessageBoxExA(hWnd, lpText.c_str(), lpCaption.c_str(), uType, wLanguageId);
 
@@ -96,7 +101,8 @@ Napi::Value User32::MessageBoxIndirectW(const Napi::CallbackInfo &info) {
   QB_SET(msgBoxParams, dwLanguageId, dwLanguageId.value());
 
   if (lpfnMsgBoxCallback.has_value()) {
-    msgBoxCallbackHandler = std::make_unique<CallbackHandler<Napi::Value>>(lpfnMsgBoxCallback.value());
+    qb::InstanceData::Get<MessageBoxState>(env).msgBoxCallback =
+        std::make_unique<CallbackHandler<Napi::Value>>(lpfnMsgBoxCallback.value());
 
     msgBoxParams.lpfnMsgBoxCallback = MsgBoxThunk;
   }
@@ -114,10 +120,10 @@ Napi::Value User32::MessageBoxIndirectA(const Napi::CallbackInfo &info) {
   const QB_ARG(cbSize, qb::ReadRequiredUint32(params, "cbSize"));
   const QB_ARG(hwndOwner, qb::ReadOptionalUint64(params, "hwndOwner"));
   const QB_ARG(hInstance, qb::ReadOptionalUint64(params, "hInstance"));
-  const QB_ARG(lpszText, qb::ReadRequiredString(params, "lpszText"));
-  const QB_ARG(lpszCaption, qb::ReadOptionalString(params, "lpszCaption"));
+  const QB_ARG(lpszText, qb::ReadRequiredAnsiString(params, "lpszText"));
+  const QB_ARG(lpszCaption, qb::ReadOptionalAnsiString(params, "lpszCaption"));
   const QB_ARG(dwStyle, qb::ReadRequiredUint32(params, "dwStyle"));
-  const QB_ARG(lpszIcon, qb::ReadOptionalString(params, "lpszIcon"));
+  const QB_ARG(lpszIcon, qb::ReadOptionalAnsiString(params, "lpszIcon"));
   const QB_ARG(dwContextHelpId, qb::ReadOptionalUint64(params, "dwContextHelpId"));
   const QB_ARG(lpfnMsgBoxCallback, qb::ReadOptionalFunction(params, "lpfnMsgBoxCallback"));
   const QB_ARG(dwLanguageId, qb::ReadOptionalInt32(params, "dwLanguageId"));
@@ -135,7 +141,8 @@ Napi::Value User32::MessageBoxIndirectA(const Napi::CallbackInfo &info) {
   QB_SET(msgBoxParams, dwLanguageId, dwLanguageId.value());
 
   if (lpfnMsgBoxCallback.has_value()) {
-    msgBoxCallbackHandler = std::make_unique<CallbackHandler<Napi::Value>>(lpfnMsgBoxCallback.value());
+    qb::InstanceData::Get<MessageBoxState>(env).msgBoxCallback =
+        std::make_unique<CallbackHandler<Napi::Value>>(lpfnMsgBoxCallback.value());
     msgBoxParams.lpfnMsgBoxCallback = MsgBoxThunk;
   }
 
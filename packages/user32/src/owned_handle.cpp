@@ -0,0 +1,17 @@
+#include "user32.hpp"
+
+Napi::Value User32::OwnMenu(const Napi::CallbackInfo &info) {
+  const QB_ARG(hMenu, qb::ReadRequiredHandle<HMENU>(info, 0));
+
+  return qb::OwnedHandle::New(info.Env(), hMenu);
+}
+
+Napi::Value User32::OwnWindow(const Napi::CallbackInfo &info) {
+  const QB_ARG(hWnd, qb::ReadRequiredHandle<HWND>(info, 0));
+
+  return qb::OwnedHandle::New(info.Env(), hWnd);
+}
+
+Napi::Value User32::GetOwnedHandleStats(const Napi::CallbackInfo &info) {
+  return qb::OwnedHandle::GetStats(info.Env());
+}
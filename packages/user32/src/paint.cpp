@@ -0,0 +1,104 @@
+#include "user32.hpp"
+
+Napi::Value User32::BeginPaint(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(hWnd, qb::ReadRequiredHandle<HWND>(info, 0));
+  const QB_ARG(lpPaint, qb::ReadRequiredObject(info, 1));
+
+  if (PAINTSTRUCT *native = qb::NativeStruct<PAINTSTRUCT>::Unwrap(lpPaint)) {
+    const HDC hdc = ::BeginPaint(hWnd, native);
+
+    return qb::HandleToBigInt(info, hdc);
+  }
+
+  PAINTSTRUCT ps{};
+
+  const HDC hdc = ::BeginPaint(hWnd, &ps);
+
+  // rcPaint is the bounding box of the window's update region, i.e. every InvalidateRect/InvalidateRgn call since the
+  // last paint already merged together by the window manager. Painting only within it is what keeps repaints partial.
+  Napi::Object rcPaint = Napi::Object::New(env);
+  rcPaint.Set("left", Napi::Number::New(env, ps.rcPaint.left));
+  rcPaint.Set("top", Napi::Number::New(env, ps.rcPaint.top));
+  rcPaint.Set("right", Napi::Number::New(env, ps.rcPaint.right));
+  rcPaint.Set("bottom", Napi::Number::New(env, ps.rcPaint.bottom));
+
+  lpPaint.Set("hdc", qb::HandleToBigInt(info, ps.hdc));
+  lpPaint.Set("fErase", Napi::Boolean::New(env, ps.fErase));
+  lpPaint.Set("rcPaint", rcPaint);
+  lpPaint.Set("fRestore", Napi::Boolean::New(env, ps.fRestore));
+  lpPaint.Set("fIncUpdate", Napi::Boolean::New(env, ps.fIncUpdate));
+
+  return qb::HandleToBigInt(info, hdc);
+}
+
+Napi::Value User32::EndPaint(const Napi::CallbackInfo &info) {
+  const QB_ARG(hWnd, qb::ReadRequiredHandle<HWND>(info, 0));
+  const QB_ARG(lpPaint, qb::ReadRequiredObject(info, 1));
+
+  if (const PAINTSTRUCT *native = qb::NativeStruct<PAINTSTRUCT>::Unwrap(lpPaint)) {
+    const BOOL result = ::EndPaint(hWnd, native);
+
+    return Napi::Boolean::New(info.Env(), result);
+  }
+
+  const QB_ARG(hdc, qb::ReadRequiredHandle<HDC>(lpPaint, "hdc"));
+  const QB_ARG(fErase, qb::ReadOptionalBoolean(lpPaint, "fErase"));
+  const QB_ARG(rcPaint, qb::ReadRequiredObject(lpPaint, "rcPaint"));
+
+  const QB_ARG(left, qb::ReadRequiredInt32(rcPaint, "left"));
+  const QB_ARG(top, qb::ReadRequiredInt32(rcPaint, "top"));
+  const QB_ARG(right, qb::ReadRequiredInt32(rcPaint, "right"));
+  const QB_ARG(bottom, qb::ReadRequiredInt32(rcPaint, "bottom"));
+
+  PAINTSTRUCT ps{};
+
+  ps.hdc = hdc;
+  ps.rcPaint = {left, top, right, bottom};
+  QB_SET(ps, fErase, fErase.value())
+
+  const BOOL result = ::EndPaint(hWnd, &ps);
+
+  return Napi::Boolean::New(info.Env(), result);
+}
+
+Napi::Value User32::InvalidateRect(const Napi::CallbackInfo &info) {
+  const QB_ARG(hWnd, qb::ReadOptionalHandle<HWND>(info, 0));
+  const QB_ARG(lpRect, qb::ReadOptionalObject(info, 1));
+  const QB_ARG(bErase, qb::ReadRequiredBoolean(info, 2));
+
+  // A null rect invalidates the entire client area, anything else only adds that rect to the update region.
+  if (!lpRect.has_value()) {
+    const BOOL result = ::InvalidateRect(hWnd ? hWnd.value() : nullptr, nullptr, bErase);
+
+    return Napi::Boolean::New(info.Env(), result);
+  }
+
+  if (const RECT *native = qb::NativeStruct<RECT>::Unwrap(lpRect.value())) {
+    const BOOL result = ::InvalidateRect(hWnd ? hWnd.value() : nullptr, native, bErase);
+
+    return Napi::Boolean::New(info.Env(), result);
+  }
+
+  const QB_ARG(left, qb::ReadRequiredInt32(lpRect.value(), "left"));
+  const QB_ARG(top, qb::ReadRequiredInt32(lpRect.value(), "top"));
+  const QB_ARG(right, qb::ReadRequiredInt32(lpRect.value(), "right"));
+  const QB_ARG(bottom, qb::ReadRequiredInt32(lpRect.value(), "bottom"));
+
+  const RECT rect{left, top, right, bottom};
+
+  const BOOL result = ::InvalidateRect(hWnd ? hWnd.value() : nullptr, &rect, bErase);
+
+  return Napi::Boolean::New(info.Env(), result);
+}
+
+Napi::Value User32::InvalidateRgn(const Napi::CallbackInfo &info) {
+  const QB_ARG(hWnd, qb::ReadRequiredHandle<HWND>(info, 0));
+  const QB_ARG(hRgn, qb::ReadOptionalHandle<HRGN>(info, 1));
+  const QB_ARG(bErase, qb::ReadRequiredBoolean(info, 2));
+
+  const BOOL result = ::InvalidateRgn(hWnd, hRgn ? hRgn.value() : nullptr, bErase);
+
+  return Napi::Boolean::New(info.Env(), result);
+}
@@ -0,0 +1,156 @@
+#include "user32.hpp"
+
+#include <algorithm>
+#include <vector>
+
+static constexpr std::string_view TOO_FEW_DEVICES = "Array has fewer than uiNumDevices elements ";
+
+// Each drained record is stored as one element in each of these columns (see lib/raw-input.ts), so a buffer of N
+// records is laid out as hDevice[N] (u64), dwType[N], x[N], y[N], flags[N], data[N], extra[N] (all 32-bit).
+static constexpr size_t RAW_INPUT_RECORD_SIZE = sizeof(uint64_t) + 6 * sizeof(uint32_t);
+
+// The smallest record GetRawInputBuffer can return. Sizing the native buffer by it guarantees that a single drain
+// never returns more records than the caller's buffer has room for.
+static constexpr size_t MIN_RAW_INPUT_SIZE = sizeof(RAWINPUTHEADER) + offsetof(RAWHID, bRawData);
+
+// The largest mouse or keyboard record. A buffer sized by MIN_RAW_INPUT_SIZE alone can't hold one when a single slot is
+// left, so the last slot is sized by this instead. It is less than one more minimal record over, so a drain still never
+// returns more records than there are slots.
+static constexpr size_t MAX_FIXED_RAW_INPUT_SIZE =
+    sizeof(RAWINPUTHEADER) + std::max(sizeof(RAWMOUSE), sizeof(RAWKEYBOARD));
+
+static_assert(MAX_FIXED_RAW_INPUT_SIZE - MIN_RAW_INPUT_SIZE < MIN_RAW_INPUT_SIZE);
+
+// Bytes to hand GetRawInputBuffer for at most `slots` records, at least one of them.
+static constexpr size_t RawInputSizeFor(const size_t slots) {
+  return (slots - 1) * MIN_RAW_INPUT_SIZE + MAX_FIXED_RAW_INPUT_SIZE;
+}
+
+static thread_local std::vector<uint64_t> rawInputScratch;
+
+// Grows the scratch buffer to at least `size` bytes and returns it.
+static PRAWINPUT RawInputScratch(const size_t size) {
+  if (rawInputScratch.size() * sizeof(uint64_t) < size) {
+    rawInputScratch.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+  }
+
+  return reinterpret_cast<PRAWINPUT>(rawInputScratch.data());
+}
+
+Napi::Value User32::RegisterRawInputDevices(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(uiNumDevices, qb::ReadRequiredUint32(info, 1));
+  const QB_ARG(cbSize, qb::ReadRequiredUint32(info, 2));
+
+  if (!info[0].IsArray()) {
+    qb::detail::ThrowTypeError(env, qb::detail::EXPECTED_ARRAY, qb::detail::Argument(0));
+    return env.Undefined();
+  }
+
+  const Napi::Array pRawInputDevices = info[0].As<Napi::Array>();
+
+  if (pRawInputDevices.Length() < uiNumDevices) {
+    qb::detail::ThrowTypeError(env, TOO_FEW_DEVICES, qb::detail::Argument(0));
+    return env.Undefined();
+  }
+
+  std::pmr::vector<RAWINPUTDEVICE> devices(uiNumDevices, &qb::CallArena::Current());
+
+  for (uint32_t i = 0; i < uiNumDevices; i++) {
+    const QB_ARG(device, qb::ReadRequiredObject(pRawInputDevices, std::to_string(i)));
+
+    const QB_ARG(usUsagePage, qb::ReadRequiredUint16<qb::Narrowing::Checked>(device, "usUsagePage"));
+    const QB_ARG(usUsage, qb::ReadRequiredUint16<qb::Narrowing::Checked>(device, "usUsage"));
+    const QB_ARG(dwFlags, qb::ReadRequiredUint32(device, "dwFlags"));
+    const QB_ARG(hwndTarget, qb::ReadOptionalHandle<HWND>(device, "hwndTarget"));
+
+    devices[i] = {usUsagePage, usUsage, dwFlags, hwndTarget ? hwndTarget.value() : nullptr};
+  }
+
+  const BOOL result = ::RegisterRawInputDevices(devices.data(), uiNumDevices, cbSize);
+
+  return Napi::Boolean::New(env, result);
+}
+
+Napi::Value User32::GetRawInputBuffer(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  // Viewed as u64 so the hDevice column at the start of the buffer is guaranteed to be 8 byte aligned.
+  const QB_ARG(buffer, qb::ReadRequiredSpan<uint64_t>(info, 0));
+
+  const size_t capacity = buffer.size_bytes() / RAW_INPUT_RECORD_SIZE;
+
+  uint8_t *base = reinterpret_cast<uint8_t *>(buffer.data());
+  uint64_t *hDevice = reinterpret_cast<uint64_t *>(base);
+  uint32_t *dwType = reinterpret_cast<uint32_t *>(base + capacity * sizeof(uint64_t));
+  int32_t *x = reinterpret_cast<int32_t *>(dwType + capacity);
+  int32_t *y = x + capacity;
+  uint32_t *flags = reinterpret_cast<uint32_t *>(y + capacity);
+  uint32_t *data = flags + capacity;
+  uint32_t *extra = data + capacity;
+
+  if (capacity == 0) {
+    return Napi::Number::New(env, 0);
+  }
+
+  size_t count = 0;
+
+  // Keep draining until the queue is empty or the caller's buffer is full, so one call per message pump iteration is
+  // enough no matter how fast the device reports.
+  while (count < capacity) {
+    UINT cbSize = static_cast<UINT>(RawInputSizeFor(capacity - count));
+
+    PRAWINPUT raw = RawInputScratch(cbSize);
+
+    UINT records = ::GetRawInputBuffer(raw, &cbSize, sizeof(RAWINPUTHEADER));
+
+    // The next record is a HID report too big for the slots that are left. It would stay at the head of the queue
+    // forever, so ask how big it is and drain it on its own; a buffer of exactly that size has no room for another.
+    if (records == static_cast<UINT>(-1) && ::GetLastError() == ERROR_INSUFFICIENT_BUFFER) {
+      cbSize = 0;
+
+      if (::GetRawInputBuffer(nullptr, &cbSize, sizeof(RAWINPUTHEADER)) != 0 || cbSize == 0) {
+        break;
+      }
+
+      raw = RawInputScratch(cbSize);
+      records = ::GetRawInputBuffer(raw, &cbSize, sizeof(RAWINPUTHEADER));
+    }
+
+    if (records == 0 || records == static_cast<UINT>(-1)) {
+      break;
+    }
+
+    for (UINT i = 0; i < records; i++, count++, raw = NEXTRAWINPUTBLOCK(raw)) {
+      hDevice[count] = reinterpret_cast<uintptr_t>(raw->header.hDevice);
+      dwType[count] = raw->header.dwType;
+
+      switch (raw->header.dwType) {
+      case RIM_TYPEMOUSE:
+        x[count] = raw->data.mouse.lLastX;
+        y[count] = raw->data.mouse.lLastY;
+        flags[count] = raw->data.mouse.usFlags;
+        data[count] = raw->data.mouse.ulButtons;
+        extra[count] = raw->data.mouse.ulExtraInformation;
+        break;
+      case RIM_TYPEKEYBOARD:
+        x[count] = raw->data.keyboard.MakeCode;
+        y[count] = raw->data.keyboard.VKey;
+        flags[count] = raw->data.keyboard.Flags;
+        data[count] = raw->data.keyboard.Message;
+        extra[count] = raw->data.keyboard.ExtraInformation;
+        break;
+      default:
+        x[count] = static_cast<int32_t>(raw->data.hid.dwSizeHid);
+        y[count] = static_cast<int32_t>(raw->data.hid.dwCount);
+        flags[count] = 0;
+        data[count] = 0;
+        extra[count] = 0;
+        break;
+      }
+    }
+  }
+
+  return Napi::Number::New(env, static_cast<double>(count));
+}
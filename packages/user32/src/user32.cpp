@@ -1,30 +1,66 @@
 #include "user32.hpp"
 
-Napi::Object Initialize(const Napi::Env env, Napi::Object exports) {
-  QB_EXPORT(User32::GetClientRect);
-  QB_EXPORT(User32::MessageBoxW);
-  QB_EXPORT(User32::MessageBoxA);
-  QB_EXPORT(User32::MessageBoxExW);
-  QB_EXPORT(User32::MessageBoxExA);
-  QB_EXPORT(User32::MessageBoxIndirectW);
-  QB_EXPORT(User32::MessageBoxIndirectA);
-  QB_EXPORT(User32::CreateMenu);
-  QB_EXPORT(User32::DestroyMenu);
-  QB_EXPORT(User32::GetMenu);
-  QB_EXPORT(User32::AppendMenuA);
-  QB_EXPORT(User32::AppendMenuW);
-  QB_EXPORT(User32::SetMenu);
-  QB_EXPORT(User32::CreateWindowExW);
-  QB_EXPORT(User32::RegisterClassExW);
-  QB_EXPORT(User32::GetMessageW);
-  QB_EXPORT(User32::TranslateMessage);
-  QB_EXPORT(User32::DispatchMessageW);
-  QB_EXPORT(User32::ShowWindow);
-  QB_EXPORT(User32::UpdateWindow);
-  QB_EXPORT(User32::DefWindowProcW);
-  QB_EXPORT(User32::PostQuitMessage);
+Napi::Object User32::Initialize(const Napi::Env env, Napi::Object exports) {
+  static constexpr qb::Export EXPORTS[] = {
+      QB_EXPORT(User32::GetClientRect),
+      QB_EXPORT(User32::MessageBoxW),
+      QB_EXPORT(User32::MessageBoxA),
+      QB_EXPORT(User32::MessageBoxExW),
+      QB_EXPORT(User32::MessageBoxExA),
+      QB_EXPORT(User32::MessageBoxIndirectW),
+      QB_EXPORT(User32::MessageBoxIndirectA),
+      QB_EXPORT(User32::CreateMenu),
+      QB_EXPORT(User32::DestroyMenu),
+      QB_EXPORT(User32::GetMenu),
+      QB_EXPORT(User32::AppendMenuA),
+      QB_EXPORT(User32::AppendMenuW),
+      QB_EXPORT(User32::SetMenu),
+      QB_EXPORT(User32::GetMenuStringW),
+      QB_EXPORT(User32::CreateWindowExW),
+      QB_EXPORT(User32::DestroyWindow),
+      QB_EXPORT(User32::RegisterClassExW),
+      QB_EXPORT(User32::GetMessageW),
+      QB_EXPORT(User32::TranslateMessage),
+      QB_EXPORT(User32::DispatchMessageW),
+      QB_EXPORT(User32::ShowWindow),
+      QB_EXPORT(User32::UpdateWindow),
+      QB_EXPORT(User32::GetClassNameW),
+      QB_EXPORT(User32::GetWindowTextW),
+      QB_EXPORT(User32::DefWindowProcW),
+      QB_EXPORT(User32::PostMessageW),
+      QB_EXPORT(User32::PostQuitMessage),
+      QB_EXPORT(User32::BeginPaint),
+      QB_EXPORT(User32::EndPaint),
+      QB_EXPORT(User32::InvalidateRect),
+      QB_EXPORT(User32::InvalidateRgn),
+      QB_EXPORT(User32::SendInput),
+      QB_EXPORT(User32::RegisterRawInputDevices),
+      QB_EXPORT(User32::GetRawInputBuffer),
+      QB_EXPORT(User32::EnumWindows),
+      QB_EXPORT(User32::EnumChildWindows),
+      QB_EXPORT(User32::GetWindowDetails),
+      QB_EXPORT(User32::BeginMessageTrace),
+      QB_EXPORT(User32::EndMessageTrace),
+      QB_EXPORT(User32::ReplayMessageTrace),
+      QB_EXPORT(User32::SetWndProcNumericParams),
+      QB_EXPORT(User32::OwnMenu),
+      QB_EXPORT(User32::OwnWindow),
+      QB_EXPORT(User32::GetOwnedHandleStats),
+  };
+
+  qb::DefineExports(env, exports, EXPORTS);
+
+  // Native-backed structs for the objects that are passed back into bindings over and over, see quickbind_struct.hpp.
+  exports.Set("MSG", qb::NativeStruct<MSG>::Constructor(env));
+  exports.Set("PAINTSTRUCT", qb::NativeStruct<PAINTSTRUCT>::Constructor(env));
+  exports.Set("POINT", qb::NativeStruct<POINT>::Constructor(env));
+  exports.Set("RECT", qb::NativeStruct<RECT>::Constructor(env));
 
   return exports;
 }
 
+#ifndef LIBWIN_MONOLITHIC
+static Napi::Object Initialize(const Napi::Env env, Napi::Object exports) { return User32::Initialize(env, exports); }
+
 NODE_API_MODULE(user32, Initialize)
+#endif
@@ -5,8 +5,15 @@
 
 #include "../../common/include/callback_handler.hpp"
 #include "../../common/include/quickbind.hpp"
+#include "../../common/include/quickbind_handle.hpp"
+#include "../../common/include/quickbind_instance.hpp"
+#include "../../common/include/quickbind_struct.hpp"
 
 namespace User32 {
+  // Defines every user32 binding on `exports`. Called by this addon's module entry point, or by the combined libwin
+  // addon when building with LIBWIN_MONOLITHIC.
+  Napi::Object Initialize(const Napi::Env env, Napi::Object exports);
+
   Napi::Value ActivateKeyboardLayout(const Napi::CallbackInfo &info);
   Napi::Value AddClipboardFormatListener(const Napi::CallbackInfo &info);
   Napi::Value AddVisualIdentifier(const Napi::CallbackInfo &info);
@@ -1045,4 +1052,14 @@ namespace User32 {
   Napi::Value wsprintfW(const Napi::CallbackInfo &info);
   Napi::Value wvsprintfA(const Napi::CallbackInfo &info);
   Napi::Value wvsprintfW(const Napi::CallbackInfo &info);
+
+  // libwin extensions that have no user32.dll counterpart.
+  Napi::Value GetWindowDetails(const Napi::CallbackInfo &info);
+  Napi::Value BeginMessageTrace(const Napi::CallbackInfo &info);
+  Napi::Value EndMessageTrace(const Napi::CallbackInfo &info);
+  Napi::Value ReplayMessageTrace(const Napi::CallbackInfo &info);
+  Napi::Value SetWndProcNumericParams(const Napi::CallbackInfo &info);
+  Napi::Value OwnMenu(const Napi::CallbackInfo &info);
+  Napi::Value OwnWindow(const Napi::CallbackInfo &info);
+  Napi::Value GetOwnedHandleStats(const Napi::CallbackInfo &info);
 } // namespace User32
@@ -1,38 +1,176 @@
 #include "user32.hpp"
 
-static thread_local std::unique_ptr<CallbackHandler<Napi::BigInt>> wndProcCallbackHandler = nullptr;
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+static constexpr std::string_view EXPECTED_MESSAGE_TRACE = "Expected an ArrayBuffer containing a message trace ";
+
+static constexpr uint32_t MESSAGE_TRACE_MAGIC = 0x544D4251; // "QBMT"
+static constexpr uint32_t MESSAGE_TRACE_VERSION = 1;
+
+// Set on records whose WndProc call is the one DispatchMessageW delivered (posted messages), not one sent directly,
+// including anything sent while handling a dispatched message.
+static constexpr uint32_t MESSAGE_TRACE_DISPATCHED = 0x1;
+
+struct MessageTraceHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t recordSize;
+  uint32_t reserved;
+};
+
+// One WndProc invocation. Layout is mirrored by lib/message-trace.ts.
+struct MessageTraceRecord {
+  uint64_t timestamp; // ns since BeginMessageTrace
+  uint64_t hwnd;
+  uint64_t wParam;
+  int64_t lParam;
+  uint32_t message;
+  uint32_t flags;
+  uint64_t handlerNs; // time spent in the JS WndProc, including anything it sends or dispatches
+};
+
+static_assert(sizeof(MessageTraceHeader) == 16);
+static_assert(sizeof(MessageTraceRecord) == 48);
+
+// Owned by the env that registered the window class; WndProcThunk finds it through qb::InstanceData::Find.
+struct WindowState {
+  std::unique_ptr<CallbackHandler<Napi::Value>> wndProc;
+
+  // When set, the WndProc receives wParam and lParam, and DefWindowProcW and DispatchMessageW return their LRESULT, as
+  // Numbers whenever they fit in one exactly, which is nearly every message, rather than as freshly allocated BigInts.
+  bool numericParams = false;
+
+  bool traceActive = false;
+  std::chrono::steady_clock::time_point traceStart;
+  std::vector<MessageTraceRecord> trace;
+
+  // The message DispatchMessageW is delivering, until WndProcThunk receives it. Cleared there so messages sent while it
+  // is handled aren't mistaken for it.
+  const MSG *dispatching = nullptr;
+};
+
+static uint64_t NanosecondsSince(const std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
 
-static LRESULT CALLBACK WndProcThunk(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) {
-  if (wndProcCallbackHandler) {
-    const Napi::Env env = wndProcCallbackHandler->GetEnv();
+static LRESULT InvokeWndProc(const WindowState &state, HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+  const Napi::Env env = state.wndProc->GetEnv();
 
-    const auto windowHandle = Napi::BigInt::New(env, reinterpret_cast<uintptr_t>(hWnd));
-    const auto message = Napi::Number::New(env, msg);
-    const auto wordParam = Napi::BigInt::New(env, static_cast<uint64_t>(wParam));
-    const auto longParam = Napi::BigInt::New(env, static_cast<uint64_t>(lParam));
+  const auto windowHandle = Napi::BigInt::New(env, reinterpret_cast<uintptr_t>(hWnd));
+  const auto message = Napi::Number::New(env, msg);
+  const Napi::Value wordParam = state.numericParams ? qb::ToNumberOrBigInt(env, static_cast<uintptr_t>(wParam))
+                                                    : Napi::BigInt::New(env, static_cast<uint64_t>(wParam));
+  const Napi::Value longParam = state.numericParams ? qb::ToNumberOrBigInt(env, static_cast<intptr_t>(lParam))
+                                                    : Napi::BigInt::New(env, static_cast<int64_t>(lParam));
 
-    const Napi::BigInt result = wndProcCallbackHandler->Invoke({windowHandle, message, wordParam, longParam});
+  const Napi::Value result = state.wndProc->Invoke({windowHandle, message, wordParam, longParam});
 
+  // The WndProc may return either a BigInt or a Number; anything else counts as 0.
+  if (result.IsBigInt()) {
     bool lossless;
-    return result.Int64Value(&lossless);
+    return result.As<Napi::BigInt>().Int64Value(&lossless);
+  }
+
+  if (result.IsNumber()) {
+    return result.As<Napi::Number>().Int64Value();
   }
 
   return 0;
 }
 
+// Every binding that returns an LRESULT goes through here, so all of them follow SetWndProcNumericParams the same way.
+static Napi::Value FromLResult(const Napi::Env env, const WindowState &state, const LRESULT result) {
+  if (state.numericParams) {
+    return qb::ToNumberOrBigInt(env, static_cast<intptr_t>(result));
+  }
+
+  return Napi::BigInt::New(env, static_cast<int64_t>(result));
+}
+
+// Hands `msg` to ::DispatchMessageW, marked so WndProcThunk can tell it from whatever the handler sends in turn.
+static LRESULT Dispatch(WindowState &state, const MSG &msg) {
+  // Restored afterwards in case the message never reached a JS WndProc, e.g. one for a window of another class.
+  const MSG *previous = std::exchange(state.dispatching, &msg);
+  const LRESULT result = ::DispatchMessageW(&msg);
+  state.dispatching = previous;
+
+  return result;
+}
+
+static LRESULT CALLBACK WndProcThunk(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+  // Nothing to call once the env that registered the class has been torn down.
+  WindowState *state = qb::InstanceData::Find<WindowState>();
+
+  if (state == nullptr || !state->wndProc) {
+    return 0;
+  }
+
+  // The last message a window receives, whoever destroyed it: by DestroyWindow on the raw handle, or along with its
+  // parent or owner. An owner still holding the handle must not destroy it again, or a window that reuses the value.
+  if (msg == WM_NCDESTROY) {
+    qb::OwnedHandle::Orphan(hWnd);
+  }
+
+  const MSG *dispatching = state->dispatching;
+  const bool dispatched = dispatching != nullptr && dispatching->hwnd == hWnd && dispatching->message == msg &&
+                          dispatching->wParam == wParam && dispatching->lParam == lParam;
+
+  if (dispatched) {
+    state->dispatching = nullptr;
+  }
+
+  if (!state->traceActive) {
+    return InvokeWndProc(*state, hWnd, msg, wParam, lParam);
+  }
+
+  // Reserve the slot before invoking so nested messages sent from the handler are recorded after the one that caused
+  // them, matching the order they were delivered in.
+  const size_t index = state->trace.size();
+  state->trace.push_back({NanosecondsSince(state->traceStart),
+                          reinterpret_cast<uintptr_t>(hWnd),
+                          static_cast<uint64_t>(wParam),
+                          static_cast<int64_t>(lParam),
+                          msg,
+                          dispatched ? MESSAGE_TRACE_DISPATCHED : 0,
+                          0});
+
+  const auto start = std::chrono::steady_clock::now();
+  const LRESULT result = InvokeWndProc(*state, hWnd, msg, wParam, lParam);
+
+  state->trace[index].handlerNs = NanosecondsSince(start);
+
+  return result;
+}
 Napi::Value User32::CreateWindowExW(const Napi::CallbackInfo &info) {
-  const QB_ARG(dwExStyle, qb::ReadRequiredUint32(info, 0));
-  const QB_ARG(lpClassName, qb::ReadOptionalWideString(info, 1));
-  const QB_ARG(lpWindowName, qb::ReadOptionalWideString(info, 2));
-  const QB_ARG(dwStyle, qb::ReadRequiredUint32(info, 3));
-  const QB_ARG(X, qb::ReadRequiredInt32(info, 4));
-  const QB_ARG(Y, qb::ReadRequiredInt32(info, 5));
-  const QB_ARG(nWidth, qb::ReadRequiredInt32(info, 6));
-  const QB_ARG(nHeight, qb::ReadRequiredInt32(info, 7));
-  const QB_ARG(hWndParent, qb::ReadOptionalHandle<HWND>(info, 8));
-  const QB_ARG(hMenu, qb::ReadOptionalHandle<HMENU>(info, 9));
-  const QB_ARG(hInstance, qb::ReadOptionalHandle<HINSTANCE>(info, 10));
-  const QB_ARG(lpParam, qb::ReadOptionalHandle<LPVOID>(info, 11));
+  const auto [dwExStyle,
+              lpClassName,
+              lpWindowName,
+              dwStyle,
+              X,
+              Y,
+              nWidth,
+              nHeight,
+              hWndParent,
+              hMenu,
+              hInstance,
+              lpParam] = QB_ARGS(qb::ReadRequiredUint32(info, 0),
+                                 qb::ReadOptionalWideString(info, 1),
+                                 qb::ReadOptionalWideString(info, 2),
+                                 qb::ReadRequiredUint32(info, 3),
+                                 qb::ReadRequiredInt32(info, 4),
+                                 qb::ReadRequiredInt32(info, 5),
+                                 qb::ReadRequiredInt32(info, 6),
+                                 qb::ReadRequiredInt32(info, 7),
+                                 qb::ReadOptionalHandle<HWND>(info, 8),
+                                 qb::ReadOptionalHandle<HMENU>(info, 9),
+                                 qb::ReadOptionalHandle<HINSTANCE>(info, 10),
+                                 qb::ReadOptionalHandle<LPVOID>(info, 11));
 
   const HWND hWnd = ::CreateWindowExW(dwExStyle,
                                       lpClassName ? lpClassName->c_str() : nullptr,
@@ -47,9 +185,29 @@ Napi::Value User32::CreateWindowExW(const Napi::CallbackInfo &info) {
                                       hInstance ? hInstance.value() : nullptr,
                                       lpParam ? lpParam.value() : nullptr);
 
+  // Same as SetMenu: the menu of a window that isn't a child, where it is a control ID, is destroyed with the window.
+  if (hWnd != nullptr && hMenu && hMenu.value() != nullptr && (dwStyle & WS_CHILD) == 0) {
+    qb::OwnedHandle::Orphan(hMenu.value());
+  }
+
   return qb::HandleToBigInt(info, hWnd);
 }
 
+Napi::Value User32::DestroyWindow(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(hWnd, qb::ReadRequiredHandle<HWND>(info, 0));
+
+  // An owned window is disposed instead, so its object doesn't destroy the handle a second time.
+  if (const std::optional<BOOL> disposed = qb::OwnedHandle::Dispose<HWND>(info[0])) {
+    return Napi::Boolean::New(env, disposed.value());
+  }
+
+  const BOOL result = ::DestroyWindow(hWnd);
+
+  return Napi::Boolean::New(env, result);
+}
+
 Napi::Value User32::RegisterClassExW(const Napi::CallbackInfo &info) {
   const Napi::Env env = info.Env();
 
@@ -68,7 +226,7 @@ Napi::Value User32::RegisterClassExW(const Napi::CallbackInfo &info) {
   const QB_ARG(lpszClassName, qb::ReadRequiredWideString(params, "lpszClassName"));
   const QB_ARG(hIconSm, qb::ReadOptionalHandle<HICON>(params, "hIconSm"));
 
-  wndProcCallbackHandler = std::make_unique<CallbackHandler<Napi::BigInt>>(lpfnWndProc);
+  qb::InstanceData::Get<WindowState>(env).wndProc = std::make_unique<CallbackHandler<Napi::Value>>(lpfnWndProc);
 
   WNDCLASSEXW wcex{};
 
@@ -93,23 +251,40 @@ Napi::Value User32::RegisterClassExW(const Napi::CallbackInfo &info) {
 Napi::Value User32::DefWindowProcW(const Napi::CallbackInfo &info) {
   const Napi::Env env = info.Env();
 
-  const QB_ARG(hWnd, qb::ReadRequiredHandle<HWND>(info, 0));
-  const QB_ARG(msg, qb::ReadRequiredUint32(info, 1));
-  const QB_ARG(wParam, qb::ReadRequiredUint64(info, 2));
-  const QB_ARG(lParam, qb::ReadRequiredInt64(info, 3));
+  const auto [hWnd, msg, wParam, lParam] = QB_ARGS(qb::ReadRequiredHandle<HWND>(info, 0),
+                                                   qb::ReadRequiredUint32(info, 1),
+                                                   qb::ReadRequiredUintPtr(info, 2),
+                                                   qb::ReadRequiredIntPtr(info, 3));
 
   const LRESULT result = ::DefWindowProcW(hWnd, msg, wParam, lParam);
 
-  return Napi::BigInt::New(env, result);
+  return FromLResult(env, qb::InstanceData::Get<WindowState>(env), result);
+}
+
+Napi::Value User32::SetWndProcNumericParams(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const QB_ARG(enabled, qb::ReadRequiredBoolean(info, 0));
+
+  const bool previous = std::exchange(qb::InstanceData::Get<WindowState>(env).numericParams, enabled);
+
+  return Napi::Boolean::New(env, previous);
 }
 
 Napi::Value User32::GetMessageW(const Napi::CallbackInfo &info) {
   const Napi::Env env = info.Env();
 
-  const QB_ARG(lpMsg, qb::ReadRequiredObject(info, 0));
-  const QB_ARG(hWnd, qb::ReadOptionalHandle<HWND>(info, 1));
-  const QB_ARG(wMsgFilterMin, qb::ReadRequiredUint32(info, 2));
-  const QB_ARG(wMsgFilterMax, qb::ReadRequiredUint32(info, 3));
+  const auto [lpMsg, hWnd, wMsgFilterMin, wMsgFilterMax] = QB_ARGS(qb::ReadRequiredObject(info, 0),
+                                                                   qb::ReadOptionalHandle<HWND>(info, 1),
+                                                                   qb::ReadRequiredUint32(info, 2),
+                                                                   qb::ReadRequiredUint32(info, 3));
+
+  // A wrapped MSG is filled in place; a plain object gets every field set on it afterwards.
+  if (MSG *native = qb::NativeStruct<MSG>::Unwrap(lpMsg)) {
+    const BOOL result = ::GetMessageW(native, hWnd ? hWnd.value() : nullptr, wMsgFilterMin, wMsgFilterMax);
+
+    return Napi::Boolean::New(env, result);
+  }
 
   MSG msg{};
 
@@ -122,7 +297,7 @@ Napi::Value User32::GetMessageW(const Napi::CallbackInfo &info) {
   lpMsg.Set("hwnd", qb::HandleToBigInt(info, msg.hwnd));
   lpMsg.Set("message", Napi::Number::New(env, msg.message));
   lpMsg.Set("wParam", Napi::BigInt::New(env, static_cast<uint64_t>(msg.wParam)));
-  lpMsg.Set("lParam", Napi::BigInt::New(env, static_cast<uint64_t>(msg.lParam)));
+  lpMsg.Set("lParam", Napi::BigInt::New(env, static_cast<int64_t>(msg.lParam)));
   lpMsg.Set("time", Napi::Number::New(env, msg.time));
   lpMsg.Set("pt", pt);
 
@@ -134,15 +309,20 @@ Napi::Value User32::TranslateMessage(const Napi::CallbackInfo &info) {
 
   const QB_ARG(lpMsg, qb::ReadRequiredObject(info, 0));
 
-  const QB_ARG(hwnd, qb::ReadRequiredHandle<HWND>(lpMsg, "hwnd"));
-  const QB_ARG(message, qb::ReadRequiredUint32(lpMsg, "message"));
-  const QB_ARG(wParam, qb::ReadRequiredUint64(lpMsg, "wParam"));
-  const QB_ARG(lParam, qb::ReadRequiredInt64(lpMsg, "lParam"));
-  const QB_ARG(time, qb::ReadRequiredUint32(lpMsg, "time"));
-  const QB_ARG(ptObj, qb::ReadRequiredObject(lpMsg, "pt"));
+  if (const MSG *native = qb::NativeStruct<MSG>::Unwrap(lpMsg)) {
+    const BOOL result = ::TranslateMessage(native);
 
-  const QB_ARG(x, qb::ReadRequiredInt32(ptObj, "x"));
-  const QB_ARG(y, qb::ReadRequiredInt32(ptObj, "y"));
+    return Napi::Boolean::New(env, result);
+  }
+
+  const auto [hwnd, message, wParam, lParam, time, ptObj] = QB_ARGS(qb::ReadRequiredHandle<HWND>(lpMsg, "hwnd"),
+                                                                    qb::ReadRequiredUint32(lpMsg, "message"),
+                                                                    qb::ReadRequiredUintPtr(lpMsg, "wParam"),
+                                                                    qb::ReadRequiredIntPtr(lpMsg, "lParam"),
+                                                                    qb::ReadRequiredUint32(lpMsg, "time"),
+                                                                    qb::ReadRequiredObject(lpMsg, "pt"));
+
+  const auto [x, y] = QB_ARGS(qb::ReadRequiredInt32(ptObj, "x"), qb::ReadRequiredInt32(ptObj, "y"));
 
   MSG msg{hwnd, message, wParam, lParam, time, {x, y}};
 
@@ -156,28 +336,36 @@ Napi::Value User32::DispatchMessageW(const Napi::CallbackInfo &info) {
 
   const QB_ARG(lpMsg, qb::ReadRequiredObject(info, 0));
 
-  const QB_ARG(hwnd, qb::ReadRequiredHandle<HWND>(lpMsg, "hwnd"));
-  const QB_ARG(message, qb::ReadRequiredUint32(lpMsg, "message"));
-  const QB_ARG(wParam, qb::ReadRequiredUint64(lpMsg, "wParam"));
-  const QB_ARG(lParam, qb::ReadRequiredInt64(lpMsg, "lParam"));
-  const QB_ARG(time, qb::ReadRequiredUint32(lpMsg, "time"));
-  const QB_ARG(ptObj, qb::ReadRequiredObject(lpMsg, "pt"));
+  MSG msg{};
 
-  const QB_ARG(x, qb::ReadRequiredInt32(ptObj, "x"));
-  const QB_ARG(y, qb::ReadRequiredInt32(ptObj, "y"));
+  // The WndProc may call GetMessageW with the same wrapped MSG before DispatchMessageW returns, so it is copied rather
+  // than handed over in place.
+  if (const MSG *native = qb::NativeStruct<MSG>::Unwrap(lpMsg)) {
+    msg = *native;
+  } else {
+    const auto [hwnd, message, wParam, lParam, time, ptObj] = QB_ARGS(qb::ReadRequiredHandle<HWND>(lpMsg, "hwnd"),
+                                                                      qb::ReadRequiredUint32(lpMsg, "message"),
+                                                                      qb::ReadRequiredUintPtr(lpMsg, "wParam"),
+                                                                      qb::ReadRequiredIntPtr(lpMsg, "lParam"),
+                                                                      qb::ReadRequiredUint32(lpMsg, "time"),
+                                                                      qb::ReadRequiredObject(lpMsg, "pt"));
+
+    const auto [x, y] = QB_ARGS(qb::ReadRequiredInt32(ptObj, "x"), qb::ReadRequiredInt32(ptObj, "y"));
+
+    msg = {hwnd, message, wParam, lParam, time, {x, y}};
+  }
 
-  MSG msg{hwnd, message, wParam, lParam, time, {x, y}};
+  WindowState &state = qb::InstanceData::Get<WindowState>(env);
 
-  const LRESULT result = ::DispatchMessageW(&msg);
+  const LRESULT result = Dispatch(state, msg);
 
-  return Napi::BigInt::New(env, result);
+  return FromLResult(env, state, result);
 }
 
 Napi::Value User32::ShowWindow(const Napi::CallbackInfo &info) {
   const Napi::Env env = info.Env();
 
-  const QB_ARG(hWnd, qb::ReadRequiredHandle<HWND>(info, 0));
-  const QB_ARG(nCmdShow, qb::ReadRequiredInt32(info, 1));
+  const auto [hWnd, nCmdShow] = QB_ARGS(qb::ReadRequiredHandle<HWND>(info, 0), qb::ReadRequiredInt32(info, 1));
 
   const BOOL result = ::ShowWindow(hWnd, nCmdShow);
 
@@ -193,3 +381,152 @@ Napi::Value User32::UpdateWindow(const Napi::CallbackInfo &info) {
 
   return Napi::Boolean::New(env, result);
 }
+
+Napi::Value User32::GetClassNameW(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const auto [hWnd, lpClassName, nMaxCount] = QB_ARGS(
+      qb::ReadRequiredHandle<HWND>(info, 0), qb::ReadRequiredObject(info, 1), qb::ReadRequiredInt32(info, 2));
+
+  qb::TextBuffer &buffer = qb::TextBuffer::Current();
+
+  const int result = ::GetClassNameW(hWnd, buffer.Reserve(std::max(nMaxCount, 1)), nMaxCount);
+
+  lpClassName.Set("value", buffer.ToString(env, result));
+
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value User32::GetWindowTextW(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const auto [hWnd, lpString, nMaxCount] = QB_ARGS(
+      qb::ReadRequiredHandle<HWND>(info, 0), qb::ReadRequiredObject(info, 1), qb::ReadRequiredInt32(info, 2));
+
+  qb::TextBuffer &buffer = qb::TextBuffer::Current();
+
+  const int result = ::GetWindowTextW(hWnd, buffer.Reserve(std::max(nMaxCount, 1)), nMaxCount);
+
+  lpString.Set("value", buffer.ToString(env, result));
+
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value User32::BeginMessageTrace(const Napi::CallbackInfo &info) {
+  const QB_ARG(capacity, qb::ReadOptionalUint32(info, 0));
+
+  WindowState &state = qb::InstanceData::Get<WindowState>(info.Env());
+
+  state.trace.clear();
+  state.trace.reserve(capacity.value_or(65536));
+  state.traceStart = std::chrono::steady_clock::now();
+  state.traceActive = true;
+
+  return info.Env().Undefined();
+}
+
+Napi::Value User32::EndMessageTrace(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  WindowState &state = qb::InstanceData::Get<WindowState>(env);
+
+  state.traceActive = false;
+
+  const size_t recordsSize = state.trace.size() * sizeof(MessageTraceRecord);
+  const MessageTraceHeader header{MESSAGE_TRACE_MAGIC, MESSAGE_TRACE_VERSION, sizeof(MessageTraceRecord), 0};
+
+  Napi::ArrayBuffer trace = Napi::ArrayBuffer::New(env, sizeof(MessageTraceHeader) + recordsSize);
+  uint8_t *data = static_cast<uint8_t *>(trace.Data());
+
+  std::memcpy(data, &header, sizeof(MessageTraceHeader));
+
+  if (recordsSize > 0) {
+    std::memcpy(data + sizeof(MessageTraceHeader), state.trace.data(), recordsSize);
+  }
+
+  state.trace.clear();
+  state.trace.shrink_to_fit();
+
+  return trace;
+}
+
+Napi::Value User32::ReplayMessageTrace(const Napi::CallbackInfo &info) {
+  const Napi::Env env = info.Env();
+
+  const auto [trace, realTime, direct] = QB_ARGS(qb::ReadRequiredSpan<const uint8_t>(info, 0),
+                                                 qb::ReadOptionalBoolean(info, 1),
+                                                 qb::ReadOptionalBoolean(info, 2));
+
+  const uint8_t *data = trace.data();
+
+  MessageTraceHeader header{};
+
+  if (trace.size() >= sizeof(MessageTraceHeader)) {
+    std::memcpy(&header, data, sizeof(MessageTraceHeader));
+  }
+
+  if (header.magic != MESSAGE_TRACE_MAGIC || header.version != MESSAGE_TRACE_VERSION ||
+      header.recordSize != sizeof(MessageTraceRecord)) {
+    qb::detail::ThrowTypeError(env, EXPECTED_MESSAGE_TRACE, qb::detail::Argument(0));
+    return env.Undefined();
+  }
+
+  const size_t count = (trace.size() - sizeof(MessageTraceHeader)) / sizeof(MessageTraceRecord);
+
+  // Records are copied out up front since the handler may detach or otherwise reuse the trace's ArrayBuffer.
+  std::vector<MessageTraceRecord> records(count);
+
+  if (count > 0) {
+    std::memcpy(records.data(), data + sizeof(MessageTraceHeader), count * sizeof(MessageTraceRecord));
+  }
+
+  Napi::Float64Array handlerNs = Napi::Float64Array::New(env, count, napi_float64_array);
+
+  // By default only dispatched records are replayed, through DispatchMessageW like the pump they came from, since the
+  // messages sent while handling them are sent again by the handler itself. With `direct`, every record goes straight
+  // to the JS WndProc instead, so the trace can be run without the windows it was recorded from. Records that aren't
+  // replayed get NaN. Recording is suspended so a replay never ends up in its own trace.
+  WindowState &state = qb::InstanceData::Get<WindowState>(env);
+
+  const bool wasTracing = state.traceActive;
+  state.traceActive = false;
+
+  const auto replayStart = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < count; i++) {
+    const MessageTraceRecord &record = records[i];
+
+    if (realTime.value_or(false)) {
+      std::this_thread::sleep_until(replayStart + std::chrono::nanoseconds(record.timestamp));
+    }
+
+    const HWND hWnd = reinterpret_cast<HWND>(static_cast<uintptr_t>(record.hwnd));
+    const WPARAM wParam = static_cast<WPARAM>(record.wParam);
+    const LPARAM lParam = static_cast<LPARAM>(record.lParam);
+
+    if (direct.value_or(false) ? !state.wndProc
+                               : (record.flags & MESSAGE_TRACE_DISPATCHED) == 0 || !::IsWindow(hWnd)) {
+      handlerNs[i] = std::numeric_limits<double>::quiet_NaN();
+      continue;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    if (direct.value_or(false)) {
+      InvokeWndProc(state, hWnd, record.message, wParam, lParam);
+    } else {
+      const MSG msg{hWnd, record.message, wParam, lParam, 0, {0, 0}};
+      Dispatch(state, msg);
+    }
+
+    handlerNs[i] = static_cast<double>(NanosecondsSince(start));
+
+    if (env.IsExceptionPending()) {
+      break;
+    }
+  }
+
+  state.traceActive = wasTracing;
+
+  return handlerNs;
+}
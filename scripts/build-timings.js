@@ -0,0 +1,96 @@
+//@ts-check
+import { spawnSync } from 'node:child_process';
+import { writeFileSync } from 'node:fs';
+
+// Times clean rebuilds of the addons so the effect of the unity and pch options can be compared on the same machine.
+//
+// Usage: node scripts/build-timings.js [--workspace=packages/native ...] [--unity=0,8,64] [--runs=3] [--output=file]
+//                                      [-- <extra node-gyp arguments...>]
+//
+// Every workspace is rebuilt once per unity batch size and run, and the wall time of each `node-gyp rebuild` is written
+// as JSON to stdout or --output. Only the median of the runs is meaningful; the first build after checkout also pays
+// for warming the file cache. On Linux and macOS the addons compile against packages/common/win32-stub, so the numbers
+// measure the compiler, not a working addon.
+const separator = process.argv.indexOf('--');
+const options = separator === -1 ? process.argv.slice(2) : process.argv.slice(2, separator);
+const extra = separator === -1 ? [] : process.argv.slice(separator + 1);
+
+const workspaces = options
+  .filter((option) => option.startsWith('--workspace='))
+  .map((option) => option.slice('--workspace='.length));
+
+if (workspaces.length === 0) {
+  workspaces.push('packages/comctl32', 'packages/gdi32', 'packages/kernel32', 'packages/user32', 'packages/native');
+}
+
+const unity = (option('unity') ?? '0,8')
+  .split(',')
+  .map((value) => Number.parseInt(value, 10))
+  .filter((value) => Number.isInteger(value) && value >= 0);
+const runs = Math.max(1, Number.parseInt(option('runs') ?? '1', 10) || 1);
+const output = option('output');
+
+const results = [];
+
+for (const workspace of workspaces) {
+  for (const batchSize of unity) {
+    const seconds = [];
+
+    for (let run = 0; run < runs; run++) {
+      seconds.push(rebuild(workspace, batchSize));
+    }
+
+    seconds.sort((a, b) => a - b);
+
+    results.push({
+      workspace,
+      unity: batchSize,
+      runs: seconds,
+      median: seconds[Math.floor(seconds.length / 2)],
+    });
+  }
+}
+
+const json = JSON.stringify({ platform: process.platform, arch: process.arch, extra, results }, null, 2);
+
+if (output) {
+  writeFileSync(output, `${json}\n`);
+} else {
+  console.log(json);
+}
+
+/**
+ * @param {string} name
+ *
+ * @returns {string | undefined}
+ */
+function option(name) {
+  return options.find((arg) => arg.startsWith(`--${name}=`))?.slice(name.length + 3);
+}
+
+/**
+ * @param {string} workspace
+ * @param {number} batchSize
+ *
+ * @returns {number} Wall time in seconds.
+ */
+function rebuild(workspace, batchSize) {
+  const args = ['node-gyp', 'rebuild', '-j', 'max', `--unity=${batchSize}`, ...extra];
+
+  console.error(`> npx ${args.join(' ')} (${workspace})`);
+
+  const start = process.hrtime.bigint();
+  const result = spawnSync('npx', args, {
+    cwd: workspace,
+    stdio: ['ignore', 'ignore', 'inherit'],
+    shell: process.platform === 'win32',
+  });
+  const elapsed = Number(process.hrtime.bigint() - start) / 1e9;
+
+  if (result.status !== 0) {
+    console.error(`node-gyp exited with ${result.status ?? result.signal}`);
+    process.exit(result.status ?? 1);
+  }
+
+  return Math.round(elapsed * 1000) / 1000;
+}
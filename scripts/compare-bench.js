@@ -0,0 +1,146 @@
+//@ts-check
+import { readFileSync, writeFileSync } from 'node:fs';
+import { relative } from 'node:path';
+import { fileURLToPath } from 'node:url';
+
+// Compares a `vitest bench --outputJson` report with the recorded baseline and fails if any benchmark got slower.
+//
+// Usage: node scripts/compare-bench.js <report.json> [--baseline=bench/baseline.json] [--threshold=0.25] [--update]
+//
+// A benchmark regresses when its mean is more than --threshold (a fraction) above the baseline, after allowing for the
+// relative margin of error of both runs. Benchmarks without a baseline entry are listed but never fail the comparison.
+// --update rewrites the baseline from the report instead. The baseline only means something on comparable hardware,
+// so refresh it from the CI artifact rather than from a local run. A baseline that wasn't written by --update, and so
+// isn't known to come from a vitest report, is compared but never fails.
+const root = fileURLToPath(new URL('..', import.meta.url));
+const options = process.argv.slice(2);
+
+const reportPath = options.find((arg) => !arg.startsWith('--'));
+const baselinePath = option('baseline') ?? fileURLToPath(new URL('../bench/baseline.json', import.meta.url));
+const threshold = Number.parseFloat(option('threshold') ?? '0.25');
+
+if (!reportPath || !Number.isFinite(threshold) || threshold < 0) {
+  console.error('Usage: node scripts/compare-bench.js <report.json> [--baseline=file] [--threshold=0.25] [--update]');
+  process.exit(2);
+}
+
+const current = readReport(reportPath);
+
+if (options.includes('--update')) {
+  const baseline = {
+    source: 'vitest',
+    platform: process.platform,
+    arch: process.arch,
+    node: process.version,
+    benchmarks: Object.fromEntries([...current].sort(([a], [b]) => a.localeCompare(b))),
+  };
+
+  writeFileSync(baselinePath, `${JSON.stringify(baseline, null, 2)}\n`);
+  console.log(`Wrote ${current.size} benchmarks to ${relative(root, baselinePath)}`);
+  process.exit(0);
+}
+
+/** @type {{ source?: string, benchmarks: Record<string, Result> }} */
+const baseline = JSON.parse(readFileSync(baselinePath, 'utf8'));
+
+// Numbers from another runner have a different overhead and no real margin of error, so they can't gate anything.
+const gating = baseline.source === 'vitest';
+
+let regressions = 0;
+
+for (const [name, result] of current) {
+  const previous = baseline.benchmarks[name];
+
+  if (!previous) {
+    console.log(`  new  ${name}: ${format(result.nsPerOp)}`);
+    continue;
+  }
+
+  const change = result.nsPerOp / previous.nsPerOp - 1;
+  const margin = threshold + (result.rme + previous.rme) / 100;
+  const regressed = change > margin;
+
+  if (regressed) {
+    regressions++;
+  }
+
+  const sign = change >= 0 ? '+' : '';
+  const status = regressed ? 'SLOW' : '  ok';
+
+  console.log(
+    `${status} ${name}: ${format(previous.nsPerOp)} -> ${format(result.nsPerOp)} (${sign}${(change * 100).toFixed(1)}%)`,
+  );
+}
+
+for (const name of Object.keys(baseline.benchmarks)) {
+  if (!current.has(name)) {
+    console.log(`gone  ${name}`);
+  }
+}
+
+if (regressions > 0) {
+  console.error(`${regressions} benchmark(s) regressed by more than ${threshold * 100}% plus their margin of error`);
+
+  if (gating) {
+    process.exit(1);
+  }
+}
+
+if (!gating) {
+  console.error(`${relative(root, baselinePath)} wasn't recorded from a vitest report, so the comparison doesn't fail`);
+}
+
+/**
+ * @typedef {Object} Result
+ * @property {number} nsPerOp - Mean time of one iteration.
+ * @property {number} rme - Relative margin of error of the mean, in percent.
+ */
+
+/**
+ * @param {string} path
+ *
+ * @returns {Map<string, Result>} Keyed by `<file relative to the repo> > <describe> > <bench>`.
+ */
+function readReport(path) {
+  /** @type {{ files: { filepath: string, groups: { fullName: string, benchmarks: { name: string, mean: number, rme: number }[] }[] }[] }} */
+  const report = JSON.parse(readFileSync(path, 'utf8'));
+
+  /** @type {Map<string, Result>} */
+  const results = new Map();
+
+  for (const file of report.files) {
+    const filepath = relative(root, file.filepath).replaceAll('\\', '/');
+
+    for (const group of file.groups) {
+      // fullName already starts with the file name when the group is the file itself rather than a describe block.
+      const prefix = group.fullName.startsWith(filepath) ? group.fullName : `${filepath} > ${group.fullName}`;
+
+      for (const benchmark of group.benchmarks) {
+        results.set(`${prefix} > ${benchmark.name}`, {
+          nsPerOp: Math.round(benchmark.mean * 1e6),
+          rme: Math.round(benchmark.rme * 100) / 100,
+        });
+      }
+    }
+  }
+
+  return results;
+}
+
+/**
+ * @param {string} name
+ *
+ * @returns {string | undefined}
+ */
+function option(name) {
+  return options.find((arg) => arg.startsWith(`--${name}=`))?.slice(name.length + 3);
+}
+
+/**
+ * @param {number} nanoseconds
+ *
+ * @returns {string}
+ */
+function format(nanoseconds) {
+  return nanoseconds >= 1e6 ? `${(nanoseconds / 1e6).toFixed(2)} ms` : `${(nanoseconds / 1e3).toFixed(2)} µs`;
+}
@@ -28,7 +28,7 @@ export function createRollupConfig(root, addon) {
         declaration: false,
         declarationMap: false,
         removeComments: true,
-        exclude: 'lib/**/*.test.*',
+        exclude: ['lib/**/*.test.*', 'lib/**/*.bench.*'],
       }),
       copyFilesPlugin(root, addon),
     ],
@@ -1,13 +1,78 @@
 //@ts-check
-import { readdirSync } from 'node:fs';
-import { join } from 'node:path';
+import { existsSync, mkdirSync, readFileSync, readdirSync, writeFileSync } from 'node:fs';
+import { join, relative } from 'node:path';
 
-const files = readdirSync(join(process.cwd(), 'src'), {
-  withFileTypes: true,
-  recursive: true,
-})
+// Lists the sources of the package in the current directory, or of every package directory passed as an argument so
+// the combined libwin addon can compile all of them into one target.
+//
+// With --unity=<n> (n > 0) the sources are instead batched into jumbo translation units of up to n files each, written
+// to build/unity, and those are listed. Sources compiled this way share one TU with their batch, and a batch can span
+// packages when several are passed, so file-local names (static functions, constants) must be unique across every
+// package that is built together, not just within one. Helpers shared between files belong in qb::detail; anything
+// else file-local goes in a namespace named after its file.
+//
+// Paths are printed relative to the current directory, which gyp resolves against the .gyp file; make-based generators
+// can't place objects for absolute source paths.
+const args = process.argv.slice(2);
+
+const unityArg = args.find((arg) => arg.startsWith('--unity='));
+const batchSize = unityArg ? Number.parseInt(unityArg.slice('--unity='.length), 10) || 0 : 0;
+
+const packages = args.filter((arg) => !arg.startsWith('--'));
+
+if (packages.length === 0) {
+  packages.push('.');
+}
+
+const files = packages
+  .flatMap((pkg) =>
+    readdirSync(join(process.cwd(), pkg, 'src'), {
+      withFileTypes: true,
+      recursive: true,
+    }),
+  )
   .filter((dirent) => dirent.isFile() && dirent.name.endsWith('.cpp'))
-  .map((dirent) => join(dirent.parentPath, dirent.name).replace(/\\/g, '/'))
-  .join(' ');
+  .map((dirent) => toPosix(relative(process.cwd(), join(dirent.parentPath, dirent.name))))
+  .sort();
+
+process.stdout.write((batchSize > 0 ? writeUnitySources(files, batchSize) : files).join(' '));
+
+/**
+ * @param {string[]} files
+ * @param {number} batchSize
+ *
+ * @returns {string[]}
+ */
+function writeUnitySources(files, batchSize) {
+  const unityDir = join(process.cwd(), 'build', 'unity');
+
+  mkdirSync(unityDir, { recursive: true });
+
+  const unitySources = [];
+
+  for (let i = 0; i < files.length; i += batchSize) {
+    const unitySource = join(unityDir, `unity_${unitySources.length}.cpp`);
+    const contents = files
+      .slice(i, i + batchSize)
+      .map((file) => `#include "${toPosix(relative(unityDir, file))}"\n`)
+      .join('');
+
+    // Only touch files whose batch changed, so an incremental build doesn't recompile every jumbo TU after configure.
+    if (!existsSync(unitySource) || readFileSync(unitySource, 'utf8') !== contents) {
+      writeFileSync(unitySource, contents);
+    }
+
+    unitySources.push(toPosix(relative(process.cwd(), unitySource)));
+  }
+
+  return unitySources;
+}
 
-process.stdout.write(files);
+/**
+ * @param {string} path
+ *
+ * @returns {string}
+ */
+function toPosix(path) {
+  return path.replace(/\\/g, '/');
+}
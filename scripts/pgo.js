@@ -0,0 +1,102 @@
+//@ts-check
+import { spawnSync } from 'node:child_process';
+import { existsSync, mkdirSync, readFileSync, readdirSync, rmSync } from 'node:fs';
+import { join, resolve } from 'node:path';
+
+// Profile-guided optimization workflow for the addons.
+//
+// Usage: node scripts/pgo.js [--workspace=packages/user32 ...] -- <training command...>
+//
+// 1. Rebuilds each workspace instrumented (pgo=generate, which implies LTO) and, if it has a build:lib script, its dist.
+// 2. Runs the training command once. It should exercise the hot paths the addons are meant to be optimized for, e.g. a
+//    message loop or code that marshals a lot of structs, such as `node packages/common/bench/run.js`.
+// 3. Merges Clang's raw profiles if there are any (GCC and MSVC consume theirs directly) and rebuilds each workspace
+//    with pgo=use.
+//
+// Any directory with a binding.gyp including common.gypi works as a workspace, e.g. packages/native or
+// packages/common/bench.
+//
+// Profiles are kept in <workspace>/pgo rather than under build/, since node-gyp rebuild wipes build/ between phases.
+const separator = process.argv.indexOf('--');
+const options = separator === -1 ? process.argv.slice(2) : process.argv.slice(2, separator);
+const training = separator === -1 ? [] : process.argv.slice(separator + 1);
+
+if (training.length === 0) {
+  console.error('Usage: node scripts/pgo.js [--workspace=packages/<name> ...] -- <training command...>');
+  process.exit(1);
+}
+
+const workspaces = options
+  .filter((option) => option.startsWith('--workspace='))
+  .map((option) => option.slice('--workspace='.length));
+
+if (workspaces.length === 0) {
+  workspaces.push('packages/comctl32', 'packages/gdi32', 'packages/kernel32', 'packages/user32');
+}
+
+for (const workspace of workspaces) {
+  const pgoDir = join(resolve(workspace), 'pgo');
+
+  rmSync(pgoDir, { recursive: true, force: true });
+  mkdirSync(pgoDir, { recursive: true });
+
+  rebuild(workspace, 'generate');
+}
+
+run(training[0] ?? '', training.slice(1), process.cwd());
+
+for (const workspace of workspaces) {
+  const pgoDir = join(resolve(workspace), 'pgo');
+  const rawProfiles = readdirSync(pgoDir).filter((file) => file.endsWith('.profraw'));
+
+  if (rawProfiles.length > 0) {
+    run(
+      'llvm-profdata',
+      ['merge', `--output=${join(pgoDir, 'default.profdata')}`, ...rawProfiles.map((file) => join(pgoDir, file))],
+      process.cwd(),
+    );
+  }
+
+  rebuild(workspace, 'use');
+}
+
+/**
+ * @param {string} workspace
+ * @param {'generate' | 'use'} pgo
+ */
+function rebuild(workspace, pgo) {
+  // node-gyp hands unknown --name=value options to gyp as variables; arguments after -- never reach it.
+  run('npx', ['node-gyp', 'rebuild', '-j', 'max', `--pgo=${pgo}`], workspace);
+
+  if (hasScript(workspace, 'build:lib')) {
+    run('npm', ['run', 'build:lib'], workspace);
+  }
+}
+
+/**
+ * @param {string} workspace
+ * @param {string} name
+ *
+ * @returns {boolean}
+ */
+function hasScript(workspace, name) {
+  const manifest = join(resolve(workspace), 'package.json');
+
+  return existsSync(manifest) && name in (JSON.parse(readFileSync(manifest, 'utf8')).scripts ?? {});
+}
+
+/**
+ * @param {string} command
+ * @param {string[]} args
+ * @param {string} cwd
+ */
+function run(command, args, cwd) {
+  console.log(`> ${command} ${args.join(' ')} (${cwd})`);
+
+  const result = spawnSync(command, args, { cwd, stdio: 'inherit', shell: process.platform === 'win32' });
+
+  if (result.status !== 0) {
+    console.error(`${command} exited with ${result.status ?? result.signal}`);
+    process.exit(result.status ?? 1);
+  }
+}
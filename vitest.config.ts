@@ -0,0 +1,21 @@
+import { fileURLToPath } from 'node:url';
+
+import { defineConfig } from 'vitest/config';
+
+const packages = fileURLToPath(new URL('./packages', import.meta.url));
+
+export default defineConfig({
+  resolve: {
+    // Run every package from its TypeScript sources rather than from a dist that may be stale or not built at all.
+    alias: [{ find: /^@libwin\/(comctl32|gdi32|kernel32|user32)$/, replacement: `${packages}/$1/lib/index.ts` }],
+  },
+  test: {
+    include: ['packages/*/lib/**/*.test.ts'],
+    setupFiles: ['packages/common/win32-stub/setup.ts'],
+    // Addons keep process-wide state (window classes, the message queue), so each file gets its own process.
+    pool: 'forks',
+    benchmark: {
+      include: ['packages/*/lib/**/*.bench.ts'],
+    },
+  },
+});